@@ -0,0 +1,26 @@
+#include <benchmark/benchmark.h>
+
+#include "sd_benchmark.hpp"
+
+/** Times the stages of the Stokesian Dynamics solver for a range of system
+ *  sizes and flags. All options of Google Benchmark are available, e.g.
+ *
+ *      sd_benchmark --benchmark_filter='host/.*' \
+ *                   --benchmark_out=sd.json --benchmark_out_format=json
+ *
+ *  writes machine-readable results for the CPU only.
+ */
+int main(int argc, char **argv) {
+  sd_benchmark::register_benchmarks<policy::host>("host");
+#if defined(SD_BENCHMARK_GPU)
+  sd_benchmark::register_device_benchmarks();
+#endif
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,235 @@
+#ifndef SD_BENCHMARK_HPP
+#define SD_BENCHMARK_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include "sd.hpp"
+
+namespace sd_benchmark {
+
+/** Wait for all work queued on the device, so that the asynchronous
+ *  BLAS/LAPACK calls are included in the measured time.
+ */
+inline void synchronize(policy::host) {}
+
+#if defined(__CUDACC__)
+inline void synchronize(policy::device) { cudaDeviceSynchronize(); }
+#elif defined(__HIPCC__)
+inline void synchronize(policy::device) { hipDeviceSynchronize(); }
+#endif
+
+/** Free memory in the memory space of the policy */
+inline std::size_t available_bytes(policy::host) {
+    long const pages = sysconf(_SC_AVPHYS_PAGES);
+    long const page_size = sysconf(_SC_PAGE_SIZE);
+    if (pages < 0 || page_size < 0) {
+        return 0;
+    }
+    return static_cast<std::size_t>(pages) *
+           static_cast<std::size_t>(page_size);
+}
+
+#if defined(__CUDACC__)
+inline std::size_t available_bytes(policy::device) {
+    std::size_t free = 0, total = 0;
+    cudaMemGetInfo(&free, &total);
+    return free;
+}
+#elif defined(__HIPCC__)
+inline std::size_t available_bytes(policy::device) {
+    std::size_t free = 0, total = 0;
+    hipMemGetInfo(&free, &total);
+    return free;
+}
+#endif
+
+/** A system of \p n_part spheres of unit radius on a slightly perturbed
+ *  simple cubic lattice, dilute enough to be free of overlaps but dense
+ *  enough that some pairs are within the lubrication cutoff.
+ */
+struct configuration {
+    std::vector<double> x, f, a;
+
+    explicit configuration(std::size_t n_part)
+        : x(6 * n_part), f(6 * n_part), a(n_part, 1.0) {
+        auto const side = static_cast<std::size_t>(
+            std::ceil(std::cbrt(static_cast<double>(n_part))));
+        for (std::size_t i = 0; i < n_part; ++i) {
+            std::size_t const ijk[3] = {i % side, (i / side) % side,
+                                        i / (side * side)};
+            for (std::size_t d = 0; d < 3; ++d) {
+                // deterministic jitter of at most 0.2
+                double const jitter = 0.2 * std::sin(1.7 * i + 2.9 * d);
+                x[6 * i + d] = 2.5 * ijk[d] + jitter;
+                f[6 * i + d] = std::cos(0.3 * i + d);
+                f[6 * i + 3 + d] = std::sin(0.7 * i + d);
+            }
+        }
+    }
+};
+
+/** Solver and buffers for one benchmark, initialized by a full run of
+ *  \ref sd::solver::calc_vel, so that every stage finds valid input.
+ */
+template <typename Policy>
+struct fixture {
+    std::size_t const n_part;
+    int const flg;
+    configuration const conf;
+    sd::solver<Policy, double> solver;
+    sd::workspace<Policy, double> ws;
+
+    explicit fixture(benchmark::State const &state)
+        : n_part(static_cast<std::size_t>(state.range(0))),
+          flg(static_cast<int>(state.range(1))), conf(n_part),
+          solver{1.0, n_part}, ws{n_part, flg} {
+        solver.calc_vel(ws, conf.x, conf.f, conf.a, 1.0, 0, 0, flg);
+        synchronize(Policy{});
+    }
+};
+
+/** The stages of \ref sd::solver::calc_vel, which are timed separately */
+enum class stage {
+    self_mobility,
+    pair_mobility,
+    invert_grand_mobility_matrix,
+    lubrication,
+    cholesky,
+    thermalization,
+    solve,
+    calc_vel,
+};
+
+template <typename Policy>
+void run(benchmark::State &state, stage s) {
+    fixture<Policy> fix(state);
+    auto &ws = fix.ws;
+    auto &solver = fix.solver;
+
+    for (auto _ : state) {
+        switch (s) {
+        case stage::self_mobility:
+            solver.add_self_mobility(ws, fix.flg);
+            break;
+        case stage::pair_mobility:
+            solver.add_pair_mobility(ws, fix.flg);
+            break;
+        case stage::invert_grand_mobility_matrix:
+            // The inversion consumes its input, so the mobility matrix is
+            // assembled again without timing it.
+            state.PauseTiming();
+            solver.add_self_mobility(ws, fix.flg);
+            solver.add_pair_mobility(ws, fix.flg);
+            synchronize(Policy{});
+            state.ResumeTiming();
+            solver.invert_grand_mobility_matrix(ws.zmuf, ws.zmus, ws.zmes,
+                                                ws.rsu, ws.rfu, ws.rfe, ws.rse,
+                                                fix.flg);
+            break;
+        case stage::lubrication:
+            solver.add_lubrication(ws, fix.flg);
+            break;
+        case stage::cholesky:
+            ws.rfu_factor.factorize(ws.rfu);
+            break;
+        case stage::thermalization:
+            benchmark::DoNotOptimize(solver.thermalization(
+                ws.rfu_factor, 6 * fix.n_part, 1.0, 0, 0));
+            break;
+        case stage::solve:
+            benchmark::DoNotOptimize(ws.rfu_factor.solve(ws.fext));
+            break;
+        case stage::calc_vel:
+            benchmark::DoNotOptimize(solver.calc_vel(
+                ws, fix.conf.x, fix.conf.f, fix.conf.a, 1.0, 0, 0, fix.flg));
+            break;
+        }
+        synchronize(Policy{});
+    }
+
+    state.counters["n_part"] = static_cast<double>(fix.n_part);
+    state.counters["flg"] = fix.flg;
+}
+
+/** Register all stages for one policy. The benchmarks are named
+ *  <policy>/<stage>/n_part:<n>/flg:<flags>, e.g.
+ *  host/lubrication/n_part:500/flg:15, and
+ *  sweep the number of particles and the flags (F-T, FTS, with and without
+ *  lubrication). Cases whose \ref sd::workspace::peak_bytes exceed the
+ *  free memory at registration are skipped, e.g. the larger FTS systems,
+ *  whose dense matrices take several GB at 5000 particles.
+ */
+template <typename Policy>
+void register_benchmarks(std::string const &policy_name) {
+    using sd::flags::FTS;
+    using sd::flags::LUBRICATION;
+    using sd::flags::PAIR_MOBILITY;
+    using sd::flags::SELF_MOBILITY;
+
+    static std::pair<char const *, stage> const stages[] = {
+        {"self_mobility", stage::self_mobility},
+        {"pair_mobility", stage::pair_mobility},
+        {"invert_grand_mobility_matrix", stage::invert_grand_mobility_matrix},
+        {"lubrication", stage::lubrication},
+        {"cholesky", stage::cholesky},
+        {"thermalization", stage::thermalization},
+        {"solve", stage::solve},
+        {"calc_vel", stage::calc_vel},
+    };
+
+    std::vector<std::int64_t> const n_parts = {50, 100, 200, 500, 1000, 2000, 5000};
+    std::int64_t const ft = SELF_MOBILITY | PAIR_MOBILITY;
+    std::vector<std::int64_t> const flgs = {ft, ft | LUBRICATION, ft | FTS,
+                                            ft | FTS | LUBRICATION};
+
+    // without the flag there is nothing to measure for the lubrication
+    std::vector<std::int64_t> const lub_flgs = {ft | LUBRICATION,
+                                                ft | FTS | LUBRICATION};
+
+    std::size_t const available = available_bytes(Policy{});
+    for (auto const &entry : stages) {
+        stage const s = entry.second;
+        std::vector<std::vector<std::int64_t>> args;
+        for (std::int64_t const n_part : n_parts) {
+            for (std::int64_t const flg :
+                 s == stage::lubrication ? lub_flgs : flgs) {
+                std::size_t const peak =
+                    sd::workspace<Policy, double>::peak_bytes(
+                        static_cast<std::size_t>(n_part),
+                        static_cast<int>(flg));
+                if (peak <= available) {
+                    args.push_back({n_part, flg});
+                }
+            }
+        }
+        if (args.empty()) {
+            continue;
+        }
+        auto *const bench =
+            benchmark::RegisterBenchmark(
+                (policy_name + "/" + entry.first).c_str(),
+                [s](benchmark::State &state) { run<Policy>(state, s); })
+                ->ArgNames({"n_part", "flg"})
+                ->Unit(benchmark::kMillisecond)
+                ->UseRealTime();
+        for (auto const &arg : args) {
+            bench->Args(arg);
+        }
+    }
+}
+
+#if defined(SD_BENCHMARK_GPU)
+void register_device_benchmarks();
+#endif
+
+} // namespace sd_benchmark
+
+#endif
@@ -0,0 +1,5 @@
+#include "sd_benchmark.hpp"
+
+void sd_benchmark::register_device_benchmarks() {
+  register_benchmarks<policy::device>("device");
+}
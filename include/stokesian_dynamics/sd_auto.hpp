@@ -0,0 +1,27 @@
+#ifndef SD_AUTO_HPP
+#define SD_AUTO_HPP
+
+#include <cstddef>
+#include <vector>
+
+std::vector<double> sd_auto(std::vector<double> const &x_host,
+                            std::vector<double> const &f_host,
+                            std::vector<double> const &a_host,
+                            std::size_t n_part, double eta, double sqrt_kT_Dt,
+                            std::size_t offset, std::size_t seed, int flg);
+
+std::vector<double> sd_auto_batch(std::vector<double> const &x_host,
+                                  std::vector<double> const &f_host,
+                                  std::vector<double> const &a_host,
+                                  std::size_t n_part, std::size_t n_batch,
+                                  double eta, double sqrt_kT_Dt,
+                                  std::size_t offset, std::size_t seed,
+                                  int flg, bool split);
+
+std::size_t sd_auto_calibrate(int flg, std::size_t max_particles);
+
+void sd_auto_set_crossover(int flg, std::size_t n_part);
+
+std::size_t sd_auto_crossover(int flg);
+
+#endif
@@ -4,10 +4,87 @@
 #include <cstddef>
 #include <vector>
 
+#include "sd_instrumentation.hpp"
+
 std::vector<double> sd_cpu(std::vector<double> const &x_host,
                            std::vector<double> const &f_host,
                            std::vector<double> const &a_host,
                            std::size_t n_part, double eta, double sqrt_kT_Dt,
                            std::size_t offset, std::size_t seed, int flg);
 
+std::vector<double> sd_cpu_batch(std::vector<double> const &x_host,
+                                 std::vector<double> const &f_host,
+                                 std::vector<double> const &a_host,
+                                 std::size_t n_part, std::size_t n_batch,
+                                 double eta, double sqrt_kT_Dt,
+                                 std::size_t offset, std::size_t seed, int flg);
+
+std::vector<double> sd_cpu_batch(std::vector<double> const &x_host,
+                                 std::vector<double> const &f_host,
+                                 std::vector<double> const &a_host,
+                                 std::size_t n_part, std::size_t n_batch,
+                                 double eta, double sqrt_kT_Dt,
+                                 std::size_t offset, std::size_t seed, int flg,
+                                 std::size_t first_system);
+
+std::size_t sd_cpu_peak_bytes(std::size_t n_part, int flg);
+
+struct sd_cpu_context;
+
+sd_cpu_context *sd_cpu_create(std::size_t n_part, int flg);
+
+std::vector<double> sd_cpu_step(sd_cpu_context *ctx,
+                                std::vector<double> const &x_host,
+                                std::vector<double> const &f_host,
+                                std::vector<double> const &a_host,
+                                std::size_t n_part, double eta,
+                                double sqrt_kT_Dt, std::size_t offset,
+                                std::size_t seed, int flg);
+
+std::vector<double> sd_cpu_step(sd_cpu_context *ctx,
+                                std::vector<double> const &x_host,
+                                std::vector<double> const &f_host,
+                                std::vector<double> const &a_host,
+                                std::size_t n_part, double eta,
+                                double sqrt_kT_Dt, std::size_t offset,
+                                std::size_t seed, int flg,
+                                std::vector<std::size_t> const &pairs);
+
+std::vector<double> sd_cpu_step_multi(sd_cpu_context *ctx,
+                                      std::vector<double> const &x_host,
+                                      std::vector<double> const &f_host,
+                                      std::vector<double> const &a_host,
+                                      std::size_t n_part, std::size_t n_rhs,
+                                      double eta, double sqrt_kT_Dt,
+                                      std::size_t offset, std::size_t seed,
+                                      int flg);
+
+void sd_cpu_step(sd_cpu_context *ctx, double const *x, std::size_t x_stride,
+                 double const *f, std::size_t f_stride, double const *a,
+                 std::size_t a_stride, double *u, std::size_t u_stride,
+                 std::size_t n_part, double eta, double sqrt_kT_Dt,
+                 std::size_t offset, std::size_t seed, int flg);
+
+void sd_cpu_set_box_length(sd_cpu_context *ctx, double box_l);
+
+void sd_cpu_set_num_threads(sd_cpu_context *ctx, int n_threads);
+
+void sd_cpu_set_reuse_thresholds(sd_cpu_context *ctx,
+                                 double max_displacement,
+                                 std::size_t max_iterations);
+
+void sd_cpu_reuse_statistics(sd_cpu_context const *ctx,
+                             std::size_t &factorizations,
+                             std::size_t &reused_steps,
+                             std::size_t &iterations, double &displacement);
+
+void sd_cpu_set_instrumentation(sd_cpu_context *ctx,
+                                sd_instrumentation *stats);
+
+void sd_cpu_set_factor_cache(sd_cpu_context *ctx, char const *directory);
+
+void sd_cpu_destroy(sd_cpu_context *ctx);
+
+bool sd_cpu_select_gpus(std::vector<int> const &devices, std::size_t min_size);
+
 #endif
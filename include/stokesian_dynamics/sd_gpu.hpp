@@ -2,12 +2,106 @@
 #define SD_GPU_HPP
 
 #include <cstddef>
+#include <future>
 #include <vector>
 
+#include "sd_instrumentation.hpp"
+
 std::vector<double> sd_gpu(std::vector<double> const &x_host,
                            std::vector<double> const &f_host,
                            std::vector<double> const &a_host,
                            std::size_t n_part, double eta, double sqrt_kT_Dt,
                            std::size_t offset, std::size_t seed, int flg);
 
+std::vector<double> sd_gpu_batch(std::vector<double> const &x_host,
+                                 std::vector<double> const &f_host,
+                                 std::vector<double> const &a_host,
+                                 std::size_t n_part, std::size_t n_batch,
+                                 double eta, double sqrt_kT_Dt,
+                                 std::size_t offset, std::size_t seed, int flg);
+
+std::vector<double> sd_gpu_batch(std::vector<double> const &x_host,
+                                 std::vector<double> const &f_host,
+                                 std::vector<double> const &a_host,
+                                 std::size_t n_part, std::size_t n_batch,
+                                 double eta, double sqrt_kT_Dt,
+                                 std::size_t offset, std::size_t seed, int flg,
+                                 std::size_t first_system);
+
+std::size_t sd_gpu_peak_bytes(std::size_t n_part, int flg);
+
+struct sd_gpu_context;
+
+sd_gpu_context *sd_gpu_create(std::size_t n_part, int flg);
+
+std::vector<double> sd_gpu_step(sd_gpu_context *ctx,
+                                std::vector<double> const &x_host,
+                                std::vector<double> const &f_host,
+                                std::vector<double> const &a_host,
+                                std::size_t n_part, double eta,
+                                double sqrt_kT_Dt, std::size_t offset,
+                                std::size_t seed, int flg);
+
+std::vector<double> sd_gpu_step(sd_gpu_context *ctx,
+                                std::vector<double> const &x_host,
+                                std::vector<double> const &f_host,
+                                std::vector<double> const &a_host,
+                                std::size_t n_part, double eta,
+                                double sqrt_kT_Dt, std::size_t offset,
+                                std::size_t seed, int flg,
+                                std::vector<std::size_t> const &pairs);
+
+std::vector<double> sd_gpu_step_multi(sd_gpu_context *ctx,
+                                      std::vector<double> const &x_host,
+                                      std::vector<double> const &f_host,
+                                      std::vector<double> const &a_host,
+                                      std::size_t n_part, std::size_t n_rhs,
+                                      double eta, double sqrt_kT_Dt,
+                                      std::size_t offset, std::size_t seed,
+                                      int flg);
+
+std::vector<double> sd_gpu_step_batch(sd_gpu_context *ctx,
+                                      std::vector<double> const &x_host,
+                                      std::vector<double> const &f_host,
+                                      std::vector<double> const &a_host,
+                                      std::size_t n_part, std::size_t n_batch,
+                                      double eta, double sqrt_kT_Dt,
+                                      std::size_t offset, std::size_t seed,
+                                      int flg);
+
+void sd_gpu_step(sd_gpu_context *ctx, double const *x, std::size_t x_stride,
+                 double const *f, std::size_t f_stride, double const *a,
+                 std::size_t a_stride, double *u, std::size_t u_stride,
+                 std::size_t n_part, double eta, double sqrt_kT_Dt,
+                 std::size_t offset, std::size_t seed, int flg, bool on_device);
+
+void sd_gpu_set_box_length(sd_gpu_context *ctx, double box_l);
+
+void sd_gpu_set_reuse_thresholds(sd_gpu_context *ctx,
+                                 double max_displacement,
+                                 std::size_t max_iterations);
+
+void sd_gpu_reuse_statistics(sd_gpu_context const *ctx,
+                             std::size_t &factorizations,
+                             std::size_t &reused_steps,
+                             std::size_t &iterations, double &displacement);
+
+void sd_gpu_set_instrumentation(sd_gpu_context *ctx,
+                                sd_instrumentation *stats);
+
+void sd_gpu_set_factor_cache(sd_gpu_context *ctx, char const *directory);
+
+std::future<void> sd_gpu_step_async(sd_gpu_context *ctx, void *stream,
+                                    double const *x_host, double const *f_host,
+                                    double const *a_host, double *u_host,
+                                    std::size_t n_part, double eta,
+                                    double sqrt_kT_Dt, std::size_t offset,
+                                    std::size_t seed, int flg);
+
+double *sd_gpu_alloc_pinned(std::size_t n);
+
+void sd_gpu_free_pinned(double *ptr);
+
+void sd_gpu_destroy(sd_gpu_context *ctx);
+
 #endif
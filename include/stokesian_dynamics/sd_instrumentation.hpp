@@ -0,0 +1,75 @@
+#ifndef SD_INSTRUMENTATION_HPP
+#define SD_INSTRUMENTATION_HPP
+
+#include <cstddef>
+
+/** Wall time and memory of the stages of the steps of a context, see
+ *  sd_cpu_set_instrumentation and sd_gpu_set_instrumentation. All values
+ *  are summed up over the steps since the object was attached or reset.
+ */
+struct sd_instrumentation {
+  enum stage {
+    /** resizing the buffers, the tables of the periodic box */
+    ALLOCATION,
+    /** copying the particle data in and the velocities out */
+    TRANSFER,
+    /** compacting and sorting the lubrication pairs of the dense solver,
+     *  the other solvers search and assemble the pairs within SOLVE
+     */
+    PAIR_LIST,
+    SELF_MOBILITY,
+    /** includes the pair distances, which are computed on the fly */
+    PAIR_MOBILITY,
+    INVERSION,
+    /** the dense lubrication correction, see PAIR_LIST */
+    LUBRICATION,
+    SYMMETRIZATION,
+    /** includes looking up and storing the factor in the cache, see
+     *  sd_cpu_set_factor_cache and sd_gpu_set_factor_cache
+     */
+    FACTORIZATION,
+    THERMALIZATION,
+    /** the final solve, or all of the work of the iterative, mixed
+     *  precision and reused factorization solvers
+     */
+    SOLVE,
+    N_STAGES
+  };
+
+  /** wall time of each stage in seconds */
+  double seconds[N_STAGES] = {};
+  /** bytes by which each stage grew the buffers of the workspace. The
+   *  buffers of the iterative, mixed precision and reused factorization
+   *  solvers and the table of the periodic box are included, the scratch
+   *  space of the BLAS/LAPACK libraries is not.
+   */
+  std::size_t bytes[N_STAGES] = {};
+  /** pairs passed to the lubrication correction, i.e. within the cutoff
+   *  or given by the caller. The iterative and mixed precision solvers
+   *  only pass the pairs within the cutoff.
+   */
+  std::size_t lubrication_pairs = 0;
+  /** iterations of the conjugate gradient and Lanczos methods of the
+   *  ITERATIVE and REUSE_FACTORIZATION solvers
+   */
+  std::size_t iterations = 0;
+  /** steps in which one of these solvers did not converge, the velocities
+   *  of these steps were computed with the dense solver instead
+   */
+  std::size_t fallbacks = 0;
+  /** number of steps */
+  std::size_t steps = 0;
+
+  void reset() { *this = sd_instrumentation{}; }
+
+  static char const *name(stage s) {
+    static char const *const names[N_STAGES] = {
+        "allocation",     "transfer",      "pair list",
+        "self mobility",  "pair mobility", "inversion",
+        "lubrication",    "symmetrization", "factorization",
+        "thermalization", "solve"};
+    return names[s];
+  }
+};
+
+#endif
@@ -7,12 +7,15 @@
 #ifndef SD_DEVICE_MATRIX_HPP
 #define SD_DEVICE_MATRIX_HPP
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <cstddef>
 #include <iomanip>
 #include <limits>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "thrust_wrapper.hpp"
 
@@ -22,6 +25,12 @@
 #elif defined(__HIPCC__)
 #include <rocblas.h>
 #include <rocsolver.h>
+#elif defined(SD_USE_CUSOLVERMG)
+#include <cstdint>
+#include <mutex>
+
+#include <cuda_runtime.h>
+#include <cusolverMg.h>
 #endif
 
 #if defined(__CUDACC__) || defined(__HIPCC__)
@@ -44,6 +53,21 @@
  *  for host or device. The `par()` function returns the according Thrust
  *  execution policy that is needed when Thrust routines are called.
  */
+#if defined(__CUDACC__) || defined(__HIPCC__)
+namespace internal {
+#if defined(__CUDACC__)
+using stream_type = cudaStream_t;
+#else
+using stream_type = hipStream_t;
+#endif
+
+/** Stream bound to the handles of the calling thread on the current device,
+ *  see \ref handle_pool::set_stream
+ */
+inline stream_type bound_stream();
+} // namespace internal
+#endif
+
 namespace policy {
 
 struct host {
@@ -55,11 +79,23 @@ struct host {
       { return thrust_wrapper::host; }
 };
 
+/** On GPUs, the Thrust algorithms run on the stream that is bound to the
+ *  BLAS/LAPACK handles, so that all work of a time step is queued on the
+ *  same stream.
+ */
 struct device {
     template <typename T>
     using vector = thrust_wrapper::device_vector<T>;
+#if defined(__CUDACC__)
+    static decltype(thrust::cuda::par.on(internal::stream_type{})) par()
+      { return thrust::cuda::par.on(internal::bound_stream()); }
+#elif defined(__HIPCC__)
+    static decltype(thrust::hip::par.on(internal::stream_type{})) par()
+      { return thrust::hip::par.on(internal::bound_stream()); }
+#else
     static std::remove_const<decltype(thrust_wrapper::device)>::type par()
       { return thrust_wrapper::device; }
+#endif
 };
 
 template <typename...>
@@ -84,6 +120,38 @@ unravel_index(std::size_t index, std::size_t lda) {
     ;
 }
 
+/** Linear index of the pair (\p i, \p j) with i < j < \p n, when the strict
+ *  upper triangle of an n x n matrix is enumerated row by row.
+ */
+DEVICE_FUNC inline std::size_t ravel_triangular_index(std::size_t i,
+                                                      std::size_t j,
+                                                      std::size_t n) {
+    return i * (2 * n - i - 1) / 2 + (j - i - 1);
+}
+
+/** Inverse of \ref ravel_triangular_index, i.e. the pair (i, j) with
+ *  i < j < \p n that belongs to \p index. The row is estimated in floating
+ *  point and then corrected, so the result is exact for any n.
+ */
+DEVICE_FUNC inline thrust_wrapper::tuple<std::size_t, std::size_t>
+unravel_triangular_index(std::size_t index, std::size_t n) {
+    double const b = 2. * static_cast<double>(n) - 1.;
+    double const disc = b * b - 8. * static_cast<double>(index);
+    auto i = static_cast<std::size_t>(
+        0.5 * (b - std::sqrt(disc > 0. ? disc : 0.)));
+    if (i > n - 2) {
+        i = n - 2;
+    }
+    while (i > 0 && i * (2 * n - i - 1) / 2 > index) {
+        --i;
+    }
+    while ((i + 1) * (2 * n - i - 2) / 2 <= index) {
+        ++i;
+    }
+    std::size_t const j = index - i * (2 * n - i - 1) / 2 + i + 1;
+    return thrust_wrapper::make_tuple(i, j);
+}
+
 /// \cond
 
 // LAPACK prototypes
@@ -96,15 +164,620 @@ int dgemm_(char *transa, char *transb, int *m, int *n, int *k, double *alpha,
 int dgemv_(char *trans, int *m, int *n, double *alpha, double *a, int *lda,
            double *x, int *incx, double *beta, double *y, int *incy);
 
+int daxpy_(int *n, double *alpha, double *x, int *incx, double *y, int *incy);
+
+double ddot_(int *n, double *x, int *incx, double *y, int *incy);
+
+int dscal_(int *n, double *alpha, double *x, int *incx);
+
+int dsymm_(char *side, char *uplo, int *m, int *n, double *alpha, double *a,
+           int *lda, double *b, int *ldb, double *beta, double *c, int *ldc);
+
+int dsyrk_(char *uplo, char *trans, int *n, int *k, double *alpha, double *a,
+           int *lda, double *beta, double *c, int *ldc);
+
+int dtrsm_(char *side, char *uplo, char *transa, char *diag, int *m, int *n,
+           double *alpha, double *a, int *lda, double *b, int *ldb);
+
+int dtrmm_(char *side, char *uplo, char *transa, char *diag, int *m, int *n,
+           double *alpha, double *a, int *lda, double *b, int *ldb);
+
 int dpotrf_(char *uplo, int *n, double *a, int *lda, int *info);
 
 int dpotrs_(char *uplo, int *n, int *nrhs, double *a, int *lda, double *b,
             int *ldb, int *info);
+
+int dpotri_(char *uplo, int *n, double *a, int *lda, int *info);
+
+int dtrmv_(char *uplo, char *trans, char *diag, int *n, double *a, int *lda,
+           double *x, int *incx);
+
+int sgemm_(char *transa, char *transb, int *m, int *n, int *k, float *alpha,
+           float *a, int *lda, float *b, int *ldb, float *beta, float *c,
+           int *ldc);
+
+int sgemv_(char *trans, int *m, int *n, float *alpha, float *a, int *lda,
+           float *x, int *incx, float *beta, float *y, int *incy);
+
+int saxpy_(int *n, float *alpha, float *x, int *incx, float *y, int *incy);
+
+float sdot_(int *n, float *x, int *incx, float *y, int *incy);
+
+int sscal_(int *n, float *alpha, float *x, int *incx);
+
+int ssymm_(char *side, char *uplo, int *m, int *n, float *alpha, float *a,
+           int *lda, float *b, int *ldb, float *beta, float *c, int *ldc);
+
+int ssyrk_(char *uplo, char *trans, int *n, int *k, float *alpha, float *a,
+           int *lda, float *beta, float *c, int *ldc);
+
+int strsm_(char *side, char *uplo, char *transa, char *diag, int *m, int *n,
+           float *alpha, float *a, int *lda, float *b, int *ldb);
+
+int strmm_(char *side, char *uplo, char *transa, char *diag, int *m, int *n,
+           float *alpha, float *a, int *lda, float *b, int *ldb);
+
+int spotrf_(char *uplo, int *n, float *a, int *lda, int *info);
+
+int spotrs_(char *uplo, int *n, int *nrhs, float *a, int *lda, float *b,
+            int *ldb, int *info);
+
+int spotri_(char *uplo, int *n, float *a, int *lda, int *info);
+
+int strmv_(char *uplo, char *trans, char *diag, int *n, float *a, int *lda,
+           float *x, int *incx);
 }
 #endif
 
 namespace internal {
 
+#if defined(__CUDACC__)
+/** Creating a cuBLAS or cuSOLVER handle is expensive compared to a single
+ *  BLAS call on small matrices. The `handle_pool` therefore creates the
+ *  handles lazily, once per thread and device, and keeps them until the
+ *  thread exits. A stream can be bound to the handles of the current device,
+ *  which is then used by all subsequent calls from this thread.
+ */
+class handle_pool {
+    struct entry {
+        cublasHandle_t blas = nullptr;
+        cusolverDnHandle_t solver = nullptr;
+        cudaStream_t stream = nullptr;
+    };
+    std::vector<entry> m_entries;
+
+    handle_pool() = default;
+
+    entry &current() {
+        int device = 0;
+        MAYBE_UNUSED cudaError_t err = cudaGetDevice(&device);
+        assert(cudaSuccess == err);
+        if (static_cast<std::size_t>(device) >= m_entries.size()) {
+            m_entries.resize(device + 1);
+        }
+        return m_entries[device];
+    }
+
+public:
+    handle_pool(handle_pool const &) = delete;
+    handle_pool &operator=(handle_pool const &) = delete;
+
+    ~handle_pool() {
+        // Errors are ignored, the CUDA runtime might already be shut down
+        // when the pool of the main thread gets destroyed.
+        for (std::size_t device = 0; device < m_entries.size(); ++device) {
+            if (m_entries[device].blas || m_entries[device].solver) {
+                cudaSetDevice(static_cast<int>(device));
+            }
+            if (m_entries[device].blas) {
+                cublasDestroy(m_entries[device].blas);
+            }
+            if (m_entries[device].solver) {
+                cusolverDnDestroy(m_entries[device].solver);
+            }
+        }
+    }
+
+    /** The pool of the calling thread */
+    static handle_pool &instance() {
+        static thread_local handle_pool pool;
+        return pool;
+    }
+
+    /** cuBLAS handle for the current device */
+    cublasHandle_t blas() {
+        entry &e = current();
+        if (!e.blas) {
+            MAYBE_UNUSED cublasStatus_t stat = cublasCreate(&e.blas);
+            assert(CUBLAS_STATUS_SUCCESS == stat);
+            stat = cublasSetStream(e.blas, e.stream);
+            assert(CUBLAS_STATUS_SUCCESS == stat);
+        }
+        return e.blas;
+    }
+
+    /** cuSOLVER handle for the current device */
+    cusolverDnHandle_t solver() {
+        entry &e = current();
+        if (!e.solver) {
+            MAYBE_UNUSED cusolverStatus_t stat = cusolverDnCreate(&e.solver);
+            assert(CUSOLVER_STATUS_SUCCESS == stat);
+            stat = cusolverDnSetStream(e.solver, e.stream);
+            assert(CUSOLVER_STATUS_SUCCESS == stat);
+        }
+        return e.solver;
+    }
+
+    /** Stream bound to the handles of the current device */
+    cudaStream_t stream() { return current().stream; }
+
+    /** Bind \p stream to the handles of the current device. Passing
+     *  `nullptr` selects the default stream again.
+     */
+    void set_stream(cudaStream_t stream) {
+        entry &e = current();
+        e.stream = stream;
+        if (e.blas) {
+            MAYBE_UNUSED cublasStatus_t stat = cublasSetStream(e.blas, stream);
+            assert(CUBLAS_STATUS_SUCCESS == stat);
+        }
+        if (e.solver) {
+            MAYBE_UNUSED cusolverStatus_t stat =
+                cusolverDnSetStream(e.solver, stream);
+            assert(CUSOLVER_STATUS_SUCCESS == stat);
+        }
+    }
+};
+
+inline stream_type bound_stream() { return handle_pool::instance().stream(); }
+#elif defined(__HIPCC__)
+/** Creating a rocBLAS handle is expensive compared to a single BLAS call on
+ *  small matrices. The `handle_pool` therefore creates the handles lazily,
+ *  once per thread and device, and keeps them until the thread exits.
+ *  rocSOLVER uses the same handle type as rocBLAS. A stream can be bound to
+ *  the handle of the current device, which is then used by all subsequent
+ *  calls from this thread.
+ */
+class handle_pool {
+    struct entry {
+        rocblas_handle blas = nullptr;
+        hipStream_t stream = nullptr;
+    };
+    std::vector<entry> m_entries;
+
+    handle_pool() = default;
+
+    entry &current() {
+        int device = 0;
+        MAYBE_UNUSED hipError_t err = hipGetDevice(&device);
+        assert(hipSuccess == err);
+        if (static_cast<std::size_t>(device) >= m_entries.size()) {
+            m_entries.resize(device + 1);
+        }
+        return m_entries[device];
+    }
+
+public:
+    handle_pool(handle_pool const &) = delete;
+    handle_pool &operator=(handle_pool const &) = delete;
+
+    ~handle_pool() {
+        // Errors are ignored, the HIP runtime might already be shut down
+        // when the pool of the main thread gets destroyed.
+        for (std::size_t device = 0; device < m_entries.size(); ++device) {
+            if (m_entries[device].blas) {
+                hipSetDevice(static_cast<int>(device));
+                rocblas_destroy_handle(m_entries[device].blas);
+            }
+        }
+    }
+
+    /** The pool of the calling thread */
+    static handle_pool &instance() {
+        static thread_local handle_pool pool;
+        return pool;
+    }
+
+    /** rocBLAS handle for the current device */
+    rocblas_handle blas() {
+        entry &e = current();
+        if (!e.blas) {
+            MAYBE_UNUSED rocblas_status stat = rocblas_create_handle(&e.blas);
+            assert(rocblas_status_success == stat);
+            stat = rocblas_set_stream(e.blas, e.stream);
+            assert(rocblas_status_success == stat);
+        }
+        return e.blas;
+    }
+
+    /** rocSOLVER handle for the current device */
+    rocblas_handle solver() { return blas(); }
+
+    /** Stream bound to the handle of the current device */
+    hipStream_t stream() { return current().stream; }
+
+    /** Bind \p stream to the handle of the current device. Passing
+     *  `nullptr` selects the default stream again.
+     */
+    void set_stream(hipStream_t stream) {
+        entry &e = current();
+        e.stream = stream;
+        if (e.blas) {
+            MAYBE_UNUSED rocblas_status stat = rocblas_set_stream(e.blas, stream);
+            assert(rocblas_status_success == stat);
+        }
+    }
+};
+
+inline stream_type bound_stream() { return handle_pool::instance().stream(); }
+#endif
+
+#if defined(SD_USE_CUSOLVERMG) && !defined(__CUDACC__) && !defined(__HIPCC__)
+/** Distributes the Cholesky factorizations and inversions of large host
+ *  matrices over several GPUs with cuSOLVERMg, so that matrices which do
+ *  not fit into the memory of a single GPU can still be factorized there.
+ *  The matrix stays in host memory. Its columns are copied to the GPUs in
+ *  the 1D block-cyclic layout expected by cuSOLVERMg and back after the
+ *  factorization. Smaller matrices are left to LAPACK.
+ *
+ *  The backend is shared by all threads, concurrent calls are serialized.
+ */
+class multi_gpu {
+    std::vector<int> m_devices;
+    int m_min_size = 0;
+    int m_block_size = 256;
+    cusolverMgHandle_t m_handle = nullptr;
+    cudaLibMgGrid_t m_grid = nullptr;
+    std::mutex m_mutex;
+
+    multi_gpu() = default;
+
+    void release() {
+        if (m_grid) {
+            cusolverMgDestroyGrid(m_grid);
+            m_grid = nullptr;
+        }
+        if (m_handle) {
+            cusolverMgDestroy(m_handle);
+            m_handle = nullptr;
+        }
+    }
+
+    static cudaDataType data_type(double const *) { return CUDA_R_64F; }
+    static cudaDataType data_type(float const *) { return CUDA_R_32F; }
+
+    /** Copy the columns of \p A to or from the local buffers \p local of
+     *  the GPUs. Column block b lives on GPU b % n_dev as its local column
+     *  block b / n_dev, all local buffers have the leading dimension N.
+     */
+    template <typename T>
+    void copy(T *A, std::vector<void *> const &local, int N,
+              cudaMemcpyKind kind) const {
+        int const n_dev = static_cast<int>(m_devices.size());
+        for (int first = 0, b = 0; first < N; first += m_block_size, ++b) {
+            int const cols = std::min(m_block_size, N - first);
+            int const dev = b % n_dev;
+            T *const tile = static_cast<T *>(local[dev]) +
+                            static_cast<std::size_t>(b / n_dev) *
+                                m_block_size * N;
+            T *const column = A + static_cast<std::size_t>(first) * N;
+            std::size_t const bytes = sizeof(T) * N * cols;
+            MAYBE_UNUSED cudaError_t err = cudaSetDevice(m_devices[dev]);
+            assert(cudaSuccess == err);
+            err = (kind == cudaMemcpyHostToDevice)
+                      ? cudaMemcpy(tile, column, bytes, kind)
+                      : cudaMemcpy(column, tile, bytes, kind);
+            assert(cudaSuccess == err);
+        }
+    }
+
+    /** Run cusolverMgPotrf or, if \p inverse is set, cusolverMgPotri on
+     *  the upper triangle of \p A
+     */
+    template <typename T>
+    void run(T *A, int N, bool inverse) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        int current = 0;
+        MAYBE_UNUSED cudaError_t err = cudaGetDevice(&current);
+        assert(cudaSuccess == err);
+
+        int const n_dev = static_cast<int>(m_devices.size());
+        int const n_blocks = (N + m_block_size - 1) / m_block_size;
+        std::size_t const local_size =
+            static_cast<std::size_t>((n_blocks + n_dev - 1) / n_dev) *
+            m_block_size * N;
+        cudaDataType const type = data_type(A);
+
+        cudaLibMgMatrixDesc_t desc;
+        MAYBE_UNUSED cusolverStatus_t stat = cusolverMgCreateMatrixDesc(
+            &desc, N, N, N, m_block_size, type, m_grid);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+
+        std::vector<void *> local(n_dev, nullptr), work(n_dev, nullptr);
+        for (int dev = 0; dev < n_dev; ++dev) {
+            err = cudaSetDevice(m_devices[dev]);
+            assert(cudaSuccess == err);
+            err = cudaMalloc(&local[dev], sizeof(T) * local_size);
+            assert(cudaSuccess == err);
+        }
+        copy(A, local, N, cudaMemcpyHostToDevice);
+
+        int64_t lwork = 0;
+        if (inverse) {
+            stat = cusolverMgPotri_bufferSize(m_handle, CUBLAS_FILL_MODE_UPPER,
+                                              N, local.data(), 1, 1, desc,
+                                              type, &lwork);
+        } else {
+            stat = cusolverMgPotrf_bufferSize(m_handle, CUBLAS_FILL_MODE_UPPER,
+                                              N, local.data(), 1, 1, desc,
+                                              type, &lwork);
+        }
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        for (int dev = 0; dev < n_dev; ++dev) {
+            err = cudaSetDevice(m_devices[dev]);
+            assert(cudaSuccess == err);
+            err = cudaMalloc(&work[dev], sizeof(T) * lwork);
+            assert(cudaSuccess == err);
+            err = cudaDeviceSynchronize();
+            assert(cudaSuccess == err);
+        }
+
+        int info = 0;
+        if (inverse) {
+            stat = cusolverMgPotri(m_handle, CUBLAS_FILL_MODE_UPPER, N,
+                                   local.data(), 1, 1, desc, type,
+                                   work.data(), lwork, &info);
+        } else {
+            stat = cusolverMgPotrf(m_handle, CUBLAS_FILL_MODE_UPPER, N,
+                                   local.data(), 1, 1, desc, type,
+                                   work.data(), lwork, &info);
+        }
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(info == 0);
+
+        copy(A, local, N, cudaMemcpyDeviceToHost);
+        for (int dev = 0; dev < n_dev; ++dev) {
+            err = cudaSetDevice(m_devices[dev]);
+            assert(cudaSuccess == err);
+            cudaFree(work[dev]);
+            cudaFree(local[dev]);
+        }
+        stat = cusolverMgDestroyMatrixDesc(desc);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        err = cudaSetDevice(current);
+        assert(cudaSuccess == err);
+    }
+
+public:
+    multi_gpu(multi_gpu const &) = delete;
+    multi_gpu &operator=(multi_gpu const &) = delete;
+
+    ~multi_gpu() { release(); }
+
+    /** The backend shared by all threads */
+    static multi_gpu &instance() {
+        static multi_gpu backend;
+        return backend;
+    }
+
+    /** Use the GPUs \p devices for all matrices with at least \p min_size
+     *  rows. An empty list disables the backend again.
+     *
+     *  \param block_size number of columns per block of the block-cyclic
+     *                    layout
+     */
+    void select(std::vector<int> const &devices, int min_size,
+                int block_size = 256) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        release();
+        m_devices = devices;
+        m_min_size = min_size;
+        m_block_size = block_size;
+        if (m_devices.empty()) {
+            return;
+        }
+
+        // The GPUs exchange tiles directly if they can
+        for (int dev : m_devices) {
+            cudaSetDevice(dev);
+            for (int peer : m_devices) {
+                int can_access = 0;
+                cudaDeviceCanAccessPeer(&can_access, dev, peer);
+                if (peer != dev && can_access) {
+                    // fails harmlessly if the access is already enabled
+                    cudaDeviceEnablePeerAccess(peer, 0);
+                    cudaGetLastError();
+                }
+            }
+        }
+
+        MAYBE_UNUSED cusolverStatus_t stat = cusolverMgCreate(&m_handle);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        stat = cusolverMgDeviceSelect(m_handle,
+                                      static_cast<int>(m_devices.size()),
+                                      m_devices.data());
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        stat = cusolverMgCreateDeviceGrid(
+            &m_grid, 1, static_cast<int32_t>(m_devices.size()),
+            m_devices.data(), CUDALIBMG_GRID_MAPPING_COL_MAJOR);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+    }
+
+    /** Whether a matrix with \p N rows is handled by this backend */
+    bool applicable(int N) const {
+        return !m_devices.empty() && N >= m_min_size;
+    }
+
+    /** Cholesky factorization, like \ref cusolver::potrf */
+    template <typename T>
+    void potrf(T *A, int N) {
+        run(A, N, false);
+    }
+
+    /** Inverse from the Cholesky factorization, like \ref cusolver::potri */
+    template <typename T>
+    void potri(T *A, int N) {
+        run(A, N, true);
+    }
+};
+#endif
+
+/** Mirrors the upper triangle of a square matrix into its lower triangle.
+ *  Each index handles one tile of the lower triangle, so that the tiles can
+ *  be processed in parallel. The tile which is read from lies in the upper
+ *  triangle and is never written, therefore there are no data races.
+ *  Several matrices which are stored one after another can be processed at
+ *  once, the tiles of all matrices are simply enumerated consecutively.
+ */
+template <typename T>
+struct SymmetrizeUpper {
+    static constexpr std::size_t tile = 32;
+
+    T *data;
+    std::size_t n;
+    /** number of tiles per dimension */
+    std::size_t n_tiles;
+
+    DEVICE_FUNC void operator()(std::size_t index) {
+        std::size_t const tiles_per_matrix = n_tiles * (n_tiles + 1) / 2;
+        T *const A = data + (index / tiles_per_matrix) * n * n;
+
+        // enumerate the tiles on and below the diagonal
+        std::size_t bj, bi;
+        thrust_wrapper::tie(bj, bi) =
+            unravel_triangular_index(index % tiles_per_matrix, n_tiles + 1);
+        bi -= 1;
+
+        std::size_t const row_end = (bi + 1) * tile < n ? (bi + 1) * tile : n;
+        std::size_t const col_end = (bj + 1) * tile < n ? (bj + 1) * tile : n;
+        for (std::size_t col = bj * tile; col < col_end; ++col) {
+            std::size_t const row_begin = bi * tile > col ? bi * tile : col + 1;
+            for (std::size_t row = row_begin; row < row_end; ++row) {
+                A[row + col * n] = A[col + row * n];
+            }
+        }
+    }
+};
+
+/** Copy the upper triangles of \p batch square matrices of size \p n, which
+ *  are stored one after another, into their lower triangles.
+ */
+template <typename Policy, typename T>
+void symmetrize_upper_batched(T *data, std::size_t n, std::size_t batch) {
+    if (n < 2) {
+        return;
+    }
+    using functor = SymmetrizeUpper<T>;
+    std::size_t const n_tiles = (n + functor::tile - 1) / functor::tile;
+    thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+    thrust_wrapper::for_each(Policy::par(), begin,
+                             begin + batch * n_tiles * (n_tiles + 1) / 2,
+                             functor{data, n, n_tiles});
+}
+
+/** Sets the strict lower triangle of square matrices of size n, which are
+ *  stored one after another, to zero.
+ */
+template <typename T>
+struct ZeroStrictLower {
+    T *data;
+    std::size_t n;
+
+    DEVICE_FUNC void operator()(std::size_t index) {
+        std::size_t i, j;
+        thrust_wrapper::tie(i, j) = unravel_index(index % (n * n), n);
+        if (i > j) {
+            data[index] = T{0};
+        }
+    }
+};
+
+/** Pointers to matrices which are stored one after another, as required by
+ *  the batched routines that take arrays of pointers.
+ */
+template <typename T>
+struct BatchPointer {
+    T *data;
+    std::size_t stride;
+
+    DEVICE_FUNC T *operator()(std::size_t index) const {
+        return data + index * stride;
+    }
+};
+
+/** Whether all entries of the \p info array of a batched LAPACK routine
+ *  report success. The array is copied to the host, so this is meant for
+ *  assertions.
+ */
+template <typename Int>
+bool batch_succeeded(thrust_wrapper::device_vector<Int> const &info) {
+    thrust_wrapper::host_vector<Int> const host(info);
+    return std::all_of(host.begin(), host.end(), [](Int i) { return i == 0; });
+}
+
+/** Product of a block sparse row matrix with a vector, y = alpha A x + beta y.
+ *  Each index handles one block row, so the rows of y are written by exactly
+ *  one thread each. The blocks are stored column-major one after another.
+ */
+template <typename T>
+struct BsrProduct {
+    T const *values;
+    std::size_t const *row_offsets;
+    std::size_t const *col_indices;
+    std::size_t row_block;
+    std::size_t col_block;
+    T const *x;
+    T *y;
+    T alpha;
+    T beta;
+
+    DEVICE_FUNC void operator()(std::size_t row) {
+        for (std::size_t r = 0; r < row_block; ++r) {
+            T sum = T{0};
+            for (std::size_t b = row_offsets[row]; b < row_offsets[row + 1];
+                 ++b) {
+                T const *A = values + b * row_block * col_block;
+                T const *xb = x + col_indices[b] * col_block;
+                for (std::size_t c = 0; c < col_block; ++c) {
+                    sum += A[r + c * row_block] * xb[c];
+                }
+            }
+            // like in BLAS, y is not read if beta is zero
+            T &yr = y[row * row_block + r];
+            yr = beta == T{0} ? alpha * sum : alpha * sum + beta * yr;
+        }
+    }
+};
+
+/** Adds a block sparse row matrix to a dense column-major matrix with
+ *  leading dimension \p lda, converting the values to the type of the dense
+ *  matrix. Each index handles one block row and the blocks of a row belong
+ *  to distinct block columns, so every element is written at most once.
+ */
+template <typename T, typename U>
+struct BsrAddToDense {
+    T const *values;
+    std::size_t const *row_offsets;
+    std::size_t const *col_indices;
+    std::size_t row_block;
+    std::size_t col_block;
+    U *A;
+    std::size_t lda;
+
+    DEVICE_FUNC void operator()(std::size_t row) {
+        for (std::size_t b = row_offsets[row]; b < row_offsets[row + 1]; ++b) {
+            T const *block = values + b * row_block * col_block;
+            std::size_t const col = col_indices[b];
+            for (std::size_t c = 0; c < col_block; ++c) {
+                for (std::size_t r = 0; r < row_block; ++r) {
+                    A[(row * row_block + r) + (col * col_block + c) * lda] +=
+                        static_cast<U>(block[r + c * row_block]);
+                }
+            }
+        }
+    }
+};
+
 /** The `cublas` struct channels access to efficient basic matrix operations
  *  provided by either the cuBLAS library (after which it is named), which
  *  executes on an Nvidia GPU, rocBLAS, which executes on an AMD GPU, or by
@@ -112,7 +785,7 @@ namespace internal {
  *  \tparam Policy Specifies whether the routines are executed on host or on
  *                 device, by either passing \ref policy::host or \ref
  *                 policy::device
- *  \tparam T      Specifies the data type (only `double` is available).
+ *  \tparam T      Specifies the data type (`double` or `float`).
  */
 template <typename Policy, typename T>
 struct cublas {};
@@ -133,15 +806,11 @@ struct cublas<policy::device, double> {
         double const beta = 0;
 
         MAYBE_UNUSED cublasStatus_t stat;
-        cublasHandle_t handle;
-        stat = cublasCreate(&handle);
-        assert(CUBLAS_STATUS_SUCCESS == stat);
+        cublasHandle_t handle = handle_pool::instance().blas();
 
         stat = cublasDgeam(handle, CUBLAS_OP_T, CUBLAS_OP_T, n, m, &alpha, A, m,
                            &beta, A, m, C, n);
         assert(CUBLAS_STATUS_SUCCESS == stat);
-
-        cublasDestroy(handle);
     }
 
     /** Matrix matrix multiplication
@@ -154,20 +823,28 @@ struct cublas<policy::device, double> {
      */
     static void gemm(const double *A, const double *B, double *C, int m, int k,
                      int n) {
-        int lda = m, ldb = k, ldc = m;
-        double alpha = 1;
-        double beta = 0;
+        gemm(false, false, A, B, C, m, k, n, 1, 0);
+    }
+
+    /** Fused matrix matrix multiplication, C = alpha op(A) op(B) + beta C,
+     *  which accumulates into C without temporaries.
+     *  \param transA, transB whether A or B enter transposed
+     *  \param m number of rows of op(A) and C
+     *  \param k number of columns of op(A), rows of op(B)
+     *  \param n number of columns of op(B) and C
+     */
+    static void gemm(bool transA, bool transB, const double *A,
+                     const double *B, double *C, int m, int k, int n,
+                     double alpha, double beta) {
+        int lda = transA ? k : m, ldb = transB ? n : k, ldc = m;
 
         MAYBE_UNUSED cublasStatus_t stat;
-        cublasHandle_t handle;
-        stat = cublasCreate(&handle);
-        assert(CUBLAS_STATUS_SUCCESS == stat);
+        cublasHandle_t handle = handle_pool::instance().blas();
 
-        stat = cublasDgemm(handle, CUBLAS_OP_N, CUBLAS_OP_N, m, n, k, &alpha, A,
-                           lda, B, ldb, &beta, C, ldc);
+        stat = cublasDgemm(handle, transA ? CUBLAS_OP_T : CUBLAS_OP_N,
+                           transB ? CUBLAS_OP_T : CUBLAS_OP_N, m, n, k, &alpha,
+                           A, lda, B, ldb, &beta, C, ldc);
         assert(CUBLAS_STATUS_SUCCESS == stat);
-
-        cublasDestroy(handle);
     }
 
     /** Matrix vector multiplication
@@ -179,274 +856,1835 @@ struct cublas<policy::device, double> {
      */
     static void gemv(const double *A, const double *x, double *y, int m,
                      int n) {
+        gemv(false, A, x, y, m, n, 1, 0);
+    }
+
+    /** Fused matrix vector multiplication, y = alpha op(A) x + beta y
+     *  \param trans whether A enters transposed
+     *  \param m number of rows of A
+     *  \param n number of columns of A
+     */
+    static void gemv(bool trans, const double *A, const double *x, double *y,
+                     int m, int n, double alpha, double beta) {
         int lda = m;
-        double alpha = 1;
-        double beta = 0;
         int incx = 1;
         int incy = 1;
 
         MAYBE_UNUSED cublasStatus_t stat;
-        cublasHandle_t handle;
-        stat = cublasCreate(&handle);
-        assert(CUBLAS_STATUS_SUCCESS == stat);
+        cublasHandle_t handle = handle_pool::instance().blas();
 
-        stat = cublasDgemv(handle, CUBLAS_OP_N, m, n, &alpha, A, lda, x, incx,
-                           &beta, y, incy);
+        stat = cublasDgemv(handle, trans ? CUBLAS_OP_T : CUBLAS_OP_N, m, n,
+                           &alpha, A, lda, x, incx, &beta, y, incy);
         assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    /** Scaled vector addition, y = alpha x + y
+     *  \param n number of elements of x and y
+     */
+    static void axpy(int n, double alpha, const double *x, double *y) {
+        int incx = 1;
+        int incy = 1;
 
-        cublasDestroy(handle);
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasDaxpy(handle, n, &alpha, x, incx, y, incy);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
     }
-};
-#elif defined(__HIPCC__)
-/** Basic matrix operations on device (AMD-GPU) using the rocBLAS library
- */
-template <>
-struct cublas<policy::device, double> {
-    /** Transpose matrix
-     *  \param A buffer on device for the matrix to be transposed.
-     *  \param C buffer on device to store the result. May be the same as A.
-     *  \param m number of rows of A
-     *  \param n number of columns of A
+
+    /** Dot product of two vectors
+     *  \param n number of elements of x and y
      */
-    static void geam(double const *A, double *C, int m, int n) {
-        double const alpha = 1;
-        double const beta = 0;
+    static double dot(int n, const double *x, const double *y) {
+        double result;
 
-        MAYBE_UNUSED rocblas_status stat;
-        rocblas_handle handle;
-        stat = rocblas_create_handle(&handle);
-        assert(rocblas_status_success == stat);
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
 
-        stat = rocblas_dgeam(handle, rocblas_operation_transpose,
-                             rocblas_operation_transpose, n, m, &alpha, A, m,
-                             &beta, A, m, C, n);
-        assert(rocblas_status_success == stat);
+        stat = cublasDdot(handle, n, x, 1, y, 1, &result);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+        return result;
+    }
+
+    /** Scale a vector in place, x = alpha x
+     *  \param n number of elements of x
+     */
+    static void scal(int n, double alpha, double *x) {
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
 
-        rocblas_destroy_handle(handle);
+        stat = cublasDscal(handle, n, &alpha, x, 1);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
     }
 
-    /** Matrix matrix multiplication
-     *  \param A buffer on device for the matrix: first factor
-     *  \param B buffer on device for the matrix: second factor
-     *  \param C buffer on device to store the result
-     *  \param m number of rows of A
+    /** Multiply a vector with the transpose of an upper triangular matrix,
+     *  x = A^T x, where A^T is the lower triangular Cholesky factor.
+     *  \param A buffer on device for the upper triangular matrix
+     *  \param x buffer on device for the vector, overwritten with the result
+     *  \param n size of the matrix
+     */
+    static void trmv(const double *A, double *x, int n) {
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasDtrmv(handle, CUBLAS_FILL_MODE_UPPER, CUBLAS_OP_T,
+                           CUBLAS_DIAG_NON_UNIT, n, A, n, x, 1);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    /** Symmetric matrix matrix multiplication, C = alpha S B + beta C or
+     *  C = alpha B S, where only the upper triangle of S is referenced.
+     *  \param right whether S is multiplied from the right
+     *  \param m number of rows of B and C
+     *  \param n number of columns of B and C
+     */
+    static void symm(bool right, const double *S, const double *B, double *C,
+                     int m, int n, double alpha, double beta) {
+        int lda = right ? n : m;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasDsymm(handle, right ? CUBLAS_SIDE_RIGHT : CUBLAS_SIDE_LEFT,
+                           CUBLAS_FILL_MODE_UPPER, m, n, &alpha, S, lda, B, m,
+                           &beta, C, m);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    /** Symmetric rank-k update of the upper triangle of C,
+     *  C = alpha op(A) op(A)^T + beta C
+     *  \param trans whether A enters transposed, i.e. C = alpha A^T A + beta C
+     *  \param n size of C
+     *  \param k number of columns of op(A)
+     */
+    static void syrk(bool trans, const double *A, double *C, int n, int k,
+                     double alpha, double beta) {
+        int lda = trans ? k : n;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasDsyrk(handle, CUBLAS_FILL_MODE_UPPER,
+                           trans ? CUBLAS_OP_T : CUBLAS_OP_N, n, k, &alpha, A,
+                           lda, &beta, C, n);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    /** Triangular solve with multiple right-hand sides, B = op(U)^-1 B,
+     *  where U is upper triangular, e.g. a Cholesky factor.
+     *  \param trans whether U enters transposed
+     *  \param m size of U and number of rows of B
      *  \param n number of columns of B
-     *  \param k number of columns of A, rows of B
      */
-    static void gemm(const double *A, const double *B, double *C, int m, int k,
-                     int n) {
-        int lda = m, ldb = k, ldc = m;
+    static void trsm(bool trans, const double *U, double *B, int m, int n) {
+        double const alpha = 1;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasDtrsm(handle, CUBLAS_SIDE_LEFT, CUBLAS_FILL_MODE_UPPER,
+                           trans ? CUBLAS_OP_T : CUBLAS_OP_N,
+                           CUBLAS_DIAG_NON_UNIT, m, n, &alpha, U, m, B, m);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    /** Triangular matrix matrix multiplication, B = U^T B, where U is upper
+     *  triangular, e.g. the transpose of the lower triangular Cholesky
+     *  factor. This is \ref trmv with multiple right-hand sides.
+     *  \param m size of U and number of rows of B
+     *  \param n number of columns of B
+     */
+    static void trmm(const double *U, double *B, int m, int n) {
+        double const alpha = 1;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        // cuBLAS computes out of place, C = B makes it in place
+        stat = cublasDtrmm(handle, CUBLAS_SIDE_LEFT, CUBLAS_FILL_MODE_UPPER,
+                           CUBLAS_OP_T, CUBLAS_DIAG_NON_UNIT, m, n, &alpha, U,
+                           m, B, m, B, m);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    /** Batched matrix matrix multiplication, C = alpha op(A) op(B) + beta C
+     *  for \p batch matrices which are stored one after another.
+     *  \param transA, transB whether A or B enter transposed
+     *  \param m number of rows of op(A) and C
+     *  \param k number of columns of op(A), rows of op(B)
+     *  \param n number of columns of op(B) and C
+     */
+    static void gemm_batched(bool transA, bool transB, const double *A,
+                             const double *B, double *C, int m, int k, int n,
+                             int batch, double alpha, double beta) {
+        int lda = transA ? k : m, ldb = transB ? n : k, ldc = m;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasDgemmStridedBatched(
+            handle, transA ? CUBLAS_OP_T : CUBLAS_OP_N,
+            transB ? CUBLAS_OP_T : CUBLAS_OP_N, m, n, k, &alpha, A, lda,
+            static_cast<long long>(m) * k, B, ldb,
+            static_cast<long long>(k) * n, &beta, C, ldc,
+            static_cast<long long>(m) * n, batch);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    /** Batched \ref trmv for \p batch matrices and vectors which are stored
+     *  one after another. cuBLAS lacks a batched trmv, therefore the strict
+     *  lower triangle of A, which is not used by the Cholesky routines, is
+     *  cleared and a batched gemv with the transpose is used instead.
+     */
+    static void trmv_batched(double *A, double *x, int n, int batch) {
         double alpha = 1;
         double beta = 0;
 
-        MAYBE_UNUSED rocblas_status stat;
-        rocblas_handle handle;
-        stat = rocblas_create_handle(&handle);
-        assert(rocblas_status_success == stat);
+        std::size_t const size = static_cast<std::size_t>(n) * n * batch;
+        thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+        thrust_wrapper::for_each(policy::device::par(), begin, begin + size,
+                                 ZeroStrictLower<double>{A, static_cast<std::size_t>(n)});
 
-        stat = rocblas_dgemm(handle, rocblas_operation_none,
-                             rocblas_operation_none, m, n, k, &alpha, A, lda,
-                             B, ldb, &beta, C, ldc);
-        assert(rocblas_status_success == stat);
+        thrust_wrapper::device_vector<double> y(static_cast<std::size_t>(n) * batch);
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasDgemvStridedBatched(
+            handle, CUBLAS_OP_T, n, n, &alpha, A, n,
+            static_cast<long long>(n) * n, x, 1, n, &beta,
+            thrust_wrapper::raw_pointer_cast(y.data()), 1, n, batch);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
 
-        rocblas_destroy_handle(handle);
+        thrust_wrapper::copy(y.begin(), y.end(),
+                             thrust_wrapper::device_pointer_cast(x));
     }
+};
 
-    /** Matrix vector multiplication
-     *  \param A buffer on device for the matrix
-     *  \param x buffer on device for the vector
-     *  \param y buffer on device for the result
-     *  \param m number of rows of A
-     *  \param n number of columns of A
-     */
-    static void gemv(const double *A, const double *x, double *y, int m,
+/** Single precision variant of the specialization above, e.g. for the
+ *  mixed precision mode of \ref sd::mixed_precision_solver. The routines
+ *  have the same meaning as their double precision counterparts.
+ */
+template <>
+struct cublas<policy::device, float> {
+    static void geam(float const *A, float *C, int m, int n) {
+        float const alpha = 1;
+        float const beta = 0;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasSgeam(handle, CUBLAS_OP_T, CUBLAS_OP_T, n, m, &alpha, A, m,
+                           &beta, A, m, C, n);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    static void gemm(const float *A, const float *B, float *C, int m, int k,
+                     int n) {
+        gemm(false, false, A, B, C, m, k, n, 1, 0);
+    }
+
+    static void gemm(bool transA, bool transB, const float *A,
+                     const float *B, float *C, int m, int k, int n,
+                     float alpha, float beta) {
+        int lda = transA ? k : m, ldb = transB ? n : k, ldc = m;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasSgemm(handle, transA ? CUBLAS_OP_T : CUBLAS_OP_N,
+                           transB ? CUBLAS_OP_T : CUBLAS_OP_N, m, n, k, &alpha,
+                           A, lda, B, ldb, &beta, C, ldc);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    static void gemv(const float *A, const float *x, float *y, int m,
                      int n) {
+        gemv(false, A, x, y, m, n, 1, 0);
+    }
+
+    static void gemv(bool trans, const float *A, const float *x, float *y,
+                     int m, int n, float alpha, float beta) {
         int lda = m;
-        double alpha = 1;
-        double beta = 0;
         int incx = 1;
         int incy = 1;
 
-        MAYBE_UNUSED rocblas_status stat;
-        rocblas_handle handle;
-        stat = rocblas_create_handle(&handle);
-        assert(rocblas_status_success == stat);
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
 
-        stat = rocblas_dgemv(handle, rocblas_operation_none, m, n, &alpha, A,
-                             lda, x, incx, &beta, y, incy);
-        assert(rocblas_status_success == stat);
+        stat = cublasSgemv(handle, trans ? CUBLAS_OP_T : CUBLAS_OP_N, m, n,
+                           &alpha, A, lda, x, incx, &beta, y, incy);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    static void axpy(int n, float alpha, const float *x, float *y) {
+        int incx = 1;
+        int incy = 1;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasSaxpy(handle, n, &alpha, x, incx, y, incy);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    static float dot(int n, const float *x, const float *y) {
+        float result;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasSdot(handle, n, x, 1, y, 1, &result);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+        return result;
+    }
+
+    static void scal(int n, float alpha, float *x) {
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasSscal(handle, n, &alpha, x, 1);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    static void trmv(const float *A, float *x, int n) {
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasStrmv(handle, CUBLAS_FILL_MODE_UPPER, CUBLAS_OP_T,
+                           CUBLAS_DIAG_NON_UNIT, n, A, n, x, 1);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    static void symm(bool right, const float *S, const float *B, float *C,
+                     int m, int n, float alpha, float beta) {
+        int lda = right ? n : m;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasSsymm(handle, right ? CUBLAS_SIDE_RIGHT : CUBLAS_SIDE_LEFT,
+                           CUBLAS_FILL_MODE_UPPER, m, n, &alpha, S, lda, B, m,
+                           &beta, C, m);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    static void syrk(bool trans, const float *A, float *C, int n, int k,
+                     float alpha, float beta) {
+        int lda = trans ? k : n;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasSsyrk(handle, CUBLAS_FILL_MODE_UPPER,
+                           trans ? CUBLAS_OP_T : CUBLAS_OP_N, n, k, &alpha, A,
+                           lda, &beta, C, n);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    static void trsm(bool trans, const float *U, float *B, int m, int n) {
+        float const alpha = 1;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasStrsm(handle, CUBLAS_SIDE_LEFT, CUBLAS_FILL_MODE_UPPER,
+                           trans ? CUBLAS_OP_T : CUBLAS_OP_N,
+                           CUBLAS_DIAG_NON_UNIT, m, n, &alpha, U, m, B, m);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    static void trmm(const float *U, float *B, int m, int n) {
+        float const alpha = 1;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        // cuBLAS computes out of place, C = B makes it in place
+        stat = cublasStrmm(handle, CUBLAS_SIDE_LEFT, CUBLAS_FILL_MODE_UPPER,
+                           CUBLAS_OP_T, CUBLAS_DIAG_NON_UNIT, m, n, &alpha, U,
+                           m, B, m, B, m);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    static void gemm_batched(bool transA, bool transB, const float *A,
+                             const float *B, float *C, int m, int k, int n,
+                             int batch, float alpha, float beta) {
+        int lda = transA ? k : m, ldb = transB ? n : k, ldc = m;
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        stat = cublasSgemmStridedBatched(
+            handle, transA ? CUBLAS_OP_T : CUBLAS_OP_N,
+            transB ? CUBLAS_OP_T : CUBLAS_OP_N, m, n, k, &alpha, A, lda,
+            static_cast<long long>(m) * k, B, ldb,
+            static_cast<long long>(k) * n, &beta, C, ldc,
+            static_cast<long long>(m) * n, batch);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+    }
+
+    static void trmv_batched(float *A, float *x, int n, int batch) {
+        float alpha = 1;
+        float beta = 0;
+
+        std::size_t const size = static_cast<std::size_t>(n) * n * batch;
+        thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+        thrust_wrapper::for_each(policy::device::par(), begin, begin + size,
+                                 ZeroStrictLower<float>{A, static_cast<std::size_t>(n)});
+
+        thrust_wrapper::device_vector<float> y(static_cast<std::size_t>(n) * batch);
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
 
-        rocblas_destroy_handle(handle);
+        stat = cublasSgemvStridedBatched(
+            handle, CUBLAS_OP_T, n, n, &alpha, A, n,
+            static_cast<long long>(n) * n, x, 1, n, &beta,
+            thrust_wrapper::raw_pointer_cast(y.data()), 1, n, batch);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+
+        thrust_wrapper::copy(y.begin(), y.end(),
+                             thrust_wrapper::device_pointer_cast(x));
     }
 };
-#else
-/** Basic matrix operations on host (CPU) using the BLAS library
+#elif defined(__HIPCC__)
+/** Basic matrix operations on device (AMD-GPU) using the rocBLAS library
  */
 template <>
-struct cublas<policy::host, double> {
+struct cublas<policy::device, double> {
     /** Transpose matrix
-     *  \param A buffer on host for the matrix to be transposed.
-     *  \param C buffer on host to store the result. May be the same as A.
+     *  \param A buffer on device for the matrix to be transposed.
+     *  \param C buffer on device to store the result. May be the same as A.
      *  \param m number of rows of A
      *  \param n number of columns of A
      */
     static void geam(double const *A, double *C, int m, int n) {
-        // m = m_rows, n = m_cols
-        for (int i = 0; i < m; ++i) {
-            for (int j = 0; j < n; ++j) {
-                // (row,col) = row + col * m_rows
-                C[j + i * n] = A[i + j * m];
-            }
-        }
+        double const alpha = 1;
+        double const beta = 0;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_dgeam(handle, rocblas_operation_transpose,
+                             rocblas_operation_transpose, n, m, &alpha, A, m,
+                             &beta, A, m, C, n);
+        assert(rocblas_status_success == stat);
     }
 
     /** Matrix matrix multiplication
-     *  \param A buffer on host for the matrix: first factor
-     *  \param B buffer on host for the matrix: second factor
-     *  \param C buffer on host to store the result
+     *  \param A buffer on device for the matrix: first factor
+     *  \param B buffer on device for the matrix: second factor
+     *  \param C buffer on device to store the result
      *  \param m number of rows of A
      *  \param n number of columns of B
      *  \param k number of columns of A, rows of B
      */
     static void gemm(const double *A, const double *B, double *C, int m, int k,
                      int n) {
-        int lda = m, ldb = k, ldc = m;
-        double alpha = 1;
-        double beta = 0;
+        gemm(false, false, A, B, C, m, k, n, 1, 0);
+    }
 
-        char N = 'N';
-        dgemm_(&N, &N, &m, &n, &k, &alpha, const_cast<double *>(A), &lda,
-               const_cast<double *>(B), &ldb, &beta, C, &ldc);
+    /** Fused matrix matrix multiplication, C = alpha op(A) op(B) + beta C,
+     *  which accumulates into C without temporaries.
+     *  \param transA, transB whether A or B enter transposed
+     *  \param m number of rows of op(A) and C
+     *  \param k number of columns of op(A), rows of op(B)
+     *  \param n number of columns of op(B) and C
+     */
+    static void gemm(bool transA, bool transB, const double *A,
+                     const double *B, double *C, int m, int k, int n,
+                     double alpha, double beta) {
+        int lda = transA ? k : m, ldb = transB ? n : k, ldc = m;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_dgemm(
+            handle, transA ? rocblas_operation_transpose : rocblas_operation_none,
+            transB ? rocblas_operation_transpose : rocblas_operation_none, m, n,
+            k, &alpha, A, lda, B, ldb, &beta, C, ldc);
+        assert(rocblas_status_success == stat);
     }
 
     /** Matrix vector multiplication
-     *  \param A buffer on host for the matrix
-     *  \param x buffer on host for the vector
-     *  \param y buffer on host for the result
+     *  \param A buffer on device for the matrix
+     *  \param x buffer on device for the vector
+     *  \param y buffer on device for the result
      *  \param m number of rows of A
      *  \param n number of columns of A
      */
     static void gemv(const double *A, const double *x, double *y, int m,
                      int n) {
+        gemv(false, A, x, y, m, n, 1, 0);
+    }
+
+    /** Fused matrix vector multiplication, y = alpha op(A) x + beta y
+     *  \param trans whether A enters transposed
+     *  \param m number of rows of A
+     *  \param n number of columns of A
+     */
+    static void gemv(bool trans, const double *A, const double *x, double *y,
+                     int m, int n, double alpha, double beta) {
         int lda = m;
-        double alpha = 1;
-        double beta = 0;
         int incx = 1;
         int incy = 1;
 
-        char N = 'N';
-        dgemv_(&N, &m, &n, &alpha, const_cast<double *>(A), &lda,
-               const_cast<double *>(x), &incx, &beta, y, &incy);
-    }
-};
-#endif
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
 
-/** The `cusolver` struct channels access to efficient linear algebra solvers
- *  provided by either the cuSolver library (after which it is named), which
- *  executes on an Nvidia GPU, rocSolver, which executes on an AMD GPU, or by
- *  LAPACK (Linear Algebra PACKage), which executes on the CPU.
- *  The first template parameter specifies whether the routines are executed on
- *  host or on device, by either passing `policy::host` or `policy::device`.
- *  The second template parameter specifies the data type (only `double` is
- *  available).
- *
- *  Note: since at the time of writing, the rocSolver library lacks the
- *  `dpotrs` function, the implementation for AMD GPUs is less efficient than
- *  for the other platforms.
- */
-template <typename, typename>
-struct cusolver;
+        stat = rocblas_dgemv(
+            handle, trans ? rocblas_operation_transpose : rocblas_operation_none,
+            m, n, &alpha, A, lda, x, incx, &beta, y, incy);
+        assert(rocblas_status_success == stat);
+    }
 
-#if defined(__CUDACC__)
-template <>
-struct cusolver<policy::device, double> {
-    /** Computes the Cholesky factorization and the inverse of a real symmetric
-     *  positive definite matrix, looking only in the top half of the symmetric
-     *  matrix.
-     *
-     *  \param A buffer on device for the symmetric input matrix,
-     *           serves as output for the Cholesky decomposition
-     *  \param B buffer on device expects identity matrix,
-     *           serves as output for the inverse
-     *  \param N size of the matrix
+    /** Scaled vector addition, y = alpha x + y
+     *  \param n number of elements of x and y
      */
-    static void potrf(double *A, double *B, int N) {
-        MAYBE_UNUSED cusolverStatus_t stat;
-        cusolverDnHandle_t handle;
-        stat = cusolverDnCreate(&handle);
-        assert(CUSOLVER_STATUS_SUCCESS == stat);
+    static void axpy(int n, double alpha, const double *x, double *y) {
+        int incx = 1;
+        int incy = 1;
 
-        int lwork = -1;
-        stat = cusolverDnDpotrf_bufferSize(handle, CUBLAS_FILL_MODE_UPPER, N, A,
-                                           N, &lwork);
-        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
 
-        assert(lwork != -1);
+        stat = rocblas_daxpy(handle, n, &alpha, x, incx, y, incy);
+        assert(rocblas_status_success == stat);
+    }
+
+    /** Dot product of two vectors
+     *  \param n number of elements of x and y
+     */
+    static double dot(int n, const double *x, const double *y) {
+        double result;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_ddot(handle, n, x, 1, y, 1, &result);
+        assert(rocblas_status_success == stat);
+        return result;
+    }
+
+    /** Scale a vector in place, x = alpha x
+     *  \param n number of elements of x
+     */
+    static void scal(int n, double alpha, double *x) {
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_dscal(handle, n, &alpha, x, 1);
+        assert(rocblas_status_success == stat);
+    }
+
+    /** Multiply a vector with the transpose of an upper triangular matrix,
+     *  x = A^T x, where A^T is the lower triangular Cholesky factor.
+     *  \param A buffer on device for the upper triangular matrix
+     *  \param x buffer on device for the vector, overwritten with the result
+     *  \param n size of the matrix
+     */
+    static void trmv(const double *A, double *x, int n) {
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_dtrmv(handle, rocblas_fill_upper,
+                             rocblas_operation_transpose,
+                             rocblas_diagonal_non_unit, n, A, n, x, 1);
+        assert(rocblas_status_success == stat);
+    }
+
+    /** Symmetric matrix matrix multiplication, C = alpha S B + beta C or
+     *  C = alpha B S, where only the upper triangle of S is referenced.
+     *  \param right whether S is multiplied from the right
+     *  \param m number of rows of B and C
+     *  \param n number of columns of B and C
+     */
+    static void symm(bool right, const double *S, const double *B, double *C,
+                     int m, int n, double alpha, double beta) {
+        int lda = right ? n : m;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_dsymm(handle,
+                             right ? rocblas_side_right : rocblas_side_left,
+                             rocblas_fill_upper, m, n, &alpha, S, lda, B, m,
+                             &beta, C, m);
+        assert(rocblas_status_success == stat);
+    }
+
+    /** Symmetric rank-k update of the upper triangle of C,
+     *  C = alpha op(A) op(A)^T + beta C
+     *  \param trans whether A enters transposed, i.e. C = alpha A^T A + beta C
+     *  \param n size of C
+     *  \param k number of columns of op(A)
+     */
+    static void syrk(bool trans, const double *A, double *C, int n, int k,
+                     double alpha, double beta) {
+        int lda = trans ? k : n;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_dsyrk(
+            handle, rocblas_fill_upper,
+            trans ? rocblas_operation_transpose : rocblas_operation_none, n, k,
+            &alpha, A, lda, &beta, C, n);
+        assert(rocblas_status_success == stat);
+    }
+
+    /** Triangular solve with multiple right-hand sides, B = op(U)^-1 B,
+     *  where U is upper triangular, e.g. a Cholesky factor.
+     *  \param trans whether U enters transposed
+     *  \param m size of U and number of rows of B
+     *  \param n number of columns of B
+     */
+    static void trsm(bool trans, const double *U, double *B, int m, int n) {
+        double const alpha = 1;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_dtrsm(
+            handle, rocblas_side_left, rocblas_fill_upper,
+            trans ? rocblas_operation_transpose : rocblas_operation_none,
+            rocblas_diagonal_non_unit, m, n, &alpha, U, m, B, m);
+        assert(rocblas_status_success == stat);
+    }
+
+    /** Triangular matrix matrix multiplication, B = U^T B, where U is upper
+     *  triangular, e.g. the transpose of the lower triangular Cholesky
+     *  factor. This is \ref trmv with multiple right-hand sides.
+     *  \param m size of U and number of rows of B
+     *  \param n number of columns of B
+     */
+    static void trmm(const double *U, double *B, int m, int n) {
+        double const alpha = 1;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        // rocBLAS 4 made trmm out of place, C = B makes it in place
+        stat = rocblas_dtrmm(handle, rocblas_side_left, rocblas_fill_upper,
+                             rocblas_operation_transpose,
+                             rocblas_diagonal_non_unit, m, n, &alpha, U, m,
+#if ROCBLAS_VERSION_MAJOR >= 4
+                             B, m,
+#endif
+                             B, m);
+        assert(rocblas_status_success == stat);
+    }
+
+    /** Batched matrix matrix multiplication, C = alpha op(A) op(B) + beta C
+     *  for \p batch matrices which are stored one after another.
+     *  \param transA, transB whether A or B enter transposed
+     *  \param m number of rows of op(A) and C
+     *  \param k number of columns of op(A), rows of op(B)
+     *  \param n number of columns of op(B) and C
+     */
+    static void gemm_batched(bool transA, bool transB, const double *A,
+                             const double *B, double *C, int m, int k, int n,
+                             int batch, double alpha, double beta) {
+        int lda = transA ? k : m, ldb = transB ? n : k, ldc = m;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_dgemm_strided_batched(
+            handle,
+            transA ? rocblas_operation_transpose : rocblas_operation_none,
+            transB ? rocblas_operation_transpose : rocblas_operation_none, m,
+            n, k, &alpha, A, lda, static_cast<rocblas_stride>(m) * k, B, ldb,
+            static_cast<rocblas_stride>(k) * n, &beta, C, ldc,
+            static_cast<rocblas_stride>(m) * n, batch);
+        assert(rocblas_status_success == stat);
+    }
+
+    /** Batched \ref trmv for \p batch matrices and vectors which are stored
+     *  one after another.
+     */
+    static void trmv_batched(double *A, double *x, int n, int batch) {
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_dtrmv_strided_batched(
+            handle, rocblas_fill_upper, rocblas_operation_transpose,
+            rocblas_diagonal_non_unit, n, A, n,
+            static_cast<rocblas_stride>(n) * n, x, 1, n, batch);
+        assert(rocblas_status_success == stat);
+    }
+};
+
+/** Single precision variant of the specialization above, e.g. for the
+ *  mixed precision mode of \ref sd::mixed_precision_solver. The routines
+ *  have the same meaning as their double precision counterparts.
+ */
+template <>
+struct cublas<policy::device, float> {
+    static void geam(float const *A, float *C, int m, int n) {
+        float const alpha = 1;
+        float const beta = 0;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_sgeam(handle, rocblas_operation_transpose,
+                             rocblas_operation_transpose, n, m, &alpha, A, m,
+                             &beta, A, m, C, n);
+        assert(rocblas_status_success == stat);
+    }
+
+    static void gemm(const float *A, const float *B, float *C, int m, int k,
+                     int n) {
+        gemm(false, false, A, B, C, m, k, n, 1, 0);
+    }
+
+    static void gemm(bool transA, bool transB, const float *A,
+                     const float *B, float *C, int m, int k, int n,
+                     float alpha, float beta) {
+        int lda = transA ? k : m, ldb = transB ? n : k, ldc = m;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_sgemm(
+            handle, transA ? rocblas_operation_transpose : rocblas_operation_none,
+            transB ? rocblas_operation_transpose : rocblas_operation_none, m, n,
+            k, &alpha, A, lda, B, ldb, &beta, C, ldc);
+        assert(rocblas_status_success == stat);
+    }
+
+    static void gemv(const float *A, const float *x, float *y, int m,
+                     int n) {
+        gemv(false, A, x, y, m, n, 1, 0);
+    }
+
+    static void gemv(bool trans, const float *A, const float *x, float *y,
+                     int m, int n, float alpha, float beta) {
+        int lda = m;
+        int incx = 1;
+        int incy = 1;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_sgemv(
+            handle, trans ? rocblas_operation_transpose : rocblas_operation_none,
+            m, n, &alpha, A, lda, x, incx, &beta, y, incy);
+        assert(rocblas_status_success == stat);
+    }
+
+    static void axpy(int n, float alpha, const float *x, float *y) {
+        int incx = 1;
+        int incy = 1;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_saxpy(handle, n, &alpha, x, incx, y, incy);
+        assert(rocblas_status_success == stat);
+    }
+
+    static float dot(int n, const float *x, const float *y) {
+        float result;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_sdot(handle, n, x, 1, y, 1, &result);
+        assert(rocblas_status_success == stat);
+        return result;
+    }
+
+    static void scal(int n, float alpha, float *x) {
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_sscal(handle, n, &alpha, x, 1);
+        assert(rocblas_status_success == stat);
+    }
+
+    static void trmv(const float *A, float *x, int n) {
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_strmv(handle, rocblas_fill_upper,
+                             rocblas_operation_transpose,
+                             rocblas_diagonal_non_unit, n, A, n, x, 1);
+        assert(rocblas_status_success == stat);
+    }
+
+    static void symm(bool right, const float *S, const float *B, float *C,
+                     int m, int n, float alpha, float beta) {
+        int lda = right ? n : m;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_ssymm(handle,
+                             right ? rocblas_side_right : rocblas_side_left,
+                             rocblas_fill_upper, m, n, &alpha, S, lda, B, m,
+                             &beta, C, m);
+        assert(rocblas_status_success == stat);
+    }
+
+    static void syrk(bool trans, const float *A, float *C, int n, int k,
+                     float alpha, float beta) {
+        int lda = trans ? k : n;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_ssyrk(
+            handle, rocblas_fill_upper,
+            trans ? rocblas_operation_transpose : rocblas_operation_none, n, k,
+            &alpha, A, lda, &beta, C, n);
+        assert(rocblas_status_success == stat);
+    }
+
+    static void trsm(bool trans, const float *U, float *B, int m, int n) {
+        float const alpha = 1;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_strsm(
+            handle, rocblas_side_left, rocblas_fill_upper,
+            trans ? rocblas_operation_transpose : rocblas_operation_none,
+            rocblas_diagonal_non_unit, m, n, &alpha, U, m, B, m);
+        assert(rocblas_status_success == stat);
+    }
+
+    static void trmm(const float *U, float *B, int m, int n) {
+        float const alpha = 1;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        // rocBLAS 4 made trmm out of place, C = B makes it in place
+        stat = rocblas_strmm(handle, rocblas_side_left, rocblas_fill_upper,
+                             rocblas_operation_transpose,
+                             rocblas_diagonal_non_unit, m, n, &alpha, U, m,
+#if ROCBLAS_VERSION_MAJOR >= 4
+                             B, m,
+#endif
+                             B, m);
+        assert(rocblas_status_success == stat);
+    }
+
+    static void gemm_batched(bool transA, bool transB, const float *A,
+                             const float *B, float *C, int m, int k, int n,
+                             int batch, float alpha, float beta) {
+        int lda = transA ? k : m, ldb = transB ? n : k, ldc = m;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_sgemm_strided_batched(
+            handle,
+            transA ? rocblas_operation_transpose : rocblas_operation_none,
+            transB ? rocblas_operation_transpose : rocblas_operation_none, m,
+            n, k, &alpha, A, lda, static_cast<rocblas_stride>(m) * k, B, ldb,
+            static_cast<rocblas_stride>(k) * n, &beta, C, ldc,
+            static_cast<rocblas_stride>(m) * n, batch);
+        assert(rocblas_status_success == stat);
+    }
+
+    static void trmv_batched(float *A, float *x, int n, int batch) {
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_strmv_strided_batched(
+            handle, rocblas_fill_upper, rocblas_operation_transpose,
+            rocblas_diagonal_non_unit, n, A, n,
+            static_cast<rocblas_stride>(n) * n, x, 1, n, batch);
+        assert(rocblas_status_success == stat);
+    }
+};
+#else
+/** Basic matrix operations on host (CPU) using the BLAS library
+ */
+template <>
+struct cublas<policy::host, double> {
+    /** Transpose matrix
+     *  \param A buffer on host for the matrix to be transposed.
+     *  \param C buffer on host to store the result. May be the same as A.
+     *  \param m number of rows of A
+     *  \param n number of columns of A
+     */
+    static void geam(double const *A, double *C, int m, int n) {
+        // m = m_rows, n = m_cols
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < n; ++j) {
+                // (row,col) = row + col * m_rows
+                C[j + i * n] = A[i + j * m];
+            }
+        }
+    }
+
+    /** Matrix matrix multiplication
+     *  \param A buffer on host for the matrix: first factor
+     *  \param B buffer on host for the matrix: second factor
+     *  \param C buffer on host to store the result
+     *  \param m number of rows of A
+     *  \param n number of columns of B
+     *  \param k number of columns of A, rows of B
+     */
+    static void gemm(const double *A, const double *B, double *C, int m, int k,
+                     int n) {
+        gemm(false, false, A, B, C, m, k, n, 1, 0);
+    }
+
+    /** Fused matrix matrix multiplication, C = alpha op(A) op(B) + beta C,
+     *  which accumulates into C without temporaries.
+     *  \param transA, transB whether A or B enter transposed
+     *  \param m number of rows of op(A) and C
+     *  \param k number of columns of op(A), rows of op(B)
+     *  \param n number of columns of op(B) and C
+     */
+    static void gemm(bool transA, bool transB, const double *A,
+                     const double *B, double *C, int m, int k, int n,
+                     double alpha, double beta) {
+        int lda = transA ? k : m, ldb = transB ? n : k, ldc = m;
+
+        char opA = transA ? 'T' : 'N';
+        char opB = transB ? 'T' : 'N';
+        dgemm_(&opA, &opB, &m, &n, &k, &alpha, const_cast<double *>(A), &lda,
+               const_cast<double *>(B), &ldb, &beta, C, &ldc);
+    }
+
+    /** Matrix vector multiplication
+     *  \param A buffer on host for the matrix
+     *  \param x buffer on host for the vector
+     *  \param y buffer on host for the result
+     *  \param m number of rows of A
+     *  \param n number of columns of A
+     */
+    static void gemv(const double *A, const double *x, double *y, int m,
+                     int n) {
+        gemv(false, A, x, y, m, n, 1, 0);
+    }
+
+    /** Fused matrix vector multiplication, y = alpha op(A) x + beta y
+     *  \param trans whether A enters transposed
+     *  \param m number of rows of A
+     *  \param n number of columns of A
+     */
+    static void gemv(bool trans, const double *A, const double *x, double *y,
+                     int m, int n, double alpha, double beta) {
+        int lda = m;
+        int incx = 1;
+        int incy = 1;
+
+        char op = trans ? 'T' : 'N';
+        dgemv_(&op, &m, &n, &alpha, const_cast<double *>(A), &lda,
+               const_cast<double *>(x), &incx, &beta, y, &incy);
+    }
+
+    /** Scaled vector addition, y = alpha x + y
+     *  \param n number of elements of x and y
+     */
+    static void axpy(int n, double alpha, const double *x, double *y) {
+        int incx = 1;
+        int incy = 1;
+
+        daxpy_(&n, &alpha, const_cast<double *>(x), &incx, y, &incy);
+    }
+
+    /** Dot product of two vectors
+     *  \param n number of elements of x and y
+     */
+    static double dot(int n, const double *x, const double *y) {
+        int incx = 1;
+        int incy = 1;
+
+        return ddot_(&n, const_cast<double *>(x), &incx,
+                     const_cast<double *>(y), &incy);
+    }
+
+    /** Scale a vector in place, x = alpha x
+     *  \param n number of elements of x
+     */
+    static void scal(int n, double alpha, double *x) {
+        int incx = 1;
+
+        dscal_(&n, &alpha, x, &incx);
+    }
+
+    /** Multiply a vector with the transpose of an upper triangular matrix,
+     *  x = A^T x, where A^T is the lower triangular Cholesky factor.
+     *  \param A buffer on host for the upper triangular matrix
+     *  \param x buffer on host for the vector, overwritten with the result
+     *  \param n size of the matrix
+     */
+    static void trmv(const double *A, double *x, int n) {
+        int incx = 1;
+
+        char U = 'U';
+        char T = 'T';
+        char N = 'N';
+        dtrmv_(&U, &T, &N, &n, const_cast<double *>(A), &n, x, &incx);
+    }
+
+    /** Symmetric matrix matrix multiplication, C = alpha S B + beta C or
+     *  C = alpha B S, where only the upper triangle of S is referenced.
+     *  \param right whether S is multiplied from the right
+     *  \param m number of rows of B and C
+     *  \param n number of columns of B and C
+     */
+    static void symm(bool right, const double *S, const double *B, double *C,
+                     int m, int n, double alpha, double beta) {
+        int lda = right ? n : m, ldb = m, ldc = m;
+
+        char side = right ? 'R' : 'L';
+        char U = 'U';
+        dsymm_(&side, &U, &m, &n, &alpha, const_cast<double *>(S), &lda,
+               const_cast<double *>(B), &ldb, &beta, C, &ldc);
+    }
+
+    /** Symmetric rank-k update of the upper triangle of C,
+     *  C = alpha op(A) op(A)^T + beta C
+     *  \param trans whether A enters transposed, i.e. C = alpha A^T A + beta C
+     *  \param n size of C
+     *  \param k number of columns of op(A)
+     */
+    static void syrk(bool trans, const double *A, double *C, int n, int k,
+                     double alpha, double beta) {
+        int lda = trans ? k : n;
+
+        char U = 'U';
+        char op = trans ? 'T' : 'N';
+        dsyrk_(&U, &op, &n, &k, &alpha, const_cast<double *>(A), &lda, &beta,
+               C, &n);
+    }
+
+    /** Triangular solve with multiple right-hand sides, B = op(U)^-1 B,
+     *  where U is upper triangular, e.g. a Cholesky factor.
+     *  \param trans whether U enters transposed
+     *  \param m size of U and number of rows of B
+     *  \param n number of columns of B
+     */
+    static void trsm(bool trans, const double *U, double *B, int m, int n) {
+        double alpha = 1;
+
+        char L = 'L';
+        char Up = 'U';
+        char op = trans ? 'T' : 'N';
+        char N = 'N';
+        dtrsm_(&L, &Up, &op, &N, &m, &n, &alpha, const_cast<double *>(U), &m,
+               B, &m);
+    }
+
+    /** Triangular matrix matrix multiplication, B = U^T B, where U is upper
+     *  triangular, e.g. the transpose of the lower triangular Cholesky
+     *  factor. This is \ref trmv with multiple right-hand sides.
+     *  \param m size of U and number of rows of B
+     *  \param n number of columns of B
+     */
+    static void trmm(const double *U, double *B, int m, int n) {
+        double alpha = 1;
+
+        char L = 'L';
+        char Up = 'U';
+        char T = 'T';
+        char N = 'N';
+        dtrmm_(&L, &Up, &T, &N, &m, &n, &alpha, const_cast<double *>(U), &m, B,
+               &m);
+    }
+
+    /** Batched matrix matrix multiplication, C = alpha op(A) op(B) + beta C
+     *  for \p batch matrices which are stored one after another.
+     *  \param transA, transB whether A or B enter transposed
+     *  \param m number of rows of op(A) and C
+     *  \param k number of columns of op(A), rows of op(B)
+     *  \param n number of columns of op(B) and C
+     */
+    static void gemm_batched(bool transA, bool transB, const double *A,
+                             const double *B, double *C, int m, int k, int n,
+                             int batch, double alpha, double beta) {
+        int lda = transA ? k : m, ldb = transB ? n : k, ldc = m;
+
+        char opA = transA ? 'T' : 'N';
+        char opB = transB ? 'T' : 'N';
+        for (int i = 0; i < batch; ++i) {
+            std::size_t const offset = static_cast<std::size_t>(i);
+            dgemm_(&opA, &opB, &m, &n, &k, &alpha,
+                   const_cast<double *>(A) + offset * m * k, &lda,
+                   const_cast<double *>(B) + offset * k * n, &ldb, &beta,
+                   C + offset * m * n, &ldc);
+        }
+    }
+
+    /** Batched \ref trmv for \p batch matrices and vectors which are stored
+     *  one after another.
+     */
+    static void trmv_batched(double *A, double *x, int n, int batch) {
+        for (int i = 0; i < batch; ++i) {
+            std::size_t const offset = static_cast<std::size_t>(i);
+            trmv(A + offset * n * n, x + offset * n, n);
+        }
+    }
+};
+
+/** Single precision variant of the specialization above, e.g. for the
+ *  mixed precision mode of \ref sd::mixed_precision_solver. The routines
+ *  have the same meaning as their double precision counterparts.
+ */
+template <>
+struct cublas<policy::host, float> {
+    static void geam(float const *A, float *C, int m, int n) {
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < n; ++j) {
+                C[j + i * n] = A[i + j * m];
+            }
+        }
+    }
+
+    static void gemm(const float *A, const float *B, float *C, int m, int k,
+                     int n) {
+        gemm(false, false, A, B, C, m, k, n, 1, 0);
+    }
+
+    static void gemm(bool transA, bool transB, const float *A,
+                     const float *B, float *C, int m, int k, int n,
+                     float alpha, float beta) {
+        int lda = transA ? k : m, ldb = transB ? n : k, ldc = m;
+
+        char opA = transA ? 'T' : 'N';
+        char opB = transB ? 'T' : 'N';
+        sgemm_(&opA, &opB, &m, &n, &k, &alpha, const_cast<float *>(A), &lda,
+               const_cast<float *>(B), &ldb, &beta, C, &ldc);
+    }
+
+    static void gemv(const float *A, const float *x, float *y, int m,
+                     int n) {
+        gemv(false, A, x, y, m, n, 1, 0);
+    }
+
+    static void gemv(bool trans, const float *A, const float *x, float *y,
+                     int m, int n, float alpha, float beta) {
+        int lda = m;
+        int incx = 1;
+        int incy = 1;
+
+        char op = trans ? 'T' : 'N';
+        sgemv_(&op, &m, &n, &alpha, const_cast<float *>(A), &lda,
+               const_cast<float *>(x), &incx, &beta, y, &incy);
+    }
+
+    static void axpy(int n, float alpha, const float *x, float *y) {
+        int incx = 1;
+        int incy = 1;
+
+        saxpy_(&n, &alpha, const_cast<float *>(x), &incx, y, &incy);
+    }
+
+    static float dot(int n, const float *x, const float *y) {
+        int incx = 1;
+        int incy = 1;
+
+        return sdot_(&n, const_cast<float *>(x), &incx,
+                     const_cast<float *>(y), &incy);
+    }
+
+    static void scal(int n, float alpha, float *x) {
+        int incx = 1;
+
+        sscal_(&n, &alpha, x, &incx);
+    }
+
+    static void trmv(const float *A, float *x, int n) {
+        int incx = 1;
+
+        char U = 'U';
+        char T = 'T';
+        char N = 'N';
+        strmv_(&U, &T, &N, &n, const_cast<float *>(A), &n, x, &incx);
+    }
+
+    static void symm(bool right, const float *S, const float *B, float *C,
+                     int m, int n, float alpha, float beta) {
+        int lda = right ? n : m, ldb = m, ldc = m;
+
+        char side = right ? 'R' : 'L';
+        char U = 'U';
+        ssymm_(&side, &U, &m, &n, &alpha, const_cast<float *>(S), &lda,
+               const_cast<float *>(B), &ldb, &beta, C, &ldc);
+    }
+
+    static void syrk(bool trans, const float *A, float *C, int n, int k,
+                     float alpha, float beta) {
+        int lda = trans ? k : n;
+
+        char U = 'U';
+        char op = trans ? 'T' : 'N';
+        ssyrk_(&U, &op, &n, &k, &alpha, const_cast<float *>(A), &lda, &beta,
+               C, &n);
+    }
+
+    static void trsm(bool trans, const float *U, float *B, int m, int n) {
+        float alpha = 1;
+
+        char L = 'L';
+        char Up = 'U';
+        char op = trans ? 'T' : 'N';
+        char N = 'N';
+        strsm_(&L, &Up, &op, &N, &m, &n, &alpha, const_cast<float *>(U), &m,
+               B, &m);
+    }
+
+    static void trmm(const float *U, float *B, int m, int n) {
+        float alpha = 1;
+
+        char L = 'L';
+        char Up = 'U';
+        char T = 'T';
+        char N = 'N';
+        strmm_(&L, &Up, &T, &N, &m, &n, &alpha, const_cast<float *>(U), &m, B,
+               &m);
+    }
+
+    static void gemm_batched(bool transA, bool transB, const float *A,
+                             const float *B, float *C, int m, int k, int n,
+                             int batch, float alpha, float beta) {
+        int lda = transA ? k : m, ldb = transB ? n : k, ldc = m;
+
+        char opA = transA ? 'T' : 'N';
+        char opB = transB ? 'T' : 'N';
+        for (int i = 0; i < batch; ++i) {
+            std::size_t const offset = static_cast<std::size_t>(i);
+            sgemm_(&opA, &opB, &m, &n, &k, &alpha,
+                   const_cast<float *>(A) + offset * m * k, &lda,
+                   const_cast<float *>(B) + offset * k * n, &ldb, &beta,
+                   C + offset * m * n, &ldc);
+        }
+    }
+
+    static void trmv_batched(float *A, float *x, int n, int batch) {
+        for (int i = 0; i < batch; ++i) {
+            std::size_t const offset = static_cast<std::size_t>(i);
+            trmv(A + offset * n * n, x + offset * n, n);
+        }
+    }
+};
+#endif
+
+/** The `cusolver` struct channels access to efficient linear algebra solvers
+ *  provided by either the cuSolver library (after which it is named), which
+ *  executes on an Nvidia GPU, rocSolver, which executes on an AMD GPU, or by
+ *  LAPACK (Linear Algebra PACKage), which executes on the CPU.
+ *  The first template parameter specifies whether the routines are executed on
+ *  host or on device, by either passing `policy::host` or `policy::device`.
+ *  The second template parameter specifies the data type (`double` or
+ *  `float`).
+ *
+ *  Note: since at the time of writing, the rocSolver library lacks the
+ *  `dpotrs` function, the implementation for AMD GPUs is less efficient than
+ *  for the other platforms.
+ */
+template <typename, typename>
+struct cusolver;
+
+#if defined(__CUDACC__)
+template <>
+struct cusolver<policy::device, double> {
+    /** Computes the Cholesky factorization and the inverse of a real symmetric
+     *  positive definite matrix, looking only in the top half of the symmetric
+     *  matrix.
+     *
+     *  \param A buffer on device for the symmetric input matrix,
+     *           serves as output for the Cholesky decomposition
+     *  \param B buffer on device expects identity matrix,
+     *           serves as output for the inverse
+     *  \param N size of the matrix
+     */
+    static void potrf(double *A, double *B, int N) {
+        MAYBE_UNUSED cusolverStatus_t stat;
+        cusolverDnHandle_t handle = handle_pool::instance().solver();
+
+        int lwork = -1;
+        stat = cusolverDnDpotrf_bufferSize(handle, CUBLAS_FILL_MODE_UPPER, N, A,
+                                           N, &lwork);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+
+        assert(lwork != -1);
+
+        thrust_wrapper::device_vector<double> workspace(lwork);
+        thrust_wrapper::device_vector<int> info(1);
+        stat = cusolverDnDpotrf(handle, CUBLAS_FILL_MODE_UPPER, N, A, N,
+                                thrust_wrapper::raw_pointer_cast(workspace.data()),
+                                lwork, thrust_wrapper::raw_pointer_cast(info.data()));
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(info[0] == 0);
+
+        stat = cusolverDnDpotrs(handle, CUBLAS_FILL_MODE_UPPER, N, N, A, N, B,
+                                N, thrust_wrapper::raw_pointer_cast(info.data()));
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(info[0] == 0);
+    }
+    /** Computes the Cholesky factorization of a real symmetric positive
+     *  definite matrix, looking only in the top half of the symmetric matrix.
+     *
+     *  \param A buffer on device for the symmetric input matrix,
+     *           serves as output for the Cholesky decomposition
+     *  \param N size of the matrix
+     */
+    static void potrf(double *A, int N) {
+        MAYBE_UNUSED cusolverStatus_t stat;
+        cusolverDnHandle_t handle = handle_pool::instance().solver();
+
+        int lwork = -1;
+        stat = cusolverDnDpotrf_bufferSize(handle, CUBLAS_FILL_MODE_UPPER, N, A,
+                                           N, &lwork);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+
+        assert(lwork != -1);
+
+        thrust_wrapper::device_vector<double> workspace(lwork);
+        thrust_wrapper::device_vector<int> info(1);
+        stat = cusolverDnDpotrf(handle, CUBLAS_FILL_MODE_UPPER, N, A, N,
+                                thrust_wrapper::raw_pointer_cast(workspace.data()),
+                                lwork, thrust_wrapper::raw_pointer_cast(info.data()));
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(info[0] == 0);
+    }
+
+    /** Solves A X = B for a real symmetric positive definite matrix A, of
+     *  which the Cholesky factorization is given.
+     *
+     *  \param A buffer on device for the Cholesky decomposition
+     *  \param B buffer on device for the right-hand sides,
+     *           serves as output for the solution
+     *  \param N size of the matrix
+     *  \param nrhs number of right-hand sides, i.e. columns of B
+     */
+    static void potrs(double const *A, double *B, int N, int nrhs) {
+        MAYBE_UNUSED cusolverStatus_t stat;
+        cusolverDnHandle_t handle = handle_pool::instance().solver();
+
+        thrust_wrapper::device_vector<int> info(1);
+        stat = cusolverDnDpotrs(handle, CUBLAS_FILL_MODE_UPPER, N, nrhs, A, N,
+                                B, N, thrust_wrapper::raw_pointer_cast(info.data()));
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(info[0] == 0);
+    }
+
+    /** Computes the inverse of a real symmetric positive definite matrix
+     *  from its Cholesky factorization. Only the upper triangle of the
+     *  result is written.
+     *
+     *  \param A buffer on device for the Cholesky decomposition,
+     *           serves as output for the inverse
+     *  \param N size of the matrix
+     */
+    static void potri(double *A, int N) {
+        MAYBE_UNUSED cusolverStatus_t stat;
+        cusolverDnHandle_t handle = handle_pool::instance().solver();
+
+        int lwork = -1;
+        stat = cusolverDnDpotri_bufferSize(handle, CUBLAS_FILL_MODE_UPPER, N, A,
+                                           N, &lwork);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+
+        assert(lwork != -1);
+
+        thrust_wrapper::device_vector<double> workspace(lwork);
+        thrust_wrapper::device_vector<int> info(1);
+        stat = cusolverDnDpotri(handle, CUBLAS_FILL_MODE_UPPER, N, A, N,
+                                thrust_wrapper::raw_pointer_cast(workspace.data()),
+                                lwork, thrust_wrapper::raw_pointer_cast(info.data()));
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(info[0] == 0);
+    }
+
+    /** Batched Cholesky factorization of \p batch matrices of size \p N,
+     *  which are stored one after another, see \ref potrf.
+     */
+    static void potrf_batched(double *A, int N, int batch) {
+        thrust_wrapper::device_vector<double *> ptrs(batch);
+        thrust_wrapper::tabulate(policy::device::par(), ptrs.begin(), ptrs.end(),
+                                 BatchPointer<double>{A, static_cast<std::size_t>(N) * N});
+
+        MAYBE_UNUSED cusolverStatus_t stat;
+        cusolverDnHandle_t handle = handle_pool::instance().solver();
+
+        thrust_wrapper::device_vector<int> info(batch);
+        stat = cusolverDnDpotrfBatched(handle, CUBLAS_FILL_MODE_UPPER, N,
+                                       thrust_wrapper::raw_pointer_cast(ptrs.data()), N,
+                                       thrust_wrapper::raw_pointer_cast(info.data()), batch);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(batch_succeeded(info));
+    }
+
+    /** Batched \ref potrs with a single right-hand side per matrix. The
+     *  matrices and the vectors are stored one after another.
+     */
+    static void potrs_batched(double *A, double *B, int N, int batch) {
+        thrust_wrapper::device_vector<double *> ptrs_A(batch);
+        thrust_wrapper::device_vector<double *> ptrs_B(batch);
+        thrust_wrapper::tabulate(policy::device::par(), ptrs_A.begin(), ptrs_A.end(),
+                                 BatchPointer<double>{A, static_cast<std::size_t>(N) * N});
+        thrust_wrapper::tabulate(policy::device::par(), ptrs_B.begin(), ptrs_B.end(),
+                                 BatchPointer<double>{B, static_cast<std::size_t>(N)});
+
+        MAYBE_UNUSED cusolverStatus_t stat;
+        cusolverDnHandle_t handle = handle_pool::instance().solver();
+
+        thrust_wrapper::device_vector<int> info(1);
+        stat = cusolverDnDpotrsBatched(handle, CUBLAS_FILL_MODE_UPPER, N, 1,
+                                       thrust_wrapper::raw_pointer_cast(ptrs_A.data()), N,
+                                       thrust_wrapper::raw_pointer_cast(ptrs_B.data()), N,
+                                       thrust_wrapper::raw_pointer_cast(info.data()), batch);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(info[0] == 0);
+    }
+
+    /** Replaces \p batch real symmetric positive definite matrices of size
+     *  \p N, which are stored one after another, by their inverses.
+     *  The batched Cholesky routines of cuSOLVER have no inverse and solve
+     *  only a single right-hand side, so the batched LU routines of cuBLAS
+     *  are used instead. Their inversion works out of place, hence the
+     *  second buffer of \p batch matrices.
+     */
+    static void inverse_batched(double *A, int N, int batch) {
+        std::size_t const size = static_cast<std::size_t>(N) * N;
+        thrust_wrapper::device_vector<double> C(size * batch);
+        thrust_wrapper::device_vector<double *> ptrs_A(batch);
+        thrust_wrapper::device_vector<double *> ptrs_C(batch);
+        thrust_wrapper::tabulate(policy::device::par(), ptrs_A.begin(), ptrs_A.end(),
+                                 BatchPointer<double>{A, size});
+        thrust_wrapper::tabulate(policy::device::par(), ptrs_C.begin(), ptrs_C.end(),
+                                 BatchPointer<double>{thrust_wrapper::raw_pointer_cast(C.data()), size});
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        thrust_wrapper::device_vector<int> pivots(static_cast<std::size_t>(N) * batch);
+        thrust_wrapper::device_vector<int> info(batch);
+        stat = cublasDgetrfBatched(handle, N,
+                                   thrust_wrapper::raw_pointer_cast(ptrs_A.data()), N,
+                                   thrust_wrapper::raw_pointer_cast(pivots.data()),
+                                   thrust_wrapper::raw_pointer_cast(info.data()), batch);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+        assert(batch_succeeded(info));
+
+        stat = cublasDgetriBatched(handle, N,
+                                   thrust_wrapper::raw_pointer_cast(ptrs_A.data()), N,
+                                   thrust_wrapper::raw_pointer_cast(pivots.data()),
+                                   thrust_wrapper::raw_pointer_cast(ptrs_C.data()), N,
+                                   thrust_wrapper::raw_pointer_cast(info.data()), batch);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+        assert(batch_succeeded(info));
+
+        thrust_wrapper::copy(C.begin(), C.end(),
+                             thrust_wrapper::device_pointer_cast(A));
+    }
+};
+
+/** Single precision variant of the specialization above, e.g. for the
+ *  mixed precision mode of \ref sd::mixed_precision_solver. The routines
+ *  have the same meaning as their double precision counterparts.
+ */
+template <>
+struct cusolver<policy::device, float> {
+    static void potrf(float *A, float *B, int N) {
+        MAYBE_UNUSED cusolverStatus_t stat;
+        cusolverDnHandle_t handle = handle_pool::instance().solver();
+
+        int lwork = -1;
+        stat = cusolverDnSpotrf_bufferSize(handle, CUBLAS_FILL_MODE_UPPER, N, A,
+                                           N, &lwork);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+
+        assert(lwork != -1);
+
+        thrust_wrapper::device_vector<float> workspace(lwork);
+        thrust_wrapper::device_vector<int> info(1);
+        stat = cusolverDnSpotrf(handle, CUBLAS_FILL_MODE_UPPER, N, A, N,
+                                thrust_wrapper::raw_pointer_cast(workspace.data()),
+                                lwork, thrust_wrapper::raw_pointer_cast(info.data()));
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(info[0] == 0);
+
+        stat = cusolverDnSpotrs(handle, CUBLAS_FILL_MODE_UPPER, N, N, A, N, B,
+                                N, thrust_wrapper::raw_pointer_cast(info.data()));
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(info[0] == 0);
+    }
+
+    static void potrf(float *A, int N) {
+        MAYBE_UNUSED cusolverStatus_t stat;
+        cusolverDnHandle_t handle = handle_pool::instance().solver();
+
+        int lwork = -1;
+        stat = cusolverDnSpotrf_bufferSize(handle, CUBLAS_FILL_MODE_UPPER, N, A,
+                                           N, &lwork);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+
+        assert(lwork != -1);
+
+        thrust_wrapper::device_vector<float> workspace(lwork);
+        thrust_wrapper::device_vector<int> info(1);
+        stat = cusolverDnSpotrf(handle, CUBLAS_FILL_MODE_UPPER, N, A, N,
+                                thrust_wrapper::raw_pointer_cast(workspace.data()),
+                                lwork, thrust_wrapper::raw_pointer_cast(info.data()));
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(info[0] == 0);
+    }
+
+    static void potrs(float const *A, float *B, int N, int nrhs) {
+        MAYBE_UNUSED cusolverStatus_t stat;
+        cusolverDnHandle_t handle = handle_pool::instance().solver();
+
+        thrust_wrapper::device_vector<int> info(1);
+        stat = cusolverDnSpotrs(handle, CUBLAS_FILL_MODE_UPPER, N, nrhs, A, N,
+                                B, N, thrust_wrapper::raw_pointer_cast(info.data()));
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(info[0] == 0);
+    }
+
+    static void potri(float *A, int N) {
+        MAYBE_UNUSED cusolverStatus_t stat;
+        cusolverDnHandle_t handle = handle_pool::instance().solver();
+
+        int lwork = -1;
+        stat = cusolverDnSpotri_bufferSize(handle, CUBLAS_FILL_MODE_UPPER, N, A,
+                                           N, &lwork);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+
+        assert(lwork != -1);
+
+        thrust_wrapper::device_vector<float> workspace(lwork);
+        thrust_wrapper::device_vector<int> info(1);
+        stat = cusolverDnSpotri(handle, CUBLAS_FILL_MODE_UPPER, N, A, N,
+                                thrust_wrapper::raw_pointer_cast(workspace.data()),
+                                lwork, thrust_wrapper::raw_pointer_cast(info.data()));
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(info[0] == 0);
+    }
+
+    static void potrf_batched(float *A, int N, int batch) {
+        thrust_wrapper::device_vector<float *> ptrs(batch);
+        thrust_wrapper::tabulate(policy::device::par(), ptrs.begin(), ptrs.end(),
+                                 BatchPointer<float>{A, static_cast<std::size_t>(N) * N});
+
+        MAYBE_UNUSED cusolverStatus_t stat;
+        cusolverDnHandle_t handle = handle_pool::instance().solver();
+
+        thrust_wrapper::device_vector<int> info(batch);
+        stat = cusolverDnSpotrfBatched(handle, CUBLAS_FILL_MODE_UPPER, N,
+                                       thrust_wrapper::raw_pointer_cast(ptrs.data()), N,
+                                       thrust_wrapper::raw_pointer_cast(info.data()), batch);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(batch_succeeded(info));
+    }
+
+    static void potrs_batched(float *A, float *B, int N, int batch) {
+        thrust_wrapper::device_vector<float *> ptrs_A(batch);
+        thrust_wrapper::device_vector<float *> ptrs_B(batch);
+        thrust_wrapper::tabulate(policy::device::par(), ptrs_A.begin(), ptrs_A.end(),
+                                 BatchPointer<float>{A, static_cast<std::size_t>(N) * N});
+        thrust_wrapper::tabulate(policy::device::par(), ptrs_B.begin(), ptrs_B.end(),
+                                 BatchPointer<float>{B, static_cast<std::size_t>(N)});
+
+        MAYBE_UNUSED cusolverStatus_t stat;
+        cusolverDnHandle_t handle = handle_pool::instance().solver();
+
+        thrust_wrapper::device_vector<int> info(1);
+        stat = cusolverDnSpotrsBatched(handle, CUBLAS_FILL_MODE_UPPER, N, 1,
+                                       thrust_wrapper::raw_pointer_cast(ptrs_A.data()), N,
+                                       thrust_wrapper::raw_pointer_cast(ptrs_B.data()), N,
+                                       thrust_wrapper::raw_pointer_cast(info.data()), batch);
+        assert(CUSOLVER_STATUS_SUCCESS == stat);
+        assert(info[0] == 0);
+    }
+
+    static void inverse_batched(float *A, int N, int batch) {
+        std::size_t const size = static_cast<std::size_t>(N) * N;
+        thrust_wrapper::device_vector<float> C(size * batch);
+        thrust_wrapper::device_vector<float *> ptrs_A(batch);
+        thrust_wrapper::device_vector<float *> ptrs_C(batch);
+        thrust_wrapper::tabulate(policy::device::par(), ptrs_A.begin(), ptrs_A.end(),
+                                 BatchPointer<float>{A, size});
+        thrust_wrapper::tabulate(policy::device::par(), ptrs_C.begin(), ptrs_C.end(),
+                                 BatchPointer<float>{thrust_wrapper::raw_pointer_cast(C.data()), size});
+
+        MAYBE_UNUSED cublasStatus_t stat;
+        cublasHandle_t handle = handle_pool::instance().blas();
+
+        thrust_wrapper::device_vector<int> pivots(static_cast<std::size_t>(N) * batch);
+        thrust_wrapper::device_vector<int> info(batch);
+        stat = cublasSgetrfBatched(handle, N,
+                                   thrust_wrapper::raw_pointer_cast(ptrs_A.data()), N,
+                                   thrust_wrapper::raw_pointer_cast(pivots.data()),
+                                   thrust_wrapper::raw_pointer_cast(info.data()), batch);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+        assert(batch_succeeded(info));
+
+        stat = cublasSgetriBatched(handle, N,
+                                   thrust_wrapper::raw_pointer_cast(ptrs_A.data()), N,
+                                   thrust_wrapper::raw_pointer_cast(pivots.data()),
+                                   thrust_wrapper::raw_pointer_cast(ptrs_C.data()), N,
+                                   thrust_wrapper::raw_pointer_cast(info.data()), batch);
+        assert(CUBLAS_STATUS_SUCCESS == stat);
+        assert(batch_succeeded(info));
+
+        thrust_wrapper::copy(C.begin(), C.end(),
+                             thrust_wrapper::device_pointer_cast(A));
+    }
+};
+#elif defined(__HIPCC__)
+// ROCm API documentation
+// https://rocsolver.readthedocs.io/en/latest/userguidedocu.html
+template <>
+struct cusolver<policy::device, double> {
+    /** Computes the Cholesky factorization and the inverse of a real symmetric
+     *  positive definite matrix, looking only in the top half of the symmetric
+     *  matrix.
+     *
+     *  \param A buffer on device for the symmetric input matrix,
+     *           serves as output for the Cholesky decomposition
+     *  \param B buffer on device expects identity matrix,
+     *           serves as output for the inverse
+     *  \param N size of the matrix
+     *
+     *  The inverse is obtained by solving against the identity with the
+     *  Cholesky factor, see \ref potrs, like cusolverDnDpotrs does on CUDA.
+     */
+    static void potrf(double *A, double *B, int N) {
+        potrf(A, N);
+        potrs(A, B, N, N);
+    }
+    /** Computes the Cholesky factorization of a real symmetric positive
+     *  definite matrix, looking only in the top half of the symmetric matrix.
+     *
+     *  \param A buffer on device for the symmetric input matrix,
+     *           serves as output for the Cholesky decomposition
+     *  \param N size of the matrix
+     */
+    static void potrf(double *A, int N) {
+        MAYBE_UNUSED rocsolver_status stat;
+        rocsolver_handle handle = handle_pool::instance().solver();
+
+        thrust_wrapper::device_vector<rocsolver_int> info(1);
+        stat = rocsolver_dpotrf(handle, rocblas_fill_upper, N, A, N,
+                                thrust_wrapper::raw_pointer_cast(info.data()));
+        assert(rocblas_status_success == stat);
+        assert(info[0] == 0);
+    }
+
+    /** Solves A X = B for a real symmetric positive definite matrix A, of
+     *  which the Cholesky factorization A = U^T U is given. Instead of
+     *  `dpotrs`, two triangular solves with U^T and U are used.
+     *
+     *  \param A buffer on device for the Cholesky decomposition
+     *  \param B buffer on device for the right-hand sides,
+     *           serves as output for the solution
+     *  \param N size of the matrix
+     *  \param nrhs number of right-hand sides, i.e. columns of B
+     */
+    static void potrs(double const *A, double *B, int N, int nrhs) {
+        double const alpha = 1;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_dtrsm(handle, rocblas_side_left, rocblas_fill_upper,
+                             rocblas_operation_transpose,
+                             rocblas_diagonal_non_unit, N, nrhs, &alpha, A, N,
+                             B, N);
+        assert(rocblas_status_success == stat);
+
+        stat = rocblas_dtrsm(handle, rocblas_side_left, rocblas_fill_upper,
+                             rocblas_operation_none, rocblas_diagonal_non_unit,
+                             N, nrhs, &alpha, A, N, B, N);
+        assert(rocblas_status_success == stat);
+    }
+
+    /** Computes the inverse of a real symmetric positive definite matrix
+     *  from its Cholesky factorization. Only the upper triangle of the
+     *  result is written.
+     *
+     *  \param A buffer on device for the Cholesky decomposition,
+     *           serves as output for the inverse
+     *  \param N size of the matrix
+     */
+    static void potri(double *A, int N) {
+        MAYBE_UNUSED rocsolver_status stat;
+        rocsolver_handle handle = handle_pool::instance().solver();
+
+        thrust_wrapper::device_vector<rocsolver_int> info(1);
+        stat = rocsolver_dpotri(handle, rocblas_fill_upper, N, A, N,
+                                thrust_wrapper::raw_pointer_cast(info.data()));
+        assert(rocblas_status_success == stat);
+        assert(info[0] == 0);
+    }
+
+    /** Batched Cholesky factorization of \p batch matrices of size \p N,
+     *  which are stored one after another, see \ref potrf.
+     */
+    static void potrf_batched(double *A, int N, int batch) {
+        MAYBE_UNUSED rocsolver_status stat;
+        rocsolver_handle handle = handle_pool::instance().solver();
+
+        thrust_wrapper::device_vector<rocsolver_int> info(batch);
+        stat = rocsolver_dpotrf_strided_batched(
+            handle, rocblas_fill_upper, N, A, N,
+            static_cast<rocblas_stride>(N) * N,
+            thrust_wrapper::raw_pointer_cast(info.data()), batch);
+        assert(rocblas_status_success == stat);
+        assert(batch_succeeded(info));
+    }
+
+    /** Batched \ref potrs with a single right-hand side per matrix. The
+     *  matrices and the vectors are stored one after another.
+     */
+    static void potrs_batched(double *A, double *B, int N, int batch) {
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_dtrsv_strided_batched(
+            handle, rocblas_fill_upper, rocblas_operation_transpose,
+            rocblas_diagonal_non_unit, N, A, N,
+            static_cast<rocblas_stride>(N) * N, B, 1, N, batch);
+        assert(rocblas_status_success == stat);
+
+        stat = rocblas_dtrsv_strided_batched(
+            handle, rocblas_fill_upper, rocblas_operation_none,
+            rocblas_diagonal_non_unit, N, A, N,
+            static_cast<rocblas_stride>(N) * N, B, 1, N, batch);
+        assert(rocblas_status_success == stat);
+    }
+
+    /** Replaces \p batch real symmetric positive definite matrices of size
+     *  \p N, which are stored one after another, by their inverses.
+     */
+    static void inverse_batched(double *A, int N, int batch) {
+        MAYBE_UNUSED rocsolver_status stat;
+        rocsolver_handle handle = handle_pool::instance().solver();
 
-        thrust_wrapper::device_vector<double> workspace(lwork);
-        thrust_wrapper::device_vector<int> info(1);
-        stat = cusolverDnDpotrf(handle, CUBLAS_FILL_MODE_UPPER, N, A, N,
-                                thrust_wrapper::raw_pointer_cast(workspace.data()),
-                                lwork, thrust_wrapper::raw_pointer_cast(info.data()));
-        assert(CUSOLVER_STATUS_SUCCESS == stat);
-        assert(info[0] == 0);
+        thrust_wrapper::device_vector<rocsolver_int> info(batch);
+        stat = rocsolver_dpotrf_strided_batched(
+            handle, rocblas_fill_upper, N, A, N,
+            static_cast<rocblas_stride>(N) * N,
+            thrust_wrapper::raw_pointer_cast(info.data()), batch);
+        assert(rocblas_status_success == stat);
+        assert(batch_succeeded(info));
 
-        stat = cusolverDnDpotrs(handle, CUBLAS_FILL_MODE_UPPER, N, N, A, N, B,
-                                N, thrust_wrapper::raw_pointer_cast(info.data()));
-        assert(CUSOLVER_STATUS_SUCCESS == stat);
-        assert(info[0] == 0);
+        stat = rocsolver_dpotri_strided_batched(
+            handle, rocblas_fill_upper, N, A, N,
+            static_cast<rocblas_stride>(N) * N,
+            thrust_wrapper::raw_pointer_cast(info.data()), batch);
+        assert(rocblas_status_success == stat);
+        assert(batch_succeeded(info));
 
-        cusolverDnDestroy(handle);
+        // dpotri only computes the upper triangle
+        symmetrize_upper_batched<policy::device>(A, N, batch);
     }
 };
-#elif defined(__HIPCC__)
-// ROCm API documentation
-// https://rocsolver.readthedocs.io/en/latest/userguidedocu.html
+
+/** Single precision variant of the specialization above, e.g. for the
+ *  mixed precision mode of \ref sd::mixed_precision_solver. The routines
+ *  have the same meaning as their double precision counterparts.
+ */
 template <>
-struct cusolver<policy::device, double> {
-    /** Computes the Cholesky factorization and the inverse of a real symmetric
-     *  positive definite matrix, looking only in the top half of the symmetric
-     *  matrix.
-     *
-     *  \param A buffer on device for the symmetric input matrix,
-     *           serves as output for the Cholesky decomposition
-     *  \param B buffer on device expects identity matrix,
-     *           serves as output for the inverse
-     *  \param N size of the matrix
-     */
-    static void potrf(double *A, double *B, int N) {
-        // copy input so that it is available twice
-        thrust_wrapper::device_vector<double> C(N*N);
-        thrust_wrapper::copy_n(policy::device::par(), A, N*N, C.begin());
+struct cusolver<policy::device, float> {
+    static void potrf(float *A, float *B, int N) {
+        potrf(A, N);
+        potrs(A, B, N, N);
+    }
 
+    static void potrf(float *A, int N) {
         MAYBE_UNUSED rocsolver_status stat;
-        rocsolver_handle handle;
-        stat = rocsolver_create_handle(&handle);
-        assert(rocblas_status_success == stat);
+        rocsolver_handle handle = handle_pool::instance().solver();
 
-        // Cholesky decomposition
         thrust_wrapper::device_vector<rocsolver_int> info(1);
-        stat = rocsolver_dpotrf(handle, rocblas_fill_upper, N, A, N,
+        stat = rocsolver_spotrf(handle, rocblas_fill_upper, N, A, N,
                                 thrust_wrapper::raw_pointer_cast(info.data()));
         assert(rocblas_status_success == stat);
         assert(info[0] == 0);
+    }
+
+    static void potrs(float const *A, float *B, int N, int nrhs) {
+        float const alpha = 1;
+
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_strsm(handle, rocblas_side_left, rocblas_fill_upper,
+                             rocblas_operation_transpose,
+                             rocblas_diagonal_non_unit, N, nrhs, &alpha, A, N,
+                             B, N);
+        assert(rocblas_status_success == stat);
+
+        stat = rocblas_strsm(handle, rocblas_side_left, rocblas_fill_upper,
+                             rocblas_operation_none, rocblas_diagonal_non_unit,
+                             N, nrhs, &alpha, A, N, B, N);
+        assert(rocblas_status_success == stat);
+    }
 
-        // Matrix inversion - relatively inefficient due to lack of rocsolver_dpotrs
-        thrust_wrapper::device_vector<rocsolver_int> ipiv(N);
-        stat = rocsolver_dgetrf(handle, N, N,
-                                thrust_wrapper::raw_pointer_cast(C.data()), N,
-                                thrust_wrapper::raw_pointer_cast(ipiv.data()),
+    static void potri(float *A, int N) {
+        MAYBE_UNUSED rocsolver_status stat;
+        rocsolver_handle handle = handle_pool::instance().solver();
+
+        thrust_wrapper::device_vector<rocsolver_int> info(1);
+        stat = rocsolver_spotri(handle, rocblas_fill_upper, N, A, N,
                                 thrust_wrapper::raw_pointer_cast(info.data()));
         assert(rocblas_status_success == stat);
         assert(info[0] == 0);
+    }
+
+    static void potrf_batched(float *A, int N, int batch) {
+        MAYBE_UNUSED rocsolver_status stat;
+        rocsolver_handle handle = handle_pool::instance().solver();
+
+        thrust_wrapper::device_vector<rocsolver_int> info(batch);
+        stat = rocsolver_spotrf_strided_batched(
+            handle, rocblas_fill_upper, N, A, N,
+            static_cast<rocblas_stride>(N) * N,
+            thrust_wrapper::raw_pointer_cast(info.data()), batch);
+        assert(rocblas_status_success == stat);
+        assert(batch_succeeded(info));
+    }
+
+    static void potrs_batched(float *A, float *B, int N, int batch) {
+        MAYBE_UNUSED rocblas_status stat;
+        rocblas_handle handle = handle_pool::instance().blas();
+
+        stat = rocblas_strsv_strided_batched(
+            handle, rocblas_fill_upper, rocblas_operation_transpose,
+            rocblas_diagonal_non_unit, N, A, N,
+            static_cast<rocblas_stride>(N) * N, B, 1, N, batch);
+        assert(rocblas_status_success == stat);
+
+        stat = rocblas_strsv_strided_batched(
+            handle, rocblas_fill_upper, rocblas_operation_none,
+            rocblas_diagonal_non_unit, N, A, N,
+            static_cast<rocblas_stride>(N) * N, B, 1, N, batch);
+        assert(rocblas_status_success == stat);
+    }
+
+    static void inverse_batched(float *A, int N, int batch) {
+        MAYBE_UNUSED rocsolver_status stat;
+        rocsolver_handle handle = handle_pool::instance().solver();
+
+        thrust_wrapper::device_vector<rocsolver_int> info(batch);
+        stat = rocsolver_spotrf_strided_batched(
+            handle, rocblas_fill_upper, N, A, N,
+            static_cast<rocblas_stride>(N) * N,
+            thrust_wrapper::raw_pointer_cast(info.data()), batch);
+        assert(rocblas_status_success == stat);
+        assert(batch_succeeded(info));
 
-        stat = rocsolver_dgetrs(handle, rocblas_operation_none, N, N,
-                                thrust_wrapper::raw_pointer_cast(C.data()), N,
-                                thrust_wrapper::raw_pointer_cast(ipiv.data()),
-                                B, N);
+        stat = rocsolver_spotri_strided_batched(
+            handle, rocblas_fill_upper, N, A, N,
+            static_cast<rocblas_stride>(N) * N,
+            thrust_wrapper::raw_pointer_cast(info.data()), batch);
         assert(rocblas_status_success == stat);
+        assert(batch_succeeded(info));
 
-        rocblas_destroy_handle(handle);
+        symmetrize_upper_batched<policy::device>(A, N, batch);
     }
 };
 #else
@@ -475,6 +2713,185 @@ struct cusolver<policy::host, double> {
         dpotrs_(&uplo, &N, &N, A, &N, B, &N, &info);
         assert(info == 0);
     }
+    /** Computes the Cholesky factorization of a real symmetric positive
+     *  definite matrix, looking only in the top half of the symmetric matrix.
+     *
+     *  \param A buffer on host for the symmetric input matrix,
+     *           serves as output for the Cholesky decomposition
+     *  \param N size of the matrix
+     */
+    static void potrf(double *A, int N) {
+#if defined(SD_USE_CUSOLVERMG)
+        if (multi_gpu::instance().applicable(N)) {
+            multi_gpu::instance().potrf(A, N);
+            return;
+        }
+#endif
+        char uplo = 'U';
+        int info;
+
+        dpotrf_(&uplo, &N, A, &N, &info);
+        assert(info == 0);
+    }
+
+    /** Solves A X = B for a real symmetric positive definite matrix A, of
+     *  which the Cholesky factorization is given.
+     *
+     *  \param A buffer on host for the Cholesky decomposition
+     *  \param B buffer on host for the right-hand sides,
+     *           serves as output for the solution
+     *  \param N size of the matrix
+     *  \param nrhs number of right-hand sides, i.e. columns of B
+     */
+    static void potrs(double const *A, double *B, int N, int nrhs) {
+        char uplo = 'U';
+        int info;
+
+        dpotrs_(&uplo, &N, &nrhs, const_cast<double *>(A), &N, B, &N, &info);
+        assert(info == 0);
+    }
+
+    /** Computes the inverse of a real symmetric positive definite matrix
+     *  from its Cholesky factorization. Only the upper triangle of the
+     *  result is written.
+     *
+     *  \param A buffer on host for the Cholesky decomposition,
+     *           serves as output for the inverse
+     *  \param N size of the matrix
+     */
+    static void potri(double *A, int N) {
+#if defined(SD_USE_CUSOLVERMG)
+        if (multi_gpu::instance().applicable(N)) {
+            multi_gpu::instance().potri(A, N);
+            return;
+        }
+#endif
+        char uplo = 'U';
+        int info;
+
+        dpotri_(&uplo, &N, A, &N, &info);
+        assert(info == 0);
+    }
+
+    /** Batched Cholesky factorization of \p batch matrices of size \p N,
+     *  which are stored one after another, see \ref potrf.
+     */
+    static void potrf_batched(double *A, int N, int batch) {
+        for (int i = 0; i < batch; ++i) {
+            potrf(A + static_cast<std::size_t>(i) * N * N, N);
+        }
+    }
+
+    /** Batched \ref potrs with a single right-hand side per matrix. The
+     *  matrices and the vectors are stored one after another.
+     */
+    static void potrs_batched(double *A, double *B, int N, int batch) {
+        for (int i = 0; i < batch; ++i) {
+            std::size_t const offset = static_cast<std::size_t>(i);
+            potrs(A + offset * N * N, B + offset * N, N, 1);
+        }
+    }
+
+    /** Replaces \p batch real symmetric positive definite matrices of size
+     *  \p N, which are stored one after another, by their inverses.
+     */
+    static void inverse_batched(double *A, int N, int batch) {
+        char uplo = 'U';
+        int info;
+
+        for (int i = 0; i < batch; ++i) {
+            double *Ai = A + static_cast<std::size_t>(i) * N * N;
+            dpotrf_(&uplo, &N, Ai, &N, &info);
+            assert(info == 0);
+            dpotri_(&uplo, &N, Ai, &N, &info);
+            assert(info == 0);
+        }
+
+        // dpotri only computes the upper triangle
+        symmetrize_upper_batched<policy::host>(A, N, batch);
+    }
+};
+
+/** Single precision variant of the specialization above, e.g. for the
+ *  mixed precision mode of \ref sd::mixed_precision_solver. The routines
+ *  have the same meaning as their double precision counterparts.
+ */
+template <>
+struct cusolver<policy::host, float> {
+    static void potrf(float *A, float *B, int N) {
+        char uplo = 'U';
+        int info;
+
+        spotrf_(&uplo, &N, A, &N, &info);
+        assert(info == 0);
+
+        spotrs_(&uplo, &N, &N, A, &N, B, &N, &info);
+        assert(info == 0);
+    }
+
+    static void potrf(float *A, int N) {
+#if defined(SD_USE_CUSOLVERMG)
+        if (multi_gpu::instance().applicable(N)) {
+            multi_gpu::instance().potrf(A, N);
+            return;
+        }
+#endif
+        char uplo = 'U';
+        int info;
+
+        spotrf_(&uplo, &N, A, &N, &info);
+        assert(info == 0);
+    }
+
+    static void potrs(float const *A, float *B, int N, int nrhs) {
+        char uplo = 'U';
+        int info;
+
+        spotrs_(&uplo, &N, &nrhs, const_cast<float *>(A), &N, B, &N, &info);
+        assert(info == 0);
+    }
+
+    static void potri(float *A, int N) {
+#if defined(SD_USE_CUSOLVERMG)
+        if (multi_gpu::instance().applicable(N)) {
+            multi_gpu::instance().potri(A, N);
+            return;
+        }
+#endif
+        char uplo = 'U';
+        int info;
+
+        spotri_(&uplo, &N, A, &N, &info);
+        assert(info == 0);
+    }
+
+    static void potrf_batched(float *A, int N, int batch) {
+        for (int i = 0; i < batch; ++i) {
+            potrf(A + static_cast<std::size_t>(i) * N * N, N);
+        }
+    }
+
+    static void potrs_batched(float *A, float *B, int N, int batch) {
+        for (int i = 0; i < batch; ++i) {
+            std::size_t const offset = static_cast<std::size_t>(i);
+            potrs(A + offset * N * N, B + offset * N, N, 1);
+        }
+    }
+
+    static void inverse_batched(float *A, int N, int batch) {
+        char uplo = 'U';
+        int info;
+
+        for (int i = 0; i < batch; ++i) {
+            float *Ai = A + static_cast<std::size_t>(i) * N * N;
+            spotrf_(&uplo, &N, Ai, &N, &info);
+            assert(info == 0);
+            spotri_(&uplo, &N, Ai, &N, &info);
+            assert(info == 0);
+        }
+
+        symmetrize_upper_batched<policy::host>(A, N, batch);
+    }
 };
 #endif
 
@@ -630,6 +3047,107 @@ public:
         return *this;
     }
 
+    /// Fused matrix-matrix multiplication into this matrix,
+    /// *this = alpha * op(A) * op(B) + beta * (*this), where op transposes
+    /// its argument if requested. Nothing is allocated or transposed
+    /// explicitly, so this matrix must already have the shape of the result.
+    void gemm(device_matrix const &A, device_matrix const &B,
+              bool transA = false, bool transB = false,
+              value_type alpha = 1, value_type beta = 0) {
+        static_assert(std::is_floating_point<T>::value,
+                      "Data type of device_matrix must be floating point for "
+                      "BLAS/LAPACK operations");
+        size_type const k = transA ? A.m_rows : A.m_cols;
+        assert(m_rows == (transA ? A.m_cols : A.m_rows));
+        assert(m_cols == (transB ? B.m_rows : B.m_cols));
+        assert(k == (transB ? B.m_cols : B.m_rows));
+        assert(data() != A.data() && data() != B.data());
+        internal::cublas<Policy, value_type>::gemm(
+            transA, transB, thrust_wrapper::raw_pointer_cast(A.data()),
+            thrust_wrapper::raw_pointer_cast(B.data()),
+            thrust_wrapper::raw_pointer_cast(data()), m_rows, k, m_cols,
+            alpha, beta);
+    }
+
+    /// Fused matrix-vector multiplication into \p y,
+    /// y = alpha * (*this) * x + beta * y.
+    void gemv(storage_type const &x, storage_type &y, value_type alpha = 1,
+              value_type beta = 0) const {
+        static_assert(std::is_floating_point<T>::value,
+                      "Data type of device_matrix must be floating point for "
+                      "BLAS/LAPACK operations");
+        assert(m_cols == x.size());
+        assert(m_rows == y.size());
+        internal::cublas<Policy, value_type>::gemv(
+            false, thrust_wrapper::raw_pointer_cast(data()),
+            thrust_wrapper::raw_pointer_cast(x.data()),
+            thrust_wrapper::raw_pointer_cast(y.data()), m_rows, m_cols, alpha,
+            beta);
+    }
+
+    /// Scaled addition in place, *this += alpha * B
+    device_matrix &axpy(value_type alpha, device_matrix const &B) {
+        static_assert(std::is_floating_point<T>::value,
+                      "Data type of device_matrix must be floating point for "
+                      "BLAS/LAPACK operations");
+        assert(m_rows == B.m_rows);
+        assert(m_cols == B.m_cols);
+        internal::cublas<Policy, value_type>::axpy(
+            size(), alpha, thrust_wrapper::raw_pointer_cast(B.data()),
+            thrust_wrapper::raw_pointer_cast(data()));
+        return *this;
+    }
+
+    /// Symmetric matrix-matrix multiplication into this matrix,
+    /// *this = alpha * S * B + beta * (*this), or alpha * B * S if \p right
+    /// is set. Only the upper triangle of \p S is referenced.
+    void symm(device_matrix const &S, device_matrix const &B,
+              bool right = false, value_type alpha = 1, value_type beta = 0) {
+        static_assert(std::is_floating_point<T>::value,
+                      "Data type of device_matrix must be floating point for "
+                      "BLAS/LAPACK operations");
+        assert(S.m_rows == S.m_cols);
+        assert(S.m_rows == (right ? B.m_cols : B.m_rows));
+        assert(m_rows == B.m_rows && m_cols == B.m_cols);
+        assert(data() != S.data() && data() != B.data());
+        internal::cublas<Policy, value_type>::symm(
+            right, thrust_wrapper::raw_pointer_cast(S.data()),
+            thrust_wrapper::raw_pointer_cast(B.data()),
+            thrust_wrapper::raw_pointer_cast(data()), m_rows, m_cols, alpha,
+            beta);
+    }
+
+    /// Symmetric rank-k update of the upper triangle of this matrix,
+    /// *this = alpha * A * A^T + beta * (*this), or alpha * A^T * A if
+    /// \p trans is set. The strict lower triangle is left untouched, which
+    /// halves the work compared to \ref gemm.
+    void syrk(device_matrix const &A, bool trans = false, value_type alpha = 1,
+              value_type beta = 0) {
+        static_assert(std::is_floating_point<T>::value,
+                      "Data type of device_matrix must be floating point for "
+                      "BLAS/LAPACK operations");
+        assert(m_rows == m_cols);
+        assert(m_rows == (trans ? A.m_cols : A.m_rows));
+        assert(data() != A.data());
+        internal::cublas<Policy, value_type>::syrk(
+            trans, thrust_wrapper::raw_pointer_cast(A.data()),
+            thrust_wrapper::raw_pointer_cast(data()), m_rows,
+            trans ? A.m_rows : A.m_cols, alpha, beta);
+    }
+
+    /// Triangular solve in place, *this = op(U)^-1 * (*this), where \p U is
+    /// an upper triangular Cholesky factor, see \ref potrf.
+    void trsm(device_matrix const &U, bool trans = false) {
+        static_assert(std::is_floating_point<T>::value,
+                      "Data type of device_matrix must be floating point for "
+                      "BLAS/LAPACK operations");
+        assert(U.m_rows == U.m_cols);
+        assert(U.m_rows == m_rows);
+        internal::cublas<Policy, value_type>::trsm(
+            trans, thrust_wrapper::raw_pointer_cast(U.data()),
+            thrust_wrapper::raw_pointer_cast(data()), m_rows, m_cols);
+    }
+
     /// \}
 
     /// \defgroup compare Comparison
@@ -663,7 +3181,7 @@ public:
 
     /// Compute the transpose.
     device_matrix transpose() const {
-        static_assert(std::is_same<T, double>::value,
+        static_assert(std::is_floating_point<T>::value,
                       "Data type of device_matrix must be floating point for "
                       "BLAS/LAPACK operations");
         device_matrix C(m_cols, m_rows);
@@ -673,16 +3191,49 @@ public:
         return C;
     }
 
+    /// Replace this symmetric positive definite matrix by its Cholesky
+    /// factor U in place, looking only in the top half of the matrix. The
+    /// strict lower triangle is left untouched.
+    void potrf() {
+        static_assert(std::is_floating_point<T>::value,
+                      "Data type of device_matrix must be floating point for "
+                      "BLAS/LAPACK operations");
+        assert(m_rows == m_cols);
+        internal::cusolver<Policy, value_type>::potrf(
+            thrust_wrapper::raw_pointer_cast(data()), m_rows);
+    }
+
+    /// Replace the Cholesky factor computed by \ref potrf by the inverse of
+    /// the original matrix. This is cheaper than \ref inverse, which solves
+    /// against the identity.
+    void potri() {
+        static_assert(std::is_floating_point<T>::value,
+                      "Data type of device_matrix must be floating point for "
+                      "BLAS/LAPACK operations");
+        assert(m_rows == m_cols);
+        internal::cusolver<Policy, value_type>::potri(
+            thrust_wrapper::raw_pointer_cast(data()), m_rows);
+        symmetrize_upper();
+    }
+
+    /// Copy the upper triangle into the lower triangle, in parallel and in
+    /// cache-sized tiles.
+    void symmetrize_upper() {
+        assert(m_rows == m_cols);
+        internal::symmetrize_upper_batched<Policy>(
+            thrust_wrapper::raw_pointer_cast(data()), m_rows, 1);
+    }
+
     /// Compute the inverse and the Cholesky decomposition.
     thrust_wrapper::tuple<device_matrix, device_matrix> inverse_and_cholesky() const {
-        static_assert(std::is_same<T, double>::value,
+        static_assert(std::is_floating_point<T>::value,
                       "Data type of device_matrix must be floating point for "
                       "BLAS/LAPACK operations");
         assert(m_rows == m_cols);
         device_matrix A = *this;
         device_matrix B = device_matrix::Identity(m_rows, m_cols);
 
-        internal::cusolver<Policy, double>::potrf(
+        internal::cusolver<Policy, value_type>::potrf(
             thrust_wrapper::raw_pointer_cast(A.data()),
             thrust_wrapper::raw_pointer_cast(B.data()), m_rows);
 
@@ -701,7 +3252,7 @@ public:
 
     /// Generate an identity matrix with size \p rows x \p cols.
     static device_matrix Identity(size_type rows, size_type cols) {
-        static_assert(std::is_same<T, double>::value,
+        static_assert(std::is_floating_point<T>::value,
                       "Data type of device_matrix must be floating point for "
                       "BLAS/LAPACK operations");
         device_matrix I(rows, cols);
@@ -714,6 +3265,112 @@ public:
 };
 
 
+/** Cholesky factorization A = U^T U of a real symmetric positive definite
+ *  matrix. The matrix is factorized once, afterwards linear systems with A
+ *  can be solved and the square root U^T can be applied to vectors without
+ *  ever forming the inverse explicitly.
+ */
+template <typename T, typename Policy = policy::host>
+class cholesky_factor {
+    static_assert(std::is_floating_point<T>::value,
+                  "Data type of cholesky_factor must be floating point for "
+                  "BLAS/LAPACK operations");
+
+public:
+    using matrix_type = device_matrix<T, Policy>;
+    using storage_type = typename matrix_type::storage_type;
+    using size_type = typename matrix_type::size_type;
+
+private:
+    // The upper triangle holds U, the lower triangle still holds A
+    matrix_type m_factor;
+
+public:
+    cholesky_factor() = default;
+
+    /// Factorize \p A, looking only in the top half of the matrix.
+    explicit cholesky_factor(matrix_type const &A) { factorize(A); }
+
+    /// Factorize \p A, looking only in the top half of the matrix. The
+    /// storage of a previous factorization is reused if the size matches.
+    void factorize(matrix_type const &A) {
+        assert(A.rows() == A.cols());
+        m_factor = A;
+        internal::cusolver<Policy, T>::potrf(
+            thrust_wrapper::raw_pointer_cast(m_factor.data()), m_factor.rows());
+    }
+
+    /// Factorize \p A in place. The factor takes over the storage of \p A,
+    /// which is left empty, so that the matrix is not held twice.
+    void factorize_in_place(matrix_type &A) {
+        assert(A.rows() == A.cols());
+        m_factor = matrix_type();
+        m_factor.swap(A);
+        internal::cusolver<Policy, T>::potrf(
+            thrust_wrapper::raw_pointer_cast(m_factor.data()), m_factor.rows());
+    }
+
+    /// Take over \p U as the factor, e.g. one that was computed earlier and
+    /// stored with \ref matrix(). \p U is left empty.
+    void assign(matrix_type &U) {
+        assert(U.rows() == U.cols());
+        m_factor = matrix_type();
+        m_factor.swap(U);
+    }
+
+    /// Hand the storage of the factor over to the caller, e.g. to assemble
+    /// the next matrix in it. The factor is empty afterwards.
+    matrix_type release() {
+        matrix_type A;
+        A.swap(m_factor);
+        return A;
+    }
+
+    /// Solve A x = \p b.
+    storage_type solve(storage_type const &b) const {
+        storage_type x = b;
+        solve_in_place(x);
+        return x;
+    }
+
+    /// Solve A x = \p b, \p b is overwritten by x. \p b may hold \p n_rhs
+    /// right-hand sides one after another, which are solved in one call.
+    void solve_in_place(storage_type &b, size_type n_rhs = 1) const {
+        assert(b.size() == size() * n_rhs);
+        internal::cusolver<Policy, T>::potrs(
+            thrust_wrapper::raw_pointer_cast(m_factor.data()),
+            thrust_wrapper::raw_pointer_cast(b.data()), size(), n_rhs);
+    }
+
+    /// Compute U^T \p psi. If \p psi has zero mean and unit variance, the
+    /// result has the covariance A. \p psi may hold \p n_rhs vectors one
+    /// after another, which are multiplied in one call.
+    storage_type apply_sqrt(storage_type const &psi,
+                            size_type n_rhs = 1) const {
+        storage_type y = psi;
+        apply_sqrt_in_place(y, n_rhs);
+        return y;
+    }
+
+    /// Compute U^T \p psi, \p psi is overwritten by the result.
+    void apply_sqrt_in_place(storage_type &psi, size_type n_rhs = 1) const {
+        assert(psi.size() == size() * n_rhs);
+        if (n_rhs == 1) {
+            internal::cublas<Policy, T>::trmv(
+                thrust_wrapper::raw_pointer_cast(m_factor.data()),
+                thrust_wrapper::raw_pointer_cast(psi.data()), size());
+        } else {
+            internal::cublas<Policy, T>::trmm(
+                thrust_wrapper::raw_pointer_cast(m_factor.data()),
+                thrust_wrapper::raw_pointer_cast(psi.data()), size(), n_rhs);
+        }
+    }
+
+    /// The factorized matrix, only the upper triangle is meaningful.
+    matrix_type const &matrix() const noexcept { return m_factor; }
+    size_type size() const noexcept { return m_factor.rows(); }
+};
+
 /** Read-only reference to another device_matrix object. More accurately, it
  *  is a separate object that has different routines by which the same region
  *  of memory can be viewed.
@@ -742,7 +3399,7 @@ private:
     T *m_data;
 
 public:
-    device_matrix_view(pointer data, size_type rows, size_type cols)
+    DEVICE_FUNC device_matrix_view(pointer data, size_type rows, size_type cols)
         : m_rows(rows), m_cols(cols), m_data(data) {}
 
     device_matrix_view(device_matrix<T, Policy> &v)
@@ -784,7 +3441,7 @@ private:
     T *m_data;
 
 public:
-    device_vector_view(pointer data, size_type size)
+    DEVICE_FUNC device_vector_view(pointer data, size_type size)
         : m_size(size), m_data(data) {}
 
     device_vector_view(storage_type &v)
@@ -801,6 +3458,103 @@ public:
     DEVICE_FUNC size_type size() const noexcept { return m_size; }
 };
 
+/** Sparse matrix in block sparse row (BSR) format. The matrix consists of
+ *  block_rows x block_cols dense blocks of size row_block x col_block, of
+ *  which only the non-zero ones are stored. The blocks of block row i are
+ *  stored at positions row_offsets[i] to row_offsets[i+1] - 1, the block at
+ *  position b belongs to block column col_indices[b] and its values are
+ *  stored column-major at values[b * row_block * col_block].
+ *
+ *  The sparsity pattern is filled in directly by the code that assembles
+ *  the matrix, see e.g. \ref sd::near_field_resistance.
+ */
+template <typename T, typename Policy = policy::host>
+class device_bsr_matrix {
+public:
+    using storage_type = typename Policy::template vector<T>;
+    using index_storage_type = typename Policy::template vector<std::size_t>;
+    using value_type = T;
+    using size_type = std::size_t;
+
+private:
+    size_type m_block_rows = 0;
+    size_type m_block_cols = 0;
+    size_type m_row_block = 0;
+    size_type m_col_block = 0;
+    index_storage_type m_row_offsets;
+    index_storage_type m_col_indices;
+    storage_type m_values;
+
+public:
+    device_bsr_matrix() = default;
+
+    /// Empty matrix of the given shape without any blocks.
+    device_bsr_matrix(size_type block_rows, size_type block_cols,
+                      size_type row_block, size_type col_block)
+        : m_block_rows(block_rows), m_block_cols(block_cols),
+          m_row_block(row_block), m_col_block(col_block),
+          m_row_offsets(block_rows + 1, 0) {}
+
+    /// Make room for \p n_blocks blocks. The pattern and values of the
+    /// blocks are undefined afterwards.
+    void resize_blocks(size_type n_blocks) {
+        m_col_indices.resize(n_blocks);
+        m_values.resize(n_blocks * block_size());
+    }
+
+    /// y = alpha A x + beta y
+    void spmv(device_vector_view<T, Policy> x, device_vector_view<T, Policy> y,
+              T alpha = 1, T beta = 0) const {
+        assert(x.size() == cols());
+        assert(y.size() == rows());
+        thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+        thrust_wrapper::for_each(
+            Policy::par(), begin, begin + m_block_rows,
+            internal::BsrProduct<T>{
+                thrust_wrapper::raw_pointer_cast(m_values.data()),
+                thrust_wrapper::raw_pointer_cast(m_row_offsets.data()),
+                thrust_wrapper::raw_pointer_cast(m_col_indices.data()),
+                m_row_block, m_col_block, x.data(), y.data(), alpha, beta});
+    }
+
+    /// A += this matrix, where the dense matrix \p A may hold another
+    /// floating point type
+    template <typename U>
+    void add_to(device_matrix<U, Policy> &A) const {
+        assert(A.rows() == rows());
+        assert(A.cols() == cols());
+        thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+        thrust_wrapper::for_each(
+            Policy::par(), begin, begin + m_block_rows,
+            internal::BsrAddToDense<T, U>{
+                thrust_wrapper::raw_pointer_cast(m_values.data()),
+                thrust_wrapper::raw_pointer_cast(m_row_offsets.data()),
+                thrust_wrapper::raw_pointer_cast(m_col_indices.data()),
+                m_row_block, m_col_block,
+                thrust_wrapper::raw_pointer_cast(A.data()), A.rows()});
+    }
+
+    index_storage_type &row_offsets() noexcept { return m_row_offsets; }
+    index_storage_type const &row_offsets() const noexcept {
+        return m_row_offsets;
+    }
+    index_storage_type &col_indices() noexcept { return m_col_indices; }
+    index_storage_type const &col_indices() const noexcept {
+        return m_col_indices;
+    }
+    storage_type &values() noexcept { return m_values; }
+    storage_type const &values() const noexcept { return m_values; }
+
+    size_type block_rows() const noexcept { return m_block_rows; }
+    size_type block_cols() const noexcept { return m_block_cols; }
+    size_type row_block() const noexcept { return m_row_block; }
+    size_type col_block() const noexcept { return m_col_block; }
+    size_type block_size() const noexcept { return m_row_block * m_col_block; }
+    size_type n_blocks() const noexcept { return m_col_indices.size(); }
+    size_type rows() const noexcept { return m_block_rows * m_row_block; }
+    size_type cols() const noexcept { return m_block_cols * m_col_block; }
+};
+
 #undef DEVICE_FUNC
 #undef MAYBE_UNUSED
 #endif
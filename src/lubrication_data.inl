@@ -1,285 +1,1542 @@
-static constexpr double rsabc[] = {
-    2.10000000e+00, 2.15000000e+00, 2.20000000e+00, 2.25000000e+00,
-    2.30000000e+00, 2.35000000e+00, 2.40000000e+00, 2.45000000e+00,
-    2.50000000e+00, 2.55000000e+00, 2.60000000e+00, 2.65000000e+00,
-    2.70000000e+00, 2.75000000e+00, 2.80000000e+00, 2.85000000e+00,
-    2.90000000e+00, 2.95000000e+00, 3.00000000e+00, 3.05000000e+00,
-    3.10000000e+00, 3.15000000e+00, 3.20000000e+00, 3.25000000e+00,
-    3.30000000e+00, 3.35000000e+00, 3.40000000e+00, 3.45000000e+00,
-    3.50000000e+00, 3.55000000e+00, 3.60000000e+00, 3.65000000e+00,
-    3.70000000e+00, 3.75000000e+00, 3.80000000e+00, 3.85000000e+00,
-    3.90000000e+00, 3.95000000e+00, 4.00000000e+00};
+// Scalar resistance functions of the intermediate regime 2.1 <= r <= 4 in
+// one table, sampled every 0.01 in r. Each row holds the functions at one
+// node in the order x11a, x12a, y11a, y12a, y11b, y12b, x11c, x12c, y11c,
+// y12c, x11g, x12g, y11g, y12g, y11h, y12h, xm, ym, zm, so that an
+// interpolation reads two neighbouring rows only. The a, b and c functions
+// were tabulated every 0.05 and the g, h and m functions every 0.01 up to
+// r = 2.2 and every 0.05 beyond. These are linearly interpolated to the
+// common grid, which leaves the piecewise linear functions unchanged.
+static constexpr std::size_t lub_table_functions = 19;
+static constexpr std::size_t lub_table_nodes = 191;
+static constexpr double lub_table_min = 2.1;
+static constexpr double lub_table_step = 0.01;
 
-static constexpr double x11as[] = {
-    1.98069000e+00, 1.14261000e+00, 7.40120000e-01, 5.11730000e-01,
-    3.69290000e-01, 2.74840000e-01, 2.09440000e-01, 1.62630000e-01,
-    1.28260000e-01, 1.02480000e-01, 8.28000000e-02, 6.75400000e-02,
-    5.55600000e-02, 4.60300000e-02, 3.83800000e-02, 3.21700000e-02,
-    2.71000000e-02, 2.29200000e-02, 1.94500000e-02, 1.65500000e-02,
-    1.40900000e-02, 1.20200000e-02, 1.02800000e-02, 8.78000000e-03,
-    7.50000000e-03, 6.39000000e-03, 5.43000000e-03, 4.61000000e-03,
-    3.88000000e-03, 3.25000000e-03, 2.69000000e-03, 2.20000000e-03,
-    1.77000000e-03, 1.38000000e-03, 1.04000000e-03, 7.40000000e-04,
-    4.60000000e-04, 2.20000000e-04, 0.00000000e+00};
-
-static constexpr double x12as[] = {
-    -1.97823200e+00, -1.14019200e+00, -7.37752000e-01, -5.09422000e-01,
-    -3.67042000e-01, -2.72662000e-01, -2.07332000e-01, -1.60603000e-01,
-    -1.26311000e-01, -1.00617000e-01, -8.10230000e-02, -6.58530000e-02,
-    -5.39560000e-02, -4.45190000e-02, -3.69560000e-02, -3.08400000e-02,
-    -2.58530000e-02, -2.17570000e-02, -1.83680000e-02, -1.55470000e-02,
-    -1.31570000e-02, -1.11750000e-02, -9.49800000e-03, -8.07200000e-03,
-    -6.85500000e-03, -5.81300000e-03, -4.91500000e-03, -4.14100000e-03,
-    -3.47000000e-03, -2.89300000e-03, -2.38300000e-03, -1.93800000e-03,
-    -1.54700000e-03, -1.20400000e-03, -9.01000000e-04, -6.34000000e-04,
-    -3.97000000e-04, -1.87000000e-04, 0.00000000e+00};
-
-static constexpr double y11as[] = {
-    8.52200000e-02, 5.37500000e-02, 3.67000000e-02, 2.63700000e-02,
-    1.96700000e-02, 1.50800000e-02, 1.18300000e-02, 9.46000000e-03,
-    7.67000000e-03, 6.30000000e-03, 5.24000000e-03, 4.39000000e-03,
-    3.71000000e-03, 3.15000000e-03, 2.70000000e-03, 2.32000000e-03,
-    2.00000000e-03, 1.73000000e-03, 1.50000000e-03, 1.30000000e-03,
-    1.13000000e-03, 9.90000000e-04, 8.60000000e-04, 7.40000000e-04,
-    6.50000000e-04, 5.60000000e-04, 4.90000000e-04, 4.10000000e-04,
-    3.50000000e-04, 3.00000000e-04, 2.50000000e-04, 2.10000000e-04,
-    1.60000000e-04, 1.30000000e-04, 1.00000000e-04, 7.00000000e-05,
-    4.00000000e-05, 2.00000000e-05, 0.00000000e+00};
-
-static constexpr double y12as[] = {
-    -8.14540000e-02, -5.03280000e-02, -3.35920000e-02, -2.35600000e-02,
-    -1.71210000e-02, -1.27850000e-02, -9.75800000e-03, -7.58300000e-03,
-    -5.98200000e-03, -4.77900000e-03, -3.86200000e-03, -3.15100000e-03,
-    -2.59300000e-03, -2.14900000e-03, -1.79200000e-03, -1.50300000e-03,
-    -1.26700000e-03, -1.07100000e-03, -9.10000000e-04, -7.74000000e-04,
-    -6.60000000e-04, -5.63000000e-04, -4.82000000e-04, -4.12000000e-04,
-    -3.51000000e-04, -3.00000000e-04, -2.54000000e-04, -2.15000000e-04,
-    -1.82000000e-04, -1.52000000e-04, -1.26000000e-04, -1.03000000e-04,
-    -8.20000000e-05, -6.40000000e-05, -4.80000000e-05, -3.40000000e-05,
-    -2.10000000e-05, -1.00000000e-05, 0.00000000e+00};
-
-static constexpr double y11bs[] = {
-    -7.87158000e-02, -4.82308000e-02, -3.18458000e-02, -2.20328000e-02,
-    -1.57498000e-02, -1.15348000e-02, -8.60950000e-03, -6.52500000e-03,
-    -5.00680000e-03, -3.88220000e-03, -3.03670000e-03, -2.39320000e-03,
-    -1.89830000e-03, -1.51410000e-03, -1.21350000e-03, -9.76500000e-04,
-    -7.88600000e-04, -6.38700000e-04, -5.18600000e-04, -4.21900000e-04,
-    -3.43600000e-04, -2.80100000e-04, -2.28500000e-04, -1.86200000e-04,
-    -1.51700000e-04, -1.23300000e-04, -9.99000000e-05, -8.07000000e-05,
-    -6.48000000e-05, -5.16000000e-05, -4.08000000e-05, -3.18000000e-05,
-    -2.43000000e-05, -1.82000000e-05, -1.30000000e-05, -8.80000000e-06,
-    -5.30000000e-06, -2.40000000e-06, 0.00000000e+00};
-
-static constexpr double y12bs[] = {
-    8.02421000e-02, 4.95261000e-02, 3.29531000e-02, 2.29871000e-02,
-    1.65771000e-02, 1.22561000e-02, 9.24210000e-03, 7.08110000e-03,
-    5.49710000e-03, 4.31510000e-03, 3.42010000e-03, 2.73410000e-03,
-    2.20110000e-03, 1.78310000e-03, 1.45210000e-03, 1.18910000e-03,
-    9.78100000e-04, 8.07100000e-04, 6.68100000e-04, 5.55100000e-04,
-    4.62100000e-04, 3.85100000e-04, 3.21100000e-04, 2.68100000e-04,
-    2.23000000e-04, 1.85700000e-04, 1.54300000e-04, 1.27800000e-04,
-    1.05300000e-04, 8.61000000e-05, 6.99000000e-05, 5.60000000e-05,
-    4.40000000e-05, 3.37000000e-05, 2.49000000e-05, 1.73000000e-05,
-    1.07000000e-05, 4.90000000e-06, 0.00000000e+00};
-
-static constexpr double x11cs[] = {
-    2.19500000e-02, 1.67400000e-02, 1.30800000e-02, 1.04000000e-02,
-    8.37000000e-03, 6.79000000e-03, 5.56000000e-03, 4.58000000e-03,
-    3.80000000e-03, 3.17000000e-03, 2.65000000e-03, 2.23000000e-03,
-    1.88000000e-03, 1.59000000e-03, 1.34000000e-03, 1.14000000e-03,
-    9.70000000e-04, 8.30000000e-04, 7.20000000e-04, 6.10000000e-04,
-    5.20000000e-04, 4.40000000e-04, 3.80000000e-04, 3.20000000e-04,
-    2.70000000e-04, 2.30000000e-04, 2.00000000e-04, 1.70000000e-04,
-    1.40000000e-04, 1.20000000e-04, 9.00000000e-05, 8.00000000e-05,
-    7.00000000e-05, 5.00000000e-05, 3.00000000e-05, 3.00000000e-05,
-    2.00000000e-05, 1.00000000e-05, 0.00000000e+00};
-
-static constexpr double x12cs[] = {
-    -1.00995000e-02, -6.79550000e-03, -4.73150000e-03, -3.37250000e-03,
-    -2.45050000e-03, -1.80550000e-03, -1.34810000e-03, -1.01760000e-03,
-    -7.75600000e-04, -5.96300000e-04, -4.62100000e-04, -3.60600000e-04,
-    -2.83200000e-04, -2.23800000e-04, -1.77800000e-04, -1.41900000e-04,
-    -1.13900000e-04, -9.17000000e-05, -7.41000000e-05, -6.01000000e-05,
-    -4.88000000e-05, -3.97000000e-05, -3.25000000e-05, -2.65000000e-05,
-    -2.17000000e-05, -1.76000000e-05, -1.44000000e-05, -1.17000000e-05,
-    -9.50000000e-06, -7.60000000e-06, -6.10000000e-06, -4.80000000e-06,
-    -3.70000000e-06, -2.90000000e-06, -2.10000000e-06, -1.40000000e-06,
-    -9.00000000e-07, -4.00000000e-07, 0.00000000e+00};
-
-static constexpr double y11cs[] = {
-    1.59990000e-01, 1.04880000e-01, 7.36000000e-02, 5.38700000e-02,
-    4.06100000e-02, 3.12900000e-02, 2.45200000e-02, 1.94900000e-02,
-    1.56600000e-02, 1.27100000e-02, 1.04000000e-02, 8.57000000e-03,
-    7.11000000e-03, 5.92000000e-03, 4.95000000e-03, 4.17000000e-03,
-    3.52000000e-03, 2.97000000e-03, 2.51000000e-03, 2.14000000e-03,
-    1.82000000e-03, 1.55000000e-03, 1.32000000e-03, 1.12000000e-03,
-    9.50000000e-04, 8.10000000e-04, 6.80000000e-04, 5.70000000e-04,
-    4.80000000e-04, 4.00000000e-04, 3.20000000e-04, 2.70000000e-04,
-    2.10000000e-04, 1.60000000e-04, 1.20000000e-04, 8.00000000e-05,
-    5.00000000e-05, 2.00000000e-05, 0.00000000e+00};
-
-static constexpr double y12cs[] = {
-    5.80310000e-03,  -1.96900000e-04, -2.24620000e-03, -2.82460000e-03,
-    -2.81500000e-03, -2.57600000e-03, -2.26330000e-03, -1.94570000e-03,
-    -1.65200000e-03, -1.39250000e-03, -1.16880000e-03, -9.78800000e-04,
-    -8.18900000e-04, -6.84900000e-04, -5.73000000e-04, -4.79600000e-04,
-    -4.01600000e-04, -3.36500000e-04, -2.82300000e-04, -2.36900000e-04,
-    -1.98700000e-04, -1.66800000e-04, -1.40000000e-04, -1.17300000e-04,
-    -9.82000000e-05, -8.20000000e-05, -6.84000000e-05, -5.67000000e-05,
-    -4.68000000e-05, -3.84000000e-05, -3.12000000e-05, -2.50000000e-05,
-    -1.97000000e-05, -1.51000000e-05, -1.12000000e-05, -7.80000000e-06,
-    -4.90000000e-06, -2.30000000e-06, 0.00000000e+00};
-
-static constexpr double rsgh[] = {
-    2.10000000e+00, 2.11000000e+00, 2.12000000e+00, 2.13000000e+00,
-    2.14000000e+00, 2.15000000e+00, 2.16000000e+00, 2.17000000e+00,
-    2.18000000e+00, 2.19000000e+00, 2.20000000e+00, 2.25000000e+00,
-    2.30000000e+00, 2.35000000e+00, 2.40000000e+00, 2.45000000e+00,
-    2.50000000e+00, 2.55000000e+00, 2.60000000e+00, 2.65000000e+00,
-    2.70000000e+00, 2.75000000e+00, 2.80000000e+00, 2.85000000e+00,
-    2.90000000e+00, 2.95000000e+00, 3.00000000e+00, 3.05000000e+00,
-    3.10000000e+00, 3.15000000e+00, 3.20000000e+00, 3.25000000e+00,
-    3.30000000e+00, 3.35000000e+00, 3.40000000e+00, 3.45000000e+00,
-    3.50000000e+00, 3.55000000e+00, 3.60000000e+00, 3.65000000e+00,
-    3.70000000e+00, 3.75000000e+00, 3.80000000e+00, 3.85000000e+00,
-    3.90000000e+00, 3.95000000e+00, 4.00000000e+00};
-
-static constexpr double x11gs[] = {
-    2.02675700e+00, 1.79415700e+00, 1.60105700e+00, 1.43840700e+00,
-    1.29974700e+00, 1.18030700e+00, 1.07649700e+00, 9.85595000e-01,
-    9.05431000e-01, 8.34337000e-01, 7.70931000e-01, 5.36914000e-01,
-    3.89924000e-01, 2.91795000e-01, 2.23413000e-01, 1.74196000e-01,
-    1.37866000e-01, 1.10486000e-01, 8.94920000e-02, 7.31530000e-02,
-    6.02730000e-02, 5.00040000e-02, 4.17330000e-02, 3.50110000e-02,
-    2.95020000e-02, 2.49530000e-02, 2.11710000e-02, 1.80080000e-02,
-    1.53460000e-02, 1.30940000e-02, 1.11780000e-02, 9.54200000e-03,
-    8.13800000e-03, 6.92901000e-03, 5.88300000e-03, 4.97500000e-03,
-    4.18500000e-03, 3.49400000e-03, 2.88800000e-03, 2.35590000e-03,
-    1.88630000e-03, 1.47180000e-03, 1.10500000e-03, 7.79300000e-04,
-    4.89100000e-04, 2.30600000e-04, 0.00000000e+00};
-
-static constexpr double x12gs[] = {
-    -2.01782500e+00, -1.78525500e+00, -1.59219500e+00, -1.42959500e+00,
-    -1.29095500e+00, -1.17156500e+00, -1.06780500e+00, -9.76940000e-01,
-    -8.96828000e-01, -8.25778000e-01, -7.62428000e-01, -5.28699000e-01,
-    -3.82021000e-01, -2.84233000e-01, -2.16214000e-01, -1.67376000e-01,
-    -1.31428000e-01, -1.04435000e-01, -8.38270000e-02, -6.78690000e-02,
-    -5.53630000e-02, -4.54540000e-02, -3.75310000e-02, -3.11420000e-02,
-    -2.59500000e-02, -2.17020000e-02, -1.82060000e-02, -1.53100000e-02,
-    -1.28990000e-02, -1.08820000e-02, -9.18700000e-03, -7.75598000e-03,
-    -6.54299000e-03, -5.51198000e-03, -4.63101000e-03, -3.87700000e-03,
-    -3.22699000e-03, -2.66901000e-03, -2.18600000e-03, -1.76600000e-03,
-    -1.40199000e-03, -1.08500000e-03, -8.08000000e-04, -5.66010000e-04,
-    -3.52990000e-04, -1.65000000e-04, 0.00000000e+00};
-
-static constexpr double y11gs[] = {
-    4.13886800e-02, 3.75377800e-02, 3.42245800e-02, 3.13491800e-02,
-    2.88322800e-02, 2.66164800e-02, 2.46530800e-02, 2.29039800e-02,
-    2.13386800e-02, 1.99318800e-02, 1.86613800e-02, 1.38389800e-02,
-    1.06807800e-02, 8.49198000e-03, 6.90678000e-03, 5.71738000e-03,
-    4.79848000e-03, 4.07128000e-03, 3.48418000e-03, 3.00218000e-03,
-    2.60068000e-03, 2.26268000e-03, 1.97518000e-03, 1.72848000e-03,
-    1.51548000e-03, 1.33048000e-03, 1.16878000e-03, 1.02707000e-03,
-    9.02260000e-04, 7.92050000e-04, 6.94320000e-04, 6.07540000e-04,
-    5.30230000e-04, 4.61250000e-04, 3.99530000e-04, 3.44250000e-04,
-    2.94620000e-04, 2.50000000e-04, 2.09830000e-04, 1.73600000e-04,
-    1.40880000e-04, 1.11300000e-04, 8.45200000e-05, 6.02500000e-05,
-    3.82200000e-05, 1.82000000e-05, 0.00000000e+00};
-
-static constexpr double y12gs[] = {
-    -3.20663998e-02, -2.84543998e-02, -2.53723998e-02, -2.27203998e-02,
-    -2.04252998e-02, -1.84231998e-02, -1.66682998e-02, -1.51228998e-02,
-    -1.37559998e-02, -1.25411998e-02, -1.14591998e-02, -7.50679980e-03,
-    -5.11039980e-03, -3.58899980e-03, -2.58849980e-03, -1.91129980e-03,
-    -1.44179980e-03, -1.10879980e-03, -8.67899800e-04, -6.90400800e-04,
-    -5.57201800e-04, -4.55599800e-04, -3.76798800e-04, -3.14699800e-04,
-    -2.65099800e-04, -2.24899800e-04, -1.91899800e-04, -1.64399800e-04,
-    -1.41497800e-04, -1.21899800e-04, -1.05299800e-04, -9.09988000e-05,
-    -7.84998000e-05, -6.77002000e-05, -5.81001000e-05, -4.96996000e-05,
-    -4.22695000e-05, -3.56794000e-05, -2.98401000e-05, -2.45399000e-05,
-    -1.98698000e-05, -1.56597000e-05, -1.18399000e-05, -8.42010000e-06,
-    -5.33000000e-06, -2.52950000e-06, 0.00000000e+00};
-
-static constexpr double y11hs[] = {
-    -1.93897170e-02, -1.93518170e-02, -1.91942170e-02, -1.89486170e-02,
-    -1.86386170e-02, -1.82817170e-02, -1.78912170e-02, -1.74775170e-02,
-    -1.70483170e-02, -1.66097170e-02, -1.61666170e-02, -1.39867170e-02,
-    -1.20005170e-02, -1.02675170e-02, -8.78215700e-03, -7.51826700e-03,
-    -6.44545700e-03, -5.53487700e-03, -4.76101700e-03, -4.10210700e-03,
-    -3.53977700e-03, -3.05875700e-03, -2.64624700e-03, -2.29165700e-03,
-    -1.98608700e-03, -1.72215700e-03, -1.49368700e-03, -1.29544700e-03,
-    -1.12308700e-03, -9.72917000e-04, -8.41807000e-04, -7.27120000e-04,
-    -6.26604000e-04, -5.38357000e-04, -4.60730000e-04, -3.92344000e-04,
-    -3.31976000e-04, -2.78612000e-04, -2.31361000e-04, -1.89457000e-04,
-    -1.52240000e-04, -1.19136000e-04, -8.96460000e-05, -6.33400000e-05,
-    -3.98430000e-05, -1.88240000e-05, 0.00000000e+00};
-
-static constexpr double y12hs[] = {
-    7.95613997e-02, 7.23663997e-02, 6.60993997e-02, 6.05963997e-02,
-    5.57303997e-02, 5.14003997e-02, 4.75263997e-02, 4.40443997e-02,
-    4.09023997e-02, 3.80543997e-02, 3.54663997e-02, 2.54763997e-02,
-    1.88113997e-02, 1.41783997e-02, 1.08573997e-02, 8.42039970e-03,
-    6.60139970e-03, 5.22039970e-03, 4.16079970e-03, 3.33870970e-03,
-    2.69489970e-03, 2.18679970e-03, 1.78249970e-03, 1.45918970e-03,
-    1.19879970e-03, 9.87899700e-04, 8.16400700e-04, 6.76300700e-04,
-    5.61199700e-04, 4.66298700e-04, 3.87701700e-04, 3.22401700e-04,
-    2.68101700e-04, 2.22399700e-04, 1.84301700e-04, 1.52200700e-04,
-    1.24897700e-04, 1.01998700e-04, 8.25007000e-05, 6.57997000e-05,
-    5.15990000e-05, 3.94993000e-05, 2.89995000e-05, 2.00998000e-05,
-    1.23996000e-05, 5.69970000e-06, 0.00000000e+00};
-
-static constexpr double rsm[] = {
-    2.10000000e+00, 2.11000000e+00, 2.12000000e+00, 2.13000000e+00,
-    2.14000000e+00, 2.15000000e+00, 2.16000000e+00, 2.17000000e+00,
-    2.18000000e+00, 2.19000000e+00, 2.20000000e+00, 2.25000000e+00,
-    2.30000000e+00, 2.35000000e+00, 2.40000000e+00, 2.45000000e+00,
-    2.50000000e+00, 2.55000000e+00, 2.60000000e+00, 2.65000000e+00,
-    2.70000000e+00, 2.75000000e+00, 2.80000000e+00, 2.85000000e+00,
-    2.90000000e+00, 2.95000000e+00, 3.00000000e+00, 3.05000000e+00,
-    3.10000000e+00, 3.15000000e+00, 3.20000000e+00, 3.25000000e+00,
-    3.30000000e+00, 3.35000000e+00, 3.40000000e+00, 3.45000000e+00,
-    3.50000000e+00, 3.55000000e+00, 3.60000000e+00, 3.65000000e+00,
-    3.70000000e+00, 3.75000000e+00, 3.80000000e+00, 3.85000000e+00,
-    3.90000000e+00, 3.95000000e+00, 4.00000000e+00};
-
-static constexpr double xms[] = {
-    2.75887000e+00, 2.44633000e+00, 2.18653000e+00, 1.96742000e+00,
-    1.78033000e+00, 1.61896000e+00, 1.47851000e+00, 1.35532000e+00,
-    1.24655000e+00, 1.14993000e+00, 1.06364000e+00, 7.43872000e-01,
-    5.41620000e-01, 4.05796000e-01, 3.10632000e-01, 2.41868000e-01,
-    1.90947000e-01, 1.52487000e-01, 1.22971000e-01, 9.99960000e-02,
-    8.19111000e-02, 6.75067000e-02, 5.59467000e-02, 4.65911000e-02,
-    3.89544000e-02, 3.26756000e-02, 2.74956000e-02, 2.31911000e-02,
-    1.95933000e-02, 1.65811000e-02, 1.40344000e-02, 1.18778000e-02,
-    1.00367000e-02, 8.48110000e-03, 7.14000000e-03, 5.98444000e-03,
-    4.99778000e-03, 4.14222000e-03, 3.39333000e-03, 2.74444000e-03,
-    2.18333000e-03, 1.68333000e-03, 1.26333000e-03, 8.88890000e-04,
-    5.56670000e-04, 2.64440000e-04, 0.00000000e+00};
-
-static constexpr double yms[] = {
-    8.07955110e-02, 7.36955110e-02, 6.76211110e-02, 6.23600110e-02,
-    5.77778110e-02, 5.37511110e-02, 5.01989110e-02, 4.70433110e-02,
-    4.42178110e-02, 4.16755110e-02, 3.93933110e-02, 3.06900110e-02,
-    2.49100110e-02, 2.07933110e-02, 1.76922110e-02, 1.52489110e-02,
-    1.32633110e-02, 1.16033110e-02, 1.01933110e-02, 8.98000100e-03,
-    7.91889100e-03, 6.99667100e-03, 6.18000100e-03, 5.46222100e-03,
-    4.83111100e-03, 4.26222100e-03, 3.75889100e-03, 3.31222100e-03,
-    2.91778100e-03, 2.56444100e-03, 2.24444100e-03, 1.96555100e-03,
-    1.71333100e-03, 1.48000100e-03, 1.28555100e-03, 1.10444100e-03,
-    9.41111000e-04, 7.90001000e-04, 6.67781000e-04, 5.51111000e-04,
-    4.37781000e-04, 3.45555000e-04, 2.63333000e-04, 1.88889000e-04,
-    1.12222000e-04, 5.33330000e-05, 0.00000000e+00};
-
-static constexpr double zms[] = {
-    8.64000330e-03, 8.31444330e-03, 8.00222330e-03, 7.69444330e-03,
-    7.41000330e-03, 7.13111330e-03, 6.86555330e-03, 6.61666330e-03,
-    6.37222330e-03, 6.14222330e-03, 5.91889330e-03, 4.92555330e-03,
-    4.11889330e-03, 3.46000330e-03, 2.91666330e-03, 2.47444330e-03,
-    2.09777330e-03, 1.78000330e-03, 1.52000330e-03, 1.30555330e-03,
-    1.11333330e-03, 9.58893300e-04, 8.23333300e-04, 7.08889300e-04,
-    6.15555300e-04, 5.33333300e-04, 4.58889300e-04, 4.01111300e-04,
-    3.45555300e-04, 2.98889300e-04, 2.54444300e-04, 2.17777300e-04,
-    1.92222300e-04, 1.63333300e-04, 1.42222300e-04, 1.23333300e-04,
-    9.88893000e-05, 9.00003000e-05, 7.11113000e-05, 6.22223000e-05,
-    4.44444000e-05, 4.22222000e-05, 3.44444000e-05, 2.33333000e-05,
-    2.00000000e-05, 1.55555000e-05, 0.00000000e+00};
+static constexpr double lub_table[lub_table_nodes * lub_table_functions] = {
+    // r = 2.10
+    1.98069000e+00, -1.97823200e+00, 8.52200000e-02,
+    -8.14540000e-02, -7.87158000e-02, 8.02421000e-02,
+    2.19500000e-02, -1.00995000e-02, 1.59990000e-01,
+    5.80310000e-03, 2.02675700e+00, -2.01782500e+00,
+    4.13886800e-02, -3.20663998e-02, -1.93897170e-02,
+    7.95613997e-02, 2.75887000e+00, 8.07955110e-02,
+    8.64000330e-03,
+    // r = 2.11
+    1.81307400e+00, -1.81062400e+00, 7.89260000e-02,
+    -7.52288000e-02, -7.26188000e-02, 7.40989000e-02,
+    2.09080000e-02, -9.43870000e-03, 1.48968000e-01,
+    4.60310000e-03, 1.79415700e+00, -1.78525500e+00,
+    3.75377800e-02, -2.84543998e-02, -1.93518170e-02,
+    7.23663997e-02, 2.44633000e+00, 7.36955110e-02,
+    8.31444330e-03,
+    // r = 2.12
+    1.64545800e+00, -1.64301600e+00, 7.26320000e-02,
+    -6.90036000e-02, -6.65218000e-02, 6.79557000e-02,
+    1.98660000e-02, -8.77790000e-03, 1.37946000e-01,
+    3.40310000e-03, 1.60105700e+00, -1.59219500e+00,
+    3.42245800e-02, -2.53723998e-02, -1.91942170e-02,
+    6.60993997e-02, 2.18653000e+00, 6.76211110e-02,
+    8.00222330e-03,
+    // r = 2.13
+    1.47784200e+00, -1.47540800e+00, 6.63380000e-02,
+    -6.27784000e-02, -6.04248000e-02, 6.18125000e-02,
+    1.88240000e-02, -8.11710000e-03, 1.26924000e-01,
+    2.20310000e-03, 1.43840700e+00, -1.42959500e+00,
+    3.13491800e-02, -2.27203998e-02, -1.89486170e-02,
+    6.05963997e-02, 1.96742000e+00, 6.23600110e-02,
+    7.69444330e-03,
+    // r = 2.14
+    1.31022600e+00, -1.30780000e+00, 6.00440000e-02,
+    -5.65532000e-02, -5.43278000e-02, 5.56693000e-02,
+    1.77820000e-02, -7.45630000e-03, 1.15902000e-01,
+    1.00310000e-03, 1.29974700e+00, -1.29095500e+00,
+    2.88322800e-02, -2.04252998e-02, -1.86386170e-02,
+    5.57303997e-02, 1.78033000e+00, 5.77778110e-02,
+    7.41000330e-03,
+    // r = 2.15
+    1.14261000e+00, -1.14019200e+00, 5.37500000e-02,
+    -5.03280000e-02, -4.82308000e-02, 4.95261000e-02,
+    1.67400000e-02, -6.79550000e-03, 1.04880000e-01,
+    -1.96900000e-04, 1.18030700e+00, -1.17156500e+00,
+    2.66164800e-02, -1.84231998e-02, -1.82817170e-02,
+    5.14003997e-02, 1.61896000e+00, 5.37511110e-02,
+    7.13111330e-03,
+    // r = 2.16
+    1.06211200e+00, -1.05970400e+00, 5.03400000e-02,
+    -4.69808000e-02, -4.49538000e-02, 4.62115000e-02,
+    1.60080000e-02, -6.38270000e-03, 9.86240000e-02,
+    -6.06760000e-04, 1.07649700e+00, -1.06780500e+00,
+    2.46530800e-02, -1.66682998e-02, -1.78912170e-02,
+    4.75263997e-02, 1.47851000e+00, 5.01989110e-02,
+    6.86555330e-03,
+    // r = 2.17
+    9.81614000e-01, -9.79216000e-01, 4.69300000e-02,
+    -4.36336000e-02, -4.16768000e-02, 4.28969000e-02,
+    1.52760000e-02, -5.96990000e-03, 9.23680000e-02,
+    -1.01662000e-03, 9.85595000e-01, -9.76940000e-01,
+    2.29039800e-02, -1.51228998e-02, -1.74775170e-02,
+    4.40443997e-02, 1.35532000e+00, 4.70433110e-02,
+    6.61666330e-03,
+    // r = 2.18
+    9.01116000e-01, -8.98728000e-01, 4.35200000e-02,
+    -4.02864000e-02, -3.83998000e-02, 3.95823000e-02,
+    1.45440000e-02, -5.55710000e-03, 8.61120000e-02,
+    -1.42648000e-03, 9.05431000e-01, -8.96828000e-01,
+    2.13386800e-02, -1.37559998e-02, -1.70483170e-02,
+    4.09023997e-02, 1.24655000e+00, 4.42178110e-02,
+    6.37222330e-03,
+    // r = 2.19
+    8.20618000e-01, -8.18240000e-01, 4.01100000e-02,
+    -3.69392000e-02, -3.51228000e-02, 3.62677000e-02,
+    1.38120000e-02, -5.14430000e-03, 7.98560000e-02,
+    -1.83634000e-03, 8.34337000e-01, -8.25778000e-01,
+    1.99318800e-02, -1.25411998e-02, -1.66097170e-02,
+    3.80543997e-02, 1.14993000e+00, 4.16755110e-02,
+    6.14222330e-03,
+    // r = 2.20
+    7.40120000e-01, -7.37752000e-01, 3.67000000e-02,
+    -3.35920000e-02, -3.18458000e-02, 3.29531000e-02,
+    1.30800000e-02, -4.73150000e-03, 7.36000000e-02,
+    -2.24620000e-03, 7.70931000e-01, -7.62428000e-01,
+    1.86613800e-02, -1.14591998e-02, -1.61666170e-02,
+    3.54663997e-02, 1.06364000e+00, 3.93933110e-02,
+    5.91889330e-03,
+    // r = 2.21
+    6.94442000e-01, -6.92086000e-01, 3.46340000e-02,
+    -3.15856000e-02, -2.98832000e-02, 3.09599000e-02,
+    1.25440000e-02, -4.45970000e-03, 6.96540000e-02,
+    -2.36188000e-03, 7.24127600e-01, -7.15682200e-01,
+    1.76969000e-02, -1.06687198e-02, -1.57306370e-02,
+    3.34683997e-02, 9.99686400e-01, 3.76526510e-02,
+    5.72022530e-03,
+    // r = 2.22
+    6.48764000e-01, -6.46420000e-01, 3.25680000e-02,
+    -2.95792000e-02, -2.79206000e-02, 2.89667000e-02,
+    1.20080000e-02, -4.18790000e-03, 6.57080000e-02,
+    -2.47756000e-03, 6.77324200e-01, -6.68936400e-01,
+    1.67324200e-02, -9.87823980e-03, -1.52946570e-02,
+    3.14703997e-02, 9.35732800e-01, 3.59119910e-02,
+    5.52155730e-03,
+    // r = 2.23
+    6.03086000e-01, -6.00754000e-01, 3.05020000e-02,
+    -2.75728000e-02, -2.59580000e-02, 2.69735000e-02,
+    1.14720000e-02, -3.91610000e-03, 6.17620000e-02,
+    -2.59324000e-03, 6.30520800e-01, -6.22190600e-01,
+    1.57679400e-02, -9.08775980e-03, -1.48586770e-02,
+    2.94723997e-02, 8.71779200e-01, 3.41713310e-02,
+    5.32288930e-03,
+    // r = 2.24
+    5.57408000e-01, -5.55088000e-01, 2.84360000e-02,
+    -2.55664000e-02, -2.39954000e-02, 2.49803000e-02,
+    1.09360000e-02, -3.64430000e-03, 5.78160000e-02,
+    -2.70892000e-03, 5.83717400e-01, -5.75444800e-01,
+    1.48034600e-02, -8.29727980e-03, -1.44226970e-02,
+    2.74743997e-02, 8.07825600e-01, 3.24306710e-02,
+    5.12422130e-03,
+    // r = 2.25
+    5.11730000e-01, -5.09422000e-01, 2.63700000e-02,
+    -2.35600000e-02, -2.20328000e-02, 2.29871000e-02,
+    1.04000000e-02, -3.37250000e-03, 5.38700000e-02,
+    -2.82460000e-03, 5.36914000e-01, -5.28699000e-01,
+    1.38389800e-02, -7.50679980e-03, -1.39867170e-02,
+    2.54763997e-02, 7.43872000e-01, 3.06900110e-02,
+    4.92555330e-03,
+    // r = 2.26
+    4.83242000e-01, -4.80946000e-01, 2.50300000e-02,
+    -2.22722000e-02, -2.07762000e-02, 2.17051000e-02,
+    9.99400000e-03, -3.18810000e-03, 5.12180000e-02,
+    -2.82268000e-03, 5.07516000e-01, -4.99363400e-01,
+    1.32073400e-02, -7.02751980e-03, -1.35894770e-02,
+    2.41433997e-02, 7.03421600e-01, 2.95340110e-02,
+    4.76422130e-03,
+    // r = 2.27
+    4.54754000e-01, -4.52470000e-01, 2.36900000e-02,
+    -2.09844000e-02, -1.95196000e-02, 2.04231000e-02,
+    9.58800000e-03, -3.00370000e-03, 4.85660000e-02,
+    -2.82076000e-03, 4.78118000e-01, -4.70027800e-01,
+    1.25757000e-02, -6.54823980e-03, -1.31922370e-02,
+    2.28103997e-02, 6.62971200e-01, 2.83780110e-02,
+    4.60288930e-03,
+    // r = 2.28
+    4.26266000e-01, -4.23994000e-01, 2.23500000e-02,
+    -1.96966000e-02, -1.82630000e-02, 1.91411000e-02,
+    9.18200000e-03, -2.81930000e-03, 4.59140000e-02,
+    -2.81884000e-03, 4.48720000e-01, -4.40692200e-01,
+    1.19440600e-02, -6.06895980e-03, -1.27949970e-02,
+    2.14773997e-02, 6.22520800e-01, 2.72220110e-02,
+    4.44155730e-03,
+    // r = 2.29
+    3.97778000e-01, -3.95518000e-01, 2.10100000e-02,
+    -1.84088000e-02, -1.70064000e-02, 1.78591000e-02,
+    8.77600000e-03, -2.63490000e-03, 4.32620000e-02,
+    -2.81692000e-03, 4.19322000e-01, -4.11356600e-01,
+    1.13124200e-02, -5.58967980e-03, -1.23977570e-02,
+    2.01443997e-02, 5.82070400e-01, 2.60660110e-02,
+    4.28022530e-03,
+    // r = 2.30
+    3.69290000e-01, -3.67042000e-01, 1.96700000e-02,
+    -1.71210000e-02, -1.57498000e-02, 1.65771000e-02,
+    8.37000000e-03, -2.45050000e-03, 4.06100000e-02,
+    -2.81500000e-03, 3.89924000e-01, -3.82021000e-01,
+    1.06807800e-02, -5.11039980e-03, -1.20005170e-02,
+    1.88113997e-02, 5.41620000e-01, 2.49100110e-02,
+    4.11889330e-03,
+    // r = 2.31
+    3.50400000e-01, -3.48166000e-01, 1.87520000e-02,
+    -1.62538000e-02, -1.49068000e-02, 1.57129000e-02,
+    8.05400000e-03, -2.32150000e-03, 3.87460000e-02,
+    -2.76720000e-03, 3.70298200e-01, -3.62463400e-01,
+    1.02430200e-02, -4.80611980e-03, -1.16539170e-02,
+    1.78847997e-02, 5.14455200e-01, 2.40866710e-02,
+    3.98711530e-03,
+    // r = 2.32
+    3.31510000e-01, -3.29290000e-01, 1.78340000e-02,
+    -1.53866000e-02, -1.40638000e-02, 1.48487000e-02,
+    7.73800000e-03, -2.19250000e-03, 3.68820000e-02,
+    -2.71940000e-03, 3.50672400e-01, -3.42905800e-01,
+    9.80526000e-03, -4.50183980e-03, -1.13073170e-02,
+    1.69581997e-02, 4.87290400e-01, 2.32633310e-02,
+    3.85533730e-03,
+    // r = 2.33
+    3.12620000e-01, -3.10414000e-01, 1.69160000e-02,
+    -1.45194000e-02, -1.32208000e-02, 1.39845000e-02,
+    7.42200000e-03, -2.06350000e-03, 3.50180000e-02,
+    -2.67160000e-03, 3.31046600e-01, -3.23348200e-01,
+    9.36750000e-03, -4.19755980e-03, -1.09607170e-02,
+    1.60315997e-02, 4.60125600e-01, 2.24399910e-02,
+    3.72355930e-03,
+    // r = 2.34
+    2.93730000e-01, -2.91538000e-01, 1.59980000e-02,
+    -1.36522000e-02, -1.23778000e-02, 1.31203000e-02,
+    7.10600000e-03, -1.93450000e-03, 3.31540000e-02,
+    -2.62380000e-03, 3.11420800e-01, -3.03790600e-01,
+    8.92974000e-03, -3.89327980e-03, -1.06141170e-02,
+    1.51049997e-02, 4.32960800e-01, 2.16166510e-02,
+    3.59178130e-03,
+    // r = 2.35
+    2.74840000e-01, -2.72662000e-01, 1.50800000e-02,
+    -1.27850000e-02, -1.15348000e-02, 1.22561000e-02,
+    6.79000000e-03, -1.80550000e-03, 3.12900000e-02,
+    -2.57600000e-03, 2.91795000e-01, -2.84233000e-01,
+    8.49198000e-03, -3.58899980e-03, -1.02675170e-02,
+    1.41783997e-02, 4.05796000e-01, 2.07933110e-02,
+    3.46000330e-03,
+    // r = 2.36
+    2.61760000e-01, -2.59596000e-01, 1.44300000e-02,
+    -1.21796000e-02, -1.09497400e-02, 1.16533000e-02,
+    6.54400000e-03, -1.71402000e-03, 2.99360000e-02,
+    -2.51346000e-03, 2.78118600e-01, -2.70629200e-01,
+    8.17494000e-03, -3.38889980e-03, -9.97044500e-03,
+    1.35141997e-02, 3.86763200e-01, 2.01730910e-02,
+    3.35133530e-03,
+    // r = 2.37
+    2.48680000e-01, -2.46530000e-01, 1.37800000e-02,
+    -1.15742000e-02, -1.03646800e-02, 1.10505000e-02,
+    6.29800000e-03, -1.62254000e-03, 2.85820000e-02,
+    -2.45092000e-03, 2.64442200e-01, -2.57025400e-01,
+    7.85790000e-03, -3.18879980e-03, -9.67337300e-03,
+    1.28499997e-02, 3.67730400e-01, 1.95528710e-02,
+    3.24266730e-03,
+    // r = 2.38
+    2.35600000e-01, -2.33464000e-01, 1.31300000e-02,
+    -1.09688000e-02, -9.77962000e-03, 1.04477000e-02,
+    6.05200000e-03, -1.53106000e-03, 2.72280000e-02,
+    -2.38838000e-03, 2.50765800e-01, -2.43421600e-01,
+    7.54086000e-03, -2.98869980e-03, -9.37630100e-03,
+    1.21857997e-02, 3.48697600e-01, 1.89326510e-02,
+    3.13399930e-03,
+    // r = 2.39
+    2.22520000e-01, -2.20398000e-01, 1.24800000e-02,
+    -1.03634000e-02, -9.19456000e-03, 9.84490000e-03,
+    5.80600000e-03, -1.43958000e-03, 2.58740000e-02,
+    -2.32584000e-03, 2.37089400e-01, -2.29817800e-01,
+    7.22382000e-03, -2.78859980e-03, -9.07922900e-03,
+    1.15215997e-02, 3.29664800e-01, 1.83124310e-02,
+    3.02533130e-03,
+    // r = 2.40
+    2.09440000e-01, -2.07332000e-01, 1.18300000e-02,
+    -9.75800000e-03, -8.60950000e-03, 9.24210000e-03,
+    5.56000000e-03, -1.34810000e-03, 2.45200000e-02,
+    -2.26330000e-03, 2.23413000e-01, -2.16214000e-01,
+    6.90678000e-03, -2.58849980e-03, -8.78215700e-03,
+    1.08573997e-02, 3.10632000e-01, 1.76922110e-02,
+    2.91666330e-03,
+    // r = 2.41
+    2.00078000e-01, -1.97986200e-01, 1.13560000e-02,
+    -9.32300000e-03, -8.19260000e-03, 8.80990000e-03,
+    5.36400000e-03, -1.28200000e-03, 2.35140000e-02,
+    -2.19978000e-03, 2.13569600e-01, -2.06446400e-01,
+    6.66890000e-03, -2.45305980e-03, -8.52937900e-03,
+    1.03699997e-02, 2.96879200e-01, 1.72035510e-02,
+    2.82821930e-03,
+    // r = 2.42
+    1.90716000e-01, -1.88640400e-01, 1.08820000e-02,
+    -8.88800000e-03, -7.77570000e-03, 8.37770000e-03,
+    5.16800000e-03, -1.21590000e-03, 2.25080000e-02,
+    -2.13626000e-03, 2.03726200e-01, -1.96678800e-01,
+    6.43102000e-03, -2.31761980e-03, -8.27660100e-03,
+    9.88259970e-03, 2.83126400e-01, 1.67148910e-02,
+    2.73977530e-03,
+    // r = 2.43
+    1.81354000e-01, -1.79294600e-01, 1.04080000e-02,
+    -8.45300000e-03, -7.35880000e-03, 7.94550000e-03,
+    4.97200000e-03, -1.14980000e-03, 2.15020000e-02,
+    -2.07274000e-03, 1.93882800e-01, -1.86911200e-01,
+    6.19314000e-03, -2.18217980e-03, -8.02382300e-03,
+    9.39519970e-03, 2.69373600e-01, 1.62262310e-02,
+    2.65133130e-03,
+    // r = 2.44
+    1.71992000e-01, -1.69948800e-01, 9.93400000e-03,
+    -8.01800000e-03, -6.94190000e-03, 7.51330000e-03,
+    4.77600000e-03, -1.08370000e-03, 2.04960000e-02,
+    -2.00922000e-03, 1.84039400e-01, -1.77143600e-01,
+    5.95526000e-03, -2.04673980e-03, -7.77104500e-03,
+    8.90779970e-03, 2.55620800e-01, 1.57375710e-02,
+    2.56288730e-03,
+    // r = 2.45
+    1.62630000e-01, -1.60603000e-01, 9.46000000e-03,
+    -7.58300000e-03, -6.52500000e-03, 7.08110000e-03,
+    4.58000000e-03, -1.01760000e-03, 1.94900000e-02,
+    -1.94570000e-03, 1.74196000e-01, -1.67376000e-01,
+    5.71738000e-03, -1.91129980e-03, -7.51826700e-03,
+    8.42039970e-03, 2.41868000e-01, 1.52489110e-02,
+    2.47444330e-03,
+    // r = 2.46
+    1.55756000e-01, -1.53744600e-01, 9.10200000e-03,
+    -7.26280000e-03, -6.22136000e-03, 6.76430000e-03,
+    4.42400000e-03, -9.69200000e-04, 1.87240000e-02,
+    -1.88696000e-03, 1.66930000e-01, -1.60186400e-01,
+    5.53360000e-03, -1.81739980e-03, -7.30370500e-03,
+    8.05659970e-03, 2.31683800e-01, 1.48517910e-02,
+    2.39910930e-03,
+    // r = 2.47
+    1.48882000e-01, -1.46886200e-01, 8.74400000e-03,
+    -6.94260000e-03, -5.91772000e-03, 6.44750000e-03,
+    4.26800000e-03, -9.20800000e-04, 1.79580000e-02,
+    -1.82822000e-03, 1.59664000e-01, -1.52996800e-01,
+    5.34982000e-03, -1.72349980e-03, -7.08914300e-03,
+    7.69279970e-03, 2.21499600e-01, 1.44546710e-02,
+    2.32377530e-03,
+    // r = 2.48
+    1.42008000e-01, -1.40027800e-01, 8.38600000e-03,
+    -6.62240000e-03, -5.61408000e-03, 6.13070000e-03,
+    4.11200000e-03, -8.72400000e-04, 1.71920000e-02,
+    -1.76948000e-03, 1.52398000e-01, -1.45807200e-01,
+    5.16604000e-03, -1.62959980e-03, -6.87458100e-03,
+    7.32899970e-03, 2.11315400e-01, 1.40575510e-02,
+    2.24844130e-03,
+    // r = 2.49
+    1.35134000e-01, -1.33169400e-01, 8.02800000e-03,
+    -6.30220000e-03, -5.31044000e-03, 5.81390000e-03,
+    3.95600000e-03, -8.24000000e-04, 1.64260000e-02,
+    -1.71074000e-03, 1.45132000e-01, -1.38617600e-01,
+    4.98226000e-03, -1.53569980e-03, -6.66001900e-03,
+    6.96519970e-03, 2.01131200e-01, 1.36604310e-02,
+    2.17310730e-03,
+    // r = 2.50
+    1.28260000e-01, -1.26311000e-01, 7.67000000e-03,
+    -5.98200000e-03, -5.00680000e-03, 5.49710000e-03,
+    3.80000000e-03, -7.75600000e-04, 1.56600000e-02,
+    -1.65200000e-03, 1.37866000e-01, -1.31428000e-01,
+    4.79848000e-03, -1.44179980e-03, -6.44545700e-03,
+    6.60139970e-03, 1.90947000e-01, 1.32633110e-02,
+    2.09777330e-03,
+    // r = 2.51
+    1.23104000e-01, -1.21172200e-01, 7.39600000e-03,
+    -5.74140000e-03, -4.78188000e-03, 5.26070000e-03,
+    3.67400000e-03, -7.39740000e-04, 1.50700000e-02,
+    -1.60010000e-03, 1.32390000e-01, -1.26029400e-01,
+    4.65304000e-03, -1.37519980e-03, -6.26334100e-03,
+    6.32519970e-03, 1.83255000e-01, 1.29313110e-02,
+    2.03421930e-03,
+    // r = 2.52
+    1.17948000e-01, -1.16033400e-01, 7.12200000e-03,
+    -5.50080000e-03, -4.55696000e-03, 5.02430000e-03,
+    3.54800000e-03, -7.03880000e-04, 1.44800000e-02,
+    -1.54820000e-03, 1.26914000e-01, -1.20630800e-01,
+    4.50760000e-03, -1.30859980e-03, -6.08122500e-03,
+    6.04899970e-03, 1.75563000e-01, 1.25993110e-02,
+    1.97066530e-03,
+    // r = 2.53
+    1.12792000e-01, -1.10894600e-01, 6.84800000e-03,
+    -5.26020000e-03, -4.33204000e-03, 4.78790000e-03,
+    3.42200000e-03, -6.68020000e-04, 1.38900000e-02,
+    -1.49630000e-03, 1.21438000e-01, -1.15232200e-01,
+    4.36216000e-03, -1.24199980e-03, -5.89910900e-03,
+    5.77279970e-03, 1.67871000e-01, 1.22673110e-02,
+    1.90711130e-03,
+    // r = 2.54
+    1.07636000e-01, -1.05755800e-01, 6.57400000e-03,
+    -5.01960000e-03, -4.10712000e-03, 4.55150000e-03,
+    3.29600000e-03, -6.32160000e-04, 1.33000000e-02,
+    -1.44440000e-03, 1.15962000e-01, -1.09833600e-01,
+    4.21672000e-03, -1.17539980e-03, -5.71699300e-03,
+    5.49659970e-03, 1.60179000e-01, 1.19353110e-02,
+    1.84355730e-03,
+    // r = 2.55
+    1.02480000e-01, -1.00617000e-01, 6.30000000e-03,
+    -4.77900000e-03, -3.88220000e-03, 4.31510000e-03,
+    3.17000000e-03, -5.96300000e-04, 1.27100000e-02,
+    -1.39250000e-03, 1.10486000e-01, -1.04435000e-01,
+    4.07128000e-03, -1.10879980e-03, -5.53487700e-03,
+    5.22039970e-03, 1.52487000e-01, 1.16033110e-02,
+    1.78000330e-03,
+    // r = 2.56
+    9.85440000e-02, -9.66982000e-02, 6.08800000e-03,
+    -4.59560000e-03, -3.71310000e-03, 4.13610000e-03,
+    3.06600000e-03, -5.69460000e-04, 1.22480000e-02,
+    -1.34776000e-03, 1.06287200e-01, -1.00313400e-01,
+    3.95386000e-03, -1.06061980e-03, -5.38010500e-03,
+    5.00847970e-03, 1.46583800e-01, 1.13213110e-02,
+    1.72800330e-03,
+    // r = 2.57
+    9.46080000e-02, -9.27794000e-02, 5.87600000e-03,
+    -4.41220000e-03, -3.54400000e-03, 3.95710000e-03,
+    2.96200000e-03, -5.42620000e-04, 1.17860000e-02,
+    -1.30302000e-03, 1.02088400e-01, -9.61918000e-02,
+    3.83644000e-03, -1.01243980e-03, -5.22533300e-03,
+    4.79655970e-03, 1.40680600e-01, 1.10393110e-02,
+    1.67600330e-03,
+    // r = 2.58
+    9.06720000e-02, -8.88606000e-02, 5.66400000e-03,
+    -4.22880000e-03, -3.37490000e-03, 3.77810000e-03,
+    2.85800000e-03, -5.15780000e-04, 1.13240000e-02,
+    -1.25828000e-03, 9.78896000e-02, -9.20702000e-02,
+    3.71902000e-03, -9.64259800e-04, -5.07056100e-03,
+    4.58463970e-03, 1.34777400e-01, 1.07573110e-02,
+    1.62400330e-03,
+    // r = 2.59
+    8.67360000e-02, -8.49418000e-02, 5.45200000e-03,
+    -4.04540000e-03, -3.20580000e-03, 3.59910000e-03,
+    2.75400000e-03, -4.88940000e-04, 1.08620000e-02,
+    -1.21354000e-03, 9.36908000e-02, -8.79486000e-02,
+    3.60160000e-03, -9.16079800e-04, -4.91578900e-03,
+    4.37271970e-03, 1.28874200e-01, 1.04753110e-02,
+    1.57200330e-03,
+    // r = 2.60
+    8.28000000e-02, -8.10230000e-02, 5.24000000e-03,
+    -3.86200000e-03, -3.03670000e-03, 3.42010000e-03,
+    2.65000000e-03, -4.62100000e-04, 1.04000000e-02,
+    -1.16880000e-03, 8.94920000e-02, -8.38270000e-02,
+    3.48418000e-03, -8.67899800e-04, -4.76101700e-03,
+    4.16079970e-03, 1.22971000e-01, 1.01933110e-02,
+    1.52000330e-03,
+    // r = 2.61
+    7.97480000e-02, -7.79890000e-02, 5.07000000e-03,
+    -3.71980000e-03, -2.90800000e-03, 3.28290000e-03,
+    2.56600000e-03, -4.41800000e-04, 1.00340000e-02,
+    -1.13080000e-03, 8.62242000e-02, -8.06354000e-02,
+    3.38778000e-03, -8.32400000e-04, -4.62923500e-03,
+    3.99638170e-03, 1.18376000e-01, 9.95064900e-03,
+    1.47711330e-03,
+    // r = 2.62
+    7.66960000e-02, -7.49550000e-02, 4.90000000e-03,
+    -3.57760000e-03, -2.77930000e-03, 3.14570000e-03,
+    2.48200000e-03, -4.21500000e-04, 9.66800000e-03,
+    -1.09280000e-03, 8.29564000e-02, -7.74438000e-02,
+    3.29138000e-03, -7.96900200e-04, -4.49745300e-03,
+    3.83196370e-03, 1.13781000e-01, 9.70798700e-03,
+    1.43422330e-03,
+    // r = 2.63
+    7.36440000e-02, -7.19210000e-02, 4.73000000e-03,
+    -3.43540000e-03, -2.65060000e-03, 3.00850000e-03,
+    2.39800000e-03, -4.01200000e-04, 9.30200000e-03,
+    -1.05480000e-03, 7.96886000e-02, -7.42522000e-02,
+    3.19498000e-03, -7.61400400e-04, -4.36567100e-03,
+    3.66754570e-03, 1.09186000e-01, 9.46532500e-03,
+    1.39133330e-03,
+    // r = 2.64
+    7.05920000e-02, -6.88870000e-02, 4.56000000e-03,
+    -3.29320000e-03, -2.52190000e-03, 2.87130000e-03,
+    2.31400000e-03, -3.80900000e-04, 8.93600000e-03,
+    -1.01680000e-03, 7.64208000e-02, -7.10606000e-02,
+    3.09858000e-03, -7.25900600e-04, -4.23388900e-03,
+    3.50312770e-03, 1.04591000e-01, 9.22266300e-03,
+    1.34844330e-03,
+    // r = 2.65
+    6.75400000e-02, -6.58530000e-02, 4.39000000e-03,
+    -3.15100000e-03, -2.39320000e-03, 2.73410000e-03,
+    2.23000000e-03, -3.60600000e-04, 8.57000000e-03,
+    -9.78800000e-04, 7.31530000e-02, -6.78690000e-02,
+    3.00218000e-03, -6.90400800e-04, -4.10210700e-03,
+    3.33870970e-03, 9.99960000e-02, 8.98000100e-03,
+    1.30555330e-03,
+    // r = 2.66
+    6.51440000e-02, -6.34736000e-02, 4.25400000e-03,
+    -3.03940000e-03, -2.29422000e-03, 2.62750000e-03,
+    2.16000000e-03, -3.45120000e-04, 8.27800000e-03,
+    -9.46820000e-04, 7.05770000e-02, -6.53678000e-02,
+    2.92188000e-03, -6.63761000e-04, -3.98964100e-03,
+    3.20994770e-03, 9.63790200e-02, 8.76777900e-03,
+    1.26710930e-03,
+    // r = 2.67
+    6.27480000e-02, -6.10942000e-02, 4.11800000e-03,
+    -2.92780000e-03, -2.19524000e-03, 2.52090000e-03,
+    2.09000000e-03, -3.29640000e-04, 7.98600000e-03,
+    -9.14840000e-04, 6.80010000e-02, -6.28666000e-02,
+    2.84158000e-03, -6.37121200e-04, -3.87717500e-03,
+    3.08118570e-03, 9.27620400e-02, 8.55555700e-03,
+    1.22866530e-03,
+    // r = 2.68
+    6.03520000e-02, -5.87148000e-02, 3.98200000e-03,
+    -2.81620000e-03, -2.09626000e-03, 2.41430000e-03,
+    2.02000000e-03, -3.14160000e-04, 7.69400000e-03,
+    -8.82860000e-04, 6.54250000e-02, -6.03654000e-02,
+    2.76128000e-03, -6.10481400e-04, -3.76470900e-03,
+    2.95242370e-03, 8.91450600e-02, 8.34333500e-03,
+    1.19022130e-03,
+    // r = 2.69
+    5.79560000e-02, -5.63354000e-02, 3.84600000e-03,
+    -2.70460000e-03, -1.99728000e-03, 2.30770000e-03,
+    1.95000000e-03, -2.98680000e-04, 7.40200000e-03,
+    -8.50880000e-04, 6.28490000e-02, -5.78642000e-02,
+    2.68098000e-03, -5.83841600e-04, -3.65224300e-03,
+    2.82366170e-03, 8.55280800e-02, 8.13111300e-03,
+    1.15177730e-03,
+    // r = 2.70
+    5.55600000e-02, -5.39560000e-02, 3.71000000e-03,
+    -2.59300000e-03, -1.89830000e-03, 2.20110000e-03,
+    1.88000000e-03, -2.83200000e-04, 7.11000000e-03,
+    -8.18900000e-04, 6.02730000e-02, -5.53630000e-02,
+    2.60068000e-03, -5.57201800e-04, -3.53977700e-03,
+    2.69489970e-03, 8.19111000e-02, 7.91889100e-03,
+    1.11333330e-03,
+    // r = 2.71
+    5.36540000e-02, -5.20686000e-02, 3.59800000e-03,
+    -2.50420000e-03, -1.82146000e-03, 2.11750000e-03,
+    1.82200000e-03, -2.71320000e-04, 6.87200000e-03,
+    -7.92100000e-04, 5.82192000e-02, -5.33812000e-02,
+    2.53308000e-03, -5.36881400e-04, -3.44357300e-03,
+    2.59327970e-03, 7.90302200e-02, 7.73444700e-03,
+    1.08244530e-03,
+    // r = 2.72
+    5.17480000e-02, -5.01812000e-02, 3.48600000e-03,
+    -2.41540000e-03, -1.74462000e-03, 2.03390000e-03,
+    1.76400000e-03, -2.59440000e-04, 6.63400000e-03,
+    -7.65300000e-04, 5.61654000e-02, -5.13994000e-02,
+    2.46548000e-03, -5.16561000e-04, -3.34736900e-03,
+    2.49165970e-03, 7.61493400e-02, 7.55000300e-03,
+    1.05155730e-03,
+    // r = 2.73
+    4.98420000e-02, -4.82938000e-02, 3.37400000e-03,
+    -2.32660000e-03, -1.66778000e-03, 1.95030000e-03,
+    1.70600000e-03, -2.47560000e-04, 6.39600000e-03,
+    -7.38500000e-04, 5.41116000e-02, -4.94176000e-02,
+    2.39788000e-03, -4.96240600e-04, -3.25116500e-03,
+    2.39003970e-03, 7.32684600e-02, 7.36555900e-03,
+    1.02066930e-03,
+    // r = 2.74
+    4.79360000e-02, -4.64064000e-02, 3.26200000e-03,
+    -2.23780000e-03, -1.59094000e-03, 1.86670000e-03,
+    1.64800000e-03, -2.35680000e-04, 6.15800000e-03,
+    -7.11700000e-04, 5.20578000e-02, -4.74358000e-02,
+    2.33028000e-03, -4.75920200e-04, -3.15496100e-03,
+    2.28841970e-03, 7.03875800e-02, 7.18111500e-03,
+    9.89781300e-04,
+    // r = 2.75
+    4.60300000e-02, -4.45190000e-02, 3.15000000e-03,
+    -2.14900000e-03, -1.51410000e-03, 1.78310000e-03,
+    1.59000000e-03, -2.23800000e-04, 5.92000000e-03,
+    -6.84900000e-04, 5.00040000e-02, -4.54540000e-02,
+    2.26268000e-03, -4.55599800e-04, -3.05875700e-03,
+    2.18679970e-03, 6.75067000e-02, 6.99667100e-03,
+    9.58893300e-04,
+    // r = 2.76
+    4.45000000e-02, -4.30064000e-02, 3.06000000e-03,
+    -2.07760000e-03, -1.45398000e-03, 1.71690000e-03,
+    1.54000000e-03, -2.14600000e-04, 5.72600000e-03,
+    -6.62520000e-04, 4.83498000e-02, -4.38694000e-02,
+    2.20518000e-03, -4.39839600e-04, -2.97625500e-03,
+    2.10593970e-03, 6.51947000e-02, 6.83333700e-03,
+    9.31781300e-04,
+    // r = 2.77
+    4.29700000e-02, -4.14938000e-02, 2.97000000e-03,
+    -2.00620000e-03, -1.39386000e-03, 1.65070000e-03,
+    1.49000000e-03, -2.05400000e-04, 5.53200000e-03,
+    -6.40140000e-04, 4.66956000e-02, -4.22848000e-02,
+    2.14768000e-03, -4.24079400e-04, -2.89375300e-03,
+    2.02507970e-03, 6.28827000e-02, 6.67000300e-03,
+    9.04669300e-04,
+    // r = 2.78
+    4.14400000e-02, -3.99812000e-02, 2.88000000e-03,
+    -1.93480000e-03, -1.33374000e-03, 1.58450000e-03,
+    1.44000000e-03, -1.96200000e-04, 5.33800000e-03,
+    -6.17760000e-04, 4.50414000e-02, -4.07002000e-02,
+    2.09018000e-03, -4.08319200e-04, -2.81125100e-03,
+    1.94421970e-03, 6.05707000e-02, 6.50666900e-03,
+    8.77557300e-04,
+    // r = 2.79
+    3.99100000e-02, -3.84686000e-02, 2.79000000e-03,
+    -1.86340000e-03, -1.27362000e-03, 1.51830000e-03,
+    1.39000000e-03, -1.87000000e-04, 5.14400000e-03,
+    -5.95380000e-04, 4.33872000e-02, -3.91156000e-02,
+    2.03268000e-03, -3.92559000e-04, -2.72874900e-03,
+    1.86335970e-03, 5.82587000e-02, 6.34333500e-03,
+    8.50445300e-04,
+    // r = 2.80
+    3.83800000e-02, -3.69560000e-02, 2.70000000e-03,
+    -1.79200000e-03, -1.21350000e-03, 1.45210000e-03,
+    1.34000000e-03, -1.77800000e-04, 4.95000000e-03,
+    -5.73000000e-04, 4.17330000e-02, -3.75310000e-02,
+    1.97518000e-03, -3.76798800e-04, -2.64624700e-03,
+    1.78249970e-03, 5.59467000e-02, 6.18000100e-03,
+    8.23333300e-04,
+    // r = 2.81
+    3.71380000e-02, -3.57328000e-02, 2.62400000e-03,
+    -1.73420000e-03, -1.16610000e-03, 1.39950000e-03,
+    1.30000000e-03, -1.70620000e-04, 4.79400000e-03,
+    -5.54320000e-04, 4.03886000e-02, -3.62532000e-02,
+    1.92584000e-03, -3.64379000e-04, -2.57532900e-03,
+    1.71783770e-03, 5.40755800e-02, 6.03644500e-03,
+    8.00444500e-04,
+    // r = 2.82
+    3.58960000e-02, -3.45096000e-02, 2.54800000e-03,
+    -1.67640000e-03, -1.11870000e-03, 1.34690000e-03,
+    1.26000000e-03, -1.63440000e-04, 4.63800000e-03,
+    -5.35640000e-04, 3.90442000e-02, -3.49754000e-02,
+    1.87650000e-03, -3.51959200e-04, -2.50441100e-03,
+    1.65317570e-03, 5.22044600e-02, 5.89288900e-03,
+    7.77555700e-04,
+    // r = 2.83
+    3.46540000e-02, -3.32864000e-02, 2.47200000e-03,
+    -1.61860000e-03, -1.07130000e-03, 1.29430000e-03,
+    1.22000000e-03, -1.56260000e-04, 4.48200000e-03,
+    -5.16960000e-04, 3.76998000e-02, -3.36976000e-02,
+    1.82716000e-03, -3.39539400e-04, -2.43349300e-03,
+    1.58851370e-03, 5.03333400e-02, 5.74933300e-03,
+    7.54666900e-04,
+    // r = 2.84
+    3.34120000e-02, -3.20632000e-02, 2.39600000e-03,
+    -1.56080000e-03, -1.02390000e-03, 1.24170000e-03,
+    1.18000000e-03, -1.49080000e-04, 4.32600000e-03,
+    -4.98280000e-04, 3.63554000e-02, -3.24198000e-02,
+    1.77782000e-03, -3.27119600e-04, -2.36257500e-03,
+    1.52385170e-03, 4.84622200e-02, 5.60577700e-03,
+    7.31778100e-04,
+    // r = 2.85
+    3.21700000e-02, -3.08400000e-02, 2.32000000e-03,
+    -1.50300000e-03, -9.76500000e-04, 1.18910000e-03,
+    1.14000000e-03, -1.41900000e-04, 4.17000000e-03,
+    -4.79600000e-04, 3.50110000e-02, -3.11420000e-02,
+    1.72848000e-03, -3.14699800e-04, -2.29165700e-03,
+    1.45918970e-03, 4.65911000e-02, 5.46222100e-03,
+    7.08889300e-04,
+    // r = 2.86
+    3.11560000e-02, -2.98426000e-02, 2.25600000e-03,
+    -1.45580000e-03, -9.38920000e-04, 1.14690000e-03,
+    1.10600000e-03, -1.36300000e-04, 4.04000000e-03,
+    -4.64000000e-04, 3.39092000e-02, -3.01036000e-02,
+    1.68588000e-03, -3.04779800e-04, -2.23054300e-03,
+    1.40711170e-03, 4.50637600e-02, 5.33599900e-03,
+    6.90222500e-04,
+    // r = 2.87
+    3.01420000e-02, -2.88452000e-02, 2.19200000e-03,
+    -1.40860000e-03, -9.01340000e-04, 1.10470000e-03,
+    1.07200000e-03, -1.30700000e-04, 3.91000000e-03,
+    -4.48400000e-04, 3.28074000e-02, -2.90652000e-02,
+    1.64328000e-03, -2.94859800e-04, -2.16942900e-03,
+    1.35503370e-03, 4.35364200e-02, 5.20977700e-03,
+    6.71555700e-04,
+    // r = 2.88
+    2.91280000e-02, -2.78478000e-02, 2.12800000e-03,
+    -1.36140000e-03, -8.63760000e-04, 1.06250000e-03,
+    1.03800000e-03, -1.25100000e-04, 3.78000000e-03,
+    -4.32800000e-04, 3.17056000e-02, -2.80268000e-02,
+    1.60068000e-03, -2.84939800e-04, -2.10831500e-03,
+    1.30295570e-03, 4.20090800e-02, 5.08355500e-03,
+    6.52888900e-04,
+    // r = 2.89
+    2.81140000e-02, -2.68504000e-02, 2.06400000e-03,
+    -1.31420000e-03, -8.26180000e-04, 1.02030000e-03,
+    1.00400000e-03, -1.19500000e-04, 3.65000000e-03,
+    -4.17200000e-04, 3.06038000e-02, -2.69884000e-02,
+    1.55808000e-03, -2.75019800e-04, -2.04720100e-03,
+    1.25087770e-03, 4.04817400e-02, 4.95733300e-03,
+    6.34222100e-04,
+    // r = 2.90
+    2.71000000e-02, -2.58530000e-02, 2.00000000e-03,
+    -1.26700000e-03, -7.88600000e-04, 9.78100000e-04,
+    9.70000000e-04, -1.13900000e-04, 3.52000000e-03,
+    -4.01600000e-04, 2.95020000e-02, -2.59500000e-02,
+    1.51548000e-03, -2.65099800e-04, -1.98608700e-03,
+    1.19879970e-03, 3.89544000e-02, 4.83111100e-03,
+    6.15555300e-04,
+    // r = 2.91
+    2.62640000e-02, -2.50338000e-02, 1.94600000e-03,
+    -1.22780000e-03, -7.58620000e-04, 9.43900000e-04,
+    9.42000000e-04, -1.09460000e-04, 3.41000000e-03,
+    -3.88580000e-04, 2.85922000e-02, -2.51004000e-02,
+    1.47848000e-03, -2.57059800e-04, -1.93330100e-03,
+    1.15661970e-03, 3.76986400e-02, 4.71733300e-03,
+    5.99110900e-04,
+    // r = 2.92
+    2.54280000e-02, -2.42146000e-02, 1.89200000e-03,
+    -1.18860000e-03, -7.28640000e-04, 9.09700000e-04,
+    9.14000000e-04, -1.05020000e-04, 3.30000000e-03,
+    -3.75560000e-04, 2.76824000e-02, -2.42508000e-02,
+    1.44148000e-03, -2.49019800e-04, -1.88051500e-03,
+    1.11443970e-03, 3.64428800e-02, 4.60355500e-03,
+    5.82666500e-04,
+    // r = 2.93
+    2.45920000e-02, -2.33954000e-02, 1.83800000e-03,
+    -1.14940000e-03, -6.98660000e-04, 8.75500000e-04,
+    8.86000000e-04, -1.00580000e-04, 3.19000000e-03,
+    -3.62540000e-04, 2.67726000e-02, -2.34012000e-02,
+    1.40448000e-03, -2.40979800e-04, -1.82772900e-03,
+    1.07225970e-03, 3.51871200e-02, 4.48977700e-03,
+    5.66222100e-04,
+    // r = 2.94
+    2.37560000e-02, -2.25762000e-02, 1.78400000e-03,
+    -1.11020000e-03, -6.68680000e-04, 8.41300000e-04,
+    8.58000000e-04, -9.61400000e-05, 3.08000000e-03,
+    -3.49520000e-04, 2.58628000e-02, -2.25516000e-02,
+    1.36748000e-03, -2.32939800e-04, -1.77494300e-03,
+    1.03007970e-03, 3.39313600e-02, 4.37599900e-03,
+    5.49777700e-04,
+    // r = 2.95
+    2.29200000e-02, -2.17570000e-02, 1.73000000e-03,
+    -1.07100000e-03, -6.38700000e-04, 8.07100000e-04,
+    8.30000000e-04, -9.17000000e-05, 2.97000000e-03,
+    -3.36500000e-04, 2.49530000e-02, -2.17020000e-02,
+    1.33048000e-03, -2.24899800e-04, -1.72215700e-03,
+    9.87899700e-04, 3.26756000e-02, 4.26222100e-03,
+    5.33333300e-04,
+    // r = 2.96
+    2.22260000e-02, -2.10792000e-02, 1.68400000e-03,
+    -1.03880000e-03, -6.14680000e-04, 7.79300000e-04,
+    8.08000000e-04, -8.81800000e-05, 2.87800000e-03,
+    -3.25660000e-04, 2.41966000e-02, -2.10028000e-02,
+    1.29814000e-03, -2.18299800e-04, -1.67646300e-03,
+    9.53599900e-04, 3.16396000e-02, 4.16155500e-03,
+    5.18444500e-04,
+    // r = 2.97
+    2.15320000e-02, -2.04014000e-02, 1.63800000e-03,
+    -1.00660000e-03, -5.90660000e-04, 7.51500000e-04,
+    7.86000000e-04, -8.46600000e-05, 2.78600000e-03,
+    -3.14820000e-04, 2.34402000e-02, -2.03036000e-02,
+    1.26580000e-03, -2.11699800e-04, -1.63076900e-03,
+    9.19300100e-04, 3.06036000e-02, 4.06088900e-03,
+    5.03555700e-04,
+    // r = 2.98
+    2.08380000e-02, -1.97236000e-02, 1.59200000e-03,
+    -9.74400000e-04, -5.66640000e-04, 7.23700000e-04,
+    7.64000000e-04, -8.11400000e-05, 2.69400000e-03,
+    -3.03980000e-04, 2.26838000e-02, -1.96044000e-02,
+    1.23346000e-03, -2.05099800e-04, -1.58507500e-03,
+    8.85000300e-04, 2.95676000e-02, 3.96022300e-03,
+    4.88666900e-04,
+    // r = 2.99
+    2.01440000e-02, -1.90458000e-02, 1.54600000e-03,
+    -9.42200000e-04, -5.42620000e-04, 6.95900000e-04,
+    7.42000000e-04, -7.76200000e-05, 2.60200000e-03,
+    -2.93140000e-04, 2.19274000e-02, -1.89052000e-02,
+    1.20112000e-03, -1.98499800e-04, -1.53938100e-03,
+    8.50700500e-04, 2.85316000e-02, 3.85955700e-03,
+    4.73778100e-04,
+    // r = 3.00
+    1.94500000e-02, -1.83680000e-02, 1.50000000e-03,
+    -9.10000000e-04, -5.18600000e-04, 6.68100000e-04,
+    7.20000000e-04, -7.41000000e-05, 2.51000000e-03,
+    -2.82300000e-04, 2.11710000e-02, -1.82060000e-02,
+    1.16878000e-03, -1.91899800e-04, -1.49368700e-03,
+    8.16400700e-04, 2.74956000e-02, 3.75889100e-03,
+    4.58889300e-04,
+    // r = 3.01
+    1.88700000e-02, -1.78038000e-02, 1.46000000e-03,
+    -8.82800000e-04, -4.99260000e-04, 6.45500000e-04,
+    6.98000000e-04, -7.13000000e-05, 2.43600000e-03,
+    -2.73220000e-04, 2.05384000e-02, -1.76268000e-02,
+    1.14043800e-03, -1.86399800e-04, -1.45403900e-03,
+    7.88380700e-04, 2.66347000e-02, 3.66955700e-03,
+    4.47333700e-04,
+    // r = 3.02
+    1.82900000e-02, -1.72396000e-02, 1.42000000e-03,
+    -8.55600000e-04, -4.79920000e-04, 6.22900000e-04,
+    6.76000000e-04, -6.85000000e-05, 2.36200000e-03,
+    -2.64140000e-04, 1.99058000e-02, -1.70476000e-02,
+    1.11209600e-03, -1.80899800e-04, -1.41439100e-03,
+    7.60360700e-04, 2.57738000e-02, 3.58022300e-03,
+    4.35778100e-04,
+    // r = 3.03
+    1.77100000e-02, -1.66754000e-02, 1.38000000e-03,
+    -8.28400000e-04, -4.60580000e-04, 6.00300000e-04,
+    6.54000000e-04, -6.57000000e-05, 2.28800000e-03,
+    -2.55060000e-04, 1.92732000e-02, -1.64684000e-02,
+    1.08375400e-03, -1.75399800e-04, -1.37474300e-03,
+    7.32340700e-04, 2.49129000e-02, 3.49088900e-03,
+    4.24222500e-04,
+    // r = 3.04
+    1.71300000e-02, -1.61112000e-02, 1.34000000e-03,
+    -8.01200000e-04, -4.41240000e-04, 5.77700000e-04,
+    6.32000000e-04, -6.29000000e-05, 2.21400000e-03,
+    -2.45980000e-04, 1.86406000e-02, -1.58892000e-02,
+    1.05541200e-03, -1.69899800e-04, -1.33509500e-03,
+    7.04320700e-04, 2.40520000e-02, 3.40155500e-03,
+    4.12666900e-04,
+    // r = 3.05
+    1.65500000e-02, -1.55470000e-02, 1.30000000e-03,
+    -7.74000000e-04, -4.21900000e-04, 5.55100000e-04,
+    6.10000000e-04, -6.01000000e-05, 2.14000000e-03,
+    -2.36900000e-04, 1.80080000e-02, -1.53100000e-02,
+    1.02707000e-03, -1.64399800e-04, -1.29544700e-03,
+    6.76300700e-04, 2.31911000e-02, 3.31222100e-03,
+    4.01111300e-04,
+    // r = 3.06
+    1.60580000e-02, -1.50690000e-02, 1.26600000e-03,
+    -7.51200000e-04, -4.06240000e-04, 5.36500000e-04,
+    5.92000000e-04, -5.78400000e-05, 2.07600000e-03,
+    -2.29260000e-04, 1.74756000e-02, -1.48278000e-02,
+    1.00210800e-03, -1.59819400e-04, -1.26097500e-03,
+    6.53280500e-04, 2.24715400e-02, 3.23333300e-03,
+    3.90000100e-04,
+    // r = 3.07
+    1.55660000e-02, -1.45910000e-02, 1.23200000e-03,
+    -7.28400000e-04, -3.90580000e-04, 5.17900000e-04,
+    5.74000000e-04, -5.55800000e-05, 2.01200000e-03,
+    -2.21620000e-04, 1.69432000e-02, -1.43456000e-02,
+    9.77146000e-04, -1.55239000e-04, -1.22650300e-03,
+    6.30260300e-04, 2.17519800e-02, 3.15444500e-03,
+    3.78888900e-04,
+    // r = 3.08
+    1.50740000e-02, -1.41130000e-02, 1.19800000e-03,
+    -7.05600000e-04, -3.74920000e-04, 4.99300000e-04,
+    5.56000000e-04, -5.33200000e-05, 1.94800000e-03,
+    -2.13980000e-04, 1.64108000e-02, -1.38634000e-02,
+    9.52184000e-04, -1.50658600e-04, -1.19203100e-03,
+    6.07240100e-04, 2.10324200e-02, 3.07555700e-03,
+    3.67777700e-04,
+    // r = 3.09
+    1.45820000e-02, -1.36350000e-02, 1.16400000e-03,
+    -6.82800000e-04, -3.59260000e-04, 4.80700000e-04,
+    5.38000000e-04, -5.10600000e-05, 1.88400000e-03,
+    -2.06340000e-04, 1.58784000e-02, -1.33812000e-02,
+    9.27222000e-04, -1.46078200e-04, -1.15755900e-03,
+    5.84219900e-04, 2.03128600e-02, 2.99666900e-03,
+    3.56666500e-04,
+    // r = 3.10
+    1.40900000e-02, -1.31570000e-02, 1.13000000e-03,
+    -6.60000000e-04, -3.43600000e-04, 4.62100000e-04,
+    5.20000000e-04, -4.88000000e-05, 1.82000000e-03,
+    -1.98700000e-04, 1.53460000e-02, -1.28990000e-02,
+    9.02260000e-04, -1.41497800e-04, -1.12308700e-03,
+    5.61199700e-04, 1.95933000e-02, 2.91778100e-03,
+    3.45555300e-04,
+    // r = 3.11
+    1.36760000e-02, -1.27606000e-02, 1.10200000e-03,
+    -6.40600000e-04, -3.30900000e-04, 4.46700000e-04,
+    5.04000000e-04, -4.69800000e-05, 1.76600000e-03,
+    -1.92320000e-04, 1.48956000e-02, -1.24956000e-02,
+    8.80218000e-04, -1.37578200e-04, -1.09305300e-03,
+    5.42219500e-04, 1.89908600e-02, 2.84711300e-03,
+    3.36222100e-04,
+    // r = 3.12
+    1.32620000e-02, -1.23642000e-02, 1.07400000e-03,
+    -6.21200000e-04, -3.18200000e-04, 4.31300000e-04,
+    4.88000000e-04, -4.51600000e-05, 1.71200000e-03,
+    -1.85940000e-04, 1.44452000e-02, -1.20922000e-02,
+    8.58176000e-04, -1.33658600e-04, -1.06301900e-03,
+    5.23239300e-04, 1.83884200e-02, 2.77644500e-03,
+    3.26888900e-04,
+    // r = 3.13
+    1.28480000e-02, -1.19678000e-02, 1.04600000e-03,
+    -6.01800000e-04, -3.05500000e-04, 4.15900000e-04,
+    4.72000000e-04, -4.33400000e-05, 1.65800000e-03,
+    -1.79560000e-04, 1.39948000e-02, -1.16888000e-02,
+    8.36134000e-04, -1.29739000e-04, -1.03298500e-03,
+    5.04259100e-04, 1.77859800e-02, 2.70577700e-03,
+    3.17555700e-04,
+    // r = 3.14
+    1.24340000e-02, -1.15714000e-02, 1.01800000e-03,
+    -5.82400000e-04, -2.92800000e-04, 4.00500000e-04,
+    4.56000000e-04, -4.15200000e-05, 1.60400000e-03,
+    -1.73180000e-04, 1.35444000e-02, -1.12854000e-02,
+    8.14092000e-04, -1.25819400e-04, -1.00295100e-03,
+    4.85278900e-04, 1.71835400e-02, 2.63510900e-03,
+    3.08222500e-04,
+    // r = 3.15
+    1.20200000e-02, -1.11750000e-02, 9.90000000e-04,
+    -5.63000000e-04, -2.80100000e-04, 3.85100000e-04,
+    4.40000000e-04, -3.97000000e-05, 1.55000000e-03,
+    -1.66800000e-04, 1.30940000e-02, -1.08820000e-02,
+    7.92050000e-04, -1.21899800e-04, -9.72917000e-04,
+    4.66298700e-04, 1.65811000e-02, 2.56444100e-03,
+    2.98889300e-04,
+    // r = 3.16
+    1.16720000e-02, -1.08396000e-02, 9.64000000e-04,
+    -5.46800000e-04, -2.69780000e-04, 3.72300000e-04,
+    4.28000000e-04, -3.82600000e-05, 1.50400000e-03,
+    -1.61440000e-04, 1.27108000e-02, -1.05430000e-02,
+    7.72504000e-04, -1.18579800e-04, -9.46695000e-04,
+    4.50579300e-04, 1.60717600e-02, 2.50044100e-03,
+    2.90000300e-04,
+    // r = 3.17
+    1.13240000e-02, -1.05042000e-02, 9.38000000e-04,
+    -5.30600000e-04, -2.59460000e-04, 3.59500000e-04,
+    4.16000000e-04, -3.68200000e-05, 1.45800000e-03,
+    -1.56080000e-04, 1.23276000e-02, -1.02040000e-02,
+    7.52958000e-04, -1.15259800e-04, -9.20473000e-04,
+    4.34859900e-04, 1.55624200e-02, 2.43644100e-03,
+    2.81111300e-04,
+    // r = 3.18
+    1.09760000e-02, -1.01688000e-02, 9.12000000e-04,
+    -5.14400000e-04, -2.49140000e-04, 3.46700000e-04,
+    4.04000000e-04, -3.53800000e-05, 1.41200000e-03,
+    -1.50720000e-04, 1.19444000e-02, -9.86500000e-03,
+    7.33412000e-04, -1.11939800e-04, -8.94251000e-04,
+    4.19140500e-04, 1.50530800e-02, 2.37244100e-03,
+    2.72222300e-04,
+    // r = 3.19
+    1.06280000e-02, -9.83340000e-03, 8.86000000e-04,
+    -4.98200000e-04, -2.38820000e-04, 3.33900000e-04,
+    3.92000000e-04, -3.39400000e-05, 1.36600000e-03,
+    -1.45360000e-04, 1.15612000e-02, -9.52600000e-03,
+    7.13866000e-04, -1.08619800e-04, -8.68029000e-04,
+    4.03421100e-04, 1.45437400e-02, 2.30844100e-03,
+    2.63333300e-04,
+    // r = 3.20
+    1.02800000e-02, -9.49800000e-03, 8.60000000e-04,
+    -4.82000000e-04, -2.28500000e-04, 3.21100000e-04,
+    3.80000000e-04, -3.25000000e-05, 1.32000000e-03,
+    -1.40000000e-04, 1.11780000e-02, -9.18700000e-03,
+    6.94320000e-04, -1.05299800e-04, -8.41807000e-04,
+    3.87701700e-04, 1.40344000e-02, 2.24444100e-03,
+    2.54444300e-04,
+    // r = 3.21
+    9.98000000e-03, -9.21280000e-03, 8.36000000e-04,
+    -4.68000000e-04, -2.20040000e-04, 3.10500000e-04,
+    3.68000000e-04, -3.13000000e-05, 1.28000000e-03,
+    -1.35460000e-04, 1.08508000e-02, -8.90079600e-03,
+    6.76964000e-04, -1.02439600e-04, -8.18869600e-04,
+    3.74641700e-04, 1.36030800e-02, 2.18866300e-03,
+    2.47110900e-04,
+    // r = 3.22
+    9.68000000e-03, -8.92760000e-03, 8.12000000e-04,
+    -4.54000000e-04, -2.11580000e-04, 2.99900000e-04,
+    3.56000000e-04, -3.01000000e-05, 1.24000000e-03,
+    -1.30920000e-04, 1.05236000e-02, -8.61459200e-03,
+    6.59608000e-04, -9.95794000e-05, -7.95932200e-04,
+    3.61581700e-04, 1.31717600e-02, 2.13288500e-03,
+    2.39777500e-04,
+    // r = 3.23
+    9.38000000e-03, -8.64240000e-03, 7.88000000e-04,
+    -4.40000000e-04, -2.03120000e-04, 2.89300000e-04,
+    3.44000000e-04, -2.89000000e-05, 1.20000000e-03,
+    -1.26380000e-04, 1.01964000e-02, -8.32838800e-03,
+    6.42252000e-04, -9.67192000e-05, -7.72994800e-04,
+    3.48521700e-04, 1.27404400e-02, 2.07710700e-03,
+    2.32444100e-04,
+    // r = 3.24
+    9.08000000e-03, -8.35720000e-03, 7.64000000e-04,
+    -4.26000000e-04, -1.94660000e-04, 2.78700000e-04,
+    3.32000000e-04, -2.77000000e-05, 1.16000000e-03,
+    -1.21840000e-04, 9.86920000e-03, -8.04218400e-03,
+    6.24896000e-04, -9.38590000e-05, -7.50057400e-04,
+    3.35461700e-04, 1.23091200e-02, 2.02132900e-03,
+    2.25110700e-04,
+    // r = 3.25
+    8.78000000e-03, -8.07200000e-03, 7.40000000e-04,
+    -4.12000000e-04, -1.86200000e-04, 2.68100000e-04,
+    3.20000000e-04, -2.65000000e-05, 1.12000000e-03,
+    -1.17300000e-04, 9.54200000e-03, -7.75598000e-03,
+    6.07540000e-04, -9.09988000e-05, -7.27120000e-04,
+    3.22401700e-04, 1.18778000e-02, 1.96555100e-03,
+    2.17777300e-04,
+    // r = 3.26
+    8.52400000e-03, -7.82860000e-03, 7.22000000e-04,
+    -3.99800000e-04, -1.79300000e-04, 2.59080000e-04,
+    3.10000000e-04, -2.55400000e-05, 1.08600000e-03,
+    -1.13480000e-04, 9.26120000e-03, -7.51338200e-03,
+    5.92078000e-04, -8.84990000e-05, -7.07016800e-04,
+    3.11541700e-04, 1.15095800e-02, 1.91510700e-03,
+    2.12666300e-04,
+    // r = 3.27
+    8.26800000e-03, -7.58520000e-03, 7.04000000e-04,
+    -3.87600000e-04, -1.72400000e-04, 2.50060000e-04,
+    3.00000000e-04, -2.45800000e-05, 1.05200000e-03,
+    -1.09660000e-04, 8.98040000e-03, -7.27078400e-03,
+    5.76616000e-04, -8.59992000e-05, -6.86913600e-04,
+    3.00681700e-04, 1.11413600e-02, 1.86466300e-03,
+    2.07555300e-04,
+    // r = 3.28
+    8.01200000e-03, -7.34180000e-03, 6.86000000e-04,
+    -3.75400000e-04, -1.65500000e-04, 2.41040000e-04,
+    2.90000000e-04, -2.36200000e-05, 1.01800000e-03,
+    -1.05840000e-04, 8.69960000e-03, -7.02818600e-03,
+    5.61154000e-04, -8.34994000e-05, -6.66810400e-04,
+    2.89821700e-04, 1.07731400e-02, 1.81421900e-03,
+    2.02444300e-04,
+    // r = 3.29
+    7.75600000e-03, -7.09840000e-03, 6.68000000e-04,
+    -3.63200000e-04, -1.58600000e-04, 2.32020000e-04,
+    2.80000000e-04, -2.26600000e-05, 9.84000000e-04,
+    -1.02020000e-04, 8.41880000e-03, -6.78558800e-03,
+    5.45692000e-04, -8.09996000e-05, -6.46707200e-04,
+    2.78961700e-04, 1.04049200e-02, 1.76377500e-03,
+    1.97333300e-04,
+    // r = 3.30
+    7.50000000e-03, -6.85500000e-03, 6.50000000e-04,
+    -3.51000000e-04, -1.51700000e-04, 2.23000000e-04,
+    2.70000000e-04, -2.17000000e-05, 9.50000000e-04,
+    -9.82000000e-05, 8.13800000e-03, -6.54299000e-03,
+    5.30230000e-04, -7.84998000e-05, -6.26604000e-04,
+    2.68101700e-04, 1.00367000e-02, 1.71333100e-03,
+    1.92222300e-04,
+    // r = 3.31
+    7.27800000e-03, -6.64660000e-03, 6.32000000e-04,
+    -3.40800000e-04, -1.46020000e-04, 2.15540000e-04,
+    2.62000000e-04, -2.08800000e-05, 9.22000000e-04,
+    -9.49600000e-05, 7.89620200e-03, -6.33678800e-03,
+    5.16434000e-04, -7.63398800e-05, -6.08954600e-04,
+    2.58961300e-04, 9.72558000e-03, 1.66666500e-03,
+    1.86444500e-04,
+    // r = 3.32
+    7.05600000e-03, -6.43820000e-03, 6.14000000e-04,
+    -3.30600000e-04, -1.40340000e-04, 2.08080000e-04,
+    2.54000000e-04, -2.00600000e-05, 8.94000000e-04,
+    -9.17200000e-05, 7.65440400e-03, -6.13058600e-03,
+    5.02638000e-04, -7.41799600e-05, -5.91305200e-04,
+    2.49820900e-04, 9.41446000e-03, 1.61999900e-03,
+    1.80666700e-04,
+    // r = 3.33
+    6.83400000e-03, -6.22980000e-03, 5.96000000e-04,
+    -3.20400000e-04, -1.34660000e-04, 2.00620000e-04,
+    2.46000000e-04, -1.92400000e-05, 8.66000000e-04,
+    -8.84800000e-05, 7.41260600e-03, -5.92438400e-03,
+    4.88842000e-04, -7.20200400e-05, -5.73655800e-04,
+    2.40680500e-04, 9.10334000e-03, 1.57333300e-03,
+    1.74888900e-04,
+    // r = 3.34
+    6.61200000e-03, -6.02140000e-03, 5.78000000e-04,
+    -3.10200000e-04, -1.28980000e-04, 1.93160000e-04,
+    2.38000000e-04, -1.84200000e-05, 8.38000000e-04,
+    -8.52400000e-05, 7.17080800e-03, -5.71818200e-03,
+    4.75046000e-04, -6.98601200e-05, -5.56006400e-04,
+    2.31540100e-04, 8.79222000e-03, 1.52666700e-03,
+    1.69111100e-04,
+    // r = 3.35
+    6.39000000e-03, -5.81300000e-03, 5.60000000e-04,
+    -3.00000000e-04, -1.23300000e-04, 1.85700000e-04,
+    2.30000000e-04, -1.76000000e-05, 8.10000000e-04,
+    -8.20000000e-05, 6.92901000e-03, -5.51198000e-03,
+    4.61250000e-04, -6.77002000e-05, -5.38357000e-04,
+    2.22399700e-04, 8.48110000e-03, 1.48000100e-03,
+    1.63333300e-04,
+    // r = 3.36
+    6.19800000e-03, -5.63340000e-03, 5.46000000e-04,
+    -2.90800000e-04, -1.18620000e-04, 1.79420000e-04,
+    2.24000000e-04, -1.69600000e-05, 7.84000000e-04,
+    -7.92800000e-05, 6.71980800e-03, -5.33578600e-03,
+    4.48906000e-04, -6.57801800e-05, -5.22831600e-04,
+    2.14780100e-04, 8.21288000e-03, 1.44111100e-03,
+    1.59111100e-04,
+    // r = 3.37
+    6.00600000e-03, -5.45380000e-03, 5.32000000e-04,
+    -2.81600000e-04, -1.13940000e-04, 1.73140000e-04,
+    2.18000000e-04, -1.63200000e-05, 7.58000000e-04,
+    -7.65600000e-05, 6.51060600e-03, -5.15959200e-03,
+    4.36562000e-04, -6.38601600e-05, -5.07306200e-04,
+    2.07160500e-04, 7.94466000e-03, 1.40222100e-03,
+    1.54888900e-04,
+    // r = 3.38
+    5.81400000e-03, -5.27420000e-03, 5.18000000e-04,
+    -2.72400000e-04, -1.09260000e-04, 1.66860000e-04,
+    2.12000000e-04, -1.56800000e-05, 7.32000000e-04,
+    -7.38400000e-05, 6.30140400e-03, -4.98339800e-03,
+    4.24218000e-04, -6.19401400e-05, -4.91780800e-04,
+    1.99540900e-04, 7.67644000e-03, 1.36333100e-03,
+    1.50666700e-04,
+    // r = 3.39
+    5.62200000e-03, -5.09460000e-03, 5.04000000e-04,
+    -2.63200000e-04, -1.04580000e-04, 1.60580000e-04,
+    2.06000000e-04, -1.50400000e-05, 7.06000000e-04,
+    -7.11200000e-05, 6.09220200e-03, -4.80720400e-03,
+    4.11874000e-04, -6.00201200e-05, -4.76255400e-04,
+    1.91921300e-04, 7.40822000e-03, 1.32444100e-03,
+    1.46444500e-04,
+    // r = 3.40
+    5.43000000e-03, -4.91500000e-03, 4.90000000e-04,
+    -2.54000000e-04, -9.99000000e-05, 1.54300000e-04,
+    2.00000000e-04, -1.44000000e-05, 6.80000000e-04,
+    -6.84000000e-05, 5.88300000e-03, -4.63101000e-03,
+    3.99530000e-04, -5.81001000e-05, -4.60730000e-04,
+    1.84301700e-04, 7.14000000e-03, 1.28555100e-03,
+    1.42222300e-04,
+    // r = 3.41
+    5.26600000e-03, -4.76020000e-03, 4.74000000e-04,
+    -2.46200000e-04, -9.60600000e-05, 1.49000000e-04,
+    1.94000000e-04, -1.38600000e-05, 6.58000000e-04,
+    -6.60600000e-05, 5.70140000e-03, -4.48020800e-03,
+    3.88474000e-04, -5.64200000e-05, -4.47052800e-04,
+    1.77881500e-04, 6.90888800e-03, 1.24932900e-03,
+    1.38444500e-04,
+    // r = 3.42
+    5.10200000e-03, -4.60540000e-03, 4.58000000e-04,
+    -2.38400000e-04, -9.22200000e-05, 1.43700000e-04,
+    1.88000000e-04, -1.33200000e-05, 6.36000000e-04,
+    -6.37200000e-05, 5.51980000e-03, -4.32940600e-03,
+    3.77418000e-04, -5.47399000e-05, -4.33375600e-04,
+    1.71461300e-04, 6.67777600e-03, 1.21310700e-03,
+    1.34666700e-04,
+    // r = 3.43
+    4.93800000e-03, -4.45060000e-03, 4.42000000e-04,
+    -2.30600000e-04, -8.83800000e-05, 1.38400000e-04,
+    1.82000000e-04, -1.27800000e-05, 6.14000000e-04,
+    -6.13800000e-05, 5.33820000e-03, -4.17860400e-03,
+    3.66362000e-04, -5.30598000e-05, -4.19698400e-04,
+    1.65041100e-04, 6.44666400e-03, 1.17688500e-03,
+    1.30888900e-04,
+    // r = 3.44
+    4.77400000e-03, -4.29580000e-03, 4.26000000e-04,
+    -2.22800000e-04, -8.45400000e-05, 1.33100000e-04,
+    1.76000000e-04, -1.22400000e-05, 5.92000000e-04,
+    -5.90400000e-05, 5.15660000e-03, -4.02780200e-03,
+    3.55306000e-04, -5.13797000e-05, -4.06021200e-04,
+    1.58620900e-04, 6.21555200e-03, 1.14066300e-03,
+    1.27111100e-04,
+    // r = 3.45
+    4.61000000e-03, -4.14100000e-03, 4.10000000e-04,
+    -2.15000000e-04, -8.07000000e-05, 1.27800000e-04,
+    1.70000000e-04, -1.17000000e-05, 5.70000000e-04,
+    -5.67000000e-05, 4.97500000e-03, -3.87700000e-03,
+    3.44250000e-04, -4.96996000e-05, -3.92344000e-04,
+    1.52200700e-04, 5.98444000e-03, 1.10444100e-03,
+    1.23333300e-04,
+    // r = 3.46
+    4.46400000e-03, -4.00680000e-03, 3.98000000e-04,
+    -2.08400000e-04, -7.75200000e-05, 1.23300000e-04,
+    1.64000000e-04, -1.12600000e-05, 5.52000000e-04,
+    -5.47200000e-05, 4.81700000e-03, -3.74699800e-03,
+    3.34324000e-04, -4.82135800e-05, -3.80270400e-04,
+    1.46740100e-04, 5.78710800e-03, 1.07177500e-03,
+    1.18444500e-04,
+    // r = 3.47
+    4.31800000e-03, -3.87260000e-03, 3.86000000e-04,
+    -2.01800000e-04, -7.43400000e-05, 1.18800000e-04,
+    1.58000000e-04, -1.08200000e-05, 5.34000000e-04,
+    -5.27400000e-05, 4.65900000e-03, -3.61699600e-03,
+    3.24398000e-04, -4.67275600e-05, -3.68196800e-04,
+    1.41279500e-04, 5.58977600e-03, 1.03910900e-03,
+    1.13555700e-04,
+    // r = 3.48
+    4.17200000e-03, -3.73840000e-03, 3.74000000e-04,
+    -1.95200000e-04, -7.11600000e-05, 1.14300000e-04,
+    1.52000000e-04, -1.03800000e-05, 5.16000000e-04,
+    -5.07600000e-05, 4.50100000e-03, -3.48699400e-03,
+    3.14472000e-04, -4.52415400e-05, -3.56123200e-04,
+    1.35818900e-04, 5.39244400e-03, 1.00644300e-03,
+    1.08666900e-04,
+    // r = 3.49
+    4.02600000e-03, -3.60420000e-03, 3.62000000e-04,
+    -1.88600000e-04, -6.79800000e-05, 1.09800000e-04,
+    1.46000000e-04, -9.94000000e-06, 4.98000000e-04,
+    -4.87800000e-05, 4.34300000e-03, -3.35699200e-03,
+    3.04546000e-04, -4.37555200e-05, -3.44049600e-04,
+    1.30358300e-04, 5.19511200e-03, 9.73777000e-04,
+    1.03778100e-04,
+    // r = 3.50
+    3.88000000e-03, -3.47000000e-03, 3.50000000e-04,
+    -1.82000000e-04, -6.48000000e-05, 1.05300000e-04,
+    1.40000000e-04, -9.50000000e-06, 4.80000000e-04,
+    -4.68000000e-05, 4.18500000e-03, -3.22699000e-03,
+    2.94620000e-04, -4.22695000e-05, -3.31976000e-04,
+    1.24897700e-04, 4.99778000e-03, 9.41111000e-04,
+    9.88893000e-05,
+    // r = 3.51
+    3.75400000e-03, -3.35460000e-03, 3.40000000e-04,
+    -1.76000000e-04, -6.21600000e-05, 1.01460000e-04,
+    1.36000000e-04, -9.12000000e-06, 4.64000000e-04,
+    -4.51200000e-05, 4.04680000e-03, -3.11539400e-03,
+    2.85696000e-04, -4.09514800e-05, -3.21303200e-04,
+    1.20317900e-04, 4.82666800e-03, 9.10889000e-04,
+    9.71115000e-05,
+    // r = 3.52
+    3.62800000e-03, -3.23920000e-03, 3.30000000e-04,
+    -1.70000000e-04, -5.95200000e-05, 9.76200000e-05,
+    1.32000000e-04, -8.74000000e-06, 4.48000000e-04,
+    -4.34400000e-05, 3.90860000e-03, -3.00379800e-03,
+    2.76772000e-04, -3.96334600e-05, -3.10630400e-04,
+    1.15738100e-04, 4.65555600e-03, 8.80667000e-04,
+    9.53337000e-05,
+    // r = 3.53
+    3.50200000e-03, -3.12380000e-03, 3.20000000e-04,
+    -1.64000000e-04, -5.68800000e-05, 9.37800000e-05,
+    1.28000000e-04, -8.36000000e-06, 4.32000000e-04,
+    -4.17600000e-05, 3.77040000e-03, -2.89220200e-03,
+    2.67848000e-04, -3.83154400e-05, -2.99957600e-04,
+    1.11158300e-04, 4.48444400e-03, 8.50445000e-04,
+    9.35559000e-05,
+    // r = 3.54
+    3.37600000e-03, -3.00840000e-03, 3.10000000e-04,
+    -1.58000000e-04, -5.42400000e-05, 8.99400000e-05,
+    1.24000000e-04, -7.98000000e-06, 4.16000000e-04,
+    -4.00800000e-05, 3.63220000e-03, -2.78060600e-03,
+    2.58924000e-04, -3.69974200e-05, -2.89284800e-04,
+    1.06578500e-04, 4.31333200e-03, 8.20223000e-04,
+    9.17781000e-05,
+    // r = 3.55
+    3.25000000e-03, -2.89300000e-03, 3.00000000e-04,
+    -1.52000000e-04, -5.16000000e-05, 8.61000000e-05,
+    1.20000000e-04, -7.60000000e-06, 4.00000000e-04,
+    -3.84000000e-05, 3.49400000e-03, -2.66901000e-03,
+    2.50000000e-04, -3.56794000e-05, -2.78612000e-04,
+    1.01998700e-04, 4.14222000e-03, 7.90001000e-04,
+    9.00003000e-05,
+    // r = 3.56
+    3.13800000e-03, -2.79100000e-03, 2.90000000e-04,
+    -1.46800000e-04, -4.94400000e-05, 8.28600000e-05,
+    1.14000000e-04, -7.30000000e-06, 3.84000000e-04,
+    -3.69600000e-05, 3.37280000e-03, -2.57240800e-03,
+    2.41966000e-04, -3.45115400e-05, -2.69161800e-04,
+    9.80991000e-05, 3.99244200e-03, 7.65557000e-04,
+    8.62225000e-05,
+    // r = 3.57
+    3.02600000e-03, -2.68900000e-03, 2.80000000e-04,
+    -1.41600000e-04, -4.72800000e-05, 7.96200000e-05,
+    1.08000000e-04, -7.00000000e-06, 3.68000000e-04,
+    -3.55200000e-05, 3.25160000e-03, -2.47580600e-03,
+    2.33932000e-04, -3.33436800e-05, -2.59711600e-04,
+    9.41995000e-05, 3.84266400e-03, 7.41113000e-04,
+    8.24447000e-05,
+    // r = 3.58
+    2.91400000e-03, -2.58700000e-03, 2.70000000e-04,
+    -1.36400000e-04, -4.51200000e-05, 7.63800000e-05,
+    1.02000000e-04, -6.70000000e-06, 3.52000000e-04,
+    -3.40800000e-05, 3.13040000e-03, -2.37920400e-03,
+    2.25898000e-04, -3.21758200e-05, -2.50261400e-04,
+    9.02999000e-05, 3.69288600e-03, 7.16669000e-04,
+    7.86669000e-05,
+    // r = 3.59
+    2.80200000e-03, -2.48500000e-03, 2.60000000e-04,
+    -1.31200000e-04, -4.29600000e-05, 7.31400000e-05,
+    9.60000000e-05, -6.40000000e-06, 3.36000000e-04,
+    -3.26400000e-05, 3.00920000e-03, -2.28260200e-03,
+    2.17864000e-04, -3.10079600e-05, -2.40811200e-04,
+    8.64003000e-05, 3.54310800e-03, 6.92225000e-04,
+    7.48891000e-05,
+    // r = 3.60
+    2.69000000e-03, -2.38300000e-03, 2.50000000e-04,
+    -1.26000000e-04, -4.08000000e-05, 6.99000000e-05,
+    9.00000000e-05, -6.10000000e-06, 3.20000000e-04,
+    -3.12000000e-05, 2.88800000e-03, -2.18600000e-03,
+    2.09830000e-04, -2.98401000e-05, -2.31361000e-04,
+    8.25007000e-05, 3.39333000e-03, 6.67781000e-04,
+    7.11113000e-05,
+    // r = 3.61
+    2.59200000e-03, -2.29400000e-03, 2.42000000e-04,
+    -1.21400000e-04, -3.90000000e-05, 6.71200000e-05,
+    8.80000000e-05, -5.84000000e-06, 3.10000000e-04,
+    -2.99600000e-05, 2.78158000e-03, -2.10200000e-03,
+    2.02584000e-04, -2.87800600e-05, -2.22980200e-04,
+    7.91605000e-05, 3.26355200e-03, 6.44447000e-04,
+    6.93335000e-05,
+    // r = 3.62
+    2.49400000e-03, -2.20500000e-03, 2.34000000e-04,
+    -1.16800000e-04, -3.72000000e-05, 6.43400000e-05,
+    8.60000000e-05, -5.58000000e-06, 3.00000000e-04,
+    -2.87200000e-05, 2.67516000e-03, -2.01800000e-03,
+    1.95338000e-04, -2.77200200e-05, -2.14599400e-04,
+    7.58203000e-05, 3.13377400e-03, 6.21113000e-04,
+    6.75557000e-05,
+    // r = 3.63
+    2.39600000e-03, -2.11600000e-03, 2.26000000e-04,
+    -1.12200000e-04, -3.54000000e-05, 6.15600000e-05,
+    8.40000000e-05, -5.32000000e-06, 2.90000000e-04,
+    -2.74800000e-05, 2.56874000e-03, -1.93400000e-03,
+    1.88092000e-04, -2.66599800e-05, -2.06218600e-04,
+    7.24801000e-05, 3.00399600e-03, 5.97779000e-04,
+    6.57779000e-05,
+    // r = 3.64
+    2.29800000e-03, -2.02700000e-03, 2.18000000e-04,
+    -1.07600000e-04, -3.36000000e-05, 5.87800000e-05,
+    8.20000000e-05, -5.06000000e-06, 2.80000000e-04,
+    -2.62400000e-05, 2.46232000e-03, -1.85000000e-03,
+    1.80846000e-04, -2.55999400e-05, -1.97837800e-04,
+    6.91399000e-05, 2.87421800e-03, 5.74445000e-04,
+    6.40001000e-05,
+    // r = 3.65
+    2.20000000e-03, -1.93800000e-03, 2.10000000e-04,
+    -1.03000000e-04, -3.18000000e-05, 5.60000000e-05,
+    8.00000000e-05, -4.80000000e-06, 2.70000000e-04,
+    -2.50000000e-05, 2.35590000e-03, -1.76600000e-03,
+    1.73600000e-04, -2.45399000e-05, -1.89457000e-04,
+    6.57997000e-05, 2.74444000e-03, 5.51111000e-04,
+    6.22223000e-05,
+    // r = 3.66
+    2.11400000e-03, -1.85980000e-03, 2.00000000e-04,
+    -9.88000000e-05, -3.03000000e-05, 5.36000000e-05,
+    7.80000000e-05, -4.58000000e-06, 2.58000000e-04,
+    -2.39400000e-05, 2.26198000e-03, -1.69319800e-03,
+    1.67056000e-04, -2.36058800e-05, -1.82013600e-04,
+    6.29595600e-05, 2.63221800e-03, 5.28445000e-04,
+    5.86667200e-05,
+    // r = 3.67
+    2.02800000e-03, -1.78160000e-03, 1.90000000e-04,
+    -9.46000000e-05, -2.88000000e-05, 5.12000000e-05,
+    7.60000000e-05, -4.36000000e-06, 2.46000000e-04,
+    -2.28800000e-05, 2.16806000e-03, -1.62039600e-03,
+    1.60512000e-04, -2.26718600e-05, -1.74570200e-04,
+    6.01194200e-05, 2.51999600e-03, 5.05779000e-04,
+    5.51111400e-05,
+    // r = 3.68
+    1.94200000e-03, -1.70340000e-03, 1.80000000e-04,
+    -9.04000000e-05, -2.73000000e-05, 4.88000000e-05,
+    7.40000000e-05, -4.14000000e-06, 2.34000000e-04,
+    -2.18200000e-05, 2.07414000e-03, -1.54759400e-03,
+    1.53968000e-04, -2.17378400e-05, -1.67126800e-04,
+    5.72792800e-05, 2.40777400e-03, 4.83113000e-04,
+    5.15555600e-05,
+    // r = 3.69
+    1.85600000e-03, -1.62520000e-03, 1.70000000e-04,
+    -8.62000000e-05, -2.58000000e-05, 4.64000000e-05,
+    7.20000000e-05, -3.92000000e-06, 2.22000000e-04,
+    -2.07600000e-05, 1.98022000e-03, -1.47479200e-03,
+    1.47424000e-04, -2.08038200e-05, -1.59683400e-04,
+    5.44391400e-05, 2.29555200e-03, 4.60447000e-04,
+    4.79999800e-05,
+    // r = 3.70
+    1.77000000e-03, -1.54700000e-03, 1.60000000e-04,
+    -8.20000000e-05, -2.43000000e-05, 4.40000000e-05,
+    7.00000000e-05, -3.70000000e-06, 2.10000000e-04,
+    -1.97000000e-05, 1.88630000e-03, -1.40199000e-03,
+    1.40880000e-04, -1.98698000e-05, -1.52240000e-04,
+    5.15990000e-05, 2.18333000e-03, 4.37781000e-04,
+    4.44444000e-05,
+    // r = 3.71
+    1.69200000e-03, -1.47840000e-03, 1.54000000e-04,
+    -7.84000000e-05, -2.30800000e-05, 4.19400000e-05,
+    6.60000000e-05, -3.54000000e-06, 2.00000000e-04,
+    -1.87800000e-05, 1.80340000e-03, -1.33859200e-03,
+    1.34964000e-04, -1.90277800e-05, -1.45619200e-04,
+    4.91790600e-05, 2.08333000e-03, 4.19335800e-04,
+    4.39999600e-05,
+    // r = 3.72
+    1.61400000e-03, -1.40980000e-03, 1.48000000e-04,
+    -7.48000000e-05, -2.18600000e-05, 3.98800000e-05,
+    6.20000000e-05, -3.38000000e-06, 1.90000000e-04,
+    -1.78600000e-05, 1.72050000e-03, -1.27519400e-03,
+    1.29048000e-04, -1.81857600e-05, -1.38998400e-04,
+    4.67591200e-05, 1.98333000e-03, 4.00890600e-04,
+    4.35555200e-05,
+    // r = 3.73
+    1.53600000e-03, -1.34120000e-03, 1.42000000e-04,
+    -7.12000000e-05, -2.06400000e-05, 3.78200000e-05,
+    5.80000000e-05, -3.22000000e-06, 1.80000000e-04,
+    -1.69400000e-05, 1.63760000e-03, -1.21179600e-03,
+    1.23132000e-04, -1.73437400e-05, -1.32377600e-04,
+    4.43391800e-05, 1.88333000e-03, 3.82445400e-04,
+    4.31110800e-05,
+    // r = 3.74
+    1.45800000e-03, -1.27260000e-03, 1.36000000e-04,
+    -6.76000000e-05, -1.94200000e-05, 3.57600000e-05,
+    5.40000000e-05, -3.06000000e-06, 1.70000000e-04,
+    -1.60200000e-05, 1.55470000e-03, -1.14839800e-03,
+    1.17216000e-04, -1.65017200e-05, -1.25756800e-04,
+    4.19192400e-05, 1.78333000e-03, 3.64000200e-04,
+    4.26666400e-05,
+    // r = 3.75
+    1.38000000e-03, -1.20400000e-03, 1.30000000e-04,
+    -6.40000000e-05, -1.82000000e-05, 3.37000000e-05,
+    5.00000000e-05, -2.90000000e-06, 1.60000000e-04,
+    -1.51000000e-05, 1.47180000e-03, -1.08500000e-03,
+    1.11300000e-04, -1.56597000e-05, -1.19136000e-04,
+    3.94993000e-05, 1.68333000e-03, 3.45555000e-04,
+    4.22222000e-05,
+    // r = 3.76
+    1.31200000e-03, -1.14340000e-03, 1.24000000e-04,
+    -6.08000000e-05, -1.71600000e-05, 3.19400000e-05,
+    4.60000000e-05, -2.74000000e-06, 1.52000000e-04,
+    -1.43200000e-05, 1.39844000e-03, -1.02960000e-03,
+    1.05944000e-04, -1.48957400e-05, -1.13238000e-04,
+    3.73993400e-05, 1.59933000e-03, 3.29110600e-04,
+    4.06666400e-05,
+    // r = 3.77
+    1.24400000e-03, -1.08280000e-03, 1.18000000e-04,
+    -5.76000000e-05, -1.61200000e-05, 3.01800000e-05,
+    4.20000000e-05, -2.58000000e-06, 1.44000000e-04,
+    -1.35400000e-05, 1.32508000e-03, -9.74200000e-04,
+    1.00588000e-04, -1.41317800e-05, -1.07340000e-04,
+    3.52993800e-05, 1.51533000e-03, 3.12666200e-04,
+    3.91110800e-05,
+    // r = 3.78
+    1.17600000e-03, -1.02220000e-03, 1.12000000e-04,
+    -5.44000000e-05, -1.50800000e-05, 2.84200000e-05,
+    3.80000000e-05, -2.42000000e-06, 1.36000000e-04,
+    -1.27600000e-05, 1.25172000e-03, -9.18800000e-04,
+    9.52320000e-05, -1.33678200e-05, -1.01442000e-04,
+    3.31994200e-05, 1.43133000e-03, 2.96221800e-04,
+    3.75555200e-05,
+    // r = 3.79
+    1.10800000e-03, -9.61600000e-04, 1.06000000e-04,
+    -5.12000000e-05, -1.40400000e-05, 2.66600000e-05,
+    3.40000000e-05, -2.26000000e-06, 1.28000000e-04,
+    -1.19800000e-05, 1.17836000e-03, -8.63400000e-04,
+    8.98760000e-05, -1.26038600e-05, -9.55440000e-05,
+    3.10994600e-05, 1.34733000e-03, 2.79777400e-04,
+    3.59999600e-05,
+    // r = 3.80
+    1.04000000e-03, -9.01000000e-04, 1.00000000e-04,
+    -4.80000000e-05, -1.30000000e-05, 2.49000000e-05,
+    3.00000000e-05, -2.10000000e-06, 1.20000000e-04,
+    -1.12000000e-05, 1.10500000e-03, -8.08000000e-04,
+    8.45200000e-05, -1.18399000e-05, -8.96460000e-05,
+    2.89995000e-05, 1.26333000e-03, 2.63333000e-04,
+    3.44444000e-05,
+    // r = 3.81
+    9.80000000e-04, -8.47600000e-04, 9.40000000e-05,
+    -4.52000000e-05, -1.21600000e-05, 2.33800000e-05,
+    3.00000000e-05, -1.96000000e-06, 1.12000000e-04,
+    -1.05200000e-05, 1.03986000e-03, -7.59602000e-04,
+    7.96660000e-05, -1.11559400e-05, -8.43848000e-05,
+    2.72195600e-05, 1.18844200e-03, 2.48444200e-04,
+    3.22221800e-05,
+    // r = 3.82
+    9.20000000e-04, -7.94200000e-04, 8.80000000e-05,
+    -4.24000000e-05, -1.13200000e-05, 2.18600000e-05,
+    3.00000000e-05, -1.82000000e-06, 1.04000000e-04,
+    -9.84000000e-06, 9.74720000e-04, -7.11204000e-04,
+    7.48120000e-05, -1.04719800e-05, -7.91236000e-05,
+    2.54396200e-05, 1.11355400e-03, 2.33555400e-04,
+    2.99999600e-05,
+    // r = 3.83
+    8.60000000e-04, -7.40800000e-04, 8.20000000e-05,
+    -3.96000000e-05, -1.04800000e-05, 2.03400000e-05,
+    3.00000000e-05, -1.68000000e-06, 9.60000000e-05,
+    -9.16000000e-06, 9.09580000e-04, -6.62806000e-04,
+    6.99580000e-05, -9.78802000e-06, -7.38624000e-05,
+    2.36596800e-05, 1.03866600e-03, 2.18666600e-04,
+    2.77777400e-05,
+    // r = 3.84
+    8.00000000e-04, -6.87400000e-04, 7.60000000e-05,
+    -3.68000000e-05, -9.64000000e-06, 1.88200000e-05,
+    3.00000000e-05, -1.54000000e-06, 8.80000000e-05,
+    -8.48000000e-06, 8.44440000e-04, -6.14408000e-04,
+    6.51040000e-05, -9.10406000e-06, -6.86012000e-05,
+    2.18797400e-05, 9.63778000e-04, 2.03777800e-04,
+    2.55555200e-05,
+    // r = 3.85
+    7.40000000e-04, -6.34000000e-04, 7.00000000e-05,
+    -3.40000000e-05, -8.80000000e-06, 1.73000000e-05,
+    3.00000000e-05, -1.40000000e-06, 8.00000000e-05,
+    -7.80000000e-06, 7.79300000e-04, -5.66010000e-04,
+    6.02500000e-05, -8.42010000e-06, -6.33400000e-05,
+    2.00998000e-05, 8.88890000e-04, 1.88889000e-04,
+    2.33333000e-05,
+    // r = 3.86
+    6.84000000e-04, -5.86600000e-04, 6.40000000e-05,
+    -3.14000000e-05, -8.10000000e-06, 1.59800000e-05,
+    2.80000000e-05, -1.30000000e-06, 7.40000000e-05,
+    -7.22000000e-06, 7.21260000e-04, -5.23406000e-04,
+    5.58440000e-05, -7.80208000e-06, -5.86406000e-05,
+    1.85597600e-05, 8.22446000e-04, 1.73555600e-04,
+    2.26666400e-05,
+    // r = 3.87
+    6.28000000e-04, -5.39200000e-04, 5.80000000e-05,
+    -2.88000000e-05, -7.40000000e-06, 1.46600000e-05,
+    2.60000000e-05, -1.20000000e-06, 6.80000000e-05,
+    -6.64000000e-06, 6.63220000e-04, -4.80802000e-04,
+    5.14380000e-05, -7.18406000e-06, -5.39412000e-05,
+    1.70197200e-05, 7.56002000e-04, 1.58222200e-04,
+    2.19999800e-05,
+    // r = 3.88
+    5.72000000e-04, -4.91800000e-04, 5.20000000e-05,
+    -2.62000000e-05, -6.70000000e-06, 1.33400000e-05,
+    2.40000000e-05, -1.10000000e-06, 6.20000000e-05,
+    -6.06000000e-06, 6.05180000e-04, -4.38198000e-04,
+    4.70320000e-05, -6.56604000e-06, -4.92418000e-05,
+    1.54796800e-05, 6.89558000e-04, 1.42888800e-04,
+    2.13333200e-05,
+    // r = 3.89
+    5.16000000e-04, -4.44400000e-04, 4.60000000e-05,
+    -2.36000000e-05, -6.00000000e-06, 1.20200000e-05,
+    2.20000000e-05, -1.00000000e-06, 5.60000000e-05,
+    -5.48000000e-06, 5.47140000e-04, -3.95594000e-04,
+    4.26260000e-05, -5.94802000e-06, -4.45424000e-05,
+    1.39396400e-05, 6.23114000e-04, 1.27555400e-04,
+    2.06666600e-05,
+    // r = 3.90
+    4.60000000e-04, -3.97000000e-04, 4.00000000e-05,
+    -2.10000000e-05, -5.30000000e-06, 1.07000000e-05,
+    2.00000000e-05, -9.00000000e-07, 5.00000000e-05,
+    -4.90000000e-06, 4.89100000e-04, -3.52990000e-04,
+    3.82200000e-05, -5.33000000e-06, -3.98430000e-05,
+    1.23996000e-05, 5.56670000e-04, 1.12222000e-04,
+    2.00000000e-05,
+    // r = 3.91
+    4.12000000e-04, -3.55000000e-04, 3.60000000e-05,
+    -1.88000000e-05, -4.72000000e-06, 9.54000000e-06,
+    1.80000000e-05, -8.00000000e-07, 4.40000000e-05,
+    -4.38000000e-06, 4.37400000e-04, -3.15392000e-04,
+    3.42160000e-05, -4.76990000e-06, -3.56392000e-05,
+    1.10596200e-05, 4.98224000e-04, 1.00444200e-04,
+    1.91111000e-05,
+    // r = 3.92
+    3.64000000e-04, -3.13000000e-04, 3.20000000e-05,
+    -1.66000000e-05, -4.14000000e-06, 8.38000000e-06,
+    1.60000000e-05, -7.00000000e-07, 3.80000000e-05,
+    -3.86000000e-06, 3.85700000e-04, -2.77794000e-04,
+    3.02120000e-05, -4.20980000e-06, -3.14354000e-05,
+    9.71964000e-06, 4.39778000e-04, 8.86664000e-05,
+    1.82222000e-05,
+    // r = 3.93
+    3.16000000e-04, -2.71000000e-04, 2.80000000e-05,
+    -1.44000000e-05, -3.56000000e-06, 7.22000000e-06,
+    1.40000000e-05, -6.00000000e-07, 3.20000000e-05,
+    -3.34000000e-06, 3.34000000e-04, -2.40196000e-04,
+    2.62080000e-05, -3.64970000e-06, -2.72316000e-05,
+    8.37966000e-06, 3.81332000e-04, 7.68886000e-05,
+    1.73333000e-05,
+    // r = 3.94
+    2.68000000e-04, -2.29000000e-04, 2.40000000e-05,
+    -1.22000000e-05, -2.98000000e-06, 6.06000000e-06,
+    1.20000000e-05, -5.00000000e-07, 2.60000000e-05,
+    -2.82000000e-06, 2.82300000e-04, -2.02598000e-04,
+    2.22040000e-05, -3.08960000e-06, -2.30278000e-05,
+    7.03968000e-06, 3.22886000e-04, 6.51108000e-05,
+    1.64444000e-05,
+    // r = 3.95
+    2.20000000e-04, -1.87000000e-04, 2.00000000e-05,
+    -1.00000000e-05, -2.40000000e-06, 4.90000000e-06,
+    1.00000000e-05, -4.00000000e-07, 2.00000000e-05,
+    -2.30000000e-06, 2.30600000e-04, -1.65000000e-04,
+    1.82000000e-05, -2.52950000e-06, -1.88240000e-05,
+    5.69970000e-06, 2.64440000e-04, 5.33330000e-05,
+    1.55555000e-05,
+    // r = 3.96
+    1.76000000e-04, -1.49600000e-04, 1.60000000e-05,
+    -8.00000000e-06, -1.92000000e-06, 3.92000000e-06,
+    8.00000000e-06, -3.20000000e-07, 1.60000000e-05,
+    -1.84000000e-06, 1.84480000e-04, -1.32000000e-04,
+    1.45600000e-05, -2.02360000e-06, -1.50592000e-05,
+    4.55976000e-06, 2.11552000e-04, 4.26664000e-05,
+    1.24444000e-05,
+    // r = 3.97
+    1.32000000e-04, -1.12200000e-04, 1.20000000e-05,
+    -6.00000000e-06, -1.44000000e-06, 2.94000000e-06,
+    6.00000000e-06, -2.40000000e-07, 1.20000000e-05,
+    -1.38000000e-06, 1.38360000e-04, -9.90000000e-05,
+    1.09200000e-05, -1.51770000e-06, -1.12944000e-05,
+    3.41982000e-06, 1.58664000e-04, 3.19998000e-05,
+    9.33330000e-06,
+    // r = 3.98
+    8.80000000e-05, -7.48000000e-05, 8.00000000e-06,
+    -4.00000000e-06, -9.60000000e-07, 1.96000000e-06,
+    4.00000000e-06, -1.60000000e-07, 8.00000000e-06,
+    -9.20000000e-07, 9.22400000e-05, -6.60000000e-05,
+    7.28000000e-06, -1.01180000e-06, -7.52960000e-06,
+    2.27988000e-06, 1.05776000e-04, 2.13332000e-05,
+    6.22220000e-06,
+    // r = 3.99
+    4.40000000e-05, -3.74000000e-05, 4.00000000e-06,
+    -2.00000000e-06, -4.80000000e-07, 9.80000000e-07,
+    2.00000000e-06, -8.00000000e-08, 4.00000000e-06,
+    -4.60000000e-07, 4.61200000e-05, -3.30000000e-05,
+    3.64000000e-06, -5.05900000e-07, -3.76480000e-06,
+    1.13994000e-06, 5.28880000e-05, 1.06666000e-05,
+    3.11110000e-06,
+    // r = 4.00
+    0.00000000e+00, 0.00000000e+00, 0.00000000e+00,
+    0.00000000e+00, 0.00000000e+00, 0.00000000e+00,
+    0.00000000e+00, 0.00000000e+00, 0.00000000e+00,
+    0.00000000e+00, 0.00000000e+00, 0.00000000e+00,
+    0.00000000e+00, 0.00000000e+00, 0.00000000e+00,
+    0.00000000e+00, 0.00000000e+00, 0.00000000e+00,
+    0.00000000e+00};
@@ -0,0 +1,198 @@
+/** @file
+ *  In this file, a binary file format for device_matrix objects is provided,
+ *  which is read and written through memory-mapped files. It serves to keep
+ *  the factors of configurations that are solved again later, e.g. frozen
+ *  clusters or reference data of regression tests.
+ */
+
+#ifndef SD_MATRIX_FILE_HPP
+#define SD_MATRIX_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "device_matrix.hpp"
+#include "thrust_wrapper.hpp"
+
+namespace sd {
+
+/** How the entries of a stored matrix are to be read */
+enum class matrix_layout : std::uint32_t {
+    /** all entries, column-major */
+    GENERAL = 0,
+    /** upper triangular Cholesky factor U of A = U^T U, column-major, the
+     *  strict lower triangle is unspecified, see \ref cholesky_factor
+     */
+    CHOLESKY_UPPER = 1,
+};
+
+/** Header in front of the entries of a matrix file. It is followed by the
+ *  key of the matrix, padded to a multiple of 8 bytes, and then by the
+ *  entries, all in the byte order of the machine that wrote them.
+ */
+struct matrix_file_header {
+    char magic[8] = {'S', 'D', 'M', 'A', 'T', 'R', 'I', 'X'};
+    std::uint32_t version = 2;
+    /** size of one entry in bytes, i.e. single or double precision */
+    std::uint32_t value_size = 0;
+    std::uint64_t rows = 0;
+    std::uint64_t cols = 0;
+    matrix_layout layout = matrix_layout::GENERAL;
+    /** flags of the solver that computed the matrix */
+    std::int32_t flg = 0;
+    /** number of particles */
+    std::uint64_t n_part = 0;
+    /** hash of the configuration, see \ref fnv1a */
+    std::uint64_t hash = 0;
+    /** size of the key in bytes */
+    std::uint64_t key_size = 0;
+
+    /** Whether the matrix described by \p other can be used in place of
+     *  the one described by this header, apart from its dimensions
+     */
+    bool matches(matrix_file_header const &other) const {
+        return std::memcmp(magic, other.magic, sizeof(magic)) == 0 &&
+               version == other.version && value_size == other.value_size &&
+               layout == other.layout && flg == other.flg &&
+               n_part == other.n_part && hash == other.hash &&
+               key_size == other.key_size;
+    }
+
+    /** Offset of the entries from the start of the file */
+    std::size_t values_offset() const {
+        return sizeof(matrix_file_header) +
+               static_cast<std::size_t>((key_size + 7) / 8 * 8);
+    }
+};
+
+/** 64 bit FNV-1a hash of \p size bytes, continuing from \p hash */
+inline std::uint64_t fnv1a(void const *data, std::size_t size,
+                           std::uint64_t hash = 14695981039346656037ULL) {
+    auto const *bytes = static_cast<unsigned char const *>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/** Write \p A with the given header to \p path. The file is written under
+ *  a unique temporary name first and then renamed, so that a file that is
+ *  read at the same time, e.g. by another process, is never incomplete,
+ *  and writers of the same path do not overwrite each other's data.
+ *
+ *  \param header description of the matrix, the dimensions and the size
+ *                of the entries are taken from \p A
+ *  \param key    data that identifies the matrix, e.g. the configuration
+ *                it was computed for. \ref load_matrix only accepts the
+ *                file for the same key.
+ *  \return false, if the file could not be written
+ */
+template <typename T, typename Policy>
+bool save_matrix(std::string const &path, device_matrix<T, Policy> const &A,
+                 matrix_file_header header,
+                 std::vector<char> const &key = {}) {
+    header.value_size = sizeof(T);
+    header.rows = A.rows();
+    header.cols = A.cols();
+    header.key_size = key.size();
+    std::size_t const size = header.values_offset() + A.size() * sizeof(T);
+
+    std::string const pattern = path + ".XXXXXX";
+    std::vector<char> tmp(pattern.c_str(),
+                          pattern.c_str() + pattern.size() + 1);
+    int const fd = ::mkstemp(tmp.data());
+    if (fd < 0) {
+        return false;
+    }
+    // mkstemp only grants access to the owner
+    if (::fchmod(fd, 0644) != 0 ||
+        ::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        ::unlink(tmp.data());
+        return false;
+    }
+    void *const map =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        ::unlink(tmp.data());
+        return false;
+    }
+    std::memcpy(map, &header, sizeof(header));
+    if (!key.empty()) {
+        std::memcpy(static_cast<char *>(map) + sizeof(header), key.data(),
+                    key.size());
+    }
+    auto *const values = reinterpret_cast<T *>(static_cast<char *>(map) +
+                                               header.values_offset());
+    thrust_wrapper::copy(A.data(), A.data() + A.size(), values);
+    ::munmap(map, size);
+    if (std::rename(tmp.data(), path.c_str()) != 0) {
+        ::unlink(tmp.data());
+        return false;
+    }
+    return true;
+}
+
+/** Read a matrix that was written by \ref save_matrix into \p A, if the
+ *  file exists and its header and key match \p expected and \p key.
+ *
+ *  \param expected description of the matrix, the dimensions and the size
+ *                  of the entries are checked as well
+ *  \return false, if there is no matching file, \p A is not touched then
+ */
+template <typename T, typename Policy>
+bool load_matrix(std::string const &path, device_matrix<T, Policy> &A,
+                 matrix_file_header expected, std::size_t rows,
+                 std::size_t cols, std::vector<char> const &key = {}) {
+    expected.value_size = sizeof(T);
+    expected.key_size = key.size();
+    int const fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    std::size_t const size =
+        expected.values_offset() + rows * cols * sizeof(T);
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) != size) {
+        ::close(fd);
+        return false;
+    }
+    void *const map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    matrix_file_header header;
+    std::memcpy(&header, map, sizeof(header));
+    bool const match =
+        header.matches(expected) && header.rows == rows &&
+        header.cols == cols &&
+        (key.empty() || std::memcmp(static_cast<char const *>(map) +
+                                        sizeof(header),
+                                    key.data(), key.size()) == 0);
+    if (match) {
+        auto const *const values = reinterpret_cast<T const *>(
+            static_cast<char const *>(map) + header.values_offset());
+        device_matrix<T, Policy> B(rows, cols);
+        thrust_wrapper::copy(values, values + rows * cols, B.data());
+        A.swap(B);
+    }
+    ::munmap(map, size);
+    return match;
+}
+
+} // namespace sd
+
+#endif
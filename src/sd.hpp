@@ -1,16 +1,30 @@
 #ifndef SD_HPP
 #define SD_HPP
 
+#include <algorithm>
+#include <chrono>
 #include <vector>
 #include <cmath>
+#include <complex>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <limits>
+#include <string>
 #include <type_traits>
+#include <utility>
 
 #include "device_matrix.hpp"
+#include "matrix_file.hpp"
 #include "multi_array.hpp"
 #include "thrust_wrapper.hpp"
+#include "stokesian_dynamics/sd_instrumentation.hpp"
 
+#if defined(SD_USE_NVTX)
+#include <nvtx3/nvToolsExt.h>
+#elif defined(SD_USE_ROCTX)
+#include <roctracer/roctx.h>
+#endif
 
 #if defined(__CUDACC__)
 #include <curand_kernel.h>
@@ -79,6 +93,154 @@ typedef r123::Philox2x64 RNG;
 
 namespace sd {
 
+/** Per particle data in the memory of the caller, e.g. one member of an
+ *  array of particle structs, which the solver reads without intermediate
+ *  copies. The values of particle i start at data + i * stride, and the
+ *  first \ref width of them are used. Packed data, which is already laid
+ *  out like the buffers of the solver, has a width of zero, e.g. the
+ *  vectors of the std::vector interface. Device memory can only be passed
+ *  to the solvers on the device.
+ */
+template <typename T>
+struct particle_view {
+    using value_type = typename std::remove_const<T>::type;
+
+    T *data = nullptr;
+    /** number of values per particle, zero for packed data */
+    std::size_t width = 0;
+    /** distance between the first values of consecutive particles */
+    std::size_t stride = 0;
+    /** number of values of packed data */
+    std::size_t size = 0;
+    /** whether \ref data points to device memory */
+    bool on_device = false;
+
+    particle_view() = default;
+    particle_view(T *data, std::size_t width, std::size_t stride,
+                  bool on_device = false)
+        : data(data), width(width), stride(stride), on_device(on_device) {}
+    particle_view(std::vector<value_type> &v)
+        : data(v.data()), size(v.size()) {}
+    particle_view(std::vector<value_type> const &v)
+        : data(v.data()), size(v.size()) {}
+
+    /** View of \p size packed values */
+    static particle_view packed(T *data, std::size_t size,
+                                bool on_device = false) {
+        particle_view view;
+        view.data = data;
+        view.size = size;
+        view.on_device = on_device;
+        return view;
+    }
+
+    /** View of the \p count particles starting at particle \p first, where
+     *  packed data holds \p packed_width values per particle
+     */
+    particle_view slice(std::size_t first, std::size_t count,
+                        std::size_t packed_width) const {
+        particle_view view = *this;
+        if (width) {
+            view.data += first * stride;
+        } else {
+            view.data += first * packed_width;
+            view.size = count * packed_width;
+        }
+        return view;
+    }
+};
+
+/** Copies \ref width values per particle between two arrays with
+ *  different distances between consecutive particles. The index enumerates
+ *  (particle, value).
+ */
+template <typename T>
+struct copy_particles {
+    T const *src;
+    std::size_t const src_stride;
+    T *dst;
+    std::size_t const dst_stride;
+    std::size_t const width;
+
+    DEVICE_FUNC void operator()(std::size_t index) {
+        std::size_t const i = index / width;
+        std::size_t const k = index % width;
+        dst[i * dst_stride + k] = src[i * src_stride + k];
+    }
+};
+
+/** Copy the data of \p n_part particles from \p src into \p dst, which
+ *  holds \p dst_width values per particle. Values beyond the width of
+ *  \p src are left untouched. Strided host data is packed on the host
+ *  before it is transferred to the device in one piece.
+ */
+template <typename Policy, typename T>
+void gather_particles(particle_view<T const> src, std::size_t n_part,
+                      std::size_t dst_width,
+                      typename Policy::template vector<T> &dst) {
+    constexpr bool host = std::is_same<Policy, policy::host>::value;
+    assert(!(host && src.on_device));
+    assert(dst.size() == n_part * dst_width);
+    std::size_t const width = src.width ? src.width : dst_width;
+    std::size_t const stride = src.width ? src.stride : dst_width;
+    assert(src.width ? width <= dst_width : src.size == dst.size());
+    if (!host && !src.on_device) {
+        if (src.width == 0) {
+            thrust_wrapper::copy(src.data, src.data + src.size, dst.begin());
+            return;
+        }
+        std::vector<T> packed(dst.size());
+        thrust_wrapper::copy(dst.begin(), dst.end(), packed.begin());
+        copy_particles<T> op{src.data, stride, packed.data(), dst_width,
+                             width};
+        for (std::size_t index = 0; index < n_part * width; ++index) {
+            op(index);
+        }
+        thrust_wrapper::copy(packed.begin(), packed.end(), dst.begin());
+        return;
+    }
+    thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+    thrust_wrapper::for_each(
+        Policy::par(), begin, begin + n_part * width,
+        copy_particles<T>{src.data, stride,
+                          thrust_wrapper::raw_pointer_cast(dst.data()),
+                          dst_width, width});
+}
+
+/** Copy the data of \p n_part particles from \p src, which holds
+ *  src.size() / n_part values per particle, into \p dst. This is the
+ *  reverse of \ref gather_particles.
+ */
+template <typename Policy, typename T>
+void scatter_particles(typename Policy::template vector<T> const &src,
+                       std::size_t n_part, particle_view<T> dst) {
+    constexpr bool host = std::is_same<Policy, policy::host>::value;
+    assert(!(host && dst.on_device));
+    std::size_t const src_width = src.size() / n_part;
+    std::size_t const width = dst.width ? dst.width : src_width;
+    std::size_t const stride = dst.width ? dst.stride : src_width;
+    assert(dst.width ? width <= src_width : dst.size == src.size());
+    if (!host && !dst.on_device) {
+        if (dst.width == 0) {
+            thrust_wrapper::copy(src.begin(), src.end(), dst.data);
+            return;
+        }
+        std::vector<T> packed(src.size());
+        thrust_wrapper::copy(src.begin(), src.end(), packed.begin());
+        copy_particles<T> op{packed.data(), src_width, dst.data, stride,
+                             width};
+        for (std::size_t index = 0; index < n_part * width; ++index) {
+            op(index);
+        }
+        return;
+    }
+    thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+    thrust_wrapper::for_each(
+        Policy::par(), begin, begin + n_part * width,
+        copy_particles<T>{thrust_wrapper::raw_pointer_cast(src.data()),
+                          src_width, dst.data, stride, width});
+}
+
 namespace flags {
 enum flags {
     NONE = 0,
@@ -86,64 +248,570 @@ enum flags {
     PAIR_MOBILITY = 1 << 1,
     LUBRICATION = 1 << 2,
     FTS = 1 << 3,
+    /** Matrix-free F-T solver with O(N) memory, see \ref iterative_solver.
+     *  It is ignored together with FTS and by the batched device solver.
+     *  Steps in which it does not converge are repeated with the dense
+     *  solver.
+     */
+    ITERATIVE = 1 << 4,
+    /** Dense solver that does the inversion and factorization in single
+     *  precision and refines the velocities in double precision, see
+     *  \ref mixed_precision_solver. It is ignored together with ITERATIVE
+     *  and by the batched solvers.
+     */
+    MIXED_PRECISION = 1 << 5,
+    /** Periodic boundary conditions in a cubic box, the far field mobility
+     *  is Ewald summed, see \ref ewald_sum. Only available in F-T mode and
+     *  for the dense double precision solver, so ITERATIVE and
+     *  MIXED_PRECISION are ignored together with it. It is ignored by the
+     *  batched solvers, in FTS mode and if no box length was set, e.g. by
+     *  sd_cpu and sd_gpu, which take none. The particles are in free space
+     *  then, see \ref solver::effective_flags. The reciprocal-space sum is
+     *  tabulated once per box, so a pair costs about as much as in free
+     *  space for any accuracy, see \ref ewald_table for the setup.
+     */
+    PERIODIC = 1 << 6,
+    /** Keep the factorization of a time step and use it as preconditioner
+     *  in the following steps, as long as the particles moved little, see
+     *  \ref reuse_workspace. Only available in F-T mode for the dense double
+     *  precision solver, it is ignored together with FTS, ITERATIVE and
+     *  MIXED_PRECISION and by the batched solvers.
+     */
+    REUSE_FACTORIZATION = 1 << 7,
+    /** All particles have the radius of the first one. The pair functors
+     *  then read a single radius instead of one per particle, see
+     *  \ref static_mode.
+     */
+    MONODISPERSE = 1 << 8,
+    /** Keep the dense double precision solver within less memory: the
+     *  resistance matrices and the Cholesky factor take over the buffers of
+     *  the mobility matrices once these are consumed, instead of being
+     *  allocated alongside them, see \ref workspace::peak_bytes. It is
+     *  ignored together with MIXED_PRECISION and REUSE_FACTORIZATION, which
+     *  keep their own matrices, and by the batched solvers.
+     */
+    LOW_MEMORY = 1 << 9,
 };
 }
 
-/** This functor computes the distance between all particle pairs and checks
- *  for overlaps.
- *  A matrix containing unit vectors along particle center connection lines,
- *  and actual distances is the result of this operation.
- *  If there is a pair of particles which overlap, their distance
- *  will be set to NAN, which eventually causes NAN to appear all over the
- *  simulation. No warning is printed out, because the sheer presence of a
- *  print command could impair the parallel execution performance, even if
- *  there are no overlaps.
+/** The mode of the functors that is only known at run time, the stresslets
+ *  are decided by \ref flags::FTS and every particle has its own radius.
  */
-template <typename Policy, typename T>
-struct check_dist {
-    /** contains particle positions */
-    device_vector_view<T, Policy> const x;
-    /** contains particle radii */
-    device_vector_view<T, Policy> const a;
-    /** contains various distance information.
-     *  pd[0] through pd[2] contain a unit vector connecting the particles
-     *  pd[3] contains the actual distance
+struct runtime_mode {
+    DEVICE_FUNC static constexpr bool fts(int flg) {
+        return (flg & flags::FTS) != 0;
+    }
+
+    template <typename View>
+    DEVICE_FUNC static auto radius(View const &a, std::size_t i)
+        -> decltype(a(i)) {
+        return a(i);
+    }
+};
+
+/** The mode of the functors fixed at compile time, so that the stresslet
+ *  blocks are not even compiled into the F-T kernels and the monodisperse
+ *  kernels read the radius of the first particle only.
+ *  The solvers select one with \ref dispatch_mode.
+ */
+template <bool FTS, bool Monodisperse>
+struct static_mode {
+    DEVICE_FUNC static constexpr bool fts(int) { return FTS; }
+
+    template <typename View>
+    DEVICE_FUNC static auto radius(View const &a, std::size_t i)
+        -> decltype(a(i)) {
+        return a(Monodisperse ? 0 : i);
+    }
+};
+
+/** Call \p f with the \ref static_mode that matches \p flg */
+template <typename F>
+void dispatch_mode(int flg, F &&f) {
+    bool const monodisperse = flg & flags::MONODISPERSE;
+    if (flg & flags::FTS) {
+        if (monodisperse) {
+            f(static_mode<true, true>{});
+        } else {
+            f(static_mode<true, false>{});
+        }
+    } else {
+        if (monodisperse) {
+            f(static_mode<false, true>{});
+        } else {
+            f(static_mode<false, false>{});
+        }
+    }
+}
+
+/** The pair mobility tensors a_12, b_12 and c_12 from the first three lines
+ *  of equation (A 2) for given scalar mobility functions x_12 and y_12,
+ *  see \ref ft_pair_mobility.
+ *
+ *  \param e unit vector along the line from the first to the second particle
+ */
+template <typename T>
+DEVICE_FUNC void ft_pair_tensors(multi_array<T, 3> const &e, T x12a, T y12a,
+                                 T y12b, T x12c, T y12c,
+                                 multi_array<T, 3, 3> &mob_a,
+                                 multi_array<T, 3, 3> &mob_b,
+                                 multi_array<T, 3, 3> &mob_c) {
+    // Kronecker-Delta
+    static constexpr multi_array<T, 3, 3> const delta = {
+        // clang-format off
+        1, 0, 0,
+        0, 1, 0,
+        0, 0, 1
+        // clang-format on
+    };
+
+    // Levi-Civita tensor
+    static constexpr multi_array<T, 3, 3, 3> const eps = {
+        // clang-format off
+        0, 0, 0,   0, 0, 1,   0,-1, 0,
+        0, 0,-1,   0, 0, 0,   1, 0, 0,
+        0, 1, 0,  -1, 0, 0,   0, 0, 0
+        // clang-format on
+    };
+
+    auto ee = outer(e, e);
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            // if i and j are different from one another, this returns the
+            // "other" index missing in the set {0, 1, 2}
+            std::size_t k = (3 - i - j) % 3;
+
+            mob_a(i, j) = x12a * ee(i, j) + y12a * (delta(i, j) - ee(i, j));
+            mob_b(i, j) = y12b * eps(i, j, k) * e(k);
+            mob_c(i, j) = x12c * ee(i, j) + y12c * (delta(i, j) - ee(i, j));
+        }
+    }
+}
+
+/** Ewald summation of the F-T mobility in a cubic periodic box, see
+ *  \ref flags::PERIODIC.
+ *
+ *  The Rotne-Prager mobility of all periodic images is split into a
+ *  real-space sum which decays like a Gaussian and a reciprocal-space sum
+ *  which converges like a Gaussian, following
+ *
+ *    Beenakker, C.W.J., J. Chem. Phys. 85, 1581 (1986)
+ *    https://doi.org/10.1063/1.451199
+ *
+ *  The real-space cutoff is half the box length, so that only the minimum
+ *  image of a pair contributes. The couplings with rotations are split in
+ *  the same way, as the curl and the Laplacian of the split Oseen tensor.
+ *
+ *  The reciprocal-space sums over the lattice vectors only depend on the
+ *  distance vector of a pair, the radii enter as prefactors. They are
+ *  tabulated once per box by \ref ewald_table on a grid over one octant of
+ *  the box, and a pair interpolates them with the Lagrange polynomials of
+ *  degree \ref order - 1 along each axis. A pair thus costs the same
+ *  order^3 table lookups for any accuracy instead of one term per lattice
+ *  vector, of which there are thousands at the default accuracy.
+ *
+ *  All results are non-dimensionalized like those of \ref ft_pair_mobility.
+ *  This is a plain view that may be copied to the device, it is disabled if
+ *  box_l is zero.
+ */
+template <typename T>
+struct ewald_sum {
+    /** number of grid points per axis of the interpolation */
+    static constexpr int order = 8;
+    /** grid points below zero along each axis, so that the interpolation
+     *  at the faces of the octant needs no special case
      */
-    device_matrix_view<T, Policy> pd;
-    /** this is a list of all pairs, containing the indices of particles
-     *  that belong to each pair
+    static constexpr int ghosts = order / 2 - 1;
+    /** number of sums per grid point */
+    static constexpr std::size_t stride = 15;
+
+    /** The reciprocal-space sums at the grid points r = h (i, j, l), with
+     *  -ghosts <= i, j, l < n_grid - ghosts, stored with l running fastest.
+     *  The sums of each point are the sums of w cos(k.r) P and of
+     *  w cos(k.r) k^2 P over the lattice vectors of one half space, where
+     *  P = 1 - k k / k^2 is stored as its upper triangle xx, xy, xz, yy, yz,
+     *  zz, and the sum of w sin(k.r) k. The weight w = 2 phi(k) / (V k^2)
+     *  includes the vector -k.
      */
-    device_matrix_view<std::size_t, Policy> const part_id;
+    T const *grid = nullptr;
+    /** number of grid points per axis */
+    std::size_t n_grid = 0;
+    /** grid spacing h */
+    T spacing = 0;
+    /** edge length of the cubic box */
+    T box_l = 0;
+    /** splitting parameter */
+    T xi = 0;
+    /** real-space cutoff */
+    T r_cut = 0;
+    /** sums of the weights w and of w k^2 over all tabulated vectors */
+    T s0 = 0, s2 = 0;
+
+    DEVICE_FUNC bool enabled() const { return box_l > 0; }
+
+    /** Fold a distance vector into the minimum image */
+    DEVICE_FUNC void minimum_image(T &dx, T &dy, T &dz) const {
+        if (enabled()) {
+            dx -= box_l * std::round(dx / box_l);
+            dy -= box_l * std::round(dy / box_l);
+            dz -= box_l * std::round(dz / box_l);
+        }
+    }
 
-    DEVICE_FUNC void operator()(std::size_t i) {
-        std::size_t k = 6 * part_id(0, i);
-        std::size_t j = 6 * part_id(1, i);
+    /** Scalar self mobilities of a sphere of radius \p a and all its
+     *  images: \p xa replaces 1 and \p xc replaces 3/4 in the self
+     *  contribution of \ref mobility.
+     */
+    DEVICE_FUNC void self_mobility(T a, T &xa, T &xc) const {
+        T const sqrt_pi = std::sqrt(T{M_PI});
+        T const alpha = xi * a;
+        T const alpha3 = alpha * alpha * alpha;
+        xa = 1 - 6 * alpha / sqrt_pi + T{40. / 3.} * alpha3 / sqrt_pi +
+             T{4. * M_PI} * a * (s0 - a * a * s2 / 3);
+        xc = T{3. / 4.} - 10 * alpha3 / sqrt_pi + T{M_PI} * a * a * a * s2;
+    }
 
-        T dx = x(j + 0) - x(k + 0);
-        T dy = x(j + 1) - x(k + 1);
-        T dz = x(j + 2) - x(k + 2);
-#if defined(__HIPCC__)
-        T dr = sqrtf(dx * dx + dy * dy + dz * dz);
-#else
-        T dr = std::sqrt(dx * dx + dy * dy + dz * dz);
-#endif
-        T dr_inv = 1 / dr;
+    /** Periodic version of \ref ft_pair_mobility
+     *
+     *  \param e unit vector along the minimum image connection line from
+     *           the first to the second particle
+     *  \param dr length of the minimum image connection line
+     *  \param a12 mean radius of the pair
+     */
+    DEVICE_FUNC void ft_pair_mobility(multi_array<T, 3> const &e, T dr,
+                                      T a12, multi_array<T, 3, 3> &mob_a,
+                                      multi_array<T, 3, 3> &mob_b,
+                                      multi_array<T, 3, 3> &mob_c) const {
+        // Real-space part, Beenakker's equation (5) for the translation.
+        // The ratios fb and fc are those of the curl and the Laplacian of the
+        // real-space part of the Oseen tensor to their free-space values.
+        T x12a = 0, y12a = 0, y12b = 0, x12c = 0, y12c = 0;
+        if (dr < r_cut) {
+            T const q = a12 / dr;
+            T const q3 = q * q * q;
+            T const s = xi * dr;
+            T const s2 = s * s;
+            T const s4 = s2 * s2;
+            T const alpha = xi * a12;
+            T const alpha3 = alpha * alpha * alpha;
+            T const c = std::erfc(s);
+            T const g = std::exp(-s2) / std::sqrt(T{M_PI});
+
+            T const ia = c * (T{3. / 4.} * q + T{1. / 2.} * q3) +
+                         g * (4 * alpha3 * s4 + 3 * alpha * s2 -
+                              20 * alpha3 * s2 - T{9. / 2.} * alpha +
+                              14 * alpha3 + alpha3 / s2);
+            T const ea = c * (T{3. / 4.} * q - T{3. / 2.} * q3) +
+                         g * (-4 * alpha3 * s4 - 3 * alpha * s2 +
+                              16 * alpha3 * s2 + T{3. / 2.} * alpha -
+                              2 * alpha3 - 3 * alpha3 / s2);
+            T const fb = c + 2 * s * g * (1 - 6 * s2 + 2 * s4);
+            T const fc =
+                c + 2 * s * g * (1 + 14 * s2 - 20 * s4 + 4 * s4 * s2);
+
+            x12a = ia + ea;
+            y12a = ia;
+            y12b = T{-3. / 4.} * q * q * fb;
+            x12c = T{3. / 4.} * q3 * fb;
+            y12c = T{-3. / 8.} * q3 * fc;
+        }
+        ft_pair_tensors(e, x12a, y12a, y12b, x12c, y12c, mob_a, mob_b, mob_c);
+
+        // Reciprocal-space part, interpolated from the grid. The sums are
+        // even or odd in each component of r, so the grid only covers
+        // r >= 0 and the signs are restored afterwards.
+        T sp[6] = {}, sq[6] = {}, sb[3] = {};
+        T sign[3];
+        std::size_t first[3];
+        T weight[3][order];
+        for (std::size_t i = 0; i < 3; ++i) {
+            T const d = e(i) * dr;
+            sign[i] = d < 0 ? T{-1} : T{1};
+            T const u = std::abs(d) / spacing;
+            T const floor_u = std::floor(u);
+            T const t = u - floor_u;
+            // grid index of the first node
+            first[i] = static_cast<std::size_t>(floor_u);
+            for (int m = 0; m < order; ++m) {
+                T w = 1;
+                for (int l = 0; l < order; ++l) {
+                    if (l != m) {
+                        w *= (t + ghosts - l) / T(m - l);
+                    }
+                }
+                weight[i][m] = w;
+            }
+        }
+        for (int m0 = 0; m0 < order; ++m0) {
+            for (int m1 = 0; m1 < order; ++m1) {
+                T const w01 = weight[0][m0] * weight[1][m1];
+                T const *const row =
+                    grid + stride * (((first[0] + m0) * n_grid + first[1] +
+                                      m1) * n_grid + first[2]);
+                for (int m2 = 0; m2 < order; ++m2) {
+                    T const w = w01 * weight[2][m2];
+                    T const *const entry = row + stride * m2;
+                    for (std::size_t i = 0; i < 6; ++i) {
+                        sp[i] += w * entry[i];
+                        sq[i] += w * entry[6 + i];
+                    }
+                    for (std::size_t i = 0; i < 3; ++i) {
+                        sb[i] += w * entry[12 + i];
+                    }
+                }
+            }
+        }
+        // The off-diagonal elements of P are odd in both of their
+        // components, the sums over sin(k.r) k in their own component
+        sp[1] *= sign[0] * sign[1];
+        sq[1] *= sign[0] * sign[1];
+        sp[2] *= sign[0] * sign[2];
+        sq[2] *= sign[0] * sign[2];
+        sp[4] *= sign[1] * sign[2];
+        sq[4] *= sign[1] * sign[2];
+        for (std::size_t i = 0; i < 3; ++i) {
+            sb[i] *= sign[i];
+        }
+
+        // position of the element (i, j) in the upper triangles
+        static constexpr multi_array<std::size_t, 3, 3> const sym = {
+            // clang-format off
+            0, 1, 2,
+            1, 3, 4,
+            2, 4, 5
+            // clang-format on
+        };
+        T const a2 = a12 * a12;
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 3; ++j) {
+                std::size_t const l = (3 - i - j) % 3;
+                // Levi-Civita tensor eps(i, j, l)
+                T const eps =
+                    (i == j) ? T{0} : (((j + 3 - i) % 3 == 1) ? T{1} : T{-1});
+                T const p = sp[sym(i, j)];
+                T const pk2 = sq[sym(i, j)];
+                mob_a(i, j) += T{6. * M_PI} * a12 * (p - a2 * pk2 / 3);
+                mob_b(i, j) -= T{3. * M_PI} * a2 * eps * sb[l];
+                mob_c(i, j) += T{3. / 2. * M_PI} * a2 * a12 * pk2;
+            }
+        }
+    }
+};
+
+/** Owner of the interpolation grid of \ref ewald_sum for one box */
+template <typename Policy, typename T>
+struct ewald_table {
+    template <typename U>
+    using vector_type = typename Policy::template vector<U>;
+
+    /** see \ref ewald_sum::grid */
+    vector_type<T> grid;
+    /** all parameters of the current table, without the pointer */
+    ewald_sum<T> parameters;
+    /** relative accuracy the table was set up for */
+    T tolerance = 0;
+
+    /** Choose the splitting parameter and tabulate the reciprocal-space sums
+     *  for the box length \p box_l. Both sums are truncated where their
+     *  terms drop below \p tolerance relative to the leading term, and the
+     *  grid is chosen fine enough that the interpolation error is of the
+     *  same order. Nothing is done if the box did not change.
+     *
+     *  With n_max lattice vectors per axis and G = 2.3 sqrt(-log tolerance)
+     *  n_max grid points per box length, the grid takes 15 (G/2 + 8)^3
+     *  numbers, 21 MB in double precision at the default tolerance of 1e-6,
+     *  57 MB at 1e-8 and 260 MB at 1e-12. It is built from separable sums
+     *  over the lattice in about a second, so a box that changes every
+     *  step, e.g. under a barostat, makes this setup dominate small
+     *  systems.
+     */
+    void setup(T box_l, T tolerance) {
+        assert(box_l > 0);
+        if (box_l == parameters.box_l && tolerance == this->tolerance) {
+            return;
+        }
+        this->tolerance = tolerance;
+
+        // erfc(xi r_cut) ~ exp(-s^2) = tolerance at half the box length
+        T const s = std::sqrt(-std::log(tolerance));
+        T const r_cut = box_l / 2;
+        T const xi = s / r_cut;
+        // The reciprocal terms decay like 2 u^2 exp(-u), u = k^2 / (4 xi^2)
+        T u = s * s;
+        for (int iter = 0; iter < 4; ++iter) {
+            u = s * s + std::log(2 * u * u);
+        }
+        T const k_max = 2 * xi * std::sqrt(u);
+        T const k0 = T{2. * M_PI} / box_l;
+        int const n_max = static_cast<int>(std::ceil(k_max / k0));
+
+        // Coefficients c(n) of all lattice vectors n, such that the sums
+        // are the real parts of sum_n c(n) exp(i k(n).r). Both vectors of
+        // a pair k, -k get half the weight.
+        using complex = std::complex<T>;
+        constexpr std::size_t stride = ewald_sum<T>::stride;
+        std::size_t const width = 2 * n_max + 1;
+        std::vector<complex> c(width * width * width * stride);
+        T const volume = box_l * box_l * box_l;
+        T s0 = 0, s2 = 0;
+        for (int n3 = 0; n3 <= n_max; ++n3) {
+            for (int n2 = -n_max; n2 <= n_max; ++n2) {
+                for (int n1 = -n_max; n1 <= n_max; ++n1) {
+                    // one vector of each pair k, -k
+                    if (n3 == 0 && (n2 < 0 || (n2 == 0 && n1 <= 0))) {
+                        continue;
+                    }
+                    T const k2 = k0 * k0 * T(n1 * n1 + n2 * n2 + n3 * n3);
+                    if (k2 > k_max * k_max) {
+                        continue;
+                    }
+                    T const v = k2 / (4 * xi * xi);
+                    T const phi = (1 + v + 2 * v * v) * std::exp(-v);
+                    T const w = 2 * phi / (volume * k2);
+                    T const kv[3] = {k0 * n1, k0 * n2, k0 * n3};
+                    for (int sign = -1; sign <= 1; sign += 2) {
+                        complex *const cn =
+                            &c[stride *
+                               (((sign * n3 + n_max) * width + sign * n2 +
+                                 n_max) * width + sign * n1 + n_max)];
+                        for (std::size_t i = 0, m = 0; i < 3; ++i) {
+                            for (std::size_t j = i; j < 3; ++j, ++m) {
+                                T const p =
+                                    w * (T(i == j) - kv[i] * kv[j] / k2);
+                                cn[m] = p / 2;
+                                cn[6 + m] = k2 * p / 2;
+                            }
+                        }
+                        // sin(k.r) = Re(-i exp(i k.r))
+                        for (std::size_t i = 0; i < 3; ++i) {
+                            cn[12 + i] = complex(0, -sign * w * kv[i] / 2);
+                        }
+                    }
+                    s0 += w;
+                    s2 += w * k2;
+                }
+            }
+        }
+
+        // Sum over one axis after the other, with the phase factors
+        // exp(i k0 n x) of the grid points x = h (p - ghosts)
+        constexpr int ghosts = ewald_sum<T>::ghosts;
+        std::size_t const n_cells =
+            2 * static_cast<std::size_t>(std::ceil(1.15 * s * n_max));
+        T const spacing = box_l / T(n_cells);
+        std::size_t const n_grid = n_cells / 2 + ewald_sum<T>::order;
+        std::vector<complex> phase(n_grid * width);
+        for (std::size_t p = 0; p < n_grid; ++p) {
+            for (std::size_t n = 0; n < width; ++n) {
+                T const arg = k0 * (T(n) - n_max) * spacing *
+                              (T(p) - ghosts);
+                phase[p * width + n] = complex(std::cos(arg), std::sin(arg));
+            }
+        }
+        // sum over n1: c1(n3, n2, p1)
+        std::vector<complex> c1(width * width * n_grid * stride);
+        for (std::size_t n32 = 0; n32 < width * width; ++n32) {
+            for (std::size_t p1 = 0; p1 < n_grid; ++p1) {
+                complex *const out = &c1[stride * (n32 * n_grid + p1)];
+                for (std::size_t n1 = 0; n1 < width; ++n1) {
+                    complex const ph = phase[p1 * width + n1];
+                    complex const *const in =
+                        &c[stride * (n32 * width + n1)];
+                    for (std::size_t m = 0; m < stride; ++m) {
+                        out[m] += ph * in[m];
+                    }
+                }
+            }
+        }
+        c.clear();
+        c.shrink_to_fit();
+        // sum over n2: c2(n3, p2, p1)
+        std::vector<complex> c2(width * n_grid * n_grid * stride);
+        for (std::size_t n3 = 0; n3 < width; ++n3) {
+            for (std::size_t p2 = 0; p2 < n_grid; ++p2) {
+                complex *const out =
+                    &c2[stride * ((n3 * n_grid + p2) * n_grid)];
+                for (std::size_t n2 = 0; n2 < width; ++n2) {
+                    complex const ph = phase[p2 * width + n2];
+                    complex const *const in =
+                        &c1[stride * ((n3 * width + n2) * n_grid)];
+                    for (std::size_t m = 0; m < stride * n_grid; ++m) {
+                        out[m] += ph * in[m];
+                    }
+                }
+            }
+        }
+        c1.clear();
+        c1.shrink_to_fit();
+        // sum over n3: the grid (p1, p2, p3)
+        std::vector<T> table(n_grid * n_grid * n_grid * stride);
+        std::vector<complex> sum(stride);
+        for (std::size_t p1 = 0; p1 < n_grid; ++p1) {
+            for (std::size_t p2 = 0; p2 < n_grid; ++p2) {
+                for (std::size_t p3 = 0; p3 < n_grid; ++p3) {
+                    std::fill(sum.begin(), sum.end(), complex{});
+                    for (std::size_t n3 = 0; n3 < width; ++n3) {
+                        complex const ph = phase[p3 * width + n3];
+                        complex const *const in =
+                            &c2[stride * ((n3 * n_grid + p2) * n_grid + p1)];
+                        for (std::size_t m = 0; m < stride; ++m) {
+                            sum[m] += ph * in[m];
+                        }
+                    }
+                    T *const out =
+                        &table[stride * ((p1 * n_grid + p2) * n_grid + p3)];
+                    for (std::size_t m = 0; m < stride; ++m) {
+                        out[m] = sum[m].real();
+                    }
+                }
+            }
+        }
 
-        // Check if particles overlap and if so, cause NAN to appear
-        // throughout the simulation
-        // Currently out of use, though, since Lubrication isn't supported
-        // and this check isn't necessary for far field approximation
-        // if (dr <= a(part_id(0, i)) + a(part_id(1, i))) {
-        //     dr = NAN;
-        // }
+        grid = vector_type<T>(table.size());
+        thrust_wrapper::copy(table.begin(), table.end(), grid.begin());
+        parameters = ewald_sum<T>{nullptr, n_grid, spacing, box_l,
+                                  xi,      r_cut,  s0,      s2};
+    }
 
-        pd(0, i) = dx * dr_inv;
-        pd(1, i) = dy * dr_inv;
-        pd(2, i) = dz * dr_inv;
-        pd(3, i) = dr;
+    /** View for the functors, only valid as long as the table is alive */
+    ewald_sum<T> view() const {
+        ewald_sum<T> sum = parameters;
+        sum.grid = thrust_wrapper::raw_pointer_cast(grid.data());
+        return sum;
     }
 };
 
+/** Unit vector \p e pointing from particle \p i to particle \p j and their
+ *  distance. The pair functors compute them on the fly from the positions
+ *  instead of reading them from a table, which makes the pair passes compute
+ *  bound rather than memory bound. In periodic mode the minimum image is
+ *  used.
+ *  Overlapping particles are not detected. Their distance would best be set
+ *  to NAN, which eventually causes NAN to appear all over the simulation,
+ *  but this isn't necessary for the far field approximation.
+ */
+template <typename Policy, typename T>
+DEVICE_FUNC T pair_distance(device_vector_view<T, Policy> const &x,
+                            std::size_t i, std::size_t j,
+                            multi_array<T, 3> &e,
+                            ewald_sum<T> const &ewald = {}) {
+    T dx = x(6 * j + 0) - x(6 * i + 0);
+    T dy = x(6 * j + 1) - x(6 * i + 1);
+    T dz = x(6 * j + 2) - x(6 * i + 2);
+    ewald.minimum_image(dx, dy, dz);
+#if defined(__HIPCC__)
+    T dr = sqrtf(dx * dx + dy * dy + dz * dz);
+#else
+    T dr = std::sqrt(dx * dx + dy * dy + dz * dz);
+#endif
+    T dr_inv = 1 / dr;
+    e(0) = dx * dr_inv;
+    e(1) = dy * dr_inv;
+    e(2) = dz * dr_inv;
+    return dr;
+}
+
 
 
 
@@ -197,19 +865,22 @@ struct check_dist {
  *  on the distance between the particle centers. For these expressions, x_12
  *  and y_12 from equation (A 3) have to be plugged into equation (A 2).
  */
-template <typename Policy, typename T, bool isself>
+template <typename Policy, typename T, bool isself,
+          typename Mode = runtime_mode>
 struct mobility;
 
 /** The functor that computes the self contribution to the mobility matrix of
  *  all particles. For further information, see the description of
  * \ref mobility .
  */
-template <typename Policy, typename T>
-struct mobility<Policy, T, true> {
+template <typename Policy, typename T, typename Mode>
+struct mobility<Policy, T, true, Mode> {
     device_matrix_view<T, Policy> zmuf, zmus, zmes;
     device_vector_view<T, Policy> const a;
     T const eta;
     int const flg;
+    /** periodic images, only used in F-T mode */
+    ewald_sum<T> const ewald = {};
 
     // Determine the self contribution
     // This is independent of dr_inv, dx, dy, dz
@@ -259,14 +930,39 @@ struct mobility<Policy, T, true> {
 
         // These are the non-dimensionalizations as stated in the paragraph
         // below equation (A 1).
-        auto const visc1 = T{M_1_PI / 6. / eta / a(part_id)};
-        auto const visc2 = T{visc1 / a(part_id)};
-        auto const visc3 = T{visc2 / a(part_id)};
+        T const a_i = Mode::radius(a, part_id);
+        auto const visc1 = T{M_1_PI / 6. / eta / a_i};
+        auto const visc2 = T{visc1 / a_i};
+        auto const visc3 = T{visc2 / a_i};
+
+        // The periodic images of the particle only rescale the diagonal
+        T scale_a = 1, scale_c = 1;
+        if (ewald.enabled()) {
+            ewald.self_mobility(a_i, scale_a, scale_c);
+            scale_c /= mob_c(0, 0);
+        }
 
         // Now put the entries into the grand mobility matrix.
+        // The whole diagonal block is written, including its zeros, so that
+        // the matrices do not have to be cleared when they are reused.
         for (std::size_t i = 0; i < 3; ++i) {
-            zmuf(ph1 + i, ph1 + i) = visc1 * mob_a(i, i);
-            zmuf(ph2 + i, ph2 + i) = visc3 * mob_c(i, i);
+            for (std::size_t j = 0; j < 3; ++j) {
+                zmuf(ph1 + i, ph1 + j) = scale_a * visc1 * mob_a(i, j);
+                zmuf(ph2 + i, ph2 + j) = scale_c * visc3 * mob_c(i, j);
+                zmuf(ph1 + i, ph2 + j) = T{0.0};
+                zmuf(ph2 + i, ph1 + j) = T{0.0};
+            }
+        }
+
+        // zmus and zmes are only allocated in FTS mode
+        if (!Mode::fts(flg)) {
+            return;
+        }
+
+        for (std::size_t i = 0; i < 6; ++i) {
+            for (std::size_t j = 0; j < 5; ++j) {
+                zmus(ph1 + i, ph3 + j) = T{0.0};
+            }
         }
 
         for (std::size_t i = 0; i < 5; ++i) {
@@ -277,20 +973,130 @@ struct mobility<Policy, T, true> {
     }
 };
 
+/** The pair mobility tensors a_12, b_12 and c_12 from the first three lines
+ *  of equation (A 2), which couple the forces and torques of two particles,
+ *  before the scaling by the viscosity.
+ *
+ *  \param e unit vector along the line from the first to the second particle
+ *  \param dr_inv non-dimensionalized inverted distance between the particles
+ */
+template <typename T>
+DEVICE_FUNC void ft_pair_mobility(multi_array<T, 3> const &e, T dr_inv,
+                                  multi_array<T, 3, 3> &mob_a,
+                                  multi_array<T, 3, 3> &mob_b,
+                                  multi_array<T, 3, 3> &mob_c) {
+    T dr_inv2 = dr_inv * dr_inv;
+    T dr_inv3 = dr_inv2 * dr_inv;
+
+    // The following scalar mobility functions can be found in
+    // equation (A 3).
+    T x12a = T{3. / 2.} * dr_inv - dr_inv3;
+    T y12a = T{3. / 4.} * dr_inv + T{1. / 2.} * dr_inv3;
+
+    T y12b = T{-3. / 4.} * dr_inv2;
+
+    T x12c = T{3. / 4.} * dr_inv3;
+    T y12c = T{-3. / 8.} * dr_inv3;
+
+    ft_pair_tensors(e, x12a, y12a, y12b, x12c, y12c, mob_a, mob_b, mob_c);
+}
+
 /** The functor that computes all pair contributions to the mobility matrix.
  *  For further information, see the description of \ref mobility .
  */
-template <typename Policy, typename T>
-struct mobility<Policy, T, false> {
+template <typename Policy, typename T, typename Mode>
+struct mobility<Policy, T, false, Mode> {
     device_matrix_view<T, Policy> zmuf, zmus, zmes;
-    device_matrix_view<T, Policy> const pd;
-    device_matrix_view<std::size_t, Policy> const part_id;
+    /** particle positions, see \ref pair_distance */
+    device_vector_view<T, Policy> const x;
+    std::size_t const n_part;
     device_vector_view<T, Policy> const a;
     T const eta;
     int const flg;
+    /** periodic images, only used in F-T mode */
+    ewald_sum<T> const ewald = {};
 
     // Determine the pair contribution
     DEVICE_FUNC void operator()(std::size_t pair_id) {
+        // particle ids of the involved particles
+        std::size_t ph1, ph2;
+        thrust_wrapper::tie(ph1, ph2) = unravel_triangular_index(pair_id, n_part);
+        // These are the non-dimensionalizations as stated in the paragraph
+        // below equation (A 1).
+        // However, modified, so that the case with two unequal spheres is
+        // covered.
+        T a12 = T{.5} * (Mode::radius(a, ph1) + Mode::radius(a, ph2));
+        auto const visc1 = T{M_1_PI / 6. / eta / a12};
+        auto const visc2 = T{visc1 / a12};
+        auto const visc3 = T{visc2 / a12};
+
+        // Unit vector along particle connection line as described in
+        // paragraph below equation (A 1).
+        multi_array<T, 3> e;
+        T const dr = pair_distance(x, ph1, ph2, e, ewald);
+        // Non-dimensionalized inverted distance between particles 1/r
+        T dr_inv = a12 / dr;
+
+        // Equation (A 2) first, second, and third line
+        multi_array<T, 3, 3> mob_a;
+        multi_array<T, 3, 3> mob_b;
+        multi_array<T, 3, 3> mob_c;
+        if (ewald.enabled()) {
+            ewald.ft_pair_mobility(e, dr, a12, mob_a, mob_b, mob_c);
+        } else {
+            ft_pair_mobility(e, dr_inv, mob_a, mob_b, mob_c);
+        }
+
+        // Fill the pair mobility terms. All the necessary values have been
+        // computed in the previous lines of code. Now they need to be
+        // distributed to the correct locations in the grand mobility matrix.
+
+        // Compute where the various submatrices of the current particle pair
+        // are located in the grand mobility matrix.
+        // For velocities/forces, there are 6 independent components.
+        // (3 translation and 3 rotation)
+        // For shear rate/stresslets there are 5 independent components.
+        std::size_t ph5 = 5 * ph1;
+        std::size_t ph6 = 5 * ph2;
+
+        ph1 = 6 * ph1;
+        ph2 = 6 * ph2;
+
+        std::size_t ph3 = ph1 + 3;
+        std::size_t ph4 = ph2 + 3;
+
+        // Now copy values into the correct locations in the "big" matrix
+        // and apply scaling
+        for (std::size_t i = 0; i < 3; ++i) {
+            for (std::size_t j = 0; j < 3; ++j) {
+                zmuf(ph1 + i, ph2 + j) = visc1 * mob_a(i, j);
+                zmuf(ph3 + i, ph2 + j) = visc2 * mob_b(i, j);
+                zmuf(ph1 + i, ph4 + j) =
+                    -visc2 * mob_b(j, i); // mob_b transpose
+                zmuf(ph3 + i, ph4 + j) = visc3 * mob_c(i, j);
+
+                zmuf(ph2 + i, ph1 + j) = visc1 * mob_a(j, i);
+                zmuf(ph4 + i, ph1 + j) = visc2 * mob_b(j, i);
+                zmuf(ph2 + i, ph3 + j) =
+                    -visc2 * mob_b(i, j); // mob_b transpose
+                zmuf(ph4 + i, ph3 + j) = visc3 * mob_c(j, i);
+            }
+        }
+
+        // The stresslet couplings only exist in FTS mode, in F-T mode zmus
+        // and zmes are not even allocated.
+        if (Mode::fts(flg)) {
+            add_stresslets(e, dr_inv, visc2, visc3, ph1, ph2, ph5, ph6);
+        }
+    }
+
+    /** Fill the pair blocks of zmus and zmes, equation (A 2) fourth to
+     *  sixth line, with the geometry and the block offsets of operator().
+     */
+    DEVICE_FUNC void add_stresslets(multi_array<T, 3> const &e, T dr_inv,
+                                    T visc2, T visc3, std::size_t ph1,
+                                    std::size_t ph2, std::size_t ph5,
+                                    std::size_t ph6) {
         // Kronecker-Delta
         static constexpr multi_array<T, 3, 3> const delta = {
             // clang-format off
@@ -318,28 +1124,8 @@ struct mobility<Policy, T, false> {
             // clang-format on
         };
 
-        // particle ids of the involved particles
-        std::size_t ph1 = part_id(0, pair_id);
-        std::size_t ph2 = part_id(1, pair_id);
-        // These are the non-dimensionalizations as stated in the paragraph
-        // below equation (A 1).
-        // However, modified, so that the case with two unequal spheres is
-        // covered.
-        T a12 = T{.5} * (a(ph1) + a(ph2));
-        auto const visc1 = T{M_1_PI / 6. / eta / a12};
-        auto const visc2 = T{visc1 / a12};
-        auto const visc3 = T{visc2 / a12};
-
-        // Components of unit vector along particle connection line as
-        // described in paragraph below equation (A 1).
-        T dx = pd(0, pair_id);
-        T dy = pd(1, pair_id);
-        T dz = pd(2, pair_id);
-        // Non-dimensionalized inverted distance between particles 1/r
-        T dr_inv = a12 / pd(3, pair_id);
-
-        // Combine components into unit vector along particle connection line
-        multi_array<T, 3> e = {dx, dy, dz};
+        std::size_t const ph3 = ph1 + 3;
+        std::size_t const ph4 = ph2 + 3;
 
         // This creates a lookup-table for the many e_i * e_j like
         // multiplications in equation (A 2).
@@ -353,14 +1139,6 @@ struct mobility<Policy, T, false> {
 
         // The following scalar mobility functions can be found in
         // equation (A 3).
-        T x12a = T{3. / 2.} * dr_inv - dr_inv3;
-        T y12a = T{3. / 4.} * dr_inv + T{1. / 2.} * dr_inv3;
-
-        T y12b = T{-3. / 4.} * dr_inv2;
-
-        T x12c = T{3. / 4.} * dr_inv3;
-        T y12c = T{-3. / 8.} * dr_inv3;
-
         T x12g = T{9. / 4.} * dr_inv2 - T{18. / 5.} * dr_inv4;
         T y12g = T{6. / 5.} * dr_inv4;
 
@@ -370,22 +1148,6 @@ struct mobility<Policy, T, false> {
         T y12m = T{9. / 4.} * dr_inv3 - T{36. / 5.} * dr_inv5;
         T z12m = T{9. / 5.} * dr_inv5;
 
-        // Equation (A 2) first, second, and third line
-        multi_array<T, 3, 3> mob_a;
-        multi_array<T, 3, 3> mob_b;
-        multi_array<T, 3, 3> mob_c;
-        for (std::size_t i = 0; i < 3; ++i) {
-            for (std::size_t j = 0; j < 3; ++j) {
-                // if i and j are different from one another, this returns the
-                // "other" index missing in the set {0, 1, 2}
-                std::size_t k = (3 - i - j) % 3;
-
-                mob_a(i, j) = x12a * ee(i, j) + y12a * (delta(i, j) - ee(i, j));
-                mob_b(i, j) = y12b * eps(i, j, k) * e(k);
-                mob_c(i, j) = x12c * ee(i, j) + y12c * (delta(i, j) - ee(i, j));
-            }
-        }
-
         // Equation (A 2) fourth and fifth line
         multi_array<T, 3, 3, 3> gt;
         multi_array<T, 3, 3, 3> ht;
@@ -486,41 +1248,7 @@ struct mobility<Policy, T, false> {
             }
         }
 
-        // Fill the pair mobility terms. All the necessary values have been
-        // computed in the previous lines of code. Now they need to be
-        // distributed to the correct locations in the grand mobility matrix.
-
-        // Compute where the various submatrices of the current particle pair
-        // are located in the grand mobility matrix.
-        // For velocities/forces, there are 6 independent components.
-        // (3 translation and 3 rotation)
-        // For shear rate/stresslets there are 5 independent components.
-        std::size_t ph5 = 5 * ph1;
-        std::size_t ph6 = 5 * ph2;
-
-        ph1 = 6 * ph1;
-        ph2 = 6 * ph2;
-
-        std::size_t ph3 = ph1 + 3;
-        std::size_t ph4 = ph2 + 3;
-
-        // Now copy values into the correct locations in the "big" matrix
-        // and apply scaling
         for (std::size_t i = 0; i < 3; ++i) {
-            for (std::size_t j = 0; j < 3; ++j) {
-                zmuf(ph1 + i, ph2 + j) = visc1 * mob_a(i, j);
-                zmuf(ph3 + i, ph2 + j) = visc2 * mob_b(i, j);
-                zmuf(ph1 + i, ph4 + j) =
-                    -visc2 * mob_b(j, i); // mob_b transpose
-                zmuf(ph3 + i, ph4 + j) = visc3 * mob_c(i, j);
-
-                zmuf(ph2 + i, ph1 + j) = visc1 * mob_a(j, i);
-                zmuf(ph4 + i, ph1 + j) = visc2 * mob_b(j, i);
-                zmuf(ph2 + i, ph3 + j) =
-                    -visc2 * mob_b(i, j); // mob_b transpose
-                zmuf(ph4 + i, ph3 + j) = visc3 * mob_c(j, i);
-            }
-
             for (std::size_t j = 0; j < 5; ++j) {
                 // The paragraph under equation (A 1) claims that we would need
                 // exponent n=3, but n=2 yields correct results.
@@ -547,128 +1275,182 @@ struct mobility<Policy, T, false> {
 
 
 /** The lubrication functor adds pair wise interactions to the resistance
- *  matrix. This section of code has not been thoroughly commented yet.
+ *  matrix, in two passes, one over the pairs and one over the particles,
+ *  see \ref lubrication_pair and \ref lubrication_particle.
+ *  This section of code has not been thoroughly commented yet.
  *  Most of the comments are an educated guess of what is happening.
  */
-template <typename Policy, typename T>
+template <typename Policy, typename T, typename Mode = runtime_mode>
 struct lubrication {
     device_matrix_view<T, Policy> rfu, rfe, rse;
-    device_matrix_view<T, Policy> const pd;
-    device_matrix_view<std::size_t, Policy> const part_id;
+    /** particle positions, see \ref pair_distance */
+    device_vector_view<T, Policy> const x;
+    std::size_t const n_part;
     device_vector_view<T, Policy> const a;
     T const eta;
     int const flg;
+    /** periodic box, the minimum image of each pair is used if enabled */
+    ewald_sum<T> const ewald = {};
+
+    // Whether two particles at distance dr with mean radius a12 are close
+    // enough for lubrication interactions
+    DEVICE_FUNC static bool in_range(T dr, T a12) { return dr / a12 < T{4.0}; }
+
+    /** number of values per particle of a pair in the buffers of the
+     *  corrections to the diagonal blocks, see \ref diagonal_blocks
+     */
+    DEVICE_FUNC static std::size_t self_size(int flg) {
+        return Mode::fts(flg) ? 36 + 30 + 25 : 36;
+    }
 
     // Add the lubrication forces to the mobility inverse (i.e. the grand
     // resistance matrix).
-    // Lubrication interactions are added pair-wise.
-    DEVICE_FUNC void operator()(std::size_t pair_id) {
-        T dx = pd(0, pair_id);
-        T dy = pd(1, pair_id);
-        T dz = pd(2, pair_id);
-        multi_array<T, 3> d = {dx, dy, dz};
-        T dr = pd(3, pair_id);
+    // Lubrication interactions are added pair-wise. Many pairs share a
+    // particle, so the corrections to the diagonal blocks are not added
+    // right away. They are written to self_i and self_j instead and added up
+    // per particle by add_diagonal. This way, the pairs can be processed in
+    // parallel without conflicting writes. Pairs beyond the cutoff leave
+    // zeros there.
+    DEVICE_FUNC void add_off_diagonal(std::size_t pair_id, T *self_i,
+                                      T *self_j) {
+        std::size_t i, j;
+        thrust_wrapper::tie(i, j) = unravel_triangular_index(pair_id, n_part);
+
+        multi_array<T, 3> d;
+        T dr = pair_distance(x, i, j, d, ewald);
 
         // non-dimensionalization of the distance for lubrication cutoff
         // TODO: is that actually correct for spheres with different radii?
-        T a12 = T{.5} * (a(part_id(0, pair_id)) + a(part_id(1, pair_id)));
-
-        if (dr/a12 < 4.0) {
-
-            // Compute indices that are needed to fill in the results of
-            // calc_lub() into the correct locations of the grand resistance
-            // matrix (the mobility inverse).
-            std::size_t i = part_id(0, pair_id);
-            std::size_t j = part_id(1, pair_id);
-
-            std::size_t ira = i * 6;
-            std::size_t irg = ira;
-            std::size_t irm = i * 5;
-            std::size_t icg = irm;
-
-            std::size_t jca = j * 6;
-            std::size_t jrg = jca;
-            std::size_t jcm = j * 5;
-            std::size_t jcg = jcm;
-
-            // Compute the actual lubrication correction
-            multi_array<T, 12, 12> tabc;
-            multi_array<T, 12, 10> tght;
-            multi_array<T, 10, 10> tzm;
-            calc_lub(pair_id, dr, d, tabc, tght, tzm);
-
-            // Fill in the values to the appropriate locations in the
-            // mobility inverse.
-            for (std::size_t jc = 0; jc < 6; ++jc) {
-                std::size_t jl = jc + 6;
-                std::size_t j1 = ira + jc;
-                std::size_t j2 = jca + jc;
-
-                for (std::size_t ir = 0; ir < jc + 1; ++ir) {
+        T a12 = T{.5} * (Mode::radius(a, i) + Mode::radius(a, j));
+
+        if (!in_range(dr, a12)) {
+            for (std::size_t k = 0; k < self_size(flg); ++k) {
+                self_i[k] = T{0.0};
+                self_j[k] = T{0.0};
+            }
+            return;
+        }
+
+        // Compute indices that are needed to fill in the results of
+        // calc_lub() into the correct locations of the grand resistance
+        // matrix (the mobility inverse).
+
+        std::size_t ira = i * 6;
+        std::size_t irg = ira;
+        std::size_t irm = i * 5;
+        std::size_t icg = irm;
+
+        std::size_t jca = j * 6;
+        std::size_t jrg = jca;
+        std::size_t jcm = j * 5;
+        std::size_t jcg = jcm;
+
+        // Compute the actual lubrication correction
+        multi_array<T, 12, 12> tabc;
+        multi_array<T, 12, 10> tght;
+        multi_array<T, 10, 10> tzm;
+        calc_lub(i, j, dr, d, tabc, tght, tzm);
+        diagonal_blocks(tabc, tght, tzm, self_i, self_j);
+
+        // Fill in the values to the appropriate locations in the
+        // mobility inverse.
+        for (std::size_t jc = 6; jc < 12; ++jc) {
+            std::size_t j1 = jca + jc - 6;
+
+            for (std::size_t ir = 0; ir < 6; ++ir) {
+                std::size_t i1 = ira + ir;
+
+                rfu(i1, j1) += tabc(ir, jc);
+            }
+        }
+
+        if (Mode::fts(flg)) {
+            for (std::size_t jc = 0; jc < 5; ++jc) {
+                std::size_t jl = jc + 5;
+                std::size_t j1 = icg + jc;
+                std::size_t j2 = jcg + jc;
+
+                for (std::size_t ir = 0; ir < 6; ++ir) {
                     std::size_t il = ir + 6;
-                    std::size_t i1 = ira + ir;
-                    std::size_t i2 = jca + ir;
+                    std::size_t i1 = irg + ir;
+                    std::size_t i2 = jrg + ir;
 
-                    rfu(i1, j1) += tabc(ir, jc);
-                    rfu(i2, j2) += tabc(il, jl);
+                    rfe(i1, j2) += tght(ir, jl);
+                    rfe(i2, j1) += tght(il, jc);
                 }
             }
-            for (std::size_t jc = 6; jc < 12; ++jc) {
-                std::size_t j1 = jca + jc - 6;
+            for (std::size_t jc = 5; jc < 10; ++jc) {
+                std::size_t j1 = jcm + jc - 5;
 
-                for (std::size_t ir = 0; ir < 6; ++ir) {
-                    std::size_t i1 = ira + ir;
+                for (std::size_t ir = 0; ir < 5; ++ir) {
+                    std::size_t i1 = irm + ir;
 
-                    rfu(i1, j1) += tabc(ir, jc);
+                    rse(i1, j1) += tzm(ir, jc);
                 }
             }
+        }
+    }
 
-            if (flg & flags::FTS) {
-                for (std::size_t jc = 0; jc < 5; ++jc) {
-                    std::size_t jl = jc + 5;
-                    std::size_t j1 = icg + jc;
-                    std::size_t j2 = jcg + jc;
-
-                    for (std::size_t ir = 0; ir < 6; ++ir) {
-                        std::size_t il = ir + 6;
-                        std::size_t i1 = irg + ir;
-                        std::size_t i2 = jrg + ir;
-
-                        rfe(i1, j1) += tght(ir, jc);
-                        rfe(i2, j2) += tght(il, jl);
-                        rfe(i1, j2) += tght(ir, jl);
-                        rfe(i2, j1) += tght(il, jc);
-                    }
+    // Add the corrections to the diagonal blocks of particle i from one of
+    // its pairs, as written by add_off_diagonal. Only the upper triangles of
+    // the symmetric blocks are filled in.
+    DEVICE_FUNC void add_diagonal(std::size_t i, T const *self) {
+        for (std::size_t c = 0; c < 6; ++c) {
+            for (std::size_t r = 0; r < c + 1; ++r) {
+                rfu(6 * i + r, 6 * i + c) += self[r + 6 * c];
+            }
+        }
+
+        if (Mode::fts(flg)) {
+            for (std::size_t c = 0; c < 5; ++c) {
+                for (std::size_t r = 0; r < 6; ++r) {
+                    rfe(6 * i + r, 5 * i + c) += self[36 + r + 6 * c];
                 }
-                for (std::size_t jc = 0; jc < 5; ++jc) {
-                    std::size_t jl = jc + 5;
-                    std::size_t j1 = irm + jc;
-                    std::size_t j2 = jcm + jc;
-
-                    for (std::size_t ir = 0; ir < jc + 1; ++ir) {
-                        std::size_t il = ir + 5;
-                        std::size_t i1 = irm + ir;
-                        std::size_t i2 = jcm + ir;
-
-                        rse(i1, j1) += tzm(ir, jc);
-                        rse(i2, j2) += tzm(il, jl);
-                    }
+            }
+            for (std::size_t c = 0; c < 5; ++c) {
+                for (std::size_t r = 0; r < c + 1; ++r) {
+                    rse(5 * i + r, 5 * i + c) += self[66 + r + 5 * c];
                 }
-                for (std::size_t jc = 5; jc < 10; ++jc) {
-                    std::size_t j1 = jcm + jc - 5;
+            }
+        }
+    }
 
-                    for (std::size_t ir = 0; ir < 5; ++ir) {
-                        std::size_t i1 = irm + ir;
+    // Copy the corrections to the diagonal blocks of both particles out of
+    // the results of calc_lub: the 6x6 block of rfu, followed by the 6x5
+    // block of rfe and the 5x5 block of rse in FTS mode, each stored
+    // column-major. calc_lub only fills in the upper triangles of the
+    // symmetric blocks, they are completed here.
+    DEVICE_FUNC void diagonal_blocks(multi_array<T, 12, 12> const &tabc,
+                                     multi_array<T, 12, 10> const &tght,
+                                     multi_array<T, 10, 10> const &tzm,
+                                     T *self_i, T *self_j) const {
+        for (std::size_t c = 0; c < 6; ++c) {
+            for (std::size_t r = 0; r < 6; ++r) {
+                self_i[r + 6 * c] = r <= c ? tabc(r, c) : tabc(c, r);
+                self_j[r + 6 * c] =
+                    r <= c ? tabc(6 + r, 6 + c) : tabc(6 + c, 6 + r);
+            }
+        }
 
-                        rse(i1, j1) += tzm(ir, jc);
-                    }
+        if (Mode::fts(flg)) {
+            for (std::size_t c = 0; c < 5; ++c) {
+                for (std::size_t r = 0; r < 6; ++r) {
+                    self_i[36 + r + 6 * c] = tght(r, c);
+                    self_j[36 + r + 6 * c] = tght(6 + r, 5 + c);
+                }
+            }
+            for (std::size_t c = 0; c < 5; ++c) {
+                for (std::size_t r = 0; r < 5; ++r) {
+                    self_i[66 + r + 5 * c] = r <= c ? tzm(r, c) : tzm(c, r);
+                    self_j[66 + r + 5 * c] =
+                        r <= c ? tzm(5 + r, 5 + c) : tzm(5 + c, 5 + r);
                 }
             }
         }
     }
 
     // Computes the pair-wise lubrication interactions between particle pairs
-    DEVICE_FUNC void calc_lub(std::size_t pair_id, double dr,
+    DEVICE_FUNC void calc_lub(std::size_t ph1, std::size_t ph2, double dr,
                               multi_array<T, 3> const &d,
                               multi_array<T, 12, 12> &tabc,
                               multi_array<T, 12, 10> &tght,
@@ -698,20 +1480,17 @@ struct lubrication {
 
 #include "lubrication_data.inl"
 
-        std::size_t ph1 = part_id(0, pair_id);
-        std::size_t ph2 = part_id(1, pair_id);
-
-        T a11 = a(ph1);
+        T a11 = Mode::radius(a, ph1);
         auto const visc11_1 = T{M_PI * 6. * eta * a11};
         auto const visc11_2 = T{visc11_1 * a11};
         auto const visc11_3 = T{visc11_2 * a11};
 
-        T a22 = a(ph2);
+        T a22 = Mode::radius(a, ph2);
         auto const visc22_1 = T{M_PI * 6. * eta * a22};
         auto const visc22_2 = T{visc22_1 * a22};
         auto const visc22_3 = T{visc22_2 * a22};
 
-        T a12 = T{.5} * (a(ph1) + a(ph2));
+        T a12 = T{.5} * (a11 + a22);
         auto const visc12_1 = T{M_PI * 6. * eta * a12};
         auto const visc12_2 = T{visc12_1 * a12};
         auto const visc12_3 = T{visc12_2 * a12};
@@ -785,48 +1564,47 @@ struct lubrication {
 
         // Intermediate regime
         } else {
-            auto ida = static_cast<int>(20. * (dr - 2));
-            int ib = -2 + ida;
-            int ia = ib + 1;
-
-            double c1 = (dr - rsabc[ib]) / (rsabc[ia] - rsabc[ib]);
-
-            x11a = (x11as[ia] - x11as[ib]) * c1 + x11as[ib];
-            x12a = (x12as[ia] - x12as[ib]) * c1 + x12as[ib];
-            y11a = (y11as[ia] - y11as[ib]) * c1 + y11as[ib];
-            y12a = (y12as[ia] - y12as[ib]) * c1 + y12as[ib];
-
-            y11b = (y11bs[ia] - y11bs[ib]) * c1 + y11bs[ib];
-            y12b = (y12bs[ia] - y12bs[ib]) * c1 + y12bs[ib];
-
-            y11c = (y11cs[ia] - y11cs[ib]) * c1 + y11cs[ib];
-            y12c = (y12cs[ia] - y12cs[ib]) * c1 + y12cs[ib];
-            x11c = (x11cs[ia] - x11cs[ib]) * c1 + x11cs[ib];
-            x12c = (x12cs[ia] - x12cs[ib]) * c1 + x12cs[ib];
-
-            if (dr < 2.2) {
-                ib = -10 + static_cast<int>(100. * (dr - 2));
-            } else {
-                ib = 6 + ida;
+            // Linear interpolation between two neighbouring rows of the
+            // table. The position is clamped to the last interval instead of
+            // branching on it, beyond r = 4 all functions vanish as in the
+            // last row.
+            double t = (dr - lub_table_min) / lub_table_step;
+            t = t < lub_table_nodes - 1 ? t : lub_table_nodes - 1;
+            auto ib = static_cast<std::size_t>(t);
+            ib = ib < lub_table_nodes - 2 ? ib : lub_table_nodes - 2;
+            double const c = t - static_cast<double>(ib);
+
+            double const *lo = lub_table + ib * lub_table_functions;
+            double const *hi = lo + lub_table_functions;
+            double f[lub_table_functions];
+            for (std::size_t k = 0; k < lub_table_functions; ++k) {
+                f[k] = (hi[k] - lo[k]) * c + lo[k];
             }
 
-            ia = ib + 1;
+            x11a = f[0];
+            x12a = f[1];
+            y11a = f[2];
+            y12a = f[3];
 
-            double cgh = (dr - rsgh[ib]) / (rsgh[ia] - rsgh[ib]);
+            y11b = f[4];
+            y12b = f[5];
 
-            x11g = (x11gs[ia] - x11gs[ib]) * cgh + x11gs[ib];
-            x12g = (x12gs[ia] - x12gs[ib]) * cgh + x12gs[ib];
-            y11g = (y11gs[ia] - y11gs[ib]) * cgh + y11gs[ib];
-            y12g = (y12gs[ia] - y12gs[ib]) * cgh + y12gs[ib];
+            x11c = f[6];
+            x12c = f[7];
+            y11c = f[8];
+            y12c = f[9];
 
-            y11h = (y11hs[ia] - y11hs[ib]) * cgh + y11hs[ib];
-            y12h = (y12hs[ia] - y12hs[ib]) * cgh + y12hs[ib];
+            x11g = f[10];
+            x12g = f[11];
+            y11g = f[12];
+            y12g = f[13];
 
-            double cm = (dr - rsm[ib]) / (rsm[ia] - rsm[ib]);
+            y11h = f[14];
+            y12h = f[15];
 
-            xm = (xms[ia] - xms[ib]) * cm + xms[ib];
-            ym = (yms[ia] - yms[ib]) * cm + yms[ib];
-            zm = (zms[ia] - zms[ib]) * cm + zms[ib];
+            xm = f[16];
+            ym = f[17];
+            zm = f[18];
         }
         // The scalar resistance functions have been computed.
         // The next goal is to form all the sub-tensors, i.e. contributions to
@@ -960,7 +1738,7 @@ struct lubrication {
             }
         }
 
-        if (!(flg & flags::FTS)) {
+        if (!Mode::fts(flg)) {
             return;
         }
 
@@ -1232,15 +2010,80 @@ struct lubrication {
     }
 };
 
+/** Predicate that selects the pairs within the lubrication cutoff. It is used
+ *  to compact the list of pairs, so that the \ref lubrication functor is only
+ *  launched for pairs which actually contribute.
+ */
+template <typename Policy, typename T, typename Mode = runtime_mode>
+struct lubrication_cutoff {
+    device_vector_view<T, Policy> const x;
+    std::size_t const n_part;
+    device_vector_view<T, Policy> const a;
+    /** periodic box, the minimum image of each pair is used if enabled */
+    ewald_sum<T> const ewald = {};
+
+    DEVICE_FUNC bool operator()(std::size_t pair_id) const {
+        std::size_t i, j;
+        thrust_wrapper::tie(i, j) = unravel_triangular_index(pair_id, n_part);
+        multi_array<T, 3> e;
+        return lubrication<Policy, T>::in_range(
+            pair_distance(x, i, j, e, ewald),
+            T{.5} * (Mode::radius(a, i) + Mode::radius(a, j)));
+    }
+};
+
+/** First pass of the lubrication correction: Adds the corrections of the
+ *  pair \p pairs[p] to the off-diagonal blocks of the grand resistance
+ *  matrix and stores those to the diagonal blocks in the entries 2p and
+ *  2p+1 of \p self, see \ref lubrication::add_off_diagonal.
+ */
+template <typename Policy, typename T, typename Mode = runtime_mode>
+struct lubrication_pair {
+    lubrication<Policy, T, Mode> lub;
+    device_vector_view<std::size_t, Policy> const pairs;
+    device_vector_view<T, Policy> self;
+
+    DEVICE_FUNC void operator()(std::size_t p) {
+        std::size_t const n_self = lub.self_size(lub.flg);
+        lub.add_off_diagonal(pairs(p), self.data() + n_self * (2 * p),
+                             self.data() + n_self * (2 * p + 1));
+    }
+};
+
+/** Second pass of the lubrication correction: Adds up the corrections to
+ *  the diagonal blocks of particle i, which \ref lubrication_pair stored for
+ *  the entries of the particle in the adjacency list, see
+ *  \ref sort_lubrication_entries.
+ */
+template <typename Policy, typename T, typename Mode = runtime_mode>
+struct lubrication_particle {
+    lubrication<Policy, T, Mode> lub;
+    device_vector_view<std::size_t, Policy> const offsets;
+    device_vector_view<std::size_t, Policy> const entries;
+    device_vector_view<T, Policy> const self;
+
+    DEVICE_FUNC void operator()(std::size_t i) {
+        std::size_t const n_self = lub.self_size(lub.flg);
+        for (std::size_t n = offsets(i); n < offsets(i + 1); ++n) {
+            lub.add_diagonal(i, self.data() + n_self * entries(n));
+        }
+    }
+};
+
 template <typename T>
 struct thermalizer {
     T sqrt_kT_Dt;
     std::size_t offset;
     std::size_t seed;
+    /** index of the first random number, so that several systems can draw
+     *  from one stream without correlations
+     */
+    std::size_t first_index;
 #if defined(__CUDACC__) || defined(__HIPCC__)
     __device__
 #endif
     T operator()(std::size_t index) {
+        index += first_index;
 #if defined(__CUDACC__)
         uint4 rnd_ints = curand_Philox4x32_10(make_uint4(offset >> 32, seed >> 32, index >> 32, index),
                                               make_uint2(offset, seed));
@@ -1283,313 +2126,3202 @@ struct thermalizer {
     }
 };
 
-/** Functor that takes all the relevant particle data (i.e. positions, radii,
-    external forces and torques) and computes the translational and angular
-    velocities. These can be used to propagate the system.
+/** Convert a list of pairs given by their particle indices, e.g. from a
+ *  Verlet list, into the sorted pair indices of \ref
+ *  ravel_triangular_index. Pairs of a particle with itself are dropped and
+ *  pairs that are listed more than once, e.g. as (i,j) and (j,i) by a full
+ *  neighbor list, are only kept once, so there are at most n(n-1)/2 ids.
+ *
+ *  \param pairs two particle indices per pair
+ */
+inline std::vector<std::size_t>
+triangular_pair_ids(std::vector<std::size_t> const &pairs,
+                    std::size_t n_part) {
+    assert(pairs.size() % 2 == 0);
+    std::vector<std::size_t> ids;
+    ids.reserve(pairs.size() / 2);
+    for (std::size_t k = 0; k + 1 < pairs.size(); k += 2) {
+        std::size_t i = pairs[k];
+        std::size_t j = pairs[k + 1];
+        if (i == j) {
+            continue;
+        }
+        if (i > j) {
+            std::swap(i, j);
+        }
+        assert(j < n_part);
+        ids.push_back(ravel_triangular_index(i, j, n_part));
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
 
-    The basic idea of the method is as follows: The Stokes equation is linear,
-    i.e. the relations between force and motion (velocity) is purely linear.
-    All forces and torques that act on individual particles are merged into
-    one large vector. All velocities and angular velocities of individual
-    particles are merged into one vector alike.
-    The relationship between force and velocity is now given by the so-called
-    grand mobility matrix, or its inverse, the resistance matrix:
+/** Matrix-free product of the F-T mobility matrix with a vector,
+ *  y = M_UF * v. Every particle sums up the contributions of all other
+ *  particles on the fly, so neither the mobility matrix nor the pair
+ *  distances are stored, and the particles are processed in parallel
+ *  without write conflicts. The blocks are the same as those filled in by
+ *  the \ref mobility functors. This direct sum takes O(n_part^2)
+ *  operations per product, see \ref iterative_solver.
+ */
+template <typename Policy, typename T>
+struct far_field_mobility {
+    device_vector_view<T, Policy> const x;
+    device_vector_view<T, Policy> const a;
+    device_vector_view<T, Policy> const v;
+    device_vector_view<T, Policy> y;
+    std::size_t const n_part;
+    T const eta;
+    int const flg;
 
-            \f[\vec{U} = M_{UF} \vec{F}\f]
+    DEVICE_FUNC void operator()(std::size_t i) {
+        T yi[6] = {0, 0, 0, 0, 0, 0};
 
-    where \f$\vec{F}\f$ is the force, \f$\vec{U}\f$ the velocities and \f$M\f$
-    the grand mobility matrix. The subscript \f$_{UF}\f$ indicates that this
-    tensor describes the relationship between forces and velocities.
-    the relationship between forces and velocities.
-    The mobility matrix depends on the positions of all particles and therefore
-    is only valid for the momentary configuration. It needs to be recalculated
-    each time step.
+        if (flg & flags::SELF_MOBILITY) {
+            auto const visc1 = T{M_1_PI / 6. / eta / a(i)};
+            auto const visc3 = T{visc1 / a(i) / a(i)};
+            for (std::size_t k = 0; k < 3; ++k) {
+                yi[k] += visc1 * v(6 * i + k);
+                yi[3 + k] += visc3 * T{3. / 4.} * v(6 * i + 3 + k);
+            }
+        }
 
-    To obtain the velocities, the mobility matrix must be applied to the forces
-    that act on the particles, giving the velocities.
+        if (flg & flags::PAIR_MOBILITY) {
+            for (std::size_t j = 0; j < n_part; ++j) {
+                if (j == i) {
+                    continue;
+                }
+                multi_array<T, 3> e;
+                T const dr = pair_distance(x, i, j, e);
+                T const a12 = T{.5} * (a(i) + a(j));
+                auto const visc1 = T{M_1_PI / 6. / eta / a12};
+                auto const visc2 = T{visc1 / a12};
+                auto const visc3 = T{visc2 / a12};
+
+                multi_array<T, 3, 3> mob_a;
+                multi_array<T, 3, 3> mob_b;
+                multi_array<T, 3, 3> mob_c;
+                ft_pair_mobility(e, a12 / dr, mob_a, mob_b, mob_c);
+
+                // mob_b is antisymmetric and odd in e, therefore the block
+                // that couples particle i to particle j has the same form
+                // for i < j and i > j, compare the pair mobility functor.
+                for (std::size_t r = 0; r < 3; ++r) {
+                    for (std::size_t c = 0; c < 3; ++c) {
+                        T const vt = v(6 * j + c);
+                        T const vr = v(6 * j + 3 + c);
+                        yi[r] += visc1 * mob_a(r, c) * vt +
+                                 visc2 * mob_b(r, c) * vr;
+                        yi[3 + r] += visc2 * mob_b(r, c) * vt +
+                                     visc3 * mob_c(r, c) * vr;
+                    }
+                }
+            }
+        }
 
-    These are the steps that are taken to compute the grand mobility matrix:
-      -# Starting point is an empty mobility matrix.
-      -# All self mobility terms are added. Its translational part is widely
-         known as Stokes' Law.
-      -# All pair mobility terms are added.
-      -# The mobility matrix is inverted to become a resistance matrix.
-      -# Lubrication corrections are added to the resistance matrix. They are
-         necessary for particles in close vicinity because simplifications
-         have been made to efficiently cover long range interactions.
-      -# In the end, the finished resistance matrix is inverted again. The
-         result is the finished mobility matrix that includes the short-ranged
-         lubrication interactions.
+        for (std::size_t k = 0; k < 6; ++k) {
+            y(6 * i + k) = yi[k];
+        }
+    }
+};
 
-    The thermalisation is achieved by a generalization of the
-    Einstein-Smoluchowski equation, which relates mobility and diffusion:
+/** Every pair is listed twice in the near-field adjacency list, once for
+ *  each of its particles. Entry 2p refers to the first and 2p+1 to the
+ *  second particle of pair p. This functor returns the particle an entry
+ *  belongs to, which serves as key to sort the entries by particle.
+ *  The pairs of a batch of systems are enumerated by (system, pair), see
+ *  \ref batched_lubrication_pair, then the particles are enumerated by
+ *  (system, particle).
+ */
+template <typename Policy>
+struct lubrication_entry_particle {
+    device_vector_view<std::size_t, Policy> const pairs;
+    std::size_t const n_part;
 
-            \f[D = \mu k_B T\f]
+    DEVICE_FUNC std::size_t operator()(std::size_t entry) const {
+        std::size_t const n_pair = n_part * (n_part - 1) / 2;
+        std::size_t const system = pairs(entry / 2) / n_pair;
+        std::size_t i, j;
+        thrust_wrapper::tie(i, j) =
+            unravel_triangular_index(pairs(entry / 2) % n_pair, n_part);
+        return system * n_part + (entry % 2 ? j : i);
+    }
+};
 
-    where \f$\mu\f$ is the mobility and \f$D\f$ is the diffusion coefficient.
-    The mean square displacement during a time step of length \f$\Delta t\f$,
-    and along one degree of freedom is given by
+/** Sort the entries of the adjacency list of the first \p n_lub \p pairs by
+ *  particle, see \ref lubrication_entry_particle. Afterwards, the entries of
+ *  particle i are entries[offsets[i]] to entries[offsets[i+1] - 1].
+ *
+ *  \param n_systems number of systems if the pairs of a batch are given
+ */
+template <typename Policy>
+void sort_lubrication_entries(
+    typename Policy::template vector<std::size_t> &pairs, std::size_t n_lub,
+    std::size_t n_part, std::size_t n_systems,
+    typename Policy::template vector<std::size_t> &keys,
+    typename Policy::template vector<std::size_t> &entries,
+    typename Policy::template vector<std::size_t> &offsets) {
+    thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+    keys.resize(2 * n_lub);
+    entries.resize(2 * n_lub);
+    offsets.resize(n_systems * n_part + 1);
+    thrust_wrapper::tabulate(
+        Policy::par(), keys.begin(), keys.end(),
+        lubrication_entry_particle<Policy>{pairs, n_part});
+    thrust_wrapper::copy(begin, begin + 2 * n_lub, entries.begin());
+    thrust_wrapper::sort_by_key(Policy::par(), keys.begin(), keys.end(),
+                                entries.begin());
+    thrust_wrapper::lower_bound(Policy::par(), keys.begin(), keys.end(),
+                                begin, begin + n_systems * n_part + 1,
+                                offsets.begin());
+}
 
-            \f[\langle \Delta x^2 \rangle / \Delta t = 2 D\f]
+/** Offset of the first block of block row i of a near-field matrix. Every
+ *  block row holds the diagonal block followed by one block per entry of
+ *  the particle in the adjacency list.
+ */
+template <typename Policy>
+struct near_field_row_offset {
+    device_vector_view<std::size_t, Policy> const offsets;
 
-    By combining these two equations we get the random displacement, which we
-    can then directly use to propagate the particles:
+    DEVICE_FUNC std::size_t operator()(std::size_t i) const {
+        return i + offsets(i);
+    }
+};
 
-            \f[\Delta x = \sqrt{2 k_B T \Delta t} \times \mu^{1/2} \cdot \Phi\f]
+/** Position of the off-diagonal block of every adjacency list entry in the
+ *  near-field matrices. \p keys and \p entries are the sorted adjacency
+ *  list, the n-th entry is preceded by the diagonal blocks of particles
+ *  0 to keys[n].
+ */
+template <typename Policy>
+struct near_field_slot {
+    device_vector_view<std::size_t, Policy> const keys;
+    device_vector_view<std::size_t, Policy> const entries;
+    device_vector_view<std::size_t, Policy> slots;
+
+    DEVICE_FUNC void operator()(std::size_t n) {
+        slots(entries(n)) = keys(n) + 1 + n;
+    }
+};
 
-    where \f$\Phi\f$ is a random number drawn from a zero mean and unit
-    variance distribution.
-    That way we can determine the random displacement that our system
-    experiences along one of its many degrees of freedom. In our case,
-    \f$\mu\f$ is a matrix and we need its square root. The latter is
-    obtained via Cholesky decomposition. And \f$\Phi\f$ is a vector filled with
-    random numbers from a zero mean and unit variance distribution.
+/** Computes the lubrication correction of one pair and writes it into the
+ *  block sparse near-field matrices of \ref near_field_resistance, instead
+ *  of adding it to the dense resistance matrix like the \ref lubrication
+ *  functor does. The off-diagonal blocks of a pair have their own slots, so
+ *  they are written directly. The corrections to the diagonal blocks are
+ *  shared with the other pairs of the particles, they are stored per entry
+ *  and summed up afterwards by \ref near_field_diagonal.
  */
 template <typename Policy, typename T>
-struct solver {
-    static_assert(policy::is_policy<Policy>::value,
-                  "The execution policy must meet the requirements");
-    static_assert(std::is_arithmetic<T>::value,
-                  "Data type of device_matrix must be arithmetic for "
-                  "arithmetic operations");
-
-    template <typename U>
-    using vector_type = typename Policy::template vector<U>;
-
-    /** viscosity of the Stokes fluid */
-    T const eta;
-    /** number of particles */
+struct near_field_pair {
+    device_vector_view<T, Policy> const x;
+    device_vector_view<T, Policy> const a;
+    device_vector_view<std::size_t, Policy> const pairs;
+    device_vector_view<std::size_t, Policy> const slots;
+    device_vector_view<T, Policy> self;
+    device_vector_view<T, Policy> rfu;
+    device_vector_view<std::size_t, Policy> rfu_cols;
+    device_vector_view<T, Policy> rfe;
+    device_vector_view<std::size_t, Policy> rfe_cols;
+    device_vector_view<T, Policy> rse;
+    device_vector_view<std::size_t, Policy> rse_cols;
     std::size_t const n_part;
-    /** number of pairs of particles = n_part*(n_part-1)/2 */
-    std::size_t const n_pair;
-
-
-
-    /** Initialization of the SD solver */
-    solver(T eta, std::size_t const n_part)
-        : eta{eta}, n_part(n_part), n_pair(n_part * (n_part - 1) / 2) {}
-
+    T const eta;
+    int const flg;
 
-    /** Invert the grand-mobility tensor.  This is done in several steps
-     *  which minimize the computation time. Input matrices are not preserved.
-     *
-     *    \param zmuf sub-tensor of the input mobility matrix, relating forces
-     *                to velocities
-     *    \param zmus input, relating stresslets to velocities
-     *    \param zmes input, relating ambient shear flow to stresslets
-     *    \param rfu sub-tensor of the output resistance matrix, relating
-     *               velocities to forces
-     *    \param rfe output, relating ambient shear flow to forces
-     *    \param rse output, relating ambient shear flow to stresslets
-     */
-    void invert_grand_mobility_matrix(device_matrix<T, Policy> &zmuf,
-                                      device_matrix<T, Policy> &zmus,
-                                      device_matrix<T, Policy> &zmes,
-                                      device_matrix<T, Policy> &rfu,
-                                      device_matrix<T, Policy> &rfe,
-                                      device_matrix<T, Policy> &rse,
-                                      int const flg) {
-        // TODO: Where are these steps from?
-        // Invert R1 = Muf ^ -1 => zmuf = zmuf ^ -1
-        zmuf = zmuf.inverse();
+    DEVICE_FUNC void operator()(std::size_t p) {
+        std::size_t i, j;
+        thrust_wrapper::tie(i, j) = unravel_triangular_index(pairs(p), n_part);
+        multi_array<T, 3> d;
+        T const dr = pair_distance(x, i, j, d);
+
+        // Only calc_lub is needed, which does not touch the matrices
+        lubrication<Policy, T> lub{{nullptr, 0, 0}, {nullptr, 0, 0},
+                                   {nullptr, 0, 0}, {nullptr, 0},
+                                   n_part, a, eta, flg};
+        multi_array<T, 12, 12> tabc;
+        multi_array<T, 12, 10> tght;
+        multi_array<T, 10, 10> tzm;
+        lub.calc_lub(i, j, dr, d, tabc, tght, tzm);
+
+        std::size_t const n_self = lubrication<Policy, T>::self_size(flg);
+        T *self_i = self.data() + n_self * (2 * p);
+        T *self_j = self.data() + n_self * (2 * p + 1);
+        lub.diagonal_blocks(tabc, tght, tzm, self_i, self_j);
+        std::size_t const slot_ij = slots(2 * p);
+        std::size_t const slot_ji = slots(2 * p + 1);
+
+        // The blocks which couple both particles go into their own slots
+        T *rfu_ij = rfu.data() + 36 * slot_ij;
+        T *rfu_ji = rfu.data() + 36 * slot_ji;
+        for (std::size_t c = 0; c < 6; ++c) {
+            for (std::size_t r = 0; r < 6; ++r) {
+                rfu_ij[r + 6 * c] = tabc(r, 6 + c);
+                rfu_ji[r + 6 * c] = tabc(c, 6 + r);
+            }
+        }
+        rfu_cols(slot_ij) = j;
+        rfu_cols(slot_ji) = i;
 
         if (flg & flags::FTS) {
-            // Compute R2 = Mus(t) * R1 => rsu = zmus(t) * zmuf
-            device_matrix<T, Policy> const &rsu = zmus.transpose() * zmuf;
+            T *rfe_ij = rfe.data() + 30 * slot_ij;
+            T *rfe_ji = rfe.data() + 30 * slot_ji;
+            for (std::size_t c = 0; c < 5; ++c) {
+                for (std::size_t r = 0; r < 6; ++r) {
+                    rfe_ij[r + 6 * c] = tght(r, 5 + c);
+                    rfe_ji[r + 6 * c] = tght(6 + r, c);
+                }
+            }
+            rfe_cols(slot_ij) = j;
+            rfe_cols(slot_ji) = i;
+
+            T *rse_ij = rse.data() + 25 * slot_ij;
+            T *rse_ji = rse.data() + 25 * slot_ji;
+            for (std::size_t c = 0; c < 5; ++c) {
+                for (std::size_t r = 0; r < 5; ++r) {
+                    rse_ij[r + 5 * c] = tzm(r, 5 + c);
+                    rse_ji[r + 5 * c] = tzm(c, 5 + r);
+                }
+            }
+            rse_cols(slot_ij) = j;
+            rse_cols(slot_ji) = i;
+        }
+    }
+};
 
-            // Compute R3 = R2 * Mus - Mes => zmes = rsu * zmus - zmes
-            zmes = zmes - rsu * zmus;
+/** Sums up the corrections to the diagonal block of one particle, which
+ *  \ref near_field_pair stored per adjacency list entry, and writes it as
+ *  first block of the block row of the particle.
+ */
+template <typename Policy, typename T>
+struct near_field_diagonal {
+    device_vector_view<std::size_t, Policy> const offsets;
+    device_vector_view<std::size_t, Policy> const entries;
+    device_vector_view<T, Policy> const self;
+    device_vector_view<std::size_t, Policy> const row_offsets;
+    device_vector_view<T, Policy> rfu;
+    device_vector_view<std::size_t, Policy> rfu_cols;
+    device_vector_view<T, Policy> rfe;
+    device_vector_view<std::size_t, Policy> rfe_cols;
+    device_vector_view<T, Policy> rse;
+    device_vector_view<std::size_t, Policy> rse_cols;
+    int const flg;
 
-            // Invert  R4 = R3 ^ -1 => zmes = zmes ^ -1
-            zmes = zmes.inverse();
+    DEVICE_FUNC void operator()(std::size_t i) {
+        std::size_t const n_self = lubrication<Policy, T>::self_size(flg);
+        std::size_t const slot = row_offsets(i);
+        T *rfu_ii = rfu.data() + 36 * slot;
+        for (std::size_t k = 0; k < 36; ++k) {
+            rfu_ii[k] = T{0.0};
+        }
+        rfu_cols(slot) = i;
 
-            // Compute R5 = -R3 * R4 => zmus = -rsu(t) * zmes
-            zmus = -(rsu.transpose() * zmes);
+        T *rfe_ii = nullptr;
+        T *rse_ii = nullptr;
+        if (flg & flags::FTS) {
+            rfe_ii = rfe.data() + 30 * slot;
+            rse_ii = rse.data() + 25 * slot;
+            for (std::size_t k = 0; k < 30; ++k) {
+                rfe_ii[k] = T{0.0};
+            }
+            for (std::size_t k = 0; k < 25; ++k) {
+                rse_ii[k] = T{0.0};
+            }
+            rfe_cols(slot) = i;
+            rse_cols(slot) = i;
+        }
 
-            // Compute R6 = R1 - R5  => zmuf = zmuf - zmus * rsu
-            zmuf = zmuf - zmus * rsu;
+        for (std::size_t n = offsets(i); n < offsets(i + 1); ++n) {
+            T const *s = self.data() + n_self * entries(n);
+            for (std::size_t k = 0; k < 36; ++k) {
+                rfu_ii[k] += s[k];
+            }
+            if (flg & flags::FTS) {
+                for (std::size_t k = 0; k < 30; ++k) {
+                    rfe_ii[k] += s[36 + k];
+                }
+                for (std::size_t k = 0; k < 25; ++k) {
+                    rse_ii[k] += s[66 + k];
+                }
+            }
         }
-        rfu = zmuf;
-        rfe = zmus;
-        rse = zmes;
     }
+};
 
-    /** Thermalization with stochastic force, making use of the fluctuation-
-     *  dissipation-theorem.
-     *
+/** Memory held by a vector or matrix of the workspaces */
+template <typename Buffer>
+std::size_t buffer_bytes(Buffer const &buffer) {
+    return buffer.size() * sizeof(typename Buffer::value_type);
+}
+
+/** Lubrication corrections to the grand resistance matrix in block sparse
+ *  format, so that memory and time scale with the number of close pairs
+ *  rather than with the size of the dense matrices. rfu consists of 6x6
+ *  blocks, rfe of 6x5 blocks and rse of 5x5 blocks, one per particle, i.e.
+ *  rfu * U yields the lubrication forces and torques like the dense rfu of
+ *  \ref solver::calc_vel. rfe and rse are only assembled in FTS mode. All
+ *  three share the same pattern: every block row starts with the diagonal
+ *  block, followed by one block per close pair of the particle.
+ */
+template <typename Policy, typename T>
+struct near_field_resistance {
+    template <typename U>
+    using vector_type = typename Policy::template vector<U>;
+
+    /** pairs within the lubrication cutoff, as triangular pair indices */
+    vector_type<std::size_t> pairs;
+    /** adjacency list of the pairs, sorted by particle. The entries of
+     *  particle i are entries[offsets[i]] to entries[offsets[i+1] - 1], see
+     *  \ref lubrication_entry_particle
+     */
+    vector_type<std::size_t> keys, entries, offsets;
+    /** position of the off-diagonal block of every entry */
+    vector_type<std::size_t> slots;
+    /** corrections to the diagonal blocks per entry */
+    vector_type<T> self;
+    /** near-field resistance matrices */
+    device_bsr_matrix<T, Policy> rfu, rfe, rse;
+
+    /** Select the pairs within the lubrication cutoff
+     *
+     *  \param candidates optional list of candidate pairs, given by their
+     *                    particle indices, see \ref triangular_pair_ids. If
+     *                    it is not given, all n_part (n_part - 1) / 2
+     *                    pairs are searched.
+     */
+    void find_pairs(vector_type<T> &x, vector_type<T> &a, std::size_t n_part,
+                    std::vector<std::size_t> const *candidates) {
+        thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+        lubrication_cutoff<Policy, T> const pred{x, n_part, a};
+
+        // The pairs are counted first, so that the buffer only has to hold
+        // the pairs within the cutoff
+        if (candidates) {
+            std::vector<std::size_t> const ids =
+                triangular_pair_ids(*candidates, n_part);
+            vector_type<std::size_t> ids_dev(ids.size());
+            thrust_wrapper::copy(ids.begin(), ids.end(), ids_dev.begin());
+            pairs.resize(static_cast<std::size_t>(thrust_wrapper::count_if(
+                Policy::par(), ids_dev.begin(), ids_dev.end(), pred)));
+            thrust_wrapper::copy_if(Policy::par(), ids_dev.begin(),
+                                    ids_dev.end(), pairs.begin(), pred);
+        } else {
+            std::size_t const n_pair = n_part * (n_part - 1) / 2;
+            pairs.resize(static_cast<std::size_t>(thrust_wrapper::count_if(
+                Policy::par(), begin, begin + n_pair, pred)));
+            thrust_wrapper::copy_if(Policy::par(), begin, begin + n_pair,
+                                    pairs.begin(), pred);
+        }
+    }
+
+    /** Assemble the near-field matrices for the pairs from \ref find_pairs */
+    void assemble(vector_type<T> &x, vector_type<T> &a, std::size_t n_part,
+                  T eta, int flg) {
+        thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+        std::size_t const n_lub = pairs.size();
+        std::size_t const n_blocks = n_part + 2 * n_lub;
+
+        // Sort the entries of the adjacency list by particle
+        sort_lubrication_entries<Policy>(pairs, n_lub, n_part, 1, keys,
+                                         entries, offsets);
+
+        slots.resize(2 * n_lub);
+        thrust_wrapper::for_each(
+            Policy::par(), begin, begin + 2 * n_lub,
+            near_field_slot<Policy>{keys, entries, slots});
+
+        auto shape = [&](device_bsr_matrix<T, Policy> &A, std::size_t rows,
+                         std::size_t cols) {
+            if (A.block_rows() != n_part || A.row_block() != rows ||
+                A.col_block() != cols) {
+                A = device_bsr_matrix<T, Policy>(n_part, n_part, rows, cols);
+            }
+            A.resize_blocks(n_blocks);
+            thrust_wrapper::tabulate(Policy::par(), A.row_offsets().begin(),
+                                     A.row_offsets().end(),
+                                     near_field_row_offset<Policy>{offsets});
+        };
+        shape(rfu, 6, 6);
+        if (flg & flags::FTS) {
+            shape(rfe, 6, 5);
+            shape(rse, 5, 5);
+        }
+
+        self.resize(lubrication<Policy, T>::self_size(flg) * 2 * n_lub);
+        thrust_wrapper::for_each(
+            Policy::par(), begin, begin + n_lub,
+            near_field_pair<Policy, T>{x, a, pairs, slots, self,
+                                       rfu.values(), rfu.col_indices(),
+                                       rfe.values(), rfe.col_indices(),
+                                       rse.values(), rse.col_indices(),
+                                       n_part, eta, flg});
+        thrust_wrapper::for_each(
+            Policy::par(), begin, begin + n_part,
+            near_field_diagonal<Policy, T>{offsets, entries, self,
+                                           rfu.row_offsets(), rfu.values(),
+                                           rfu.col_indices(), rfe.values(),
+                                           rfe.col_indices(), rse.values(),
+                                           rse.col_indices(), flg});
+    }
+
+    /** Memory held by the pair list and the matrices */
+    std::size_t bytes() const {
+        std::size_t bytes = buffer_bytes(pairs) + buffer_bytes(keys) +
+                            buffer_bytes(entries) + buffer_bytes(offsets) +
+                            buffer_bytes(slots) + buffer_bytes(self);
+        for (auto const *A : {&rfu, &rfe, &rse}) {
+            bytes += buffer_bytes(A->row_offsets()) +
+                     buffer_bytes(A->col_indices()) +
+                     buffer_bytes(A->values());
+        }
+        return bytes;
+    }
+};
+
+/** Block-Jacobi preconditioner of \ref iterative_solver. The resistance
+ *  matrix R = M^-1 + L is approximated by the inverse self mobilities plus
+ *  the diagonal blocks of the near-field correction, then the same
+ *  approximation of the mobility is applied on both sides, see
+ *  \ref iterative_solver. This functor computes and stores the resulting
+ *  6x6 block of one particle.
+ */
+template <typename Policy, typename T>
+struct lubrication_preconditioner {
+    device_vector_view<T, Policy> const a;
+    device_vector_view<std::size_t, Policy> const row_offsets;
+    device_vector_view<T, Policy> const rfu;
+    device_vector_view<T, Policy> precond;
+    T const eta;
+
+    DEVICE_FUNC void operator()(std::size_t i) {
+        // inverse self mobility, see the self mobility functor
+        T const s_t = T{M_PI * 6.} * eta * a(i);
+        T const s_r = T{M_PI * 8.} * eta * a(i) * a(i) * a(i);
+        T const s[6] = {s_t, s_t, s_t, s_r, s_r, s_r};
+
+        // the diagonal block is the first block of the block row
+        T D[36];
+        T const *rfu_ii = rfu.data() + 36 * row_offsets(i);
+        for (std::size_t k = 0; k < 36; ++k) {
+            D[k] = rfu_ii[k];
+        }
+        for (std::size_t k = 0; k < 6; ++k) {
+            D[k + 6 * k] += s[k];
+        }
+
+        // Cholesky factorization D = L L^T in the lower triangle
+        for (std::size_t c = 0; c < 6; ++c) {
+            T diag = D[c + 6 * c];
+            for (std::size_t k = 0; k < c; ++k) {
+                diag -= D[c + 6 * k] * D[c + 6 * k];
+            }
+            diag = std::sqrt(diag);
+            D[c + 6 * c] = diag;
+            for (std::size_t r = c + 1; r < 6; ++r) {
+                T sum = D[r + 6 * c];
+                for (std::size_t k = 0; k < c; ++k) {
+                    sum -= D[r + 6 * k] * D[c + 6 * k];
+                }
+                D[r + 6 * c] = sum / diag;
+            }
+        }
+
+        // Solve D X = S column by column, the block is S X
+        T *P = precond.data() + 36 * i;
+        for (std::size_t c = 0; c < 6; ++c) {
+            T col[6];
+            for (std::size_t r = 0; r < 6; ++r) {
+                col[r] = r == c ? s[c] : T{0.0};
+            }
+            for (std::size_t r = 0; r < 6; ++r) {
+                for (std::size_t k = 0; k < r; ++k) {
+                    col[r] -= D[r + 6 * k] * col[k];
+                }
+                col[r] /= D[r + 6 * r];
+            }
+            for (std::size_t r = 6; r-- > 0;) {
+                for (std::size_t k = r + 1; k < 6; ++k) {
+                    col[r] -= D[k + 6 * r] * col[k];
+                }
+                col[r] /= D[r + 6 * r];
+            }
+            for (std::size_t r = 0; r < 6; ++r) {
+                P[r + 6 * c] = s[r] * col[r];
+            }
+        }
+    }
+};
+
+/** Product of a block diagonal matrix of 6x6 blocks with a vector */
+template <typename Policy, typename T>
+struct block_diagonal_product {
+    device_vector_view<T, Policy> const blocks;
+    device_vector_view<T, Policy> const v;
+    device_vector_view<T, Policy> y;
+
+    DEVICE_FUNC void operator()(std::size_t i) {
+        T const *b = blocks.data() + 36 * i;
+        for (std::size_t r = 0; r < 6; ++r) {
+            T sum = T{0.0};
+            for (std::size_t c = 0; c < 6; ++c) {
+                sum += b[r + 6 * c] * v(6 * i + c);
+            }
+            y(6 * i + r) = sum;
+        }
+    }
+};
+
+/** Square root of a small symmetric tridiagonal matrix T applied to the
+ *  first unit vector, T^1/2 e_1. This is the only dense operation of the
+ *  Lanczos method in \ref lanczos_sqrt and is done on
+ *  the host with the cyclic Jacobi eigenvalue algorithm, since T is at most
+ *  a few hundred rows large. Negative eigenvalues, which can only stem from
+ *  round-off, are clamped to zero.
+ *
+ *  \param alpha diagonal of T
+ *  \param beta off-diagonal of T, one element shorter than \p alpha
+ */
+template <typename T>
+std::vector<T> tridiagonal_sqrt_e1(std::vector<T> const &alpha,
+                                   std::vector<T> const &beta) {
+    std::size_t const k = alpha.size();
+    assert(beta.size() + 1 == k);
+    std::vector<T> A(k * k, T{0.0});
+    std::vector<T> V(k * k, T{0.0});
+    for (std::size_t i = 0; i < k; ++i) {
+        A[i + k * i] = alpha[i];
+        V[i + k * i] = T{1.0};
+        if (i + 1 < k) {
+            A[i + 1 + k * i] = beta[i];
+            A[i + k * (i + 1)] = beta[i];
+        }
+    }
+
+    for (int sweep = 0; sweep < 100; ++sweep) {
+        T off = T{0.0};
+        T diag = T{0.0};
+        for (std::size_t q = 0; q < k; ++q) {
+            diag += A[q + k * q] * A[q + k * q];
+            for (std::size_t p = 0; p < q; ++p) {
+                off += A[p + k * q] * A[p + k * q];
+            }
+        }
+        if (off <= std::numeric_limits<T>::epsilon() *
+                       std::numeric_limits<T>::epsilon() * diag) {
+            break;
+        }
+
+        for (std::size_t q = 1; q < k; ++q) {
+            for (std::size_t p = 0; p < q; ++p) {
+                T const apq = A[p + k * q];
+                if (apq == T{0.0}) {
+                    continue;
+                }
+                // Rotation that eliminates A(p,q), see Numerical Recipes
+                T const theta = (A[q + k * q] - A[p + k * p]) / (2 * apq);
+                T const t = (theta >= 0 ? T{1.0} : T{-1.0}) /
+                            (std::fabs(theta) + std::sqrt(theta * theta + 1));
+                T const c = 1 / std::sqrt(t * t + 1);
+                T const sn = t * c;
+                for (std::size_t r = 0; r < k; ++r) {
+                    T const arp = A[r + k * p];
+                    T const arq = A[r + k * q];
+                    A[r + k * p] = c * arp - sn * arq;
+                    A[r + k * q] = sn * arp + c * arq;
+                }
+                for (std::size_t r = 0; r < k; ++r) {
+                    T const apr = A[p + k * r];
+                    T const aqr = A[q + k * r];
+                    A[p + k * r] = c * apr - sn * aqr;
+                    A[q + k * r] = sn * apr + c * aqr;
+                }
+                for (std::size_t r = 0; r < k; ++r) {
+                    T const vrp = V[r + k * p];
+                    T const vrq = V[r + k * q];
+                    V[r + k * p] = c * vrp - sn * vrq;
+                    V[r + k * q] = sn * vrp + c * vrq;
+                }
+            }
+        }
+    }
+
+    // T^1/2 e_1 = V diag(sqrt(lambda)) V^T e_1
+    std::vector<T> out(k, T{0.0});
+    for (std::size_t i = 0; i < k; ++i) {
+        T const w = std::sqrt(std::max(A[i + k * i], T{0.0})) * V[0 + k * i];
+        for (std::size_t r = 0; r < k; ++r) {
+            out[r] += V[r + k * i] * w;
+        }
+    }
+    return out;
+}
+
+/** Lanczos approximation of A^1/2 psi for a symmetric positive
+ *  semi-definite operator A of which only products with vectors are known.
+ *  After k iterations, the approximation is |psi| V_k T_k^1/2 e_1, where the
+ *  columns of V_k are the orthonormal basis of the Krylov space of A and
+ *  psi, and T_k = V_k^T A V_k is tridiagonal. The basis is fully
+ *  reorthogonalized, which costs O(n k) per iteration and is cheap compared
+ *  to the product with A. Since V_k is orthonormal, the change of the
+ *  approximation between iterations is the change of its coefficients,
+ *  which serves as error estimate.
+ *
+ *  \param apply computes y = A v for views v and y
+ *  \param psi input vector
+ *  \param out result
+ *  \param q buffer of the size of \p psi
+ *  \param basis buffer for V_k, grows as needed
+ *  \param coeff buffer for the coefficients, grows as needed
+ *  \param tolerance estimated relative error at which the iteration stops
+ *  \param max_iterations upper limit for the number of iterations
+ *  \param error estimated relative error of the result
+ *  \return number of iterations
+ */
+template <typename Policy, typename T, typename Operator>
+std::size_t lanczos_sqrt(Operator const &apply,
+                         typename Policy::template vector<T> const &psi,
+                         typename Policy::template vector<T> &out,
+                         typename Policy::template vector<T> &q,
+                         typename Policy::template vector<T> &basis,
+                         typename Policy::template vector<T> &coeff_buffer,
+                         T tolerance, std::size_t max_iterations, T &error) {
+    using blas = internal::cublas<Policy, T>;
+    using vector_type = typename Policy::template vector<T>;
+    std::size_t const n = psi.size();
+    int const m = static_cast<int>(n);
+    auto ptr = [](vector_type &v) {
+        return thrust_wrapper::raw_pointer_cast(v.data());
+    };
+
+    thrust_wrapper::fill(Policy::par(), out.begin(), out.end(), T{0.0});
+    error = T{0.0};
+
+    T const *const psi_data = thrust_wrapper::raw_pointer_cast(psi.data());
+    T const psi_norm = std::sqrt(blas::dot(m, psi_data, psi_data));
+    if (!(psi_norm > 0)) {
+        return 0;
+    }
+
+    basis.resize(n);
+    thrust_wrapper::copy(psi.begin(), psi.end(), basis.begin());
+    blas::scal(m, 1 / psi_norm, ptr(basis));
+
+    std::size_t iterations = 0;
+    std::vector<T> alpha, beta, coeff;
+    for (std::size_t k = 0; k < max_iterations; ++k) {
+        int const cols = static_cast<int>(k + 1);
+        if (coeff_buffer.size() < k + 1) {
+            coeff_buffer.resize(2 * (k + 1));
+        }
+        T *v_k = ptr(basis) + n * k;
+
+        // w = A v_k - alpha_k v_k - beta_k-1 v_k-1, where w is stored in q
+        apply(device_vector_view<T, Policy>{v_k, n}, q);
+        alpha.push_back(blas::dot(m, v_k, ptr(q)));
+        blas::axpy(m, -alpha.back(), v_k, ptr(q));
+        if (k > 0) {
+            blas::axpy(m, -beta.back(), v_k - n, ptr(q));
+        }
+        // Full reorthogonalization, w -= V (V^T w)
+        blas::gemv(true, ptr(basis), ptr(q), ptr(coeff_buffer), m, cols, 1,
+                   0);
+        blas::gemv(false, ptr(basis), ptr(coeff_buffer), ptr(q), m, cols, -1,
+                   1);
+
+        std::vector<T> coeff_next = tridiagonal_sqrt_e1(alpha, beta);
+        T change = T{0.0};
+        T total = T{0.0};
+        for (std::size_t i = 0; i <= k; ++i) {
+            T const prev = i < k ? coeff[i] : T{0.0};
+            change += (coeff_next[i] - prev) * (coeff_next[i] - prev);
+            total += coeff_next[i] * coeff_next[i];
+        }
+        coeff.swap(coeff_next);
+        iterations = k + 1;
+        error = total > 0 ? std::sqrt(change / total) : T{0.0};
+
+        T const beta_k = std::sqrt(blas::dot(m, ptr(q), ptr(q)));
+        if (!(beta_k >
+              std::numeric_limits<T>::epsilon() * std::fabs(alpha.front()))) {
+            // The Krylov space is exhausted, the approximation is exact
+            error = T{0.0};
+            break;
+        }
+        if (k > 0 && error <= tolerance) {
+            break;
+        }
+        beta.push_back(beta_k);
+
+        // v_k+1 = w / beta_k, v_k is invalidated by the resize
+        basis.resize(n * (k + 2));
+        thrust_wrapper::copy(q.begin(), q.end(), basis.begin() + n * (k + 1));
+        blas::scal(m, 1 / beta_k, ptr(basis) + n * (k + 1));
+    }
+
+    // out = |psi| V c
+    std::size_t const k = coeff.size();
+    for (T &c : coeff) {
+        c *= psi_norm;
+    }
+    thrust_wrapper::copy(coeff.begin(), coeff.end(), coeff_buffer.begin());
+    blas::gemv(false, ptr(basis), ptr(coeff_buffer), ptr(out), m,
+               static_cast<int>(k), 1, 0);
+    return iterations;
+}
+
+/** All buffers that are needed by \ref iterative_solver::calc_vel. Apart
+ *  from the near-field blocks, they are all of size O(n_part).
+ */
+template <typename Policy, typename T>
+struct iterative_workspace {
+    template <typename U>
+    using vector_type = typename Policy::template vector<U>;
+
+    /** number of particles the buffers are sized for */
+    std::size_t n_part = 0;
+
+    /** particle positions, radii, forces and velocities */
+    vector_type<T> x, a, f, u;
+    /** sparse lubrication correction L */
+    near_field_resistance<Policy, T> near_field;
+    /** blocks of the preconditioner */
+    vector_type<T> precond;
+    /** vectors of the conjugate gradient method */
+    vector_type<T> g, r, z, p, q, s, t;
+    /** random numbers and the resulting thermal term, see
+     *  \ref iterative_solver::brownian_forces
+     */
+    vector_type<T> psi, frnd;
+    /** orthonormal Lanczos vectors, one after another, and the
+     *  coefficients of a vector in that basis. They grow with the number of
+     *  Lanczos iterations.
+     */
+    vector_type<T> lanczos_basis, lanczos_coeff;
+
+    /** number of iterations of the last solve */
+    std::size_t iterations = 0;
+    /** relative residual of the last solve */
+    T residual = 0;
+    /** number of Lanczos iterations of the last thermal term */
+    std::size_t lanczos_iterations = 0;
+    /** estimated relative error of the last thermal term */
+    T lanczos_error = 0;
+
+    /** Make sure that all buffers fit \p n_part particles */
+    void resize(std::size_t n_part) {
+        if (n_part == this->n_part) {
+            return;
+        }
+        this->n_part = n_part;
+
+        x = vector_type<T>(6 * n_part);
+        a = vector_type<T>(n_part);
+        f = vector_type<T>(6 * n_part);
+        u = vector_type<T>(6 * n_part);
+        precond = vector_type<T>(36 * n_part);
+        for (auto *v : {&g, &r, &z, &p, &q, &s, &t, &psi, &frnd}) {
+            *v = vector_type<T>(6 * n_part);
+        }
+    }
+
+    /** Memory held by the buffers */
+    std::size_t bytes() const {
+        std::size_t bytes = near_field.bytes() + buffer_bytes(precond) +
+                            buffer_bytes(lanczos_basis) +
+                            buffer_bytes(lanczos_coeff);
+        for (auto const *v : {&x, &a, &f, &u, &g, &r, &z, &p, &q, &s, &t,
+                              &psi, &frnd}) {
+            bytes += buffer_bytes(*v);
+        }
+        return bytes;
+    }
+};
+
+/** Matrix-free solver for the F-T problem, which needs O(n_part) memory
+ *  apart from the near-field blocks and can therefore treat much larger
+ *  systems than \ref solver.
+ *
+ *  The resistance problem R U = F with R = M^-1 + L, where M is the F-T
+ *  mobility matrix and L is the lubrication correction, is solved for
+ *  U = M G, where G solves the symmetric positive definite system
+ *
+ *      (M + M L M) G = M F
+ *
+ *  with the preconditioned conjugate gradient method. This only needs
+ *  products with M, which are provided by \ref far_field_mobility, and
+ *  products with the sparse pair blocks of L, so M is never inverted. The
+ *  preconditioner approximates M by the self mobilities and R by its block
+ *  diagonal, see \ref lubrication_preconditioner. Without lubrication,
+ *  U = M F is computed directly.
+ *
+ *  The thermal forces are handled in the same formulation. Their covariance
+ *  is R, which gives the velocities the covariance R^-1 = M B^-1 M with
+ *  B = M + M L M. Adding B^1/2 psi to the right hand side instead of M times
+ *  the thermal forces yields exactly that covariance, and B^1/2 psi is
+ *  computed with the Lanczos method, which again only needs products with
+ *  B, see \ref brownian_forces. Without lubrication, B = M and the thermal
+ *  velocities are M^1/2 psi.
+ *
+ *  The far field is summed up directly, which takes O(n_part^2) operations
+ *  per product but no memory, and without candidates from the caller the
+ *  pairs within the lubrication cutoff are searched among all pairs. So
+ *  this solver removes the O(n_part^2) memory and the O(n_part^3)
+ *  factorization of the dense solver, but not the quadratic work, which
+ *  limits it to some 10^4 particles. Larger systems would need a fast far
+ *  field, e.g. particle mesh Ewald or a fast multipole method, and a cell
+ *  list for the pair search.
+ *
+ *  The stresslets (FTS) are not supported, \ref solver::calc_vel falls
+ *  back to the dense solver in that case. It also repeats steps with the
+ *  dense solver in which the iterations do not converge.
+ */
+template <typename Policy, typename T>
+struct iterative_solver {
+    static_assert(policy::is_policy<Policy>::value,
+                  "The execution policy must meet the requirements");
+    static_assert(std::is_same<T, double>::value,
+                  "Data type of iterative_solver must be double for "
+                  "BLAS/LAPACK operations");
+
+    template <typename U>
+    using vector_type = typename Policy::template vector<U>;
+    using blas = internal::cublas<Policy, T>;
+
+    /** viscosity of the Stokes fluid */
+    T const eta;
+    /** number of particles */
+    std::size_t const n_part;
+    /** relative residual at which the iteration stops */
+    T const tolerance;
+    /** upper limit for the number of iterations */
+    std::size_t const max_iterations;
+    /** estimated relative error at which the Lanczos iteration for the
+     *  thermal term stops
+     */
+    T const sqrt_tolerance;
+    /** upper limit for the number of Lanczos iterations */
+    std::size_t const max_lanczos_iterations;
+
+    iterative_solver(T eta, std::size_t const n_part,
+                     T tolerance = T{1e-8},
+                     std::size_t max_iterations = 1000,
+                     T sqrt_tolerance = T{1e-6},
+                     std::size_t max_lanczos_iterations = 200)
+        : eta{eta}, n_part(n_part), tolerance{tolerance},
+          max_iterations(max_iterations),
+          sqrt_tolerance{sqrt_tolerance},
+          max_lanczos_iterations(max_lanczos_iterations) {}
+
+    /** Whether \p flg selects the iterative solver */
+    static bool applicable(int flg) {
+        return (flg & flags::ITERATIVE) && !(flg & flags::FTS) &&
+               !(flg & flags::PERIODIC);
+    }
+
+    /** y = M v */
+    void apply_mobility(iterative_workspace<Policy, T> &ws, int const flg,
+                        device_vector_view<T, Policy> v,
+                        device_vector_view<T, Policy> y) const {
+        thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+        thrust_wrapper::for_each(
+            Policy::par(), begin, begin + n_part,
+            far_field_mobility<Policy, T>{ws.x, ws.a, v, y, n_part, eta, flg});
+    }
+
+    /** Find the pairs within the lubrication cutoff, assemble the sparse
+     *  near-field matrix L and set up the preconditioner.
+     *
+     *  \param pairs optional list of candidate pairs, see
+     *               \ref near_field_resistance::find_pairs
+     */
+    void setup_lubrication(iterative_workspace<Policy, T> &ws, int const flg,
+                           std::vector<std::size_t> const *pairs) const {
+        ws.near_field.find_pairs(ws.x, ws.a, n_part, pairs);
+        ws.near_field.assemble(ws.x, ws.a, n_part, eta, flg);
+
+        thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+        thrust_wrapper::for_each(
+            Policy::par(), begin, begin + n_part,
+            lubrication_preconditioner<Policy, T>{
+                ws.a, ws.near_field.rfu.row_offsets(),
+                ws.near_field.rfu.values(), ws.precond, eta});
+    }
+
+    /** y = (M + M L M) v */
+    void apply_system(iterative_workspace<Policy, T> &ws, int const flg,
+                      device_vector_view<T, Policy> v,
+                      device_vector_view<T, Policy> y) const {
+        int const n = static_cast<int>(6 * n_part);
+
+        apply_mobility(ws, flg, v, ws.t);
+        ws.near_field.rfu.spmv(ws.t, ws.s);
+        apply_mobility(ws, flg, ws.s, y);
+        blas::axpy(n, 1, thrust_wrapper::raw_pointer_cast(ws.t.data()),
+                   y.data());
+    }
+
+    /** z = P r */
+    void apply_preconditioner(iterative_workspace<Policy, T> &ws,
+                              vector_type<T> &r, vector_type<T> &z) const {
+        thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+        thrust_wrapper::for_each(
+            Policy::par(), begin, begin + n_part,
+            block_diagonal_product<Policy, T>{ws.precond, r, z});
+    }
+
+    /** y = B v, with B = M + M L M with lubrication and B = M otherwise */
+    void apply_operator(iterative_workspace<Policy, T> &ws, int const flg,
+                        device_vector_view<T, Policy> v,
+                        device_vector_view<T, Policy> y) const {
+        if (flg & flags::LUBRICATION) {
+            apply_system(ws, flg, v, y);
+        } else {
+            apply_mobility(ws, flg, v, y);
+        }
+    }
+
+    /** Compute the thermal term B^1/2 psi, see \ref iterative_solver, with
+     *  the Lanczos method of \ref lanczos_sqrt.
+     *
+     *  The lubrication blocks must have been set up before.
+     *
+     *  \param sqrt_kT_Dt Square root of kT / Delta t
+     *  \param offset Simulation time, serves as RNG seed for each step
+     *  \param seed global seed for the whole simulation
+     *  \param first_index index of the first random number of this system
+     *  \return false, if the estimated error is still above
+     *          \ref sqrt_tolerance after \ref max_lanczos_iterations
+     *          iterations, like in \ref solver::reuse_factorization
+     */
+    bool brownian_forces(iterative_workspace<Policy, T> &ws, int const flg,
+                         T sqrt_kT_Dt, std::size_t offset, std::size_t seed,
+                         std::size_t first_index) const {
+        // Psi is a vector filled with random numbers, scaled correctly
+        thrust_wrapper::tabulate(
+            Policy::par(), ws.psi.begin(), ws.psi.end(),
+            thermalizer<T>{sqrt_kT_Dt, offset, seed, first_index});
+        ws.lanczos_iterations = lanczos_sqrt<Policy, T>(
+            [&](device_vector_view<T, Policy> v,
+                device_vector_view<T, Policy> y) {
+                apply_operator(ws, flg, v, y);
+            },
+            ws.psi, ws.frnd, ws.q, ws.lanczos_basis, ws.lanczos_coeff,
+            sqrt_tolerance, max_lanczos_iterations, ws.lanczos_error);
+        return ws.lanczos_error <= sqrt_tolerance;
+    }
+
+    /** Solve (M + M L M) G = M F with the preconditioned conjugate gradient
+     *  method, starting from G = 0, and set U = M G.
+     *
+     *  \param thermal whether the thermal term of \ref brownian_forces is
+     *                 added to the right hand side
+     *  \return false, if the residual is still above the tolerance after
+     *          \ref max_iterations iterations
+     */
+    bool solve(iterative_workspace<Policy, T> &ws, int const flg,
+               bool thermal) const {
+        int const n = static_cast<int>(6 * n_part);
+        auto ptr = [](vector_type<T> &v) {
+            return thrust_wrapper::raw_pointer_cast(v.data());
+        };
+
+        // r = M F - (M + M L M) G with G = 0
+        thrust_wrapper::fill(Policy::par(), ws.g.begin(), ws.g.end(), T{0.0});
+        apply_mobility(ws, flg, ws.f, ws.r);
+        if (thermal) {
+            blas::axpy(n, 1, ptr(ws.frnd), ptr(ws.r));
+        }
+        T const b_norm = std::sqrt(blas::dot(n, ptr(ws.r), ptr(ws.r)));
+
+        ws.iterations = 0;
+        ws.residual = T{0.0};
+        if (b_norm > 0) {
+            apply_preconditioner(ws, ws.r, ws.z);
+            thrust_wrapper::copy(ws.z.begin(), ws.z.end(), ws.p.begin());
+            T rz = blas::dot(n, ptr(ws.r), ptr(ws.z));
+
+            ws.residual = T{1.0};
+            while (ws.iterations < max_iterations && ws.residual > tolerance) {
+                apply_system(ws, flg, ws.p, ws.q);
+                T const alpha = rz / blas::dot(n, ptr(ws.p), ptr(ws.q));
+                blas::axpy(n, alpha, ptr(ws.p), ptr(ws.g));
+                blas::axpy(n, -alpha, ptr(ws.q), ptr(ws.r));
+                ++ws.iterations;
+
+                ws.residual =
+                    std::sqrt(blas::dot(n, ptr(ws.r), ptr(ws.r))) / b_norm;
+                if (ws.residual <= tolerance) {
+                    break;
+                }
+
+                apply_preconditioner(ws, ws.r, ws.z);
+                T const rz_next = blas::dot(n, ptr(ws.r), ptr(ws.z));
+                // p = z + beta p
+                blas::scal(n, rz_next / rz, ptr(ws.p));
+                blas::axpy(n, 1, ptr(ws.z), ptr(ws.p));
+                rz = rz_next;
+            }
+        }
+
+        apply_mobility(ws, flg, ws.g, ws.u);
+        return ws.residual <= tolerance;
+    }
+
+    /** Compute the velocities of all particles
+     *
+     *  \param x, f, a positions, forces and torques, and radii
+     *  \param u output, translational and angular velocities
+     *  \param sqrt_kT_Dt Square root of kT / Delta t, no thermal forces are
+     *                    applied if it is zero
+     *  \param offset Simulation time, serves as RNG seed for each step
+     *  \param seed global seed for the whole simulation
+     *  \param pairs optional list of candidate pairs for the lubrication
+     *               correction, see \ref setup_lubrication
+     *  \param rng_index index of the first random number
+     *  \return false, if the conjugate gradient or the Lanczos iterations
+     *          did not converge. The velocities are not accurate then, see
+     *          \ref solver::calc_vel for the fallback.
+     */
+    bool calc_vel(iterative_workspace<Policy, T> &ws,
+                  particle_view<T const> x, particle_view<T const> f,
+                  particle_view<T const> a, particle_view<T> u, int const flg,
+                  T sqrt_kT_Dt = T{0.0}, std::size_t offset = 0,
+                  std::size_t seed = 0,
+                  std::vector<std::size_t> const *pairs = nullptr,
+                  std::size_t rng_index = 0) const {
+        ws.resize(n_part);
+
+        gather_particles<Policy>(x, n_part, 6, ws.x);
+        gather_particles<Policy>(a, n_part, 1, ws.a);
+        gather_particles<Policy>(f, n_part, 6, ws.f);
+
+        bool const thermal = sqrt_kT_Dt > 0.0;
+        if (flg & flags::LUBRICATION) {
+            setup_lubrication(ws, flg, pairs);
+        }
+        if (thermal &&
+            !brownian_forces(ws, flg, sqrt_kT_Dt, offset, seed, rng_index)) {
+            // The velocities would not have the right covariance, the
+            // caller repeats the step with the dense solver
+            ws.iterations = 0;
+            ws.residual = T{0.0};
+            return false;
+        }
+        if (!thermal) {
+            ws.lanczos_iterations = 0;
+            ws.lanczos_error = T{0.0};
+        }
+
+        bool converged = true;
+        if (flg & flags::LUBRICATION) {
+            converged = solve(ws, flg, thermal);
+        } else {
+            apply_mobility(ws, flg, ws.f, ws.u);
+            if (thermal) {
+                blas::axpy(static_cast<int>(6 * n_part), 1,
+                           thrust_wrapper::raw_pointer_cast(ws.frnd.data()),
+                           thrust_wrapper::raw_pointer_cast(ws.u.data()));
+            }
+            ws.iterations = 0;
+            ws.residual = T{0.0};
+        }
+
+        scatter_particles<Policy>(ws.u, n_part, u);
+        return converged;
+    }
+
+    /** Compute the velocities of all particles, see above. Whether the
+     *  iterations converged can be read from the residual of \p ws.
+     */
+    std::vector<T> calc_vel(iterative_workspace<Policy, T> &ws,
+                            std::vector<T> const &x_host,
+                            std::vector<T> const &f_host,
+                            std::vector<T> const &a_host, int const flg,
+                            T sqrt_kT_Dt = T{0.0}, std::size_t offset = 0,
+                            std::size_t seed = 0,
+                            std::vector<std::size_t> const *pairs = nullptr,
+                            std::size_t rng_index = 0) const {
+        std::vector<T> out(6 * n_part);
+        calc_vel(ws, x_host, f_host, a_host, out, flg, sqrt_kT_Dt, offset,
+                 seed, pairs, rng_index);
+        return out;
+    }
+};
+
+/** All buffers that are needed by \ref mixed_precision_solver::calc_vel.
+ *  The matrices are stored in single precision, the vectors of the
+ *  refinement in double precision.
+ */
+template <typename Policy>
+struct mixed_workspace {
+    using matrix_type = device_matrix<float, Policy>;
+    template <typename U>
+    using vector_type = typename Policy::template vector<U>;
+
+    /** number of particles the buffers are sized for */
+    std::size_t n_part = 0;
+    /** flags the buffers were last used with */
+    int flg = flags::NONE;
+
+    /** block Cholesky factor of the grand mobility matrix,
+     *  [[u11, w], [0, u22]], see \ref mixed_precision_solver. w and u22
+     *  are only used in FTS mode.
+     */
+    matrix_type u11, w, u22;
+    /** intermediate results of the inversion in FTS mode */
+    matrix_type rsu, rse, rsu_rse;
+    /** far-field resistance matrix including lubrication */
+    matrix_type rfu;
+    /** Cholesky factor of rfu */
+    cholesky_factor<float, Policy> rfu_factor;
+    /** lubrication correction in double precision */
+    near_field_resistance<Policy, double> near_field;
+
+    /** total force, velocities, stresslets, residual and the hydrodynamic
+     *  force of the refinement
+     */
+    vector_type<double> f, u, s, r_u, r_s, h;
+    /** single precision buffers for the solves */
+    vector_type<float> v, t, c;
+
+    /** number of refinement steps of the last solve */
+    std::size_t iterations = 0;
+    /** relative residual of the last solve */
+    double residual = 0;
+
+    /** Make sure that all buffers fit \p n_part particles */
+    void resize(std::size_t n_part, int flg) {
+        bool const fts = flg & flags::FTS;
+        if (n_part == this->n_part && fts == bool(this->flg & flags::FTS)) {
+            this->flg = flg;
+            return;
+        }
+        this->n_part = n_part;
+        this->flg = flg;
+
+        std::size_t const n_s = fts ? 5 * n_part : 0;
+        u11 = matrix_type(6 * n_part, 6 * n_part);
+        rfu = matrix_type(6 * n_part, 6 * n_part);
+        w = matrix_type(6 * n_part, n_s);
+        u22 = matrix_type(n_s, n_s);
+        rsu = matrix_type(6 * n_part, n_s);
+        rse = matrix_type(n_s, n_s);
+        rsu_rse = matrix_type(6 * n_part, n_s);
+        rfu_factor = cholesky_factor<float, Policy>();
+
+        for (auto *x : {&f, &u, &r_u, &h}) {
+            *x = vector_type<double>(6 * n_part);
+        }
+        s = vector_type<double>(n_s);
+        r_s = vector_type<double>(n_s);
+        v = vector_type<float>(6 * n_part + n_s);
+        t = vector_type<float>(6 * n_part + n_s);
+        c = vector_type<float>(6 * n_part);
+    }
+
+    /** Memory held by the buffers */
+    std::size_t bytes() const {
+        std::size_t bytes = near_field.bytes() +
+                            buffer_bytes(rfu_factor.matrix());
+        for (auto const *A : {&u11, &w, &u22, &rsu, &rse, &rsu_rse, &rfu}) {
+            bytes += buffer_bytes(*A);
+        }
+        for (auto const *x : {&f, &u, &s, &r_u, &r_s, &h}) {
+            bytes += buffer_bytes(*x);
+        }
+        for (auto const *x : {&v, &t, &c}) {
+            bytes += buffer_bytes(*x);
+        }
+        return bytes;
+    }
+};
+
+/** Dense solver which assembles the grand mobility matrix in double
+ *  precision, but inverts and factorizes it in single precision, and then
+ *  recovers double precision accuracy by iterative refinement. On GPUs with
+ *  low double precision throughput, this moves all O(n_part^3) work to
+ *  single precision. The O(n_part^2) assembly and the matrix-vector products
+ *  of the refinement stay in double precision.
+ *
+ *  The grand mobility matrix G = [[Muf, Mus], [Mus^T, Mes]] is factorized
+ *  blockwise, G = U^T U with U = [[U11, W], [0, U22]], which yields the same
+ *  far-field resistance matrix as \ref solver::invert_grand_mobility_matrix.
+ *  With zero ambient shear flow, the velocities U and stresslets S solve
+ *
+ *      G [F - L U; S] = [U; 0]
+ *
+ *  where L is the lubrication correction to R_FU. Its residual is cheap to
+ *  evaluate in double precision. Each refinement step solves the residual
+ *  equation approximately with the single precision factors of G and of
+ *  R_FU = [G^-1]_FU + L. In F-T mode, the stresslets are absent and
+ *  G = Muf.
+ */
+template <typename Policy>
+struct mixed_precision_solver {
+    static_assert(policy::is_policy<Policy>::value,
+                  "The execution policy must meet the requirements");
+
+    template <typename U>
+    using vector_type = typename Policy::template vector<U>;
+    using blas = internal::cublas<Policy, double>;
+    using blas_f = internal::cublas<Policy, float>;
+
+    /** number of particles */
+    std::size_t const n_part;
+    /** relative residual at which the refinement stops */
+    double const tolerance;
+    /** upper limit for the number of refinement steps */
+    std::size_t const max_iterations;
+
+    mixed_precision_solver(std::size_t const n_part, double tolerance = 1e-12,
+                           std::size_t max_iterations = 10)
+        : n_part(n_part), tolerance{tolerance},
+          max_iterations(max_iterations) {}
+
+    /** v = G^-1 v with the single precision block Cholesky factor */
+    void solve_grand_mobility(mixed_workspace<Policy> &ws, int const flg,
+                              vector_type<float> &v) const {
+        int const n_u = static_cast<int>(6 * n_part);
+        int const n_s = static_cast<int>(5 * n_part);
+        float *v_u = thrust_wrapper::raw_pointer_cast(v.data());
+        float *v_s = v_u + n_u;
+        float const *u11 = thrust_wrapper::raw_pointer_cast(ws.u11.data());
+        float const *w = thrust_wrapper::raw_pointer_cast(ws.w.data());
+        float const *u22 = thrust_wrapper::raw_pointer_cast(ws.u22.data());
+
+        // Forward substitution with U^T, then back substitution with U
+        blas_f::trsm(true, u11, v_u, n_u, 1);
+        if (flg & flags::FTS) {
+            blas_f::gemv(true, w, v_u, v_s, n_u, n_s, -1, 1);
+            blas_f::trsm(true, u22, v_s, n_s, 1);
+            blas_f::trsm(false, u22, v_s, n_s, 1);
+            blas_f::gemv(false, w, v_s, v_u, n_u, n_s, -1, 1);
+        }
+        blas_f::trsm(false, u11, v_u, n_u, 1);
+    }
+
+    /** r = G [F - L U; S] - [U; 0] in double precision */
+    void residual(mixed_workspace<Policy> &ws,
+                  device_matrix<double, Policy> const &zmuf,
+                  device_matrix<double, Policy> const &zmus,
+                  device_matrix<double, Policy> const &zmes,
+                  int const flg) const {
+        int const n_u = static_cast<int>(6 * n_part);
+        int const n_s = static_cast<int>(5 * n_part);
+        auto ptr = [](vector_type<double> &x) {
+            return thrust_wrapper::raw_pointer_cast(x.data());
+        };
+
+        thrust_wrapper::copy(ws.f.begin(), ws.f.end(), ws.h.begin());
+        if (flg & flags::LUBRICATION) {
+            ws.near_field.rfu.spmv(ws.u, ws.h, -1, 1);
+        }
+
+        zmuf.gemv(ws.h, ws.r_u);
+        blas::axpy(n_u, -1, ptr(ws.u), ptr(ws.r_u));
+        if (flg & flags::FTS) {
+            zmus.gemv(ws.s, ws.r_u, 1, 1);
+            blas::gemv(true, thrust_wrapper::raw_pointer_cast(zmus.data()),
+                       ptr(ws.h), ptr(ws.r_s), n_u, n_s, 1, 0);
+            zmes.gemv(ws.s, ws.r_s, 1, 1);
+        }
+    }
+
+    /** Norm of the residual of \ref residual */
+    double residual_norm(mixed_workspace<Policy> &ws, int const flg) const {
+        auto ptr = [](vector_type<double> &x) {
+            return thrust_wrapper::raw_pointer_cast(x.data());
+        };
+        double norm = blas::dot(static_cast<int>(ws.r_u.size()), ptr(ws.r_u),
+                                ptr(ws.r_u));
+        if (flg & flags::FTS) {
+            norm += blas::dot(static_cast<int>(ws.r_s.size()), ptr(ws.r_s),
+                              ptr(ws.r_s));
+        }
+        return std::sqrt(norm);
+    }
+
+    /** Factorize the grand mobility matrix and compute the far-field
+     *  resistance matrix in single precision, see
+     *  \ref solver::invert_grand_mobility_matrix for the steps.
+     */
+    void factorize(mixed_workspace<Policy> &ws,
+                   device_matrix<double, Policy> const &zmuf,
+                   device_matrix<double, Policy> const &zmus,
+                   device_matrix<double, Policy> const &zmes,
+                   int const flg) const {
+        thrust_wrapper::copy(zmuf.data(), zmuf.data() + zmuf.size(),
+                             ws.u11.data());
+        ws.u11.potrf();
+        ws.rfu = ws.u11;
+        ws.rfu.potri();
+
+        if (flg & flags::FTS) {
+            thrust_wrapper::copy(zmus.data(), zmus.data() + zmus.size(),
+                                 ws.w.data());
+            ws.w.trsm(ws.u11, true);
+            thrust_wrapper::copy(zmes.data(), zmes.data() + zmes.size(),
+                                 ws.u22.data());
+            ws.u22.syrk(ws.w, true, -1, 1);
+            ws.u22.potrf();
+
+            // R_FU = Muf^-1 + R2 R4 R2^T with R2 = U11^-1 W and R4 the
+            // inverse Schur complement
+            ws.rsu = ws.w;
+            ws.rsu.trsm(ws.u11, false);
+            ws.rse = ws.u22;
+            ws.rse.potri();
+            ws.rsu_rse.symm(ws.rse, ws.rsu, true, 1, 0);
+            ws.rfu.gemm(ws.rsu_rse, ws.rsu, false, true, 1, 1);
+        }
+    }
+
+    /** Compute the velocities of all particles
+     *
+     *  \param x, a particle positions and radii on the device
+     *  \param f forces and torques on the device
+     *  \param zmuf, zmus, zmes grand mobility matrix in double precision,
+     *                          see \ref solver::calc_vel
+     *  \param sqrt_kT_Dt Square root of kT / Delta t
+     *  \param offset Simulation time, serves as RNG seed for each step
+     *  \param seed global seed for the whole simulation
+     *  \param pairs optional list of candidate pairs for the lubrication
+     *               correction, see \ref near_field_resistance::find_pairs
+     *  \param rng_index index of the first random number
+     *  \return the velocities, which are kept in \p ws
+     */
+    vector_type<double> const &
+    calc_vel(mixed_workspace<Policy> &ws, vector_type<double> &x,
+             vector_type<double> &a, device_matrix<double, Policy> const &zmuf,
+             device_matrix<double, Policy> const &zmus,
+             device_matrix<double, Policy> const &zmes, double eta,
+             vector_type<double> const &f, double sqrt_kT_Dt,
+             std::size_t offset, std::size_t seed, int const flg,
+             std::vector<std::size_t> const *pairs = nullptr,
+             std::size_t rng_index = 0) const {
+        ws.resize(n_part, flg);
+        std::size_t const n_u = 6 * n_part;
+
+        factorize(ws, zmuf, zmus, zmes, flg);
+        if (flg & flags::LUBRICATION) {
+            // Only the corrections to R_FU are needed
+            ws.near_field.find_pairs(x, a, n_part, pairs);
+            ws.near_field.assemble(x, a, n_part, eta, flg & ~flags::FTS);
+            ws.near_field.rfu.add_to(ws.rfu);
+        }
+        ws.rfu_factor.factorize(ws.rfu);
+
+        // The thermal forces only need to have the covariance R_FU to
+        // single precision accuracy
+        assert(f.size() == n_u);
+        thrust_wrapper::copy(f.begin(), f.end(), ws.f.begin());
+        if (sqrt_kT_Dt > 0.0) {
+            thrust_wrapper::tabulate(
+                Policy::par(), ws.h.begin(), ws.h.end(),
+                thermalizer<double>{sqrt_kT_Dt, offset, seed, rng_index});
+            thrust_wrapper::copy(ws.h.begin(), ws.h.end(), ws.c.begin());
+            ws.rfu_factor.apply_sqrt_in_place(ws.c);
+            thrust_wrapper::copy(ws.c.begin(), ws.c.end(), ws.h.begin());
+            blas::axpy(static_cast<int>(n_u), 1,
+                       thrust_wrapper::raw_pointer_cast(ws.h.data()),
+                       thrust_wrapper::raw_pointer_cast(ws.f.data()));
+        }
+
+        // Reference norm of the residual at U = 0, S = 0, i.e. of G [F; 0]
+        zmuf.gemv(ws.f, ws.r_u);
+        if (flg & flags::FTS) {
+            blas::gemv(true, thrust_wrapper::raw_pointer_cast(zmus.data()),
+                       thrust_wrapper::raw_pointer_cast(ws.f.data()),
+                       thrust_wrapper::raw_pointer_cast(ws.r_s.data()),
+                       static_cast<int>(n_u), static_cast<int>(5 * n_part), 1,
+                       0);
+        }
+        double const b_norm = residual_norm(ws, flg);
+
+        // Initial guess from the single precision factorization
+        thrust_wrapper::copy(ws.f.begin(), ws.f.end(), ws.c.begin());
+        ws.rfu_factor.solve_in_place(ws.c);
+        thrust_wrapper::copy(ws.c.begin(), ws.c.end(), ws.u.begin());
+        thrust_wrapper::fill(Policy::par(), ws.s.begin(), ws.s.end(), 0.0);
+
+        ws.iterations = 0;
+        for (;;) {
+            residual(ws, zmuf, zmus, zmes, flg);
+            ws.residual = b_norm > 0 ? residual_norm(ws, flg) / b_norm : 0.0;
+            if (ws.residual <= tolerance || ws.iterations >= max_iterations) {
+                break;
+            }
+            ++ws.iterations;
+
+            // y = G^-1 r
+            thrust_wrapper::copy(ws.r_u.begin(), ws.r_u.end(), ws.v.begin());
+            thrust_wrapper::copy(ws.r_s.begin(), ws.r_s.end(),
+                                 ws.v.begin() + n_u);
+            solve_grand_mobility(ws, flg, ws.v);
+
+            // U += R_FU^-1 y_U
+            thrust_wrapper::copy(ws.v.begin(), ws.v.begin() + n_u,
+                                 ws.c.begin());
+            ws.rfu_factor.solve_in_place(ws.c);
+            thrust_wrapper::copy(ws.c.begin(), ws.c.end(), ws.h.begin());
+            blas::axpy(static_cast<int>(n_u), 1,
+                       thrust_wrapper::raw_pointer_cast(ws.h.data()),
+                       thrust_wrapper::raw_pointer_cast(ws.u.data()));
+
+            // S += [G^-1 [R_FU^-1 y_U; 0]]_S - y_S
+            if (flg & flags::FTS) {
+                thrust_wrapper::copy(ws.c.begin(), ws.c.end(), ws.t.begin());
+                thrust_wrapper::fill(Policy::par(), ws.t.begin() + n_u,
+                                     ws.t.end(), 0.0f);
+                solve_grand_mobility(ws, flg, ws.t);
+                blas_f::axpy(
+                    static_cast<int>(ws.s.size()), -1,
+                    thrust_wrapper::raw_pointer_cast(ws.v.data()) + n_u,
+                    thrust_wrapper::raw_pointer_cast(ws.t.data()) + n_u);
+                thrust_wrapper::copy(ws.t.begin() + n_u, ws.t.end(),
+                                     ws.r_s.begin());
+                blas::axpy(static_cast<int>(ws.s.size()), 1,
+                           thrust_wrapper::raw_pointer_cast(ws.r_s.data()),
+                           thrust_wrapper::raw_pointer_cast(ws.s.data()));
+            }
+        }
+
+        return ws.u;
+    }
+};
+
+/** State that \ref solver::calc_vel keeps between time steps with
+ *  \ref flags::REUSE_FACTORIZATION.
+ *
+ *  In a full step, the mobility matrix M0 = V0^T V0 and the resistance
+ *  matrix R0 = M0^-1 + L0 = U0^T U0 are factorized as usual, and the
+ *  factors are kept together with the configuration. In the following
+ *  steps, the resistance problem is again written as B G = M F with
+ *  B = M + M L M and U = M G, see \ref iterative_solver. Since
+ *  B0 = M0 R0 M0 = W0 W0^T with W0 = M0 U0^T, the old factors give the
+ *  symmetric preconditioned system
+ *
+ *      (W0^-1 B W0^-T) z = W0^-1 M F,   G = W0^-T z
+ *
+ *  whose matrix is the identity for the old configuration. It is solved
+ *  with the conjugate gradient method, which only needs products with M
+ *  and L and triangular solves with the old factors, i.e. O(n_part^2)
+ *  operations instead of O(n_part^3). The thermal term W0^-1 B^1/2 psi has
+ *  the covariance of the system matrix and is replaced by its square root
+ *  applied to psi, see \ref lanczos_sqrt.
+ *
+ *  A full step is done again if a particle moved by more than
+ *  \ref max_displacement radii since the last factorization, or if the
+ *  iteration does not converge within \ref max_iterations.
+ */
+template <typename Policy, typename T>
+struct reuse_workspace {
+    template <typename U>
+    using vector_type = typename Policy::template vector<U>;
+
+    /** Cholesky factor of the mobility matrix of the last full step */
+    cholesky_factor<T, Policy> mobility;
+    /** positions and radii of the last full step, and of the current one */
+    std::vector<T> x_ref, a_ref, x_host, a_host;
+    /** number of particles and flags of the last full step, zero if the
+     *  factors are not valid
+     */
+    std::size_t n_part = 0;
+    int flg = flags::NONE;
+
+    /** right hand side and vectors of the conjugate gradient method */
+    vector_type<T> b, z, r, p, q, t, s;
+    /** random numbers and the resulting thermal term */
+    vector_type<T> psi, frnd;
+    /** Lanczos vectors and coefficients, see \ref lanczos_sqrt */
+    vector_type<T> lanczos_basis, lanczos_coeff;
+
+    /** largest displacement in units of the radius that is allowed before
+     *  the matrices are factorized again
+     */
+    T max_displacement = T{0.05};
+    /** upper limit for the number of iterations of a step that reuses the
+     *  factors, a full step is done if it is exceeded
+     */
+    std::size_t max_iterations = 30;
+    /** relative residual at which the iterations stop */
+    T tolerance = T{1e-10};
+
+    /** number of full steps */
+    std::size_t factorizations = 0;
+    /** number of steps that reused the factors */
+    std::size_t reused_steps = 0;
+    /** number of iterations of the last step, including the Lanczos
+     *  iterations for the thermal term
+     */
+    std::size_t iterations = 0;
+    /** number of iterations of all steps that reused the factors */
+    std::size_t total_iterations = 0;
+    /** largest displacement of the last step in units of the radius */
+    T displacement = 0;
+    /** relative residual of the last step that reused the factors */
+    T residual = 0;
+
+    /** Make sure that all buffers fit \p n_part particles */
+    void resize(std::size_t n_part) {
+        if (b.size() == 6 * n_part) {
+            return;
+        }
+        for (auto *v : {&b, &z, &r, &p, &q, &t, &s, &psi, &frnd}) {
+            *v = vector_type<T>(6 * n_part);
+        }
+    }
+
+    /** Whether the factors of the last full step can be reused for the
+     *  given configuration. Also updates \ref displacement.
+     *
+     *  \param x, a particle positions and radii
+     */
+    bool valid(vector_type<T> const &x, vector_type<T> const &a,
+               std::size_t n_part, int flg) {
+        displacement = T{0};
+        if (n_part != this->n_part || flg != this->flg) {
+            return false;
+        }
+        x_host.resize(x.size());
+        a_host.resize(a.size());
+        thrust_wrapper::copy(x.begin(), x.end(), x_host.begin());
+        thrust_wrapper::copy(a.begin(), a.end(), a_host.begin());
+        if (a_host != a_ref) {
+            return false;
+        }
+        for (std::size_t i = 0; i < n_part; ++i) {
+            T dr2 = T{0};
+            for (std::size_t d = 0; d < 3; ++d) {
+                T const dx = x_host[6 * i + d] - x_ref[6 * i + d];
+                dr2 += dx * dx;
+            }
+            displacement = std::max(displacement, std::sqrt(dr2) / a_host[i]);
+        }
+        return displacement <= max_displacement;
+    }
+
+    /** Remember the configuration of a full step */
+    void store(vector_type<T> const &x, vector_type<T> const &a,
+               std::size_t n_part, int flg) {
+        x_ref.resize(x.size());
+        a_ref.resize(a.size());
+        thrust_wrapper::copy(x.begin(), x.end(), x_ref.begin());
+        thrust_wrapper::copy(a.begin(), a.end(), a_ref.begin());
+        this->n_part = n_part;
+        this->flg = flg;
+        ++factorizations;
+    }
+
+    /** Memory held by the factor and the vectors in the memory space of
+     *  the policy
+     */
+    std::size_t bytes() const {
+        std::size_t bytes = buffer_bytes(mobility.matrix()) +
+                            buffer_bytes(lanczos_basis) +
+                            buffer_bytes(lanczos_coeff);
+        for (auto const *v : {&b, &z, &r, &p, &q, &t, &s, &psi, &frnd}) {
+            bytes += buffer_bytes(*v);
+        }
+        return bytes;
+    }
+};
+
+/** All buffers that are needed by \ref solver::calc_vel. A workspace can be
+ *  kept alive between time steps, so that the large matrices are only
+ *  allocated once and reused as long as the number of particles does not
+ *  change.
+ */
+template <typename Policy, typename T>
+struct workspace {
+    template <typename U>
+    using vector_type = typename Policy::template vector<U>;
+
+    /** number of particles the buffers are sized for */
+    std::size_t n_part = 0;
+    /** flags the buffers were last used with */
+    int flg = flags::NONE;
+
+    /** particle positions, radii and external forces */
+    vector_type<T> x, a, fext;
+    /** ambient flow, ambient shear flow and thermal forces */
+    vector_type<T> uinf, einf, frnd;
+
+    /** indices of the pairs that are passed to the lubrication functor,
+     *  only the first n_lub_pairs entries are valid
+     */
+    vector_type<std::size_t> lub_pairs;
+    std::size_t n_lub_pairs = 0;
+    /** adjacency list of the lubrication pairs and the corrections to the
+     *  diagonal blocks per entry, see \ref lubrication_pair
+     */
+    vector_type<std::size_t> lub_keys, lub_entries, lub_offsets;
+    vector_type<T> lub_self;
+    /** grand mobility matrix, see \ref solver::calc_vel */
+    device_matrix<T, Policy> zmuf, zmus, zmes;
+    /** grand resistance matrix, see \ref solver::calc_vel */
+    device_matrix<T, Policy> rfu, rfe, rse;
+    /** intermediate result of the inversion in FTS mode */
+    device_matrix<T, Policy> rsu;
+    /** Cholesky factor of rfu including lubrication */
+    cholesky_factor<T, Policy> rfu_factor;
+    /** buffers of the matrix-free solver, see \ref flags::ITERATIVE */
+    iterative_workspace<Policy, T> iterative;
+    /** single precision buffers, see \ref flags::MIXED_PRECISION */
+    mixed_workspace<Policy> mixed;
+    /** reciprocal-space sums of the box, see \ref flags::PERIODIC */
+    ewald_table<Policy, T> ewald;
+    /** factors of an earlier step, see \ref flags::REUSE_FACTORIZATION */
+    reuse_workspace<Policy, T> reuse;
+    /** optional timings of the stages, see \ref stage_scope */
+    sd_instrumentation *stats = nullptr;
+    /** directory in which the dense solver keeps the factors of the
+     *  configurations it solved, empty if there is no cache. A step first
+     *  looks for the factor of its configuration there, see
+     *  \ref solver::load_factor.
+     */
+    std::string factor_cache;
+
+    workspace() = default;
+
+    /** In iterative mode, the dense matrices are only allocated once they
+     *  are needed for a fallback to the dense solver.
+     */
+    workspace(std::size_t n_part, int flg) {
+        if (iterative_solver<Policy, T>::applicable(flg)) {
+            iterative.resize(n_part);
+        } else {
+            resize(n_part, flg);
+        }
+    }
+
+    /** Make sure that all buffers fit \p n_part particles. Nothing is
+     *  reallocated if the size did not change.
+     *
+     *  \return true, if the buffers had to be reallocated
+     */
+    bool resize(std::size_t n_part, int flg) {
+        this->flg = flg;
+        std::size_t const n_pair = n_part * (n_part - 1) / 2;
+        // The mixed precision solver keeps its own resistance matrices
+        bool const dense = !(flg & flags::MIXED_PRECISION) ||
+                           (flg & flags::PERIODIC);
+        if (dense && (flg & flags::LUBRICATION) && lub_pairs.size() != n_pair) {
+            lub_pairs = vector_type<std::size_t>(n_pair);
+        }
+        if (dense && (flg & flags::FTS) && rsu.size() != 30 * n_part * n_part) {
+            rsu = device_matrix<T, Policy>(n_part * 6, n_part * 5);
+        }
+        // The couplings to the stresslets are left empty in F-T mode, the
+        // functors do not touch them there
+        std::size_t const n_fts = (flg & flags::FTS) ? n_part : 0;
+        if (low_memory(flg)) {
+            // Only needed after switching the flags, the resistance
+            // matrices are handed back by recycle() otherwise
+            rfu = device_matrix<T, Policy>();
+            rfe = device_matrix<T, Policy>();
+            rse = device_matrix<T, Policy>();
+        } else if (dense) {
+            if (rfu.size() != 36 * n_part * n_part) {
+                rfu = device_matrix<T, Policy>(n_part * 6, n_part * 6);
+            }
+            if (rse.size() != 25 * n_fts * n_fts) {
+                rfe = device_matrix<T, Policy>(n_fts * 6, n_fts * 5);
+                rse = device_matrix<T, Policy>(n_fts * 5, n_fts * 5);
+            }
+        }
+        if (zmuf.size() != 36 * n_part * n_part) {
+            zmuf = device_matrix<T, Policy>(n_part * 6, n_part * 6);
+        }
+        if (zmes.size() != 25 * n_fts * n_fts) {
+            zmus = device_matrix<T, Policy>(n_fts * 6, n_fts * 5);
+            zmes = device_matrix<T, Policy>(n_fts * 5, n_fts * 5);
+            einf = vector_type<T>(5 * n_fts, T{0.0});
+        }
+        if (n_part == this->n_part) {
+            return false;
+        }
+        this->n_part = n_part;
+
+        x = vector_type<T>(6 * n_part);
+        a = vector_type<T>(n_part);
+        fext = vector_type<T>(6 * n_part);
+        uinf = vector_type<T>(6 * n_part, T{0.0});
+        frnd = vector_type<T>(6 * n_part, T{0.0});
+
+        rfu_factor = cholesky_factor<T, Policy>();
+        return true;
+    }
+
+    /** Whether the resistance matrices and the factor take over the
+     *  storage of the mobility matrices, see \ref flags::LOW_MEMORY
+     */
+    static bool low_memory(int flg) {
+        bool const mixed = (flg & flags::MIXED_PRECISION) &&
+                           !(flg & flags::PERIODIC);
+        // see solver::reuses_factorization
+        bool const reuse = (flg & flags::REUSE_FACTORIZATION) &&
+                           !(flg & flags::FTS);
+        return (flg & flags::LOW_MEMORY) && !mixed && !reuse;
+    }
+
+    /** In low memory mode, the inversion hands the mobility buffers to the
+     *  resistance matrices and the factorization hands rfu to the factor.
+     *  At the end of a step, they are handed back, so that the next step
+     *  assembles in the same storage without allocating.
+     */
+    void recycle() {
+        zmuf = rfu_factor.release();
+        zmus.swap(rfe);
+        zmes.swap(rse);
+    }
+
+    /** Make sure that the external and the thermal forces hold \p n_rhs
+     *  force vectors of the particles, one after another, see
+     *  \ref solver::calc_vel. Call this after \ref resize.
+     */
+    void resize_rhs(std::size_t n_rhs) {
+        if (fext.size() != 6 * n_part * n_rhs) {
+            fext = vector_type<T>(6 * n_part * n_rhs);
+            frnd = vector_type<T>(6 * n_part * n_rhs, T{0.0});
+        }
+    }
+
+    /** Memory held by the buffers of all solvers and by the table of the
+     *  periodic box
+     */
+    std::size_t bytes() const {
+        return buffer_bytes(x) + buffer_bytes(a) + buffer_bytes(fext) +
+               buffer_bytes(uinf) + buffer_bytes(einf) + buffer_bytes(frnd) +
+               buffer_bytes(lub_pairs) + buffer_bytes(lub_keys) +
+               buffer_bytes(lub_entries) + buffer_bytes(lub_offsets) +
+               buffer_bytes(lub_self) + buffer_bytes(zmuf) +
+               buffer_bytes(zmus) + buffer_bytes(zmes) + buffer_bytes(rfu) +
+               buffer_bytes(rfe) + buffer_bytes(rse) + buffer_bytes(rsu) +
+               buffer_bytes(rfu_factor.matrix()) + iterative.bytes() +
+               mixed.bytes() + reuse.bytes() + buffer_bytes(ewald.grid);
+    }
+
+    /** Estimate of the memory that a step with \p n_part particles needs at
+     *  its peak, in the memory space of the policy. Not included are the
+     *  scratch space of the BLAS/LAPACK libraries, the table of the periodic
+     *  box, see \ref ewald_table::setup, and the buffers that grow with the
+     *  number of pairs within the lubrication cutoff or with the number of
+     *  Lanczos iterations, which are not known in advance.
+     */
+    static std::size_t peak_bytes(std::size_t n_part, int flg) {
+        std::size_t const n = 6 * n_part;
+        std::size_t const n_s = (flg & flags::FTS) ? 5 * n_part : 0;
+        std::size_t const n_pair = n_part * (n_part - 1) / 2;
+        if (iterative_solver<Policy, T>::applicable(flg)) {
+            // see iterative_workspace, the preconditioner has 36 entries
+            // per particle
+            return (18 * n + n_part) * sizeof(T);
+        }
+        // particle data, ambient flows and forces, and the mobility matrices
+        std::size_t bytes = (4 * n + n_part + n_s) * sizeof(T) +
+                            (n * n + n * n_s + n_s * n_s) * sizeof(T);
+        if ((flg & flags::MIXED_PRECISION) && !(flg & flags::PERIODIC)) {
+            // see mixed_workspace, including the factor of rfu
+            return bytes + (4 * n + 2 * n_s) * sizeof(double) +
+                   (4 * n + 2 * n_s) * sizeof(float) +
+                   (3 * n * n + 3 * n * n_s + 2 * n_s * n_s) * sizeof(float);
+        }
+        // random numbers and their product with the factor
+        bytes += 2 * n * sizeof(T);
+        if (flg & flags::LUBRICATION) {
+            bytes += n_pair * sizeof(std::size_t);
+        }
+        if (low_memory(flg)) {
+            // The resistance matrices and the factor reuse the mobility
+            // buffers, only rsu comes on top
+            return bytes + n * n_s * sizeof(T);
+        }
+        // rfu, its factor, rsu, rfe and rse
+        bytes += (2 * n * n + 2 * n * n_s + n_s * n_s) * sizeof(T);
+        if ((flg & flags::REUSE_FACTORIZATION) && !(flg & flags::FTS)) {
+            // the factor of the mobility matrix and the vectors of
+            // reuse_workspace
+            bytes += (n * n + 9 * n) * sizeof(T);
+        }
+        return bytes;
+    }
+
+};
+
+/** Wait for the work queued on the stream of the BLAS/LAPACK handles */
+template <typename Policy>
+inline void synchronize(Policy) {}
+
+#if defined(__CUDACC__)
+inline void synchronize(policy::device) {
+    cudaStreamSynchronize(internal::bound_stream());
+}
+#elif defined(__HIPCC__)
+inline void synchronize(policy::device) {
+    hipStreamSynchronize(internal::bound_stream());
+}
+#endif
+
+/** Adds the wall time of a stage of \ref solver::calc_vel and the growth of
+ *  the workspace during it to the instrumentation attached to the
+ *  workspace, if there is one. The queued work is waited for only then,
+ *  so a workspace without instrumentation runs at full speed.
+ *  With SD_USE_NVTX or SD_USE_ROCTX, the stage is also marked as a range
+ *  for Nsight Systems or rocprof.
+ */
+template <typename Policy, typename T>
+class stage_scope {
+    workspace<Policy, T> const &m_ws;
+    sd_instrumentation::stage const m_stage;
+    std::size_t m_bytes = 0;
+    std::chrono::steady_clock::time_point m_start;
+
+public:
+    stage_scope(workspace<Policy, T> const &ws, sd_instrumentation::stage stage)
+        : m_ws(ws), m_stage(stage) {
+#if defined(SD_USE_NVTX)
+        nvtxRangePushA(sd_instrumentation::name(stage));
+#elif defined(SD_USE_ROCTX)
+        roctxRangePushA(sd_instrumentation::name(stage));
+#endif
+        if (m_ws.stats) {
+            synchronize(Policy{});
+            m_bytes = m_ws.bytes();
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+    stage_scope(stage_scope const &) = delete;
+    stage_scope &operator=(stage_scope const &) = delete;
+
+    ~stage_scope() {
+        if (m_ws.stats) {
+            synchronize(Policy{});
+            std::chrono::duration<double> const elapsed =
+                std::chrono::steady_clock::now() - m_start;
+            m_ws.stats->seconds[m_stage] += elapsed.count();
+            std::size_t const bytes = m_ws.bytes();
+            m_ws.stats->bytes[m_stage] += bytes > m_bytes ? bytes - m_bytes : 0;
+        }
+#if defined(SD_USE_NVTX)
+        nvtxRangePop();
+#elif defined(SD_USE_ROCTX)
+        roctxRangePop();
+#endif
+    }
+};
+
+/** Functor that takes all the relevant particle data (i.e. positions, radii,
+    external forces and torques) and computes the translational and angular
+    velocities. These can be used to propagate the system.
+
+    The basic idea of the method is as follows: The Stokes equation is linear,
+    i.e. the relations between force and motion (velocity) is purely linear.
+    All forces and torques that act on individual particles are merged into
+    one large vector. All velocities and angular velocities of individual
+    particles are merged into one vector alike.
+    The relationship between force and velocity is now given by the so-called
+    grand mobility matrix, or its inverse, the resistance matrix:
+
+            \f[\vec{U} = M_{UF} \vec{F}\f]
+
+    where \f$\vec{F}\f$ is the force, \f$\vec{U}\f$ the velocities and \f$M\f$
+    the grand mobility matrix. The subscript \f$_{UF}\f$ indicates that this
+    tensor describes the relationship between forces and velocities.
+    the relationship between forces and velocities.
+    The mobility matrix depends on the positions of all particles and therefore
+    is only valid for the momentary configuration. It needs to be recalculated
+    each time step.
+
+    To obtain the velocities, the mobility matrix must be applied to the forces
+    that act on the particles, giving the velocities.
+
+    These are the steps that are taken to compute the grand mobility matrix:
+      -# Starting point is an empty mobility matrix.
+      -# All self mobility terms are added. Its translational part is widely
+         known as Stokes' Law.
+      -# All pair mobility terms are added.
+      -# The mobility matrix is inverted to become a resistance matrix.
+      -# Lubrication corrections are added to the resistance matrix. They are
+         necessary for particles in close vicinity because simplifications
+         have been made to efficiently cover long range interactions.
+      -# In the end, the finished resistance matrix is inverted again. The
+         result is the finished mobility matrix that includes the short-ranged
+         lubrication interactions.
+
+    The thermalisation is achieved by a generalization of the
+    Einstein-Smoluchowski equation, which relates mobility and diffusion:
+
+            \f[D = \mu k_B T\f]
+
+    where \f$\mu\f$ is the mobility and \f$D\f$ is the diffusion coefficient.
+    The mean square displacement during a time step of length \f$\Delta t\f$,
+    and along one degree of freedom is given by
+
+            \f[\langle \Delta x^2 \rangle / \Delta t = 2 D\f]
+
+    By combining these two equations we get the random displacement, which we
+    can then directly use to propagate the particles:
+
+            \f[\Delta x = \sqrt{2 k_B T \Delta t} \times \mu^{1/2} \cdot \Phi\f]
+
+    where \f$\Phi\f$ is a random number drawn from a zero mean and unit
+    variance distribution.
+    That way we can determine the random displacement that our system
+    experiences along one of its many degrees of freedom. In our case,
+    \f$\mu\f$ is a matrix and we need its square root. The latter is
+    obtained via Cholesky decomposition. And \f$\Phi\f$ is a vector filled with
+    random numbers from a zero mean and unit variance distribution.
+ */
+template <typename Policy, typename T>
+struct solver {
+    static_assert(policy::is_policy<Policy>::value,
+                  "The execution policy must meet the requirements");
+    static_assert(std::is_arithmetic<T>::value,
+                  "Data type of device_matrix must be arithmetic for "
+                  "arithmetic operations");
+
+    template <typename U>
+    using vector_type = typename Policy::template vector<U>;
+
+    /** viscosity of the Stokes fluid */
+    T const eta;
+    /** number of particles */
+    std::size_t const n_part;
+    /** number of pairs of particles = n_part*(n_part-1)/2 */
+    std::size_t const n_pair;
+    /** edge length of the cubic box, see \ref flags::PERIODIC */
+    T const box_l;
+    /** relative accuracy of the Ewald sums in periodic mode */
+    T const ewald_tolerance;
+
+
+
+    /** Initialization of the SD solver */
+    solver(T eta, std::size_t const n_part, T box_l = T{0},
+           T ewald_tolerance = T{1e-6})
+        : eta{eta}, n_part(n_part), n_pair(n_part * (n_part - 1) / 2),
+          box_l{box_l}, ewald_tolerance{ewald_tolerance} {}
+
+
+    /** Invert the grand-mobility tensor.  This is done in several steps
+     *  which minimize the computation time. Input matrices are not preserved.
+     *
+     *    \param zmuf sub-tensor of the input mobility matrix, relating forces
+     *                to velocities
+     *    \param zmus input, relating stresslets to velocities
+     *    \param zmes input, relating ambient shear flow to stresslets
+     *    \param rsu buffer for the transpose of an intermediate result, only
+     *               used in FTS mode
+     *    \param rfu sub-tensor of the output resistance matrix, relating
+     *               velocities to forces
+     *    \param rfe output, relating ambient shear flow to forces
+     *    \param rse output, relating ambient shear flow to stresslets
+     */
+    void invert_grand_mobility_matrix(device_matrix<T, Policy> &zmuf,
+                                      device_matrix<T, Policy> &zmus,
+                                      device_matrix<T, Policy> &zmes,
+                                      device_matrix<T, Policy> &rsu,
+                                      device_matrix<T, Policy> &rfu,
+                                      device_matrix<T, Policy> &rfe,
+                                      device_matrix<T, Policy> &rse,
+                                      int const flg) {
+        // TODO: Where are these steps from?
+        // All matrices except zmus are symmetric, so the routines below
+        // reference only their upper triangles where possible.
+        if (flg & flags::FTS) {
+            // Factorize Muf = U(t) * U in place
+            zmuf.potrf();
+
+            // W = U(t) ^ -1 * Mus => zmus = U(t) ^ -1 * zmus
+            zmus.trsm(zmuf, true);
+
+            // Compute R3 = Mes - Mus(t) * R1 * Mus = Mes - W(t) * W
+            // => zmes = zmes - zmus(t) * zmus, a symmetric rank-k update
+            zmes.syrk(zmus, true, -1, 1);
+
+            // Compute R2(t) = R1 * Mus = U ^ -1 * W => rsu = U ^ -1 * zmus
+            rsu = zmus;
+            rsu.trsm(zmuf, false);
+
+            // Invert R1 = Muf ^ -1 => zmuf = zmuf ^ -1
+            zmuf.potri();
+
+            // Invert  R4 = R3 ^ -1 => zmes = zmes ^ -1
+            zmes.potrf();
+            zmes.potri();
+
+            // Compute R5 = -R2(t) * R4 => zmus = -rsu * zmes
+            zmus.symm(zmes, rsu, true, -1, 0);
+
+            // Compute R6 = R1 - R5 * R2 => zmuf = zmuf - zmus * rsu(t)
+            zmuf.gemm(zmus, rsu, false, true, -1, 1);
+        } else {
+            // Invert R1 = Muf ^ -1 => zmuf = zmuf ^ -1
+            zmuf.potrf();
+            zmuf.potri();
+        }
+        // The results are handed over by swapping the buffers, the inputs
+        // are overwritten in the next step anyway.
+        rfu.swap(zmuf);
+        rfe.swap(zmus);
+        rse.swap(zmes);
+    }
+
+    /** Thermalization with stochastic force, making use of the fluctuation-
+     *  dissipation-theorem.
+     *
      *  \return stochastic force vector
-     *  \param rfu_sqrt Square root of the resistance matrix
-     *  \param size size of the force vector, is 6 times number of particles
+     *  \param rfu_factor Cholesky factorization of the resistance matrix,
+     *                    its lower triangular factor serves as square root
+     *  \param size size of the force vector, is 6 times number of particles,
+     *              times the number of force vectors if there are several
      *  \param sqrt_kT_Dt Square root of kT / Delta t
      *  \param offset Simulation time, serves as RNG seed for each step
      *  \param seed global seed for the whole simulation
+     *  \param first_index index of the first random number of this system
+     */
+    vector_type<T> thermalization(cholesky_factor<T, Policy> const &rfu_factor,
+                                  std::size_t size, T sqrt_kT_Dt,
+                                  std::size_t offset, std::size_t seed,
+                                  std::size_t first_index = 0) {
+
+            // This method is combined from two locations,
+            // namely @cite banchio03a,
+            // Banchio, Brady 2002 https://doi.org/10.1063/1.1571819
+            // equation (6)
+            //  -- and --
+            // @cite brady88a
+            // Brady, Bossis 1988
+            // https://doi.org/10.1146/annurev.fl.20.010188.000551
+            // equation (3)
+
+            // We adopt the more detailed method of the paper @cite banchio03a.
+
+            // However, the matrix A in that paper is NOT a byproduct of the
+            // matrix inversion of R_{FU} as they claim. (We get the
+            // decomposition of R_{FU} but not of its inverse)
+            // Also, the random displacement between formulas (5) and (6) is
+            // wrong, since the square root needs to include kT and Delta t
+            // as well.
+
+            // Luckily, with the decomposition of R_{FU} we CAN compute an
+            // appropriate random force with the variance given by the paper
+            // @cite brady88a (as opposed to random displacement).
+
+            // Psi is a vector filled with random numbers, scaled correctly
+            vector_type<T> psi(size);
+            thrust_wrapper::tabulate(Policy::par(), psi.begin(), psi.end(),
+                             thermalizer<T>{sqrt_kT_Dt, offset, seed, first_index});
+
+            return rfu_factor.apply_sqrt(psi, size / rfu_factor.size());
+
+            // There is possibly an additional term for the thermalization
+            //
+            //     \nabla \cdot R_{FU}^{-1} \Delta t
+            //
+            // But this seems to be omitted in most cases in the literature.
+            // It is also very unclear how to actually calculate it.
+    }
+
+
+    /** main function doing the SD calculation, using temporary buffers */
+    std::vector<T> calc_vel(std::vector<T> const &x_host,
+                            std::vector<T> const &f_host,
+                            std::vector<T> const &a_host,
+                            T sqrt_kT_Dt,
+                            std::size_t offset,
+                            std::size_t seed,
+                            int const flg = flags::SELF_MOBILITY | flags::PAIR_MOBILITY | flags::FTS) {
+        workspace<Policy, T> ws;
+        return calc_vel(ws, x_host, f_host, a_host, sqrt_kT_Dt, offset, seed,
+                        flg);
+    }
+
+    /** Use the pairs given by the caller, e.g. from a Verlet list, as
+     *  candidates for the lubrication correction instead of searching all
+     *  pairs. Pairs outside the lubrication cutoff are skipped by the
+     *  \ref lubrication functor anyway.
+     *
+     *  \param pairs two particle indices per pair, see
+     *               \ref triangular_pair_ids
+     */
+    void set_lubrication_pairs(workspace<Policy, T> &ws,
+                               std::vector<std::size_t> const &pairs) const {
+        std::vector<std::size_t> const ids = triangular_pair_ids(pairs, n_part);
+        assert(ids.size() <= ws.lub_pairs.size());
+        thrust_wrapper::copy(ids.begin(), ids.end(), ws.lub_pairs.begin());
+        ws.n_lub_pairs = ids.size();
+    }
+
+    /** The Ewald sum of the workspace in periodic mode, otherwise a
+     *  disabled one
+     */
+    ewald_sum<T> ewald(workspace<Policy, T> const &ws, int const flg) const {
+        return (flg & flags::PERIODIC) ? ws.ewald.view() : ewald_sum<T>{};
+    }
+
+    /** Add the self mobility terms to the grand mobility matrix */
+    void add_self_mobility(workspace<Policy, T> &ws, int const flg) const {
+        dispatch_mode(flg, [&](auto mode) {
+            using Mode = decltype(mode);
+            thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+            thrust_wrapper::for_each(
+                Policy::par(), begin, begin + n_part,
+                mobility<Policy, T, true, Mode>{ws.zmuf, ws.zmus, ws.zmes,
+                                                ws.a,    eta,     flg,
+                                                ewald(ws, flg)});
+        });
+    }
+
+    /** Add the pair mobility terms to the grand mobility matrix */
+    void add_pair_mobility(workspace<Policy, T> &ws, int const flg) const {
+        dispatch_mode(flg, [&](auto mode) {
+            using Mode = decltype(mode);
+            thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+            thrust_wrapper::for_each(
+                Policy::par(), begin, begin + n_pair,
+                mobility<Policy, T, false, Mode>{ws.zmuf, ws.zmus, ws.zmes,
+                                                 ws.x,    n_part,  ws.a,
+                                                 eta,     flg,
+                                                 ewald(ws, flg)});
+        });
+    }
+
+    /** Add the lubrication corrections to the grand resistance matrix
+     *  (equation (2.18) or (2.21) resp.)
+     *
+     *  \param pairs optional list of candidate pairs, see
+     *               \ref set_lubrication_pairs
+     *  \param find_pairs whether to compact the pairs, if false, the pairs
+     *                    of an earlier call for the same configuration are
+     *                    used again and not counted a second time
+     */
+    void add_lubrication(workspace<Policy, T> &ws, int const flg,
+                         std::vector<std::size_t> const *pairs = nullptr,
+                         bool const find_pairs = true) const {
+        using scope = stage_scope<Policy, T>;
+        if (find_pairs) {
+            scope const stage{ws, sd_instrumentation::PAIR_LIST};
+            // Compact the list of pairs first, so that the lubrication
+            // functor only runs on pairs within the cutoff
+            if (pairs) {
+                set_lubrication_pairs(ws, *pairs);
+            } else {
+                dispatch_mode(flg, [&](auto mode) {
+                    using Mode = decltype(mode);
+                    thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+                    auto const last = thrust_wrapper::copy_if(
+                        Policy::par(), begin, begin + n_pair,
+                        ws.lub_pairs.begin(),
+                        lubrication_cutoff<Policy, T, Mode>{ws.x, n_part, ws.a,
+                                                            ewald(ws, flg)});
+                    ws.n_lub_pairs =
+                        static_cast<std::size_t>(last - ws.lub_pairs.begin());
+                });
+            }
+
+            // The pairs of a particle add to its diagonal blocks. So that
+            // the pairs can be processed in parallel, these corrections are
+            // summed up per particle in a second pass.
+            sort_lubrication_entries<Policy>(
+                ws.lub_pairs, ws.n_lub_pairs, n_part, 1, ws.lub_keys,
+                ws.lub_entries, ws.lub_offsets);
+            ws.lub_self.resize(lubrication<Policy, T>::self_size(flg) * 2 *
+                               ws.n_lub_pairs);
+            if (ws.stats) {
+                ws.stats->lubrication_pairs += ws.n_lub_pairs;
+            }
+        }
+
+        {
+            scope const stage{ws, sd_instrumentation::LUBRICATION};
+            dispatch_mode(flg, [&](auto mode) {
+                using Mode = decltype(mode);
+                lubrication<Policy, T, Mode> const lub{
+                    ws.rfu, ws.rfe, ws.rse, ws.x,          n_part,
+                    ws.a,   eta,    flg,    ewald(ws, flg)};
+                thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+                thrust_wrapper::for_each(
+                    Policy::par(), begin, begin + ws.n_lub_pairs,
+                    lubrication_pair<Policy, T, Mode>{lub, ws.lub_pairs,
+                                                      ws.lub_self});
+                thrust_wrapper::for_each(
+                    Policy::par(), begin, begin + n_part,
+                    lubrication_particle<Policy, T, Mode>{lub, ws.lub_offsets,
+                                                          ws.lub_entries,
+                                                          ws.lub_self});
+            });
+        }
+
+        // The lubrication functor only fills the upper triangles
+        scope const stage{ws, sd_instrumentation::SYMMETRIZATION};
+        ws.rfu.symmetrize_upper();
+        if (flg & flags::FTS) {
+            ws.rse.symmetrize_upper();
+        }
+    }
+
+    /** \p flg without the flags that cannot be honored by this solver.
+     *  PERIODIC is dropped in FTS mode, which has no Ewald sum of the
+     *  stresslet couplings, and if there is no box, so that both cases are
+     *  solved in free space instead of mixing periodic and free-space terms.
+     */
+    int effective_flags(int flg) const {
+        if ((flg & flags::PERIODIC) && ((flg & flags::FTS) || !(box_l > 0))) {
+            flg &= ~flags::PERIODIC;
+        }
+        return flg;
+    }
+
+    /** Whether the factors of a time step are kept for the following steps,
+     *  see \ref flags::REUSE_FACTORIZATION
+     */
+    static bool reuses_factorization(int const flg) {
+        return (flg & flags::REUSE_FACTORIZATION) && !(flg & flags::FTS);
+    }
+
+    /** y = W0^-1 B W0^-T v with the factors of the last full step, see
+     *  \ref reuse_workspace. The mobility matrix must be in zmuf and the
+     *  lubrication correction, if any, in rfu.
+     */
+    void apply_reused_system(workspace<Policy, T> &ws, int const flg,
+                             device_vector_view<T, Policy> v,
+                             device_vector_view<T, Policy> y) const {
+        using blas = internal::cublas<Policy, T>;
+        using lapack = internal::cusolver<Policy, T>;
+        int const n = static_cast<int>(6 * n_part);
+        T const *M = thrust_wrapper::raw_pointer_cast(ws.zmuf.data());
+        T const *L = thrust_wrapper::raw_pointer_cast(ws.rfu.data());
+        T const *U0 =
+            thrust_wrapper::raw_pointer_cast(ws.rfu_factor.matrix().data());
+        T const *V0 = thrust_wrapper::raw_pointer_cast(
+            ws.reuse.mobility.matrix().data());
+        T *t = thrust_wrapper::raw_pointer_cast(ws.reuse.t.data());
+        T *s = thrust_wrapper::raw_pointer_cast(ws.reuse.s.data());
+
+        // t = W0^-T v = M0^-1 U0^-1 v
+        thrust_wrapper::fill(Policy::par(), ws.reuse.t.begin(),
+                             ws.reuse.t.end(), T{0.0});
+        blas::axpy(n, 1, v.data(), t);
+        blas::trsm(false, U0, t, n, 1);
+        lapack::potrs(V0, t, n, 1);
+
+        // y = B t = M t + M L M t
+        blas::gemv(false, M, t, y.data(), n, n, 1, 0);
+        if (flg & flags::LUBRICATION) {
+            blas::gemv(false, L, y.data(), s, n, n, 1, 0);
+            blas::gemv(false, M, s, y.data(), n, n, 1, 1);
+        }
+
+        // y = W0^-1 y = U0^-T M0^-1 y
+        lapack::potrs(V0, y.data(), n, 1);
+        blas::trsm(true, U0, y.data(), n, 1);
+    }
+
+    /** Compute the velocities with the factors of the last full step, see
+     *  \ref reuse_workspace. The mobility matrix must be in zmuf and the
+     *  forces in fext. On success, the velocities are left in ws.reuse.b.
+     *
+     *  \return false, if the iterations did not converge
+     */
+    bool reuse_factorization(workspace<Policy, T> &ws, int const flg,
+                             T sqrt_kT_Dt, std::size_t offset, std::size_t seed,
+                             std::vector<std::size_t> const *pairs,
+                             std::size_t rng_index) const {
+        using blas = internal::cublas<Policy, T>;
+        using lapack = internal::cusolver<Policy, T>;
+        reuse_workspace<Policy, T> &rw = ws.reuse;
+        int const n = static_cast<int>(6 * n_part);
+        auto ptr = [](vector_type<T> &v) {
+            return thrust_wrapper::raw_pointer_cast(v.data());
+        };
+        T const *M = thrust_wrapper::raw_pointer_cast(ws.zmuf.data());
+        T const *U0 =
+            thrust_wrapper::raw_pointer_cast(ws.rfu_factor.matrix().data());
+        T const *V0 =
+            thrust_wrapper::raw_pointer_cast(rw.mobility.matrix().data());
+        auto const apply = [&](device_vector_view<T, Policy> v,
+                               device_vector_view<T, Policy> y) {
+            apply_reused_system(ws, flg, v, y);
+        };
+
+        // The factors are kept, so rfu is free for the dense lubrication
+        // correction L of the new configuration
+        if (flg & flags::LUBRICATION) {
+            ws.rfu.fill(T{0.0});
+            add_lubrication(ws, flg, pairs);
+        }
+        stage_scope<Policy, T> const stage{ws, sd_instrumentation::SOLVE};
+
+        // b = W0^-1 M F + (W0^-1 B W0^-T)^1/2 psi
+        rw.resize(n_part);
+        blas::gemv(false, M, ptr(ws.fext), ptr(rw.b), n, n, 1, 0);
+        lapack::potrs(V0, ptr(rw.b), n, 1);
+        blas::trsm(true, U0, ptr(rw.b), n, 1);
+        rw.iterations = 0;
+        if (sqrt_kT_Dt > 0.0) {
+            thrust_wrapper::tabulate(
+                Policy::par(), rw.psi.begin(), rw.psi.end(),
+                thermalizer<T>{sqrt_kT_Dt, offset, seed, rng_index});
+            T error = T{0.0};
+            rw.iterations = lanczos_sqrt<Policy, T>(
+                apply, rw.psi, rw.frnd, rw.q, rw.lanczos_basis,
+                rw.lanczos_coeff, rw.tolerance, rw.max_iterations, error);
+            if (error > rw.tolerance) {
+                return false;
+            }
+            blas::axpy(n, 1, ptr(rw.frnd), ptr(rw.b));
+        }
+
+        // Conjugate gradient method for z, starting from z = 0. The system
+        // matrix is close to the identity, so it needs no preconditioner.
+        thrust_wrapper::fill(Policy::par(), rw.z.begin(), rw.z.end(), T{0.0});
+        thrust_wrapper::copy(rw.b.begin(), rw.b.end(), rw.r.begin());
+        thrust_wrapper::copy(rw.b.begin(), rw.b.end(), rw.p.begin());
+        T rr = blas::dot(n, ptr(rw.r), ptr(rw.r));
+        T const b_norm = std::sqrt(rr);
+        std::size_t k = 0;
+        rw.residual = T{0.0};
+        if (b_norm > 0) {
+            rw.residual = T{1.0};
+            while (rw.residual > rw.tolerance) {
+                if (k == rw.max_iterations) {
+                    rw.iterations += k;
+                    return false;
+                }
+                apply(rw.p, rw.q);
+                T const alpha = rr / blas::dot(n, ptr(rw.p), ptr(rw.q));
+                blas::axpy(n, alpha, ptr(rw.p), ptr(rw.z));
+                blas::axpy(n, -alpha, ptr(rw.q), ptr(rw.r));
+                ++k;
+
+                T const rr_next = blas::dot(n, ptr(rw.r), ptr(rw.r));
+                rw.residual = std::sqrt(rr_next) / b_norm;
+                // p = r + beta p
+                blas::scal(n, rr_next / rr, ptr(rw.p));
+                blas::axpy(n, 1, ptr(rw.r), ptr(rw.p));
+                rr = rr_next;
+            }
+        }
+        rw.iterations += k;
+        rw.total_iterations += rw.iterations;
+        ++rw.reused_steps;
+
+        // U = M G with G = W0^-T z = M0^-1 U0^-1 z
+        blas::trsm(false, U0, ptr(rw.z), n, 1);
+        lapack::potrs(V0, ptr(rw.z), n, 1);
+        blas::gemv(false, M, ptr(rw.z), ptr(rw.b), n, n, 1, 0);
+        return true;
+    }
+
+    /** Everything the factor of the resistance matrix depends on, the
+     *  particles of the workspace, the viscosity, the box and the flags
+     *  that select the terms of the matrix. The key is stored with the
+     *  factor in the cache and compared when it is loaded, its hash only
+     *  names the files.
      */
-    vector_type<T> thermalization(device_matrix<T, Policy> &rfu_sqrt,
-                                  std::size_t size, T sqrt_kT_Dt,
-                                  std::size_t offset, std::size_t seed) {
+    std::vector<char> configuration_key(workspace<Policy, T> const &ws,
+                                        int const flg,
+                                        std::vector<std::size_t> const *pairs)
+        const {
+        std::vector<T> x_host(ws.x.size()), a_host(ws.a.size());
+        thrust_wrapper::copy(ws.x.begin(), ws.x.end(), x_host.begin());
+        thrust_wrapper::copy(ws.a.begin(), ws.a.end(), a_host.begin());
+        int const terms = flg & (flags::SELF_MOBILITY | flags::PAIR_MOBILITY |
+                                 flags::LUBRICATION | flags::FTS |
+                                 flags::PERIODIC);
+        std::vector<char> key;
+        auto const append = [&key](void const *data, std::size_t size) {
+            auto const *bytes = static_cast<char const *>(data);
+            key.insert(key.end(), bytes, bytes + size);
+        };
+        append(x_host.data(), x_host.size() * sizeof(T));
+        append(a_host.data(), a_host.size() * sizeof(T));
+        append(&eta, sizeof(eta));
+        append(&terms, sizeof(terms));
+        if (flg & flags::PERIODIC) {
+            append(&box_l, sizeof(box_l));
+            append(&ewald_tolerance, sizeof(ewald_tolerance));
+        }
+        // Pairs of the caller may leave out some within the cutoff
+        if (pairs && (flg & flags::LUBRICATION)) {
+            append(pairs->data(), pairs->size() * sizeof(std::size_t));
+        }
+        return key;
+    }
 
-            // This method is combined from two locations,
-            // namely @cite banchio03a,
-            // Banchio, Brady 2002 https://doi.org/10.1063/1.1571819
-            // equation (6)
-            //  -- and --
-            // @cite brady88a
-            // Brady, Bossis 1988
-            // https://doi.org/10.1146/annurev.fl.20.010188.000551
-            // equation (3)
+    /** Header and file name of a matrix in the cache of the workspace */
+    matrix_file_header cache_header(int const flg, std::uint64_t hash,
+                                    matrix_layout layout) const {
+        matrix_file_header header;
+        header.layout = layout;
+        header.flg = flg & (flags::SELF_MOBILITY | flags::PAIR_MOBILITY |
+                            flags::LUBRICATION | flags::FTS | flags::PERIODIC);
+        header.n_part = n_part;
+        header.hash = hash;
+        return header;
+    }
 
-            // We adopt the more detailed method of the paper @cite banchio03a.
+    static std::string cache_path(workspace<Policy, T> const &ws,
+                                  std::uint64_t hash, char const *matrix) {
+        char name[40];
+        std::snprintf(name, sizeof(name), "/sd_%016llx.%s",
+                      static_cast<unsigned long long>(hash), matrix);
+        return ws.factor_cache + name;
+    }
 
-            // However, the matrix A in that paper is NOT a byproduct of the
-            // matrix inversion of R_{FU} as they claim. (We get the
-            // decomposition of R_{FU} but not of its inverse)
-            // Also, the random displacement between formulas (5) and (6) is
-            // wrong, since the square root needs to include kT and Delta t
-            // as well.
+    /** Load the factor of rfu and, in FTS mode, rfe of the configuration
+     *  with the given key and hash from the cache, see
+     *  \ref workspace::factor_cache and \ref configuration_key
+     *
+     *  \return false, if they are not in the cache
+     */
+    bool load_factor(workspace<Policy, T> &ws, int const flg,
+                     std::uint64_t hash, std::vector<char> const &key) const {
+        std::size_t const n = 6 * n_part;
+        device_matrix<T, Policy> factor;
+        if (!load_matrix(cache_path(ws, hash, "rfu"), factor,
+                         cache_header(flg, hash, matrix_layout::CHOLESKY_UPPER),
+                         n, n, key)) {
+            return false;
+        }
+        if ((flg & flags::FTS) &&
+            !load_matrix(cache_path(ws, hash, "rfe"), ws.rfe,
+                         cache_header(flg, hash, matrix_layout::GENERAL), n,
+                         5 * n_part, key)) {
+            return false;
+        }
+        ws.rfu_factor.assign(factor);
+        return true;
+    }
 
-            // Luckily, with the decomposition of R_{FU} we CAN compute an
-            // appropriate random force with the variance given by the paper
-            // @cite brady88a (as opposed to random displacement).
+    /** Store the factor of rfu and, in FTS mode, rfe in the cache. A cache
+     *  that cannot be written only costs the time of the next factorization,
+     *  so failures are ignored.
+     */
+    void save_factor(workspace<Policy, T> const &ws, int const flg,
+                     std::uint64_t hash, std::vector<char> const &key) const {
+        if (flg & flags::FTS) {
+            save_matrix(cache_path(ws, hash, "rfe"), ws.rfe,
+                        cache_header(flg, hash, matrix_layout::GENERAL), key);
+        }
+        save_matrix(cache_path(ws, hash, "rfu"), ws.rfu_factor.matrix(),
+                    cache_header(flg, hash, matrix_layout::CHOLESKY_UPPER),
+                    key);
+    }
 
-            // Psi is a vector filled with random numbers, scaled correctly
-            vector_type<T> psi(size);
-            thrust_wrapper::tabulate(Policy::par(), psi.begin(), psi.end(),
-                             thermalizer<T>{sqrt_kT_Dt, offset, seed});
+    /** Steps after the factorization of \ref calc_vel: the thermal forces
+     *  and the solve for the velocities of all force vectors in ws.fext,
+     *  which are written to \p u
+     */
+    void solve_factorized(workspace<Policy, T> &ws, particle_view<T> u,
+                          T sqrt_kT_Dt, std::size_t offset, std::size_t seed,
+                          int const flg, std::size_t rng_index,
+                          std::size_t n_rhs) {
+        using scope = stage_scope<Policy, T>;
 
-            return rfu_sqrt * psi;
+        // Prepare the thermal stochastic forces
+        {
+            scope const stage{ws, sd_instrumentation::THERMALIZATION};
+            if (sqrt_kT_Dt > 0.0) {
+                ws.frnd = thermalization(ws.rfu_factor, ws.fext.size(),
+                                         sqrt_kT_Dt, offset, seed, rng_index);
+            } else {
+                thrust_wrapper::fill(Policy::par(), ws.frnd.begin(),
+                                     ws.frnd.end(), T{0.0});
+            }
+        }
+        // Finally, perform the matrix-multiplication
+        // multiply the force vector onto the mobility matrix (Eq. 2.22)
 
-            // There is possibly an additional term for the thermalization
-            //
-            //     \nabla \cdot R_{FU}^{-1} \Delta t
-            //
-            // But this seems to be omitted in most cases in the literature.
-            // It is also very unclear how to actually calculate it.
+        // The ambient flow uinf and the ambient shear flow einf are zero.
+        // Note: if we were to implement the case einf != 0 we would need to
+        // initialize the ambient flow according to the particle's positions.
+        // E.g. like   uinf_i = einf * r_i   where i is particle index.
+
+        // This is equation (2.22), plus thermal forces. The right hand side
+        // is accumulated in fext, all force vectors are solved at once.
+        {
+            scope const stage{ws, sd_instrumentation::SOLVE};
+            using blas = internal::cublas<Policy, T>;
+            int const n = static_cast<int>(6 * n_part);
+            T *const fext = thrust_wrapper::raw_pointer_cast(ws.fext.data());
+            if ((flg & flags::FTS) && n_rhs == 1) {
+                ws.rfe.gemv(ws.einf, ws.fext, 1, 1);
+            } else if (flg & flags::FTS) {
+                // The shear flow exerts the same forces in every vector
+                vector_type<T> fshear(6 * n_part);
+                ws.rfe.gemv(ws.einf, fshear);
+                for (std::size_t c = 0; c < n_rhs; ++c) {
+                    blas::axpy(n, 1,
+                               thrust_wrapper::raw_pointer_cast(fshear.data()),
+                               fext + c * n);
+                }
+            }
+            blas::axpy(static_cast<int>(ws.fext.size()), 1,
+                       thrust_wrapper::raw_pointer_cast(ws.frnd.data()), fext);
+            ws.rfu_factor.solve_in_place(ws.fext, n_rhs);
+            for (std::size_t c = 0; c < n_rhs; ++c) {
+                blas::axpy(n, 1,
+                           thrust_wrapper::raw_pointer_cast(ws.uinf.data()),
+                           fext + c * n);
+            }
+            if (workspace<Policy, T>::low_memory(flg)) {
+                ws.recycle();
+            }
+        }
+
+        // the velocities due to hydrodynamic interactions
+        scope const stage{ws, sd_instrumentation::TRANSFER};
+        scatter_particles<Policy>(ws.fext, n_part * n_rhs, u);
     }
 
+    /** main function doing the SD calculation
+     *
+     *  \param ws buffers which are reused if they already have the right size
+     *  \param x, f, a positions, forces and torques, and radii of the
+     *                 particles, read in place, see \ref particle_view
+     *  \param u output, translational and angular velocities
+     *  \param pairs optional list of candidate pairs for the lubrication
+     *               correction, see \ref set_lubrication_pairs. If it is
+     *               not given, all pairs are searched.
+     *  \param rng_index index of the first random number, systems of a batch
+     *                   use consecutive ranges
+     *  \param n_rhs number of force vectors, e.g. of the stages of a
+     *               midpoint integrator. \p f and \p u hold them one after
+     *               another, as if there were \p n_rhs times as many
+     *               particles. The matrices are assembled and factorized
+     *               once and all vectors are solved with one call. Vector c
+     *               gets the same velocities as a single one with the rng
+     *               index offset by 6 * n_part * c. The iterative, mixed
+     *               precision and reused factorization solvers handle the
+     *               vectors one by one.
+     *  \param requested_flg flags of the step, those that do not apply are
+     *                       ignored, see \ref effective_flags
+     */
+    void calc_vel(workspace<Policy, T> &ws, particle_view<T const> x,
+                  particle_view<T const> f, particle_view<T const> a,
+                  particle_view<T> u, T sqrt_kT_Dt, std::size_t offset,
+                  std::size_t seed,
+                  int const requested_flg = flags::SELF_MOBILITY | flags::PAIR_MOBILITY | flags::FTS,
+                  std::vector<std::size_t> const *pairs = nullptr,
+                  std::size_t rng_index = 0, std::size_t n_rhs = 1) {
+        using scope = stage_scope<Policy, T>;
+        int const flg = effective_flags(requested_flg);
+        bool const dense =
+            !iterative_solver<Policy, T>::applicable(flg) &&
+            (!(flg & flags::MIXED_PRECISION) || (flg & flags::PERIODIC)) &&
+            !reuses_factorization(flg);
+        if (n_rhs != 1 && !dense) {
+            for (std::size_t c = 0; c < n_rhs; ++c) {
+                calc_vel(ws, x, f.slice(c * n_part, n_part, 6), a,
+                         u.slice(c * n_part, n_part, 6), sqrt_kT_Dt, offset,
+                         seed, flg, pairs, rng_index + 6 * n_part * c);
+            }
+            return;
+        }
+        if (ws.stats) {
+            ++ws.stats->steps;
+        }
 
-    /** main function doing the SD calculation */
-    std::vector<T> calc_vel(std::vector<T> const &x_host,
-                            std::vector<T> const &f_host,
-                            std::vector<T> const &a_host,
-                            T sqrt_kT_Dt,
-                            std::size_t offset,
-                            std::size_t seed,
-                            int const flg = flags::SELF_MOBILITY | flags::PAIR_MOBILITY | flags::FTS) {
-        assert(x_host.size() == 6 * n_part);
-        vector_type<T> x(x_host.begin(), x_host.end());
-        assert(a_host.size() == n_part);
-        vector_type<T> a(a_host.begin(), a_host.end());
-
-        // TODO: More efficient!
-        // generate lookup table of all pairs
-        device_matrix<std::size_t, Policy> part_id(2, n_pair);
-        std::size_t k = 0;
-        for (std::size_t i = 0; i < n_part; ++i) {
-            for (std::size_t j = i + 1; j < n_part; ++j) {
-                part_id(0, k) = i;
-                part_id(1, k) = j;
-                k += 1;
+        if (iterative_solver<Policy, T>::applicable(flg)) {
+            bool const converged = [&] {
+                scope const stage{ws, sd_instrumentation::SOLVE};
+                return iterative_solver<Policy, T>{eta, n_part}.calc_vel(
+                    ws.iterative, x, f, a, u, flg, sqrt_kT_Dt, offset, seed,
+                    pairs, rng_index);
+            }();
+            if (ws.stats) {
+                ws.stats->iterations += ws.iterative.iterations +
+                                        ws.iterative.lanczos_iterations;
+            }
+            if (converged) {
+                // The pairs of a step that falls back are counted by the
+                // dense solver
+                if (ws.stats && (flg & flags::LUBRICATION)) {
+                    ws.stats->lubrication_pairs +=
+                        ws.iterative.near_field.pairs.size();
+                }
+                return;
+            }
+            // Like a failed reuse of the factors, the step is repeated with
+            // the dense solver, which needs O(n_part^2) memory
+            if (ws.stats) {
+                ++ws.stats->fallbacks;
             }
         }
 
-        device_matrix<T, Policy> pd(4, n_pair);
-        thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+        {
+            scope const stage{ws, sd_instrumentation::ALLOCATION};
+            ws.resize(n_part, flg);
+            ws.resize_rhs(n_rhs);
+
+            // The reciprocal-space sums only depend on the box, they are
+            // tabulated once and reused in later time steps
+            if (flg & flags::PERIODIC) {
+                ws.ewald.setup(box_l, ewald_tolerance);
+            }
+        }
+
+        {
+            scope const stage{ws, sd_instrumentation::TRANSFER};
+            gather_particles<Policy>(x, n_part, 6, ws.x);
+            gather_particles<Policy>(a, n_part, 1, ws.a);
+            gather_particles<Policy>(f, n_part * n_rhs, 6, ws.fext);
+        }
 
-        // check_dist
-        thrust_wrapper::for_each(Policy::par(), begin, begin + n_pair,
-                         check_dist<Policy, T>{x, a, pd, part_id});
+        // A factor of the same configuration that is found in the cache,
+        // e.g. from an earlier run, replaces steps 1 to 6
+        bool const cache = dense && !ws.factor_cache.empty();
+        std::vector<char> key;
+        std::uint64_t hash = 0;
+        bool const cached = cache && [&] {
+            scope const stage{ws, sd_instrumentation::FACTORIZATION};
+            key = configuration_key(ws, flg, pairs);
+            hash = fnv1a(key.data(), key.size());
+            return load_factor(ws, flg, hash, key);
+        }();
+        if (cached) {
+            solve_factorized(ws, u, sqrt_kT_Dt, offset, seed, flg, rng_index,
+                             n_rhs);
+            return;
+        }
 
         // 1. Generate empty grand mobility matrix
 
         // The following (sub-)tensors can be found in equation (2.17)
-        // part of the grand mobility matrix that relates forces (f)
-        // to velocities (u)
-        device_matrix<T, Policy> zmuf(n_part * 6, n_part * 6);
-        // part of the grand mobility matrix that relates stresslets (s)
-        // to velocities (u)
-        device_matrix<T, Policy> zmus(n_part * 6, n_part * 5);
-        // part of the grand mobility matrix that relates stresslets (s)
-        // to rate of strain (e)
-        device_matrix<T, Policy> zmes(n_part * 5, n_part * 5);
+        // zmuf is the part of the grand mobility matrix that relates forces
+        // (f) to velocities (u), zmus relates stresslets (s) to velocities
+        // (u) and zmes relates stresslets (s) to rate of strain (e).
+        //
+        // Together, the self and pair mobility terms overwrite every element,
+        // so the buffers only have to be cleared if one of them is missing.
+        if (!(flg & flags::SELF_MOBILITY) || !(flg & flags::PAIR_MOBILITY)) {
+            scope const stage{ws, sd_instrumentation::SELF_MOBILITY};
+            ws.zmuf.fill(T{0.0});
+            ws.zmus.fill(T{0.0});
+            ws.zmes.fill(T{0.0});
+        }
 
         // 2. add self mobility terms to the grand mobility matrix
         if (flg & flags::SELF_MOBILITY) {
-            thrust_wrapper::for_each(
-                Policy::par(), begin, begin + n_part,
-                mobility<Policy, T, true>{zmuf, zmus, zmes, a, eta, flg});
+            scope const stage{ws, sd_instrumentation::SELF_MOBILITY};
+            add_self_mobility(ws, flg);
         }
 
         // 3. add pair mobility terms to the grand mobility matrix
         if (flg & flags::PAIR_MOBILITY) {
-            thrust_wrapper::for_each(Policy::par(), begin, begin + n_pair,
-                                     mobility<Policy, T, false>{zmuf, zmus, zmes, pd,
-                                                                part_id, a, eta, flg});
+            scope const stage{ws, sd_instrumentation::PAIR_MOBILITY};
+            add_pair_mobility(ws, flg);
         }
 
-        // 4. invert M to obtain grand resistance matrix
-        device_matrix<T, Policy> rfu(n_part * 6, n_part * 6);
-        device_matrix<T, Policy> rfe(n_part * 6, n_part * 5);
-        device_matrix<T, Policy> rse(n_part * 5, n_part * 5);
-        invert_grand_mobility_matrix(zmuf, zmus, zmes, rfu, rfe, rse, flg);
-
-        // 5. add lubrication corrections (equation (2.18) or (2.21) resp.)
-        if (flg & flags::LUBRICATION) {
-            thrust_wrapper::for_each(Policy::par(), begin, begin + n_pair,
-                                     lubrication<Policy, T>{rfu, rfe, rse, pd, part_id,
-                                                            a, eta, flg});
-
-            for (std::size_t i = 0; i < 6 * n_part; ++i) {
-                for (std::size_t j = 0; j < i; ++j) {
-                    rfu(i, j) = rfu(j, i);
-                }
+        if ((flg & flags::MIXED_PRECISION) && !(flg & flags::PERIODIC)) {
+            auto const vel = [&] {
+                scope const stage{ws, sd_instrumentation::SOLVE};
+                return mixed_precision_solver<Policy>{n_part}.calc_vel(
+                    ws.mixed, ws.x, ws.a, ws.zmuf, ws.zmus, ws.zmes, eta,
+                    ws.fext, sqrt_kT_Dt, offset, seed, flg, pairs, rng_index);
+            }();
+            if (ws.stats && (flg & flags::LUBRICATION)) {
+                ws.stats->lubrication_pairs += ws.mixed.near_field.pairs.size();
             }
+            scope const stage{ws, sd_instrumentation::TRANSFER};
+            scatter_particles<Policy>(vel, n_part, u);
+            return;
+        }
 
-            for (std::size_t i = 0; i < 5 * n_part; ++i) {
-                for (std::size_t j = 0; j < i; ++j) {
-                    rse(i, j) = rse(j, i);
+        // 4. invert M to obtain grand resistance matrix
+        bool found_pairs = false;
+        if (reuses_factorization(flg)) {
+            // Try the factors of an earlier step first. Otherwise, the
+            // factor of M is kept and M^-1 is computed from a copy of it,
+            // which replaces the inversion in F-T mode.
+            if (ws.reuse.valid(ws.x, ws.a, n_part, flg)) {
+                bool const converged = reuse_factorization(
+                    ws, flg, sqrt_kT_Dt, offset, seed, pairs, rng_index);
+                // the dense step below works on the same lubrication pairs
+                found_pairs = (flg & flags::LUBRICATION) != 0;
+                if (ws.stats) {
+                    ws.stats->iterations += ws.reuse.iterations;
+                    ws.stats->fallbacks += converged ? 0 : 1;
+                }
+                if (converged) {
+                    scope const stage{ws, sd_instrumentation::TRANSFER};
+                    scatter_particles<Policy>(ws.reuse.b, n_part, u);
+                    return;
                 }
             }
+            scope const stage{ws, sd_instrumentation::INVERSION};
+            ws.reuse.mobility.factorize(ws.zmuf);
+            ws.reuse.store(ws.x, ws.a, n_part, flg);
+            ws.reuse.iterations = 0;
+            ws.rfu = ws.reuse.mobility.matrix();
+            ws.rfu.potri();
+        } else {
+            scope const stage{ws, sd_instrumentation::INVERSION};
+            invert_grand_mobility_matrix(ws.zmuf, ws.zmus, ws.zmes, ws.rsu,
+                                         ws.rfu, ws.rfe, ws.rse, flg);
+        }
+
+        // 5. add lubrication corrections (equation (2.18) or (2.21) resp.)
+        if (flg & flags::LUBRICATION) {
+            add_lubrication(ws, flg, pairs, !found_pairs);
         }
 
         // The inverse of the resistance matrix will be the mobility matrix
-        // which we need in the end
-        device_matrix<T, Policy> rfu_inv;
-        // The square root of R_FU is a byproduct of the matrix inversion,
+        // which we need in the end. It is never formed explicitly, instead
+        // the resistance matrix is factorized once and the final velocities
+        // are obtained by solving with the factor.
+        // The square root of R_FU is a byproduct of the factorization,
         // which we use for the thermalization
-        device_matrix<T, Policy> rfu_sqrt;
-        // 6. invert resistance matrix to obtain mobility matrix
+        // 6. factorize resistance matrix to obtain mobility matrix
         // The grand mobility matrix is now finished.
-        thrust_wrapper::tie(rfu_inv, rfu_sqrt) = rfu.inverse_and_cholesky();
+        {
+            scope const stage{ws, sd_instrumentation::FACTORIZATION};
+            if (workspace<Policy, T>::low_memory(flg)) {
+                ws.rfu_factor.factorize_in_place(ws.rfu);
+            } else {
+                ws.rfu_factor.factorize(ws.rfu);
+            }
+            if (cache) {
+                save_factor(ws, flg, hash, key);
+            }
+        }
 
-        // Prepare the thermal stochastic forces
-        vector_type<T> frnd(n_part * 6, T{0.0});
-        if (sqrt_kT_Dt > 0.0) {
-            frnd = thermalization(rfu_sqrt, f_host.size(), sqrt_kT_Dt,
-                                  offset, seed);
+        solve_factorized(ws, u, sqrt_kT_Dt, offset, seed, flg, rng_index,
+                         n_rhs);
+    }
+
+    /** Like above, but copies the particle data from and to host vectors
+     *  which are packed like the buffers of the solver
+     */
+    std::vector<T> calc_vel(workspace<Policy, T> &ws,
+                            std::vector<T> const &x_host,
+                            std::vector<T> const &f_host,
+                            std::vector<T> const &a_host,
+                            T sqrt_kT_Dt,
+                            std::size_t offset,
+                            std::size_t seed,
+                            int const flg = flags::SELF_MOBILITY | flags::PAIR_MOBILITY | flags::FTS,
+                            std::vector<std::size_t> const *pairs = nullptr,
+                            std::size_t rng_index = 0, std::size_t n_rhs = 1) {
+        std::vector<T> out(6 * n_part * n_rhs);
+        calc_vel(ws, x_host, f_host, a_host, out, sqrt_kT_Dt, offset, seed,
+                 flg, pairs, rng_index, n_rhs);
+        return out;
+    }
+};
+
+/** Pointers to the buffers of the first system of a batch of independent
+ *  systems. All systems have the same number of particles and their buffers
+ *  are stored one after another, so the buffers of system b are found at a
+ *  fixed stride. Matrices of one system are contiguous, i.e. the batch of
+ *  matrices forms a matrix with the same number of rows and b times the
+ *  number of columns.
+ */
+template <typename Policy, typename T>
+struct batch_layout {
+    T *x, *a, *zmuf, *zmus, *zmes;
+    std::size_t n_part;
+    std::size_t n_pair;
+
+    DEVICE_FUNC device_vector_view<T, Policy> x_of(std::size_t b) const {
+        return {x + b * 6 * n_part, 6 * n_part};
+    }
+    DEVICE_FUNC device_vector_view<T, Policy> a_of(std::size_t b) const {
+        return {a + b * n_part, n_part};
+    }
+    DEVICE_FUNC device_matrix_view<T, Policy> zmuf_of(std::size_t b) const {
+        return {zmuf + b * 36 * n_part * n_part, 6 * n_part, 6 * n_part};
+    }
+    DEVICE_FUNC device_matrix_view<T, Policy> zmus_of(std::size_t b) const {
+        return {zmus + b * 30 * n_part * n_part, 6 * n_part, 5 * n_part};
+    }
+    DEVICE_FUNC device_matrix_view<T, Policy> zmes_of(std::size_t b) const {
+        return {zmes + b * 25 * n_part * n_part, 5 * n_part, 5 * n_part};
+    }
+};
+
+/** Self \ref mobility for all particles of all systems of a batch. The index
+ *  enumerates (system, particle).
+ */
+template <typename Policy, typename T>
+struct batched_self_mobility {
+    batch_layout<Policy, T> const batch;
+    T const eta;
+    int const flg;
+
+    DEVICE_FUNC void operator()(std::size_t index) {
+        std::size_t const b = index / batch.n_part;
+        mobility<Policy, T, true>{batch.zmuf_of(b), batch.zmus_of(b),
+                                  batch.zmes_of(b), batch.a_of(b), eta,
+                                  flg}(index % batch.n_part);
+    }
+};
+
+/** Pair \ref mobility for all pairs of all systems of a batch. The index
+ *  enumerates (system, pair).
+ */
+template <typename Policy, typename T>
+struct batched_pair_mobility {
+    batch_layout<Policy, T> const batch;
+    T const eta;
+    int const flg;
+
+    DEVICE_FUNC void operator()(std::size_t index) {
+        std::size_t const b = index / batch.n_pair;
+        mobility<Policy, T, false>{batch.zmuf_of(b), batch.zmus_of(b),
+                                   batch.zmes_of(b), batch.x_of(b),
+                                   batch.n_part,     batch.a_of(b),
+                                   eta,              flg}(index % batch.n_pair);
+    }
+};
+
+/** \ref lubrication_cutoff for all pairs of all systems of a batch. The index
+ *  enumerates (system, pair).
+ */
+template <typename Policy, typename T>
+struct batched_lubrication_cutoff {
+    batch_layout<Policy, T> const batch;
+
+    DEVICE_FUNC bool operator()(std::size_t index) const {
+        std::size_t const b = index / batch.n_pair;
+        return lubrication_cutoff<Policy, T>{batch.x_of(b), batch.n_part,
+                                             batch.a_of(b)}(index % batch.n_pair);
+    }
+};
+
+/** \ref lubrication_pair for pairs of all systems of a batch. The pair
+ *  indices enumerate (system, pair). The grand resistance matrix is expected
+ *  in the buffers of the grand mobility matrix.
+ */
+template <typename Policy, typename T>
+struct batched_lubrication_pair {
+    batch_layout<Policy, T> const batch;
+    T const eta;
+    int const flg;
+    device_vector_view<std::size_t, Policy> const pairs;
+    device_vector_view<T, Policy> self;
+
+    DEVICE_FUNC void operator()(std::size_t p) {
+        std::size_t const b = pairs(p) / batch.n_pair;
+        std::size_t const n_self = lubrication<Policy, T>::self_size(flg);
+        lubrication<Policy, T>{batch.zmuf_of(b), batch.zmus_of(b),
+                               batch.zmes_of(b), batch.x_of(b),
+                               batch.n_part,     batch.a_of(b),
+                               eta,              flg}
+            .add_off_diagonal(pairs(p) % batch.n_pair,
+                              self.data() + n_self * (2 * p),
+                              self.data() + n_self * (2 * p + 1));
+    }
+};
+
+/** \ref lubrication_particle for all particles of all systems of a batch.
+ *  The index enumerates (system, particle).
+ */
+template <typename Policy, typename T>
+struct batched_lubrication_particle {
+    batch_layout<Policy, T> const batch;
+    T const eta;
+    int const flg;
+    device_vector_view<std::size_t, Policy> const offsets;
+    device_vector_view<std::size_t, Policy> const entries;
+    device_vector_view<T, Policy> const self;
+
+    DEVICE_FUNC void operator()(std::size_t index) {
+        std::size_t const b = index / batch.n_part;
+        std::size_t const n_self = lubrication<Policy, T>::self_size(flg);
+        lubrication<Policy, T> lub{batch.zmuf_of(b), batch.zmus_of(b),
+                                   batch.zmes_of(b), batch.x_of(b),
+                                   batch.n_part,     batch.a_of(b),
+                                   eta,              flg};
+        for (std::size_t n = offsets(index); n < offsets(index + 1); ++n) {
+            lub.add_diagonal(index % batch.n_part,
+                             self.data() + n_self * entries(n));
         }
-        // Finally, perform the matrix-multiplication
-        // multiply the force vector onto the mobility matrix (Eq. 2.22)
+    }
+};
 
-        // prepare the force vector
-        assert(f_host.size() == 6 * n_part);
-        vector_type<T> fext(f_host.begin(), f_host.end());
-        // initialize ambient flow
-        vector_type<T> uinf(n_part * 6, T{0.0});
-        // initialize ambient shear flow
-        vector_type<T> einf(n_part * 5, T{0.0});
-        // Note: if we were to implement the case einf != 0 we would need to
-        // initialize the ambient flow according to the particle's positions.
-        // E.g. like   uinf_i = einf * r_i   where i is particle index.
+/** All buffers that are needed by \ref batch_solver for one chunk of
+ *  systems, see \ref batch_layout for the storage order. They may be kept
+ *  between calls, e.g. in a context, and are only reallocated if the
+ *  number of particles or systems changes.
+ */
+template <typename Policy, typename T>
+struct batch_workspace {
+    template <typename U>
+    using vector_type = typename Policy::template vector<U>;
+
+    std::size_t n_part = 0;
+    std::size_t n_batch = 0;
+
+    /** particle positions, radii, forces and thermal forces */
+    vector_type<T> x, a, f, frnd;
+    /** indices (system, pair) of the pairs within the lubrication cutoff */
+    vector_type<std::size_t> lub_pairs;
+    /** adjacency list of the lubrication pairs and the corrections to the
+     *  diagonal blocks per entry, see \ref batched_lubrication_pair
+     */
+    vector_type<std::size_t> lub_keys, lub_entries, lub_offsets;
+    vector_type<T> lub_self;
+
+    /** grand mobility matrix, later overwritten by the resistance matrix */
+    device_matrix<T, Policy> zmuf, zmus, zmes;
+    /** intermediate result of the inversion in FTS mode */
+    device_matrix<T, Policy> rsu;
+
+    /** Make sure that all buffers fit \p n_batch systems of \p n_part
+     *  particles each. The chunks of \ref batch_solver::calc_vel may hold
+     *  fewer systems.
+     */
+    void resize(std::size_t n_part, std::size_t n_batch, int flg) {
+        std::size_t const n_pair = n_part * (n_part - 1) / 2;
+        if (n_part != this->n_part || n_batch != this->n_batch) {
+            this->n_part = n_part;
+            this->n_batch = n_batch;
+            x = vector_type<T>(6 * n_part * n_batch);
+            a = vector_type<T>(n_part * n_batch);
+            f = vector_type<T>(6 * n_part * n_batch);
+            frnd = vector_type<T>(6 * n_part * n_batch);
+            zmuf = device_matrix<T, Policy>(6 * n_part, 6 * n_part * n_batch);
+            zmus = device_matrix<T, Policy>(6 * n_part, 5 * n_part * n_batch);
+            zmes = device_matrix<T, Policy>(5 * n_part, 5 * n_part * n_batch);
+            rsu = device_matrix<T, Policy>();
+            lub_pairs = vector_type<std::size_t>();
+        }
+        if ((flg & flags::FTS) && rsu.size() != 30 * n_part * n_part * n_batch) {
+            rsu = device_matrix<T, Policy>(5 * n_part, 6 * n_part * n_batch);
+        }
+        if ((flg & flags::LUBRICATION) && lub_pairs.size() != n_pair * n_batch) {
+            lub_pairs = vector_type<std::size_t>(n_pair * n_batch);
+        }
+    }
+};
+
+/** Solves many independent systems with the same number of particles at
+ *  once, e.g. replicas of a small suspension. The steps are the same as in
+ *  \ref solver::calc_vel, but every functor runs over all systems in one
+ *  launch and the linear algebra uses batched BLAS/LAPACK routines, which
+ *  keeps the device busy even if the individual systems are tiny.
+ *
+ *  The systems are processed in chunks, so that the buffers of one chunk do
+ *  not exceed \ref chunk_bytes.
+ */
+template <typename Policy, typename T>
+struct batch_solver {
+    static_assert(policy::is_policy<Policy>::value,
+                  "The execution policy must meet the requirements");
+    static_assert(std::is_same<T, double>::value,
+                  "Data type of batch_solver must be double for "
+                  "BLAS/LAPACK operations");
+
+    template <typename U>
+    using vector_type = typename Policy::template vector<U>;
+
+    /** upper limit for the buffers of one chunk of systems */
+    static constexpr std::size_t chunk_bytes = std::size_t{1} << 30;
 
-        // This is equation (2.22), plus thermal forces.
-        vector_type<T> u = rfu_inv * (fext + rfe * einf + frnd) + uinf;
+    /** viscosity of the Stokes fluid */
+    T const eta;
+    /** number of particles per system */
+    std::size_t const n_part;
+    /** number of pairs of particles per system = n_part*(n_part-1)/2 */
+    std::size_t const n_pair;
+
+    batch_solver(T eta, std::size_t const n_part)
+        : eta{eta}, n_part(n_part), n_pair(n_part * (n_part - 1) / 2) {}
+
+    /** Number of systems that are processed at once. The estimate includes
+     *  the temporary copy needed by the batched inversion on some platforms.
+     */
+    std::size_t chunk_size() const {
+        std::size_t const per_system =
+            sizeof(T) * (36 + 30 + 25 + 30 + 36) * n_part * n_part +
+            sizeof(std::size_t) * n_pair;
+        std::size_t const chunk = chunk_bytes / per_system;
+        return chunk > 0 ? chunk : 1;
+    }
 
-        // return the velocities due to hydrodynamic interactions
-        std::vector<T> out(u.size());
-        thrust_wrapper::copy(u.begin(), u.end(), out.begin());
+    /** Compute the velocities of \p n_batch systems. The input vectors and
+     *  the result hold the data of all systems one after another. The random
+     *  numbers of system b are drawn with the indices following those of
+     *  system b - 1, so that the result does not depend on the chunking.
+     *
+     *  \param first_system number of the first system in a larger batch
+     *                      that is split up, its random numbers start at
+     *                      the index 6 * n_part * first_system
+     */
+    std::vector<T> calc_vel(std::vector<T> const &x_host,
+                            std::vector<T> const &f_host,
+                            std::vector<T> const &a_host,
+                            std::size_t n_batch, T sqrt_kT_Dt,
+                            std::size_t offset, std::size_t seed,
+                            int const flg = flags::SELF_MOBILITY | flags::PAIR_MOBILITY | flags::FTS,
+                            std::size_t first_system = 0) {
+        batch_workspace<Policy, T> ws;
+        return calc_vel(ws, x_host, f_host, a_host, n_batch, sqrt_kT_Dt,
+                        offset, seed, flg, first_system);
+    }
 
+    /** Like the overload above, but with the buffers in \p ws, which are
+     *  sized for the chunks of this batch and kept for later calls.
+     */
+    std::vector<T> calc_vel(batch_workspace<Policy, T> &ws,
+                            std::vector<T> const &x_host,
+                            std::vector<T> const &f_host,
+                            std::vector<T> const &a_host,
+                            std::size_t n_batch, T sqrt_kT_Dt,
+                            std::size_t offset, std::size_t seed,
+                            int const flg = flags::SELF_MOBILITY | flags::PAIR_MOBILITY | flags::FTS,
+                            std::size_t first_system = 0) {
+        assert(x_host.size() == 6 * n_part * n_batch);
+        assert(f_host.size() == 6 * n_part * n_batch);
+        assert(a_host.size() == n_part * n_batch);
+
+        std::vector<T> out(6 * n_part * n_batch);
+        std::size_t const chunk = chunk_size();
+        ws.resize(n_part, n_batch < chunk ? n_batch : chunk, flg);
+        for (std::size_t first = 0; first < n_batch; first += chunk) {
+            std::size_t const count =
+                n_batch - first < chunk ? n_batch - first : chunk;
+            calc_chunk(ws, x_host, f_host, a_host, first, count, sqrt_kT_Dt,
+                       offset, seed, flg, first_system, out);
+        }
         return out;
     }
+
+private:
+    /** Compute the velocities of the systems first, ..., first + count - 1,
+     *  \p ws must fit at least \p count systems
+     */
+    void calc_chunk(batch_workspace<Policy, T> &ws,
+                    std::vector<T> const &x_host,
+                    std::vector<T> const &f_host,
+                    std::vector<T> const &a_host, std::size_t first,
+                    std::size_t count, T sqrt_kT_Dt, std::size_t offset,
+                    std::size_t seed, int const flg,
+                    std::size_t first_system, std::vector<T> &out) {
+        using blas = internal::cublas<Policy, T>;
+        using lapack = internal::cusolver<Policy, T>;
+
+        assert(count <= ws.n_batch);
+        std::size_t const n6 = 6 * n_part;
+        std::size_t const n5 = 5 * n_part;
+
+        thrust_wrapper::copy(x_host.begin() + first * n6,
+                             x_host.begin() + (first + count) * n6,
+                             ws.x.begin());
+        thrust_wrapper::copy(a_host.begin() + first * n_part,
+                             a_host.begin() + (first + count) * n_part,
+                             ws.a.begin());
+        thrust_wrapper::copy(f_host.begin() + first * n6,
+                             f_host.begin() + (first + count) * n6,
+                             ws.f.begin());
+
+        T *const zmuf = thrust_wrapper::raw_pointer_cast(ws.zmuf.data());
+        T *const zmus = thrust_wrapper::raw_pointer_cast(ws.zmus.data());
+        T *const zmes = thrust_wrapper::raw_pointer_cast(ws.zmes.data());
+        batch_layout<Policy, T> const layout{
+            thrust_wrapper::raw_pointer_cast(ws.x.data()),
+            thrust_wrapper::raw_pointer_cast(ws.a.data()),
+            zmuf, zmus, zmes, n_part, n_pair};
+
+        thrust_wrapper::counting_iterator<std::size_t> begin(0UL);
+
+        // 1. - 3. assemble the grand mobility matrices
+        if (!(flg & flags::SELF_MOBILITY) || !(flg & flags::PAIR_MOBILITY)) {
+            ws.zmuf.fill(T{0.0});
+            ws.zmus.fill(T{0.0});
+            ws.zmes.fill(T{0.0});
+        }
+        if (flg & flags::SELF_MOBILITY) {
+            thrust_wrapper::for_each(
+                Policy::par(), begin, begin + count * n_part,
+                batched_self_mobility<Policy, T>{layout, eta, flg});
+        }
+        if (flg & flags::PAIR_MOBILITY) {
+            thrust_wrapper::for_each(
+                Policy::par(), begin, begin + count * n_pair,
+                batched_pair_mobility<Policy, T>{layout, eta, flg});
+        }
+
+        // 4. invert M to obtain the grand resistance matrix, the steps are
+        // the same as in solver::invert_grand_mobility_matrix
+        int const m6 = static_cast<int>(n6);
+        int const m5 = static_cast<int>(n5);
+        int const batch = static_cast<int>(count);
+        lapack::inverse_batched(zmuf, m6, batch);
+        if (flg & flags::FTS) {
+            T *const rsu = thrust_wrapper::raw_pointer_cast(ws.rsu.data());
+            // rsu = zmus(t) * zmuf
+            blas::gemm_batched(true, false, zmus, zmuf, rsu, m5, m6, m6, batch,
+                               1, 0);
+            // zmes = zmes - rsu * zmus
+            blas::gemm_batched(false, false, rsu, zmus, zmes, m5, m6, m5,
+                               batch, -1, 1);
+            lapack::inverse_batched(zmes, m5, batch);
+            // zmus = -rsu(t) * zmes
+            blas::gemm_batched(true, false, rsu, zmes, zmus, m6, m5, m5, batch,
+                               -1, 0);
+            // zmuf = zmuf - zmus * rsu
+            blas::gemm_batched(false, false, zmus, rsu, zmuf, m6, m5, m6,
+                               batch, -1, 1);
+        }
+
+        // 5. add lubrication corrections
+        if (flg & flags::LUBRICATION) {
+            auto const last = thrust_wrapper::copy_if(
+                Policy::par(), begin, begin + count * n_pair,
+                ws.lub_pairs.begin(),
+                batched_lubrication_cutoff<Policy, T>{layout});
+            // see solver::add_lubrication
+            auto const n_lub =
+                static_cast<std::size_t>(last - ws.lub_pairs.begin());
+            sort_lubrication_entries<Policy>(ws.lub_pairs, n_lub, n_part,
+                                             count, ws.lub_keys,
+                                             ws.lub_entries, ws.lub_offsets);
+            ws.lub_self.resize(lubrication<Policy, T>::self_size(flg) * 2 *
+                               n_lub);
+            thrust_wrapper::for_each(
+                Policy::par(), begin, begin + n_lub,
+                batched_lubrication_pair<Policy, T>{layout, eta, flg,
+                                                    ws.lub_pairs, ws.lub_self});
+            thrust_wrapper::for_each(
+                Policy::par(), begin, begin + count * n_part,
+                batched_lubrication_particle<Policy, T>{
+                    layout, eta, flg, ws.lub_offsets, ws.lub_entries,
+                    ws.lub_self});
+
+            internal::symmetrize_upper_batched<Policy>(zmuf, n6, count);
+            if (flg & flags::FTS) {
+                internal::symmetrize_upper_batched<Policy>(zmes, n5, count);
+            }
+        }
+
+        // 6. factorize the resistance matrices and solve for the velocities
+        lapack::potrf_batched(zmuf, m6, batch);
+
+        T *const f = thrust_wrapper::raw_pointer_cast(ws.f.data());
+        if (sqrt_kT_Dt > 0.0) {
+            thrust_wrapper::tabulate(
+                Policy::par(), ws.frnd.begin(), ws.frnd.begin() + count * n6,
+                thermalizer<T>{sqrt_kT_Dt, offset, seed,
+                               (first_system + first) * n6});
+            blas::trmv_batched(zmuf, thrust_wrapper::raw_pointer_cast(ws.frnd.data()),
+                               m6, batch);
+            thrust_wrapper::transform(Policy::par(), ws.f.begin(),
+                                      ws.f.begin() + count * n6,
+                                      ws.frnd.begin(), ws.f.begin(),
+                                      thrust_wrapper::plus<T>{});
+        }
+        lapack::potrs_batched(zmuf, f, m6, batch);
+
+        thrust_wrapper::copy(ws.f.begin(), ws.f.begin() + count * n6,
+                             out.begin() + first * n6);
+    }
 };
 
 } // namespace sd
@@ -0,0 +1,335 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <future>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "stokesian_dynamics/sd_auto.hpp"
+#include "stokesian_dynamics/sd_cpu.hpp"
+#include "stokesian_dynamics/sd_gpu.hpp"
+
+namespace {
+
+/** Wall time of both backends for a system size, see \ref sd_auto_calibrate */
+struct sample {
+  std::size_t n_part;
+  double cpu_seconds;
+  double gpu_seconds;
+};
+
+/** Crossover sizes and measured timings of the backends per flags, shared
+ *  by all threads of the process.
+ */
+class dispatcher {
+  std::mutex m_mutex;
+  /** held while measuring, so that calibrations do not disturb each other */
+  std::mutex m_calibration_mutex;
+  /** smallest number of particles that is solved on the GPU */
+  std::map<int, std::size_t> m_crossover;
+  /** timings of the calibration */
+  std::map<int, std::vector<sample>> m_samples;
+  /** fraction of the systems of a batch that is solved on the GPU, per
+   *  flags and number of particles, see \ref sd_auto_batch
+   */
+  std::map<std::pair<int, std::size_t>, double> m_gpu_share;
+
+public:
+  static dispatcher &instance() {
+    static dispatcher d;
+    return d;
+  }
+
+  std::mutex &calibration_mutex() { return m_calibration_mutex; }
+
+  bool find_crossover(int flg, std::size_t &n_part) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const it = m_crossover.find(flg);
+    if (it == m_crossover.end()) {
+      return false;
+    }
+    n_part = it->second;
+    return true;
+  }
+
+  void set_crossover(int flg, std::size_t n_part) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_crossover[flg] = n_part;
+  }
+
+  void set_samples(int flg, std::vector<sample> samples) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_samples[flg] = std::move(samples);
+  }
+
+  /** The share measured by earlier batches of the same size. Before that,
+   *  the one of the calibrated size that is closest on a logarithmic scale,
+   *  which balances the time of both backends if a system on the CPU and
+   *  one on the GPU take as long as in the calibration.
+   */
+  double gpu_share(int flg, std::size_t n_part) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const it = m_gpu_share.find({flg, n_part});
+    if (it != m_gpu_share.end()) {
+      return it->second;
+    }
+    auto const samples = m_samples.find(flg);
+    if (samples == m_samples.end() || samples->second.empty()) {
+      return 0.5;
+    }
+    auto const distance = [n_part](sample const &s) {
+      return std::abs(std::log(static_cast<double>(s.n_part) /
+                               static_cast<double>(n_part)));
+    };
+    auto const closest = std::min_element(
+        samples->second.begin(), samples->second.end(),
+        [&](sample const &lhs, sample const &rhs) {
+          return distance(lhs) < distance(rhs);
+        });
+    return closest->cpu_seconds /
+           (closest->cpu_seconds + closest->gpu_seconds);
+  }
+
+  /** Move the share towards the one that lets both parts of the last
+   *  batch take the same time. Averaging with the previous share damps
+   *  the jitter of single measurements.
+   */
+  void update_gpu_share(int flg, std::size_t n_part, double share,
+                        double cpu_seconds_per_system,
+                        double gpu_seconds_per_system) {
+    double const balanced =
+        cpu_seconds_per_system /
+        (cpu_seconds_per_system + gpu_seconds_per_system);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_gpu_share[{flg, n_part}] = 0.5 * (share + balanced);
+  }
+};
+
+/** Largest system size of the calibration that \ref sd_auto starts by
+ *  itself
+ */
+constexpr std::size_t default_calibration_limit = 1024;
+
+/** A system of \p n_part spheres of unit radius on a slightly perturbed
+ *  simple cubic lattice, like the one of the benchmarks
+ */
+struct configuration {
+  std::vector<double> x, f, a;
+
+  explicit configuration(std::size_t n_part)
+      : x(6 * n_part), f(6 * n_part), a(n_part, 1.0) {
+    auto const side = static_cast<std::size_t>(
+        std::ceil(std::cbrt(static_cast<double>(n_part))));
+    for (std::size_t i = 0; i < n_part; ++i) {
+      std::size_t const ijk[3] = {i % side, (i / side) % side,
+                                  i / (side * side)};
+      for (std::size_t d = 0; d < 3; ++d) {
+        x[6 * i + d] = 2.5 * ijk[d] + 0.2 * std::sin(1.7 * i + 2.9 * d);
+        f[6 * i + d] = std::cos(0.3 * i + d);
+        f[6 * i + 3 + d] = std::sin(0.7 * i + d);
+      }
+    }
+  }
+};
+
+/** Wall time of \p work in seconds */
+template <typename F> double seconds(F &&work) {
+  auto const start = std::chrono::steady_clock::now();
+  work();
+  std::chrono::duration<double> const elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+/** The calibration of \ref sd_auto_calibrate, the caller holds the
+ *  calibration mutex
+ */
+std::size_t calibrate(int flg, std::size_t max_particles) {
+  // The first call on the GPU creates the context and the handles
+  {
+    configuration const conf(8);
+    sd_gpu(conf.x, conf.f, conf.a, 8, 1.0, 1.0, 0, 0, flg);
+  }
+  std::vector<sample> samples;
+  std::size_t result = std::numeric_limits<std::size_t>::max();
+  bool gpu_was_faster = false;
+  for (std::size_t n_part = 8; n_part <= max_particles; n_part *= 2) {
+    configuration const conf(n_part);
+    sample s{n_part, std::numeric_limits<double>::max(),
+             std::numeric_limits<double>::max()};
+    // The better of two runs, the first one may still allocate
+    for (int rep = 0; rep < 2; ++rep) {
+      s.cpu_seconds = std::min(s.cpu_seconds, seconds([&] {
+        sd_cpu(conf.x, conf.f, conf.a, n_part, 1.0, 1.0, 0, 0, flg);
+      }));
+      s.gpu_seconds = std::min(s.gpu_seconds, seconds([&] {
+        sd_gpu(conf.x, conf.f, conf.a, n_part, 1.0, 1.0, 0, 0, flg);
+      }));
+    }
+    samples.push_back(s);
+    bool const gpu_is_faster = s.gpu_seconds < s.cpu_seconds;
+    if (gpu_is_faster && gpu_was_faster) {
+      result = n_part / 2;
+      break;
+    }
+    if (gpu_is_faster && 2 * n_part > max_particles) {
+      result = n_part;
+    }
+    gpu_was_faster = gpu_is_faster;
+  }
+  dispatcher::instance().set_samples(flg, std::move(samples));
+  dispatcher::instance().set_crossover(flg, result);
+  return result;
+}
+
+/** The crossover for \p flg, which is calibrated first if it is not known
+ *  yet. Threads that need the same crossover at the same time wait for
+ *  the calibration of the first one.
+ */
+std::size_t crossover(int flg) {
+  std::size_t n_part;
+  if (dispatcher::instance().find_crossover(flg, n_part)) {
+    return n_part;
+  }
+  std::lock_guard<std::mutex> lock(dispatcher::instance().calibration_mutex());
+  if (dispatcher::instance().find_crossover(flg, n_part)) {
+    return n_part;
+  }
+  return calibrate(flg, default_calibration_limit);
+}
+
+} // namespace
+
+/** Measures the wall time of \ref sd_cpu and \ref sd_gpu for systems of 8,
+ *  16, 32, ... particles up to \p max_particles, and stores the smallest
+ *  size from which on the GPU is faster as the crossover of \ref sd_auto.
+ *  The measurement stops at the first size at which the GPU is faster for
+ *  it and the following size. If the GPU is never faster, all systems stay
+ *  on the CPU. The timings also give the initial split of \ref
+ *  sd_auto_batch. Calibrations of several threads run one after another,
+ *  an explicit one always measures again.
+ *
+ *  \param flg flags the systems will be solved with
+ *  \param max_particles largest system size of the calibration
+ *  \return the crossover
+ */
+std::size_t sd_auto_calibrate(int flg, std::size_t max_particles) {
+  std::lock_guard<std::mutex> lock(dispatcher::instance().calibration_mutex());
+  return calibrate(flg, max_particles);
+}
+
+/** Sets the crossover of \ref sd_auto without a calibration, e.g. from the
+ *  timings of the benchmarks or of an sd_instrumentation.
+ *
+ *  \param flg flags the crossover applies to
+ *  \param n_part smallest number of particles that is solved on the GPU
+ */
+void sd_auto_set_crossover(int flg, std::size_t n_part) {
+  dispatcher::instance().set_crossover(flg, n_part);
+}
+
+/** The crossover of \ref sd_auto for \p flg, which is calibrated first
+ *  with up to 1024 particles if it was neither calibrated nor set
+ */
+std::size_t sd_auto_crossover(int flg) { return crossover(flg); }
+
+/** This executes the Stokesian Dynamics solver on the faster of the CPU
+ *  and the GPU, i.e. like \ref sd_gpu if \p n_part is at least the
+ *  crossover for \p flg, otherwise like \ref sd_cpu. The first call with
+ *  new flags calibrates the crossover, see \ref sd_auto_calibrate, unless
+ *  it was set with \ref sd_auto_set_crossover.
+ *
+ *  For the parameters, see \ref sd_cpu.
+ */
+std::vector<double> sd_auto(std::vector<double> const &x_host,
+                            std::vector<double> const &f_host,
+                            std::vector<double> const &a_host,
+                            std::size_t n_part, double eta, double sqrt_kT_Dt,
+                            std::size_t offset, std::size_t seed, int flg) {
+  if (n_part < crossover(flg)) {
+    return sd_cpu(x_host, f_host, a_host, n_part, eta, sqrt_kT_Dt, offset,
+                  seed, flg);
+  }
+  return sd_gpu(x_host, f_host, a_host, n_part, eta, sqrt_kT_Dt, offset, seed,
+                flg);
+}
+
+/** This executes the Stokesian Dynamics solver for \p n_batch independent
+ *  systems like \ref sd_cpu_batch and \ref sd_gpu_batch.
+ *
+ *  Without \p split, the whole batch goes to the backend that \ref sd_auto
+ *  selects for \p n_part. With \p split, the first systems are solved on
+ *  the CPU while the remaining ones are solved on the GPU at the same time.
+ *  The split starts from the calibrated timings and follows the wall
+ *  times of the earlier batches of the same size and flags, so that both
+ *  parts take about as long. Both backends keep at least one system, so
+ *  that their timings stay up to date. System b draws its random numbers
+ *  with the indices from 6 * n_part * b on, as in a batch that is solved
+ *  on one backend, so the streams do not depend on the split. However, the
+ *  generator of the device differs from the one of the host, so the noise
+ *  of a system still depends on the backend it is solved on.
+ *
+ *  \param split whether the batch is solved on both backends
+ *
+ *  For the remaining parameters, see \ref sd_cpu_batch.
+ */
+std::vector<double> sd_auto_batch(std::vector<double> const &x_host,
+                                  std::vector<double> const &f_host,
+                                  std::vector<double> const &a_host,
+                                  std::size_t n_part, std::size_t n_batch,
+                                  double eta, double sqrt_kT_Dt,
+                                  std::size_t offset, std::size_t seed,
+                                  int flg, bool split) {
+  if (!split || n_batch < 2) {
+    if (n_part < crossover(flg)) {
+      return sd_cpu_batch(x_host, f_host, a_host, n_part, n_batch, eta,
+                          sqrt_kT_Dt, offset, seed, flg);
+    }
+    return sd_gpu_batch(x_host, f_host, a_host, n_part, n_batch, eta,
+                        sqrt_kT_Dt, offset, seed, flg);
+  }
+  crossover(flg);
+  double const share = dispatcher::instance().gpu_share(flg, n_part);
+  auto const n_gpu = std::min(
+      n_batch - 1,
+      std::max<std::size_t>(1, static_cast<std::size_t>(std::lround(
+                                   share * static_cast<double>(n_batch)))));
+  std::size_t const n_cpu = n_batch - n_gpu;
+
+  auto const part = [&](std::vector<double> const &v, std::size_t width,
+                        std::size_t first, std::size_t count) {
+    return std::vector<double>(v.begin() + width * n_part * first,
+                               v.begin() + width * n_part * (first + count));
+  };
+
+  // The CPU part runs on a thread of its own, while the GPU part stays on
+  // the calling thread, which keeps its cuBLAS/cuSOLVER handles
+  double cpu_seconds = 0;
+  std::vector<double> out(6 * n_part * n_batch);
+  auto cpu = std::async(std::launch::async, [&] {
+    cpu_seconds = seconds([&] {
+      auto const u = sd_cpu_batch(part(x_host, 6, 0, n_cpu),
+                                  part(f_host, 6, 0, n_cpu),
+                                  part(a_host, 1, 0, n_cpu), n_part, n_cpu,
+                                  eta, sqrt_kT_Dt, offset, seed, flg);
+      std::copy(u.begin(), u.end(), out.begin());
+    });
+  });
+  double const gpu_seconds = seconds([&] {
+    auto const u = sd_gpu_batch(part(x_host, 6, n_cpu, n_gpu),
+                                part(f_host, 6, n_cpu, n_gpu),
+                                part(a_host, 1, n_cpu, n_gpu), n_part, n_gpu,
+                                eta, sqrt_kT_Dt, offset, seed, flg, n_cpu);
+    std::copy(u.begin(), u.end(), out.begin() + 6 * n_part * n_cpu);
+  });
+  cpu.get();
+
+  dispatcher::instance().update_gpu_share(
+      flg, n_part, share, cpu_seconds / static_cast<double>(n_cpu),
+      gpu_seconds / static_cast<double>(n_gpu));
+  return out;
+}
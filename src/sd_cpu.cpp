@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <vector>
 
@@ -30,3 +32,348 @@ std::vector<double> sd_cpu(std::vector<double> const &x_host,
   sd::solver<policy::host, double> viscous_force{eta, n_part};
   return viscous_force.calc_vel(x_host, f_host, a_host, sqrt_kT_Dt, offset, seed, flg);
 }
+
+/** This executes the Stokesian Dynamics solver for \p n_batch independent
+ *  systems of \p n_part particles each, e.g. replicas of a small suspension.
+ *  The input vectors hold the data of all systems one after another, and so
+ *  does the result. The random numbers of each system are drawn from
+ *  separate sections of the stream, so system b gets the same velocities as
+ *  a single system with the rng index offset by 6 * n_part * b.
+ *
+ *  Each system is solved by one thread, reusing one set of buffers per
+ *  thread, if the library was built with OpenMP.
+ *
+ *  \param n_batch number of systems
+ *
+ *  For the remaining parameters, see \ref sd_cpu.
+ */
+std::vector<double> sd_cpu_batch(std::vector<double> const &x_host,
+                                 std::vector<double> const &f_host,
+                                 std::vector<double> const &a_host,
+                                 std::size_t n_part, std::size_t n_batch,
+                                 double eta, double sqrt_kT_Dt,
+                                 std::size_t offset, std::size_t seed, int flg) {
+  return sd_cpu_batch(x_host, f_host, a_host, n_part, n_batch, eta, sqrt_kT_Dt,
+                      offset, seed, flg, 0);
+}
+
+/** Like \ref sd_cpu_batch, but for the systems \p first_system, ...,
+ *  \p first_system + n_batch - 1 of a larger batch, e.g. one that is split
+ *  between the CPU and the GPU. System b gets the same velocities as system
+ *  first_system + b of the whole batch.
+ *
+ *  \param first_system number of the first system in the whole batch
+ *
+ *  For the remaining parameters, see \ref sd_cpu_batch.
+ */
+std::vector<double> sd_cpu_batch(std::vector<double> const &x_host,
+                                 std::vector<double> const &f_host,
+                                 std::vector<double> const &a_host,
+                                 std::size_t n_part, std::size_t n_batch,
+                                 double eta, double sqrt_kT_Dt,
+                                 std::size_t offset, std::size_t seed, int flg,
+                                 std::size_t first_system) {
+  assert(x_host.size() == 6 * n_part * n_batch);
+  assert(f_host.size() == 6 * n_part * n_batch);
+  assert(a_host.size() == n_part * n_batch);
+  sd::solver<policy::host, double> viscous_force{eta, n_part};
+  std::vector<double> out(6 * n_part * n_batch);
+  long const n = static_cast<long>(n_batch);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    sd::workspace<policy::host, double> ws{n_part, flg};
+    std::vector<double> x(6 * n_part), f(6 * n_part), a(n_part);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for (long b = 0; b < n; ++b) {
+      std::size_t const first = static_cast<std::size_t>(b) * 6 * n_part;
+      std::copy_n(x_host.begin() + first, 6 * n_part, x.begin());
+      std::copy_n(f_host.begin() + first, 6 * n_part, f.begin());
+      std::copy_n(a_host.begin() + static_cast<std::size_t>(b) * n_part,
+                  n_part, a.begin());
+      std::size_t const rng_index = first + first_system * 6 * n_part;
+      auto const u = viscous_force.calc_vel(ws, x, f, a, sqrt_kT_Dt, offset,
+                                            seed, flg, nullptr, rng_index);
+      std::copy(u.begin(), u.end(), out.begin() + first);
+    }
+  }
+  return out;
+}
+
+/** Estimates the memory that a step of \ref sd_cpu or \ref sd_cpu_step
+ *  takes at its peak, e.g. to find the largest number of particles that
+ *  fits into the available RAM. The scratch space of the BLAS/LAPACK
+ *  libraries and the buffers of the pairs within the lubrication cutoff
+ *  are not included. With the LOW_MEMORY flag, the dense solver needs
+ *  less than half of the memory.
+ *
+ *  \param n_part number of particles
+ *  \param flg certain bits set in this register correspond to certain features activated
+ *  \return peak memory in bytes
+ */
+std::size_t sd_cpu_peak_bytes(std::size_t n_part, int flg) {
+  return sd::workspace<policy::host, double>::peak_bytes(n_part, flg);
+}
+
+/** Buffers of the Stokesian Dynamics solver which are kept alive between
+ *  time steps.
+ */
+struct sd_cpu_context {
+  sd::workspace<policy::host, double> ws;
+  /** edge length of the periodic box, zero if there is none */
+  double box_l = 0.;
+  /** number of threads of the steps, zero selects the OpenMP default */
+  int n_threads = 0;
+};
+
+/** Sets the number of threads of the solver for the calling thread as long
+ *  as it is alive, see \ref sd_cpu_set_num_threads
+ */
+class thread_count_scope {
+  int const m_previous;
+
+public:
+  explicit thread_count_scope(int n_threads)
+      : m_previous(thrust_wrapper::num_threads()) {
+    thrust_wrapper::num_threads() = n_threads;
+  }
+  thread_count_scope(thread_count_scope const &) = delete;
+  thread_count_scope &operator=(thread_count_scope const &) = delete;
+
+  ~thread_count_scope() { thrust_wrapper::num_threads() = m_previous; }
+};
+
+/** Creates a context whose buffers are reused by \ref sd_cpu_step as long as
+ *  the number of particles does not change.
+ *
+ *  \param n_part number of particles
+ *  \param flg certain bits set in this register correspond to certain features activated
+ */
+sd_cpu_context *sd_cpu_create(std::size_t n_part, int flg) {
+  return new sd_cpu_context{{n_part, flg}};
+}
+
+/** This executes the Stokesian Dynamics solver on the CPU, like \ref sd_cpu,
+ *  but reuses the buffers stored in \p ctx. They are reallocated only if
+ *  \p n_part has changed since the last call.
+ *
+ *  \param ctx context created with \ref sd_cpu_create
+ *
+ *  For the remaining parameters, see \ref sd_cpu.
+ */
+std::vector<double> sd_cpu_step(sd_cpu_context *ctx,
+                                std::vector<double> const &x_host,
+                                std::vector<double> const &f_host,
+                                std::vector<double> const &a_host,
+                                std::size_t n_part, double eta,
+                                double sqrt_kT_Dt, std::size_t offset,
+                                std::size_t seed, int flg) {
+  assert(ctx != nullptr);
+  thread_count_scope const threads{ctx->n_threads};
+  sd::solver<policy::host, double> viscous_force{eta, n_part, ctx->box_l};
+  return viscous_force.calc_vel(ctx->ws, x_host, f_host, a_host, sqrt_kT_Dt,
+                                offset, seed, flg);
+}
+
+/** Like \ref sd_cpu_step, but takes the candidate pairs for the lubrication
+ *  correction from the caller, e.g. from an existing Verlet list, instead of
+ *  searching all pairs.
+ *
+ *  \param pairs two particle indices per pair, pairs that are listed
+ *               twice, e.g. in both orders, are only counted once
+ *
+ *  For the remaining parameters, see \ref sd_cpu_step.
+ */
+std::vector<double> sd_cpu_step(sd_cpu_context *ctx,
+                                std::vector<double> const &x_host,
+                                std::vector<double> const &f_host,
+                                std::vector<double> const &a_host,
+                                std::size_t n_part, double eta,
+                                double sqrt_kT_Dt, std::size_t offset,
+                                std::size_t seed, int flg,
+                                std::vector<std::size_t> const &pairs) {
+  assert(ctx != nullptr);
+  thread_count_scope const threads{ctx->n_threads};
+  sd::solver<policy::host, double> viscous_force{eta, n_part, ctx->box_l};
+  return viscous_force.calc_vel(ctx->ws, x_host, f_host, a_host, sqrt_kT_Dt,
+                                offset, seed, flg, &pairs);
+}
+
+/** Like \ref sd_cpu_step, but for \p n_rhs force vectors on the same
+ *  configuration, e.g. the stages of a midpoint or predictor-corrector
+ *  integrator. The matrices are assembled and factorized only once, and all
+ *  vectors are solved together. \p f_host holds the vectors one after
+ *  another, and so does the result. Vector c gets the same velocities as
+ *  a single step with the rng index offset by 6 * n_part * c, i.e. every
+ *  vector gets its own random forces.
+ *
+ *  \param n_rhs number of force vectors
+ *
+ *  For the remaining parameters, see \ref sd_cpu_step.
+ */
+std::vector<double> sd_cpu_step_multi(sd_cpu_context *ctx,
+                                      std::vector<double> const &x_host,
+                                      std::vector<double> const &f_host,
+                                      std::vector<double> const &a_host,
+                                      std::size_t n_part, std::size_t n_rhs,
+                                      double eta, double sqrt_kT_Dt,
+                                      std::size_t offset, std::size_t seed,
+                                      int flg) {
+  assert(ctx != nullptr);
+  assert(f_host.size() == 6 * n_part * n_rhs);
+  thread_count_scope const threads{ctx->n_threads};
+  sd::solver<policy::host, double> viscous_force{eta, n_part, ctx->box_l};
+  return viscous_force.calc_vel(ctx->ws, x_host, f_host, a_host, sqrt_kT_Dt,
+                                offset, seed, flg, nullptr, 0, n_rhs);
+}
+
+/** Like \ref sd_cpu_step, but reads the particle data in place from
+ *  the arrays of the caller, e.g. from an array of particle structs, and
+ *  writes the velocities into a buffer of the caller. The values of
+ *  particle i start at index i times the stride of each array, all strides
+ *  are given in numbers of doubles.
+ *
+ *  \param x positions, 3 values per particle
+ *  \param f forces followed by torques, 6 values per particle
+ *  \param a radii, 1 value per particle
+ *  \param u output, translational followed by angular velocities, 6 values
+ *           per particle
+ *
+ *  For the remaining parameters, see \ref sd_cpu_step.
+ */
+void sd_cpu_step(sd_cpu_context *ctx, double const *x, std::size_t x_stride,
+                 double const *f, std::size_t f_stride, double const *a,
+                 std::size_t a_stride, double *u, std::size_t u_stride,
+                 std::size_t n_part, double eta, double sqrt_kT_Dt,
+                 std::size_t offset, std::size_t seed, int flg) {
+  assert(ctx != nullptr);
+  thread_count_scope const threads{ctx->n_threads};
+  using view = sd::particle_view<double const>;
+  sd::solver<policy::host, double> viscous_force{eta, n_part, ctx->box_l};
+  viscous_force.calc_vel(ctx->ws, view{x, 3, x_stride},
+                         view{f, 6, f_stride}, view{a, 1, a_stride},
+                         sd::particle_view<double>{u, 6, u_stride},
+                         sqrt_kT_Dt, offset, seed, flg);
+}
+
+/** Sets the edge length of the cubic box that is used by \ref sd_cpu_step
+ *  if the PERIODIC flag is set. The reciprocal-space part of the Ewald sum
+ *  is tabulated in the first step after the box changed.
+ *
+ *  \param ctx context created with \ref sd_cpu_create
+ *  \param box_l edge length of the box
+ */
+void sd_cpu_set_box_length(sd_cpu_context *ctx, double box_l) {
+  assert(ctx != nullptr);
+  ctx->box_l = box_l;
+}
+
+/** Sets the number of threads on which \ref sd_cpu_step runs the pair
+ *  stages, the generation of random numbers and the other element-wise
+ *  algorithms, if the library was built with OpenMP and without Thrust.
+ *  The threads of BLAS and LAPACK are configured separately.
+ *
+ *  \param ctx context created with \ref sd_cpu_create
+ *  \param n_threads number of threads, zero selects the OpenMP default
+ */
+void sd_cpu_set_num_threads(sd_cpu_context *ctx, int n_threads) {
+  assert(ctx != nullptr);
+  assert(n_threads >= 0);
+  ctx->n_threads = n_threads;
+}
+
+/** Sets when \ref sd_cpu_step factorizes the matrices again if the
+ *  REUSE_FACTORIZATION flag is set. In between, the factors of the last
+ *  full step serve as preconditioner of an iterative solve.
+ *
+ *  \param ctx context created with \ref sd_cpu_create
+ *  \param max_displacement largest displacement of a particle since the
+ *                          last factorization, in units of its radius
+ *  \param max_iterations largest number of iterations of a step
+ */
+void sd_cpu_set_reuse_thresholds(sd_cpu_context *ctx,
+                                 double max_displacement,
+                                 std::size_t max_iterations) {
+  assert(ctx != nullptr);
+  ctx->ws.reuse.max_displacement = max_displacement;
+  ctx->ws.reuse.max_iterations = max_iterations;
+}
+
+/** Reports how often \ref sd_cpu_step reused the factors with the
+ *  REUSE_FACTORIZATION flag.
+ *
+ *  \param ctx context created with \ref sd_cpu_create
+ *  \param factorizations number of steps which factorized the matrices
+ *  \param reused_steps number of steps which reused the factors
+ *  \param iterations total number of iterations of these steps
+ *  \param displacement largest displacement in the last step since the
+ *                      last factorization, in units of the radius
+ */
+void sd_cpu_reuse_statistics(sd_cpu_context const *ctx,
+                             std::size_t &factorizations,
+                             std::size_t &reused_steps,
+                             std::size_t &iterations, double &displacement) {
+  assert(ctx != nullptr);
+  factorizations = ctx->ws.reuse.factorizations;
+  reused_steps = ctx->ws.reuse.reused_steps;
+  iterations = ctx->ws.reuse.total_iterations;
+  displacement = ctx->ws.reuse.displacement;
+}
+
+/** Attaches \p stats to \p ctx, which then adds the wall time and the
+ *  allocations of each stage of \ref sd_cpu_step to it.
+ *
+ *  \param ctx context created with \ref sd_cpu_create
+ *  \param stats to be filled by the following steps, must stay valid until
+ *               it is detached with `nullptr`
+ */
+void sd_cpu_set_instrumentation(sd_cpu_context *ctx,
+                                sd_instrumentation *stats) {
+  assert(ctx != nullptr);
+  ctx->ws.stats = stats;
+}
+
+/** Keeps the Cholesky factors of the resistance matrices that
+ *  \ref sd_cpu_step computes in files in \p directory. A step whose
+ *  configuration, viscosity, box and flags match a file there, e.g. of
+ *  a frozen cluster or from an earlier run, loads the factor and skips the
+ *  assembly, the inversion and the factorization. The files are named by
+ *  a hash of the configuration, which is stored in them and compared
+ *  when they are loaded, so only bitwise identical configurations are
+ *  found. Only the dense double precision solver uses
+ *  the cache, it is ignored together with ITERATIVE, MIXED_PRECISION and
+ *  REUSE_FACTORIZATION.
+ *
+ *  \param ctx context created with \ref sd_cpu_create
+ *  \param directory existing directory of the files, `nullptr` or an empty
+ *                   string disables the cache
+ */
+void sd_cpu_set_factor_cache(sd_cpu_context *ctx, char const *directory) {
+  assert(ctx != nullptr);
+  ctx->ws.factor_cache = directory ? directory : "";
+}
+
+/** Distributes the Cholesky factorizations and inversions of all matrices
+ *  with at least \p min_size rows over the GPUs \p devices, if the library
+ *  was built with cuSOLVERMg. The matrices of a system of N particles have
+ *  6 N or 5 N rows. An empty list of devices keeps all of them on the CPU.
+ *
+ *  \return false, if the library was built without cuSOLVERMg
+ */
+bool sd_cpu_select_gpus(std::vector<int> const &devices, std::size_t min_size) {
+#if defined(SD_USE_CUSOLVERMG)
+  internal::multi_gpu::instance().select(devices, static_cast<int>(min_size));
+  return true;
+#else
+  static_cast<void>(devices);
+  static_cast<void>(min_size);
+  return false;
+#endif
+}
+
+/** Releases all buffers held by \p ctx.
+ */
+void sd_cpu_destroy(sd_cpu_context *ctx) { delete ctx; }
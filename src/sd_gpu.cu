@@ -1,4 +1,14 @@
+#include <cassert>
+#include <condition_variable>
 #include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "sd.hpp"
@@ -27,3 +37,481 @@ std::vector<double> sd_gpu(std::vector<double> const &x_host,
   // NOLINTNEXTLINE(clang-analyzer-core.NonNullParamChecker)
   return viscous_force.calc_vel(x_host, f_host, a_host, sqrt_kT_Dt, offset, seed, flg);
 }
+
+/** This executes the Stokesian Dynamics solver for \p n_batch independent
+ *  systems of \p n_part particles each, e.g. replicas of a small suspension.
+ *  The input vectors hold the data of all systems one after another, and so
+ *  does the result. The random numbers of each system are drawn from
+ *  separate sections of the stream, so system b gets the same velocities as
+ *  a single system with the rng index offset by 6 * n_part * b.
+ *
+ *  All systems are assembled and solved together with batched BLAS/LAPACK
+ *  routines, which keeps the GPU busy even if the systems are tiny. The
+ *  buffers are allocated anew in every call, see \ref sd_gpu_step_batch to
+ *  keep them between time steps.
+ *
+ *  \param n_batch number of systems
+ *
+ *  For the remaining parameters, see \ref sd_gpu.
+ */
+std::vector<double> sd_gpu_batch(std::vector<double> const &x_host,
+                                 std::vector<double> const &f_host,
+                                 std::vector<double> const &a_host,
+                                 std::size_t n_part, std::size_t n_batch,
+                                 double eta, double sqrt_kT_Dt,
+                                 std::size_t offset, std::size_t seed, int flg) {
+  return sd_gpu_batch(x_host, f_host, a_host, n_part, n_batch, eta, sqrt_kT_Dt,
+                      offset, seed, flg, 0);
+}
+
+/** Like \ref sd_gpu_batch, but for the systems \p first_system, ...,
+ *  \p first_system + n_batch - 1 of a larger batch, e.g. one that is split
+ *  between the CPU and the GPU. System b gets the same velocities as system
+ *  first_system + b of the whole batch.
+ *
+ *  \param first_system number of the first system in the whole batch
+ *
+ *  For the remaining parameters, see \ref sd_gpu_batch.
+ */
+std::vector<double> sd_gpu_batch(std::vector<double> const &x_host,
+                                 std::vector<double> const &f_host,
+                                 std::vector<double> const &a_host,
+                                 std::size_t n_part, std::size_t n_batch,
+                                 double eta, double sqrt_kT_Dt,
+                                 std::size_t offset, std::size_t seed, int flg,
+                                 std::size_t first_system) {
+  sd::batch_solver<policy::device, double> viscous_force{eta, n_part};
+  // NOLINTNEXTLINE(clang-analyzer-core.NonNullParamChecker)
+  return viscous_force.calc_vel(x_host, f_host, a_host, n_batch, sqrt_kT_Dt,
+                                offset, seed, flg, first_system);
+}
+
+/** Runs the steps of \ref sd_gpu_step_async one after another on a thread
+ *  of its own. The thread is started with the first step and keeps its
+ *  cuBLAS/cuSOLVER handles, see internal::handle_pool, so that they are
+ *  only created once. Steps which are still queued when the worker is
+ *  destroyed are completed first.
+ */
+class async_worker {
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<std::packaged_task<void()>> m_tasks;
+  bool m_stop = false;
+  std::thread m_thread;
+
+  void run() {
+    for (;;) {
+      std::packaged_task<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_stop || !m_tasks.empty(); });
+        if (m_tasks.empty()) {
+          return;
+        }
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+public:
+  async_worker() = default;
+  async_worker(async_worker const &) = delete;
+  async_worker &operator=(async_worker const &) = delete;
+
+  ~async_worker() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cv.notify_one();
+    if (m_thread.joinable()) {
+      m_thread.join();
+    }
+  }
+
+  /** Queue \p work, the future becomes ready once it is done */
+  std::future<void> submit(std::function<void()> work) {
+    std::packaged_task<void()> task(std::move(work));
+    std::future<void> done = task.get_future();
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_thread.joinable()) {
+        m_thread = std::thread(&async_worker::run, this);
+      }
+      m_tasks.push_back(std::move(task));
+    }
+    m_cv.notify_one();
+    return done;
+  }
+};
+
+/** Estimates the memory that a step of \ref sd_gpu or \ref sd_gpu_step
+ *  takes at its peak, e.g. to find the largest number of particles that
+ *  fits into the available device memory. The scratch space of the BLAS/LAPACK
+ *  libraries and the buffers of the pairs within the lubrication cutoff
+ *  are not included. With the LOW_MEMORY flag, the dense solver needs
+ *  less than half of the memory.
+ *
+ *  \param n_part number of particles
+ *  \param flg certain bits set in this register correspond to certain features activated
+ *  \return peak memory in bytes
+ */
+std::size_t sd_gpu_peak_bytes(std::size_t n_part, int flg) {
+  return sd::workspace<policy::device, double>::peak_bytes(n_part, flg);
+}
+
+/** Buffers of the Stokesian Dynamics solver which are kept alive between
+ *  time steps.
+ */
+struct sd_gpu_context {
+  sd::workspace<policy::device, double> ws;
+  /** buffers of \ref sd_gpu_step_batch */
+  sd::batch_workspace<policy::device, double> batch;
+  /** edge length of the periodic box, zero if there is none */
+  double box_l = 0.;
+  /** thread of \ref sd_gpu_step_async, declared last so that it finishes
+   *  its steps before the buffers are released
+   */
+  async_worker worker;
+};
+
+/** Creates a context whose buffers are reused by \ref sd_gpu_step as long as
+ *  the number of particles does not change.
+ *
+ *  \param n_part number of particles
+ *  \param flg certain bits set in this register correspond to certain features activated
+ */
+sd_gpu_context *sd_gpu_create(std::size_t n_part, int flg) {
+  return new sd_gpu_context{{n_part, flg}, {}, 0., {}};
+}
+
+/** This executes the Stokesian Dynamics solver on the GPU, like \ref sd_gpu,
+ *  but reuses the buffers stored in \p ctx. They are reallocated only if
+ *  \p n_part has changed since the last call.
+ *
+ *  \param ctx context created with \ref sd_gpu_create
+ *
+ *  For the remaining parameters, see \ref sd_gpu.
+ */
+std::vector<double> sd_gpu_step(sd_gpu_context *ctx,
+                                std::vector<double> const &x_host,
+                                std::vector<double> const &f_host,
+                                std::vector<double> const &a_host,
+                                std::size_t n_part, double eta,
+                                double sqrt_kT_Dt, std::size_t offset,
+                                std::size_t seed, int flg) {
+  assert(ctx != nullptr);
+  sd::solver<policy::device, double> viscous_force{eta, n_part, ctx->box_l};
+  // NOLINTNEXTLINE(clang-analyzer-core.NonNullParamChecker)
+  return viscous_force.calc_vel(ctx->ws, x_host, f_host, a_host, sqrt_kT_Dt,
+                                offset, seed, flg);
+}
+
+/** Like \ref sd_gpu_step, but takes the candidate pairs for the lubrication
+ *  correction from the caller, e.g. from an existing Verlet list, instead of
+ *  searching all pairs.
+ *
+ *  \param pairs two particle indices per pair, each pair listed only once
+ *
+ *  For the remaining parameters, see \ref sd_gpu_step.
+ */
+std::vector<double> sd_gpu_step(sd_gpu_context *ctx,
+                                std::vector<double> const &x_host,
+                                std::vector<double> const &f_host,
+                                std::vector<double> const &a_host,
+                                std::size_t n_part, double eta,
+                                double sqrt_kT_Dt, std::size_t offset,
+                                std::size_t seed, int flg,
+                                std::vector<std::size_t> const &pairs) {
+  assert(ctx != nullptr);
+  sd::solver<policy::device, double> viscous_force{eta, n_part, ctx->box_l};
+  // NOLINTNEXTLINE(clang-analyzer-core.NonNullParamChecker)
+  return viscous_force.calc_vel(ctx->ws, x_host, f_host, a_host, sqrt_kT_Dt,
+                                offset, seed, flg, &pairs);
+}
+
+/** Like \ref sd_gpu_step, but for \p n_rhs force vectors on the same
+ *  configuration, e.g. the stages of a midpoint or predictor-corrector
+ *  integrator. The matrices are assembled and factorized only once, and all
+ *  vectors are solved together. \p f_host holds the vectors one after
+ *  another, and so does the result. Vector c gets the same velocities as
+ *  a single step with the rng index offset by 6 * n_part * c, i.e. every
+ *  vector gets its own random forces.
+ *
+ *  \param n_rhs number of force vectors
+ *
+ *  For the remaining parameters, see \ref sd_gpu_step.
+ */
+std::vector<double> sd_gpu_step_multi(sd_gpu_context *ctx,
+                                      std::vector<double> const &x_host,
+                                      std::vector<double> const &f_host,
+                                      std::vector<double> const &a_host,
+                                      std::size_t n_part, std::size_t n_rhs,
+                                      double eta, double sqrt_kT_Dt,
+                                      std::size_t offset, std::size_t seed,
+                                      int flg) {
+  assert(ctx != nullptr);
+  assert(f_host.size() == 6 * n_part * n_rhs);
+  sd::solver<policy::device, double> viscous_force{eta, n_part, ctx->box_l};
+  // NOLINTNEXTLINE(clang-analyzer-core.NonNullParamChecker)
+  return viscous_force.calc_vel(ctx->ws, x_host, f_host, a_host, sqrt_kT_Dt,
+                                offset, seed, flg, nullptr, 0, n_rhs);
+}
+
+/** Like \ref sd_gpu_batch, but reuses the buffers stored in \p ctx. They
+ *  are reallocated only if \p n_part or \p n_batch has changed since the
+ *  last call.
+ *
+ *  \param ctx context created with \ref sd_gpu_create
+ *
+ *  For the remaining parameters, see \ref sd_gpu_batch.
+ */
+std::vector<double> sd_gpu_step_batch(sd_gpu_context *ctx,
+                                      std::vector<double> const &x_host,
+                                      std::vector<double> const &f_host,
+                                      std::vector<double> const &a_host,
+                                      std::size_t n_part, std::size_t n_batch,
+                                      double eta, double sqrt_kT_Dt,
+                                      std::size_t offset, std::size_t seed,
+                                      int flg) {
+  assert(ctx != nullptr);
+  sd::batch_solver<policy::device, double> viscous_force{eta, n_part};
+  // NOLINTNEXTLINE(clang-analyzer-core.NonNullParamChecker)
+  return viscous_force.calc_vel(ctx->batch, x_host, f_host, a_host, n_batch,
+                                sqrt_kT_Dt, offset, seed, flg);
+}
+
+/** Like \ref sd_gpu_step, but reads the particle data in place from
+ *  the arrays of the caller, e.g. from an array of particle structs, and
+ *  writes the velocities into a buffer of the caller. The values of
+ *  particle i start at index i times the stride of each array, all strides
+ *  are given in numbers of doubles.
+ *
+ *  \param x positions, 3 values per particle
+ *  \param f forces followed by torques, 6 values per particle
+ *  \param a radii, 1 value per particle
+ *  \param u output, translational followed by angular velocities, 6 values
+ *           per particle
+ *  \param on_device whether all pointers refer to device memory, e.g. if the
+ *                   particle data already resides on the GPU
+ *
+ *  For the remaining parameters, see \ref sd_gpu_step.
+ */
+void sd_gpu_step(sd_gpu_context *ctx, double const *x, std::size_t x_stride,
+                 double const *f, std::size_t f_stride, double const *a,
+                 std::size_t a_stride, double *u, std::size_t u_stride,
+                 std::size_t n_part, double eta, double sqrt_kT_Dt,
+                 std::size_t offset, std::size_t seed, int flg, bool on_device) {
+  assert(ctx != nullptr);
+  using view = sd::particle_view<double const>;
+  sd::solver<policy::device, double> viscous_force{eta, n_part, ctx->box_l};
+  // NOLINTNEXTLINE(clang-analyzer-core.NonNullParamChecker)
+  viscous_force.calc_vel(ctx->ws, view{x, 3, x_stride, on_device},
+                         view{f, 6, f_stride, on_device},
+                         view{a, 1, a_stride, on_device},
+                         sd::particle_view<double>{u, 6, u_stride, on_device},
+                         sqrt_kT_Dt, offset, seed, flg);
+}
+
+/** Sets the edge length of the cubic box that is used by \ref sd_gpu_step
+ *  if the PERIODIC flag is set. The reciprocal-space part of the Ewald sum
+ *  is tabulated in the first step after the box changed.
+ *
+ *  \param ctx context created with \ref sd_gpu_create
+ *  \param box_l edge length of the box
+ */
+void sd_gpu_set_box_length(sd_gpu_context *ctx, double box_l) {
+  assert(ctx != nullptr);
+  ctx->box_l = box_l;
+}
+
+/** Sets when \ref sd_gpu_step factorizes the matrices again if the
+ *  REUSE_FACTORIZATION flag is set. In between, the factors of the last
+ *  full step serve as preconditioner of an iterative solve.
+ *
+ *  \param ctx context created with \ref sd_gpu_create
+ *  \param max_displacement largest displacement of a particle since the
+ *                          last factorization, in units of its radius
+ *  \param max_iterations largest number of iterations of a step
+ */
+void sd_gpu_set_reuse_thresholds(sd_gpu_context *ctx,
+                                 double max_displacement,
+                                 std::size_t max_iterations) {
+  assert(ctx != nullptr);
+  ctx->ws.reuse.max_displacement = max_displacement;
+  ctx->ws.reuse.max_iterations = max_iterations;
+}
+
+/** Reports how often \ref sd_gpu_step reused the factors with the
+ *  REUSE_FACTORIZATION flag.
+ *
+ *  \param ctx context created with \ref sd_gpu_create
+ *  \param factorizations number of steps which factorized the matrices
+ *  \param reused_steps number of steps which reused the factors
+ *  \param iterations total number of iterations of these steps
+ *  \param displacement largest displacement in the last step since the
+ *                      last factorization, in units of the radius
+ */
+void sd_gpu_reuse_statistics(sd_gpu_context const *ctx,
+                             std::size_t &factorizations,
+                             std::size_t &reused_steps,
+                             std::size_t &iterations, double &displacement) {
+  assert(ctx != nullptr);
+  factorizations = ctx->ws.reuse.factorizations;
+  reused_steps = ctx->ws.reuse.reused_steps;
+  iterations = ctx->ws.reuse.total_iterations;
+  displacement = ctx->ws.reuse.displacement;
+}
+
+/** Attaches \p stats to \p ctx, which then adds the wall time and the
+ *  allocations of each stage of \ref sd_gpu_step to it. The stream is
+ *  synchronized between the stages for the timings, so this slows down
+ *  the steps a bit.
+ *  With \ref sd_gpu_step_async, it is written by the worker thread, so it
+ *  must only be read once the step is done.
+ *
+ *  \param ctx context created with \ref sd_gpu_create
+ *  \param stats to be filled by the following steps, must stay valid until
+ *               it is detached with `nullptr`
+ */
+void sd_gpu_set_instrumentation(sd_gpu_context *ctx,
+                                sd_instrumentation *stats) {
+  assert(ctx != nullptr);
+  ctx->ws.stats = stats;
+}
+
+/** Keeps the Cholesky factors of the resistance matrices that
+ *  \ref sd_gpu_step computes in files in \p directory. A step whose
+ *  configuration, viscosity, box and flags match a file there, e.g. of
+ *  a frozen cluster or from an earlier run, loads the factor and skips the
+ *  assembly, the inversion and the factorization. The files are named by
+ *  a hash of the configuration, which is stored in them and compared
+ *  when they are loaded, so only bitwise identical configurations are
+ *  found. Only the dense double precision solver uses
+ *  the cache, it is ignored together with ITERATIVE, MIXED_PRECISION and
+ *  REUSE_FACTORIZATION.
+ *
+ *  \param ctx context created with \ref sd_gpu_create
+ *  \param directory existing directory of the files, `nullptr` or an empty
+ *                   string disables the cache
+ */
+void sd_gpu_set_factor_cache(sd_gpu_context *ctx, char const *directory) {
+  assert(ctx != nullptr);
+  ctx->ws.factor_cache = directory ? directory : "";
+}
+
+/** Starts a time step like \ref sd_gpu_step and returns immediately, so
+ *  that the caller can compute other forces on the CPU in the meantime. The
+ *  step runs on a worker thread of \p ctx, and all its kernels and
+ *  BLAS/LAPACK calls are queued on \p stream. Steps of the same context run
+ *  in the order in which they were started. \p ctx must not be used by
+ *  other functions until the step is done.
+ *
+ *  The input and output buffers must stay valid until then and should be
+ *  page-locked, see \ref sd_gpu_alloc_pinned, so that the transfers need no
+ *  staging. The host side of the transfers is ordered with the default
+ *  stream, therefore \p stream must not be created with the
+ *  `cudaStreamNonBlocking` flag.
+ *
+ *  \param ctx context created with \ref sd_gpu_create
+ *  \param stream `cudaStream_t` or `hipStream_t`, `nullptr` selects the
+ *                default stream
+ *  \param x_host particle positions, 6 entries per particle
+ *  \param f_host particle forces and torques, 6 entries per particle
+ *  \param a_host particle radii
+ *  \param u_host output, translational and angular velocities
+ *
+ *  For the remaining parameters, see \ref sd_gpu.
+ *
+ *  \return future that becomes ready once \p u_host is written, it
+ *          rethrows errors of the step. If \p stream is non-blocking or
+ *          its flags cannot be queried, the step is not started and the
+ *          future holds a std::invalid_argument.
+ */
+std::future<void> sd_gpu_step_async(sd_gpu_context *ctx, void *stream,
+                                    double const *x_host, double const *f_host,
+                                    double const *a_host, double *u_host,
+                                    std::size_t n_part, double eta,
+                                    double sqrt_kT_Dt, std::size_t offset,
+                                    std::size_t seed, int flg) {
+  assert(ctx != nullptr);
+  // The worker thread has to use the device of the caller
+  int device = 0;
+#if defined(__HIPCC__)
+  hipError_t err = hipGetDevice(&device);
+  auto const s = static_cast<hipStream_t>(stream);
+  unsigned int stream_flags = 0;
+  if (s) {
+    err = hipStreamGetFlags(s, &stream_flags);
+  }
+  bool const valid = hipSuccess == err && !(stream_flags & hipStreamNonBlocking);
+#else
+  cudaError_t err = cudaGetDevice(&device);
+  auto const s = static_cast<cudaStream_t>(stream);
+  unsigned int stream_flags = 0;
+  if (s) {
+    err = cudaStreamGetFlags(s, &stream_flags);
+  }
+  bool const valid = cudaSuccess == err && !(stream_flags & cudaStreamNonBlocking);
+#endif
+  if (!valid) {
+    std::promise<void> rejected;
+    rejected.set_exception(std::make_exception_ptr(std::invalid_argument(
+        "sd_gpu_step_async: stream must be a valid blocking stream")));
+    return rejected.get_future();
+  }
+
+  return ctx->worker.submit([=] {
+#if defined(__HIPCC__)
+    hipError_t err = hipSetDevice(device);
+    assert(hipSuccess == err);
+#else
+    cudaError_t err = cudaSetDevice(device);
+    assert(cudaSuccess == err);
+#endif
+    static_cast<void>(err);
+    internal::handle_pool::instance().set_stream(s);
+    sd::solver<policy::device, double> viscous_force{eta, n_part, ctx->box_l};
+    using view = sd::particle_view<double const>;
+    viscous_force.calc_vel(ctx->ws, view::packed(x_host, 6 * n_part),
+                           view::packed(f_host, 6 * n_part),
+                           view::packed(a_host, n_part),
+                           sd::particle_view<double>::packed(u_host, 6 * n_part),
+                           sqrt_kT_Dt, offset, seed, flg);
+  });
+}
+
+/** Allocates page-locked host memory for \p n values, e.g. for the buffers
+ *  of \ref sd_gpu_step_async. Transfers from and to page-locked memory are
+ *  faster and can overlap with computations.
+ *
+ *  \return the buffer, to be released with \ref sd_gpu_free_pinned
+ */
+double *sd_gpu_alloc_pinned(std::size_t n) {
+  void *ptr = nullptr;
+#if defined(__HIPCC__)
+  hipError_t err = hipHostMalloc(&ptr, n * sizeof(double));
+  assert(hipSuccess == err);
+#else
+  cudaError_t err = cudaMallocHost(&ptr, n * sizeof(double));
+  assert(cudaSuccess == err);
+#endif
+  static_cast<void>(err);
+  return static_cast<double *>(ptr);
+}
+
+/** Releases a buffer of \ref sd_gpu_alloc_pinned */
+void sd_gpu_free_pinned(double *ptr) {
+#if defined(__HIPCC__)
+  hipHostFree(ptr);
+#else
+  cudaFreeHost(ptr);
+#endif
+}
+
+/** Releases all buffers held by \p ctx, after the steps started with
+ *  \ref sd_gpu_step_async are done.
+ */
+void sd_gpu_destroy(sd_gpu_context *ctx) { delete ctx; }
@@ -4,15 +4,20 @@
 /** \file
  *  This file provides a wrapper around THRUST functions and types. In case
  *  that CUDA/THRUST is not present, equivalent standard C++ types and
- *  functions are used.
+ *  functions are used. If SD_USE_OPENMP is defined, those of them that
+ *  process independent elements run on several threads.
  */
 
 
 
 // Dependencies with THRUST
 #ifdef SD_USE_THRUST
+#  include <thrust/binary_search.h>
+#  include <thrust/copy.h>
+#  include <thrust/count.h>
 #  include <thrust/device_vector.h>
 #  include <thrust/execution_policy.h>
+#  include <thrust/sort.h>
 #  include <thrust/tabulate.h>
 #  include <thrust/tuple.h>
 
@@ -31,16 +36,28 @@ namespace thrust_wrapper {
 
   // routines
   using thrust::copy;
+  using thrust::copy_if;
   using thrust::copy_n;
+  using thrust::count_if;
+  using thrust::device_pointer_cast;
   using thrust::equal;
   using thrust::fill;
   using thrust::for_each;
   using thrust::get;
+  using thrust::lower_bound;
   using thrust::make_tuple;
   using thrust::raw_pointer_cast;
+  using thrust::sort_by_key;
   using thrust::tabulate;
   using thrust::tie;
   using thrust::transform;
+
+  // Thrust chooses the number of threads of its OpenMP backend itself, the
+  // setting is only there so that callers compile with either variant
+  inline int &num_threads() {
+    static thread_local int n = 0;
+    return n;
+  }
 }
 
 
@@ -77,11 +94,17 @@ thrust::host_vector<T> operator+(thrust::host_vector<T> const &x,
 #  include <cassert>
 #  include <functional>
 #  include <iterator>
+#  include <numeric>
 #  include <tuple>
+#  include <utility>
 #  include <vector>
 
 #  include <boost/iterator/counting_iterator.hpp>
 
+#  ifdef SD_USE_OPENMP
+#    include <omp.h>
+#  endif
+
 
 namespace thrust_wrapper {
 
@@ -106,6 +129,27 @@ namespace thrust_wrapper {
   using std::make_tuple;
   using std::tie;
 
+  // Number of threads of the parallel algorithms started from the calling
+  // thread, zero selects the OpenMP default. Inside of a parallel region the
+  // algorithms run on the thread that calls them.
+  inline int &num_threads() {
+    static thread_local int n = 0;
+    return n;
+  }
+
+  // Calls f(i) for all i in [0, n), split into contiguous chunks of equal
+  // size if OpenMP is available
+  template <typename Size, typename Function>
+  void parallel_for(Size n, Function const &f) {
+#  ifdef SD_USE_OPENMP
+    int const threads = num_threads() > 0 ? num_threads() : omp_get_max_threads();
+#    pragma omp parallel for schedule(static) num_threads(threads)
+#  endif
+    for (Size i = 0; i < n; ++i) {
+      f(i);
+    }
+  }
+
   // tabulate doesn't exist in the standard library
   template <typename DerivedPolicy, typename ForwardIterator,
             typename UnaryOperation>
@@ -113,11 +157,9 @@ namespace thrust_wrapper {
                 ForwardIterator first,
                 ForwardIterator last,
                 UnaryOperation unary_op) {
-    ForwardIterator i = first;
-    while (i != last) {
-      *i = unary_op(i - first);
-      ++i;
-    }
+    parallel_for(last - first, [&](decltype(last - first) i) {
+      first[i] = unary_op(i);
+    });
   }
 
   // literally does nothing with its argument
@@ -137,21 +179,122 @@ namespace thrust_wrapper {
     return std::equal(first1, last1, first2);
   }
 
+  // With OpenMP, every thread compacts a contiguous chunk of the input. The
+  // predicate is evaluated twice, first to count the selected elements of
+  // each chunk and then to copy them behind those of the preceding chunks,
+  // so that the order is the same as with std::copy_if.
+  template <typename DerivedPolicy, typename InputIterator,
+            typename OutputIterator, typename Predicate>
+  OutputIterator copy_if(const DerivedPolicy &,
+                         InputIterator first,
+                         InputIterator last,
+                         OutputIterator result,
+                         Predicate pred) {
+#  ifdef SD_USE_OPENMP
+    using difference_type = decltype(last - first);
+    difference_type const n = last - first;
+    int const threads = num_threads() > 0 ? num_threads() : omp_get_max_threads();
+    std::vector<difference_type> offsets(static_cast<std::size_t>(threads) + 1, 0);
+#    pragma omp parallel num_threads(threads)
+    {
+      auto const t = static_cast<std::size_t>(omp_get_thread_num());
+      auto const n_threads = static_cast<difference_type>(omp_get_num_threads());
+      difference_type const begin = n * static_cast<difference_type>(t) / n_threads;
+      difference_type const end = n * static_cast<difference_type>(t + 1) / n_threads;
+      difference_type count = 0;
+      for (difference_type i = begin; i < end; ++i) {
+        count += pred(first[i]) ? 1 : 0;
+      }
+      offsets[t + 1] = count;
+#    pragma omp barrier
+#    pragma omp single
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      OutputIterator out = result + offsets[t];
+      for (difference_type i = begin; i < end; ++i) {
+        if (pred(first[i])) {
+          *out++ = first[i];
+        }
+      }
+    }
+    return result + offsets.back();
+#  else
+    return std::copy_if(first, last, result, pred);
+#  endif
+  }
+
+  template <typename DerivedPolicy, typename InputIterator,
+            typename Predicate>
+  typename std::iterator_traits<InputIterator>::difference_type
+  count_if(const DerivedPolicy &,
+           InputIterator first,
+           InputIterator last,
+           Predicate pred) {
+    return std::count_if(first, last, pred);
+  }
+
+  // sort the values by their keys, in contrast to THRUST the sort is stable
+  template <typename DerivedPolicy, typename RandomAccessIterator1,
+            typename RandomAccessIterator2>
+  void sort_by_key(const DerivedPolicy &,
+                   RandomAccessIterator1 keys_first,
+                   RandomAccessIterator1 keys_last,
+                   RandomAccessIterator2 values_first) {
+    using key_type =
+        typename std::iterator_traits<RandomAccessIterator1>::value_type;
+    using value_type =
+        typename std::iterator_traits<RandomAccessIterator2>::value_type;
+    std::vector<std::pair<key_type, value_type>> zipped;
+    zipped.reserve(keys_last - keys_first);
+    for (auto k = keys_first, v = values_first; k != keys_last; ++k, ++v) {
+      zipped.emplace_back(*k, *v);
+    }
+    std::stable_sort(zipped.begin(), zipped.end(),
+                     [](std::pair<key_type, value_type> const &lhs,
+                        std::pair<key_type, value_type> const &rhs) {
+                       return lhs.first < rhs.first;
+                     });
+    for (auto const &kv : zipped) {
+      *keys_first++ = kv.first;
+      *values_first++ = kv.second;
+    }
+  }
+
+  // vectorized lower_bound, writes the position of each value
+  template <typename DerivedPolicy, typename ForwardIterator,
+            typename InputIterator, typename OutputIterator>
+  OutputIterator lower_bound(const DerivedPolicy &,
+                             ForwardIterator first,
+                             ForwardIterator last,
+                             InputIterator values_first,
+                             InputIterator values_last,
+                             OutputIterator result) {
+    for (; values_first != values_last; ++values_first, ++result) {
+      *result = std::lower_bound(first, last, *values_first) - first;
+    }
+    return result;
+  }
+
   template <typename DerivedPolicy, typename ForwardIterator, typename T>
   void fill(const DerivedPolicy &,
             ForwardIterator first,
             ForwardIterator last,
             const T &value) {
-    std::fill(first, last, value);
+    parallel_for(last - first, [&](decltype(last - first) i) {
+      first[i] = value;
+    });
   }
 
+  // In contrast to std::for_each, the function is not applied in order,
+  // all threads call the same function object
   template <typename DerivedPolicy, typename InputIterator,
             typename UnaryFunction>
   void for_each(const DerivedPolicy &,
                 InputIterator first,
                 InputIterator last,
                 UnaryFunction f) {
-    std::for_each(first, last, f);
+    parallel_for(last - first, [&](decltype(last - first) i) {
+      f(first[i]);
+    });
   }
 
   // unary transform
@@ -162,20 +305,25 @@ namespace thrust_wrapper {
                  ForwardIterator last,
                  OutputIterator result,
                  UnaryFunction op) {
-    std::transform(first, last, result, op);
+    parallel_for(last - first, [&](decltype(last - first) i) {
+      result[i] = op(first[i]);
+    });
   }
 
   // binary transform
   template <typename DerivedPolicy, typename InputIterator1,
             typename InputIterator2, typename OutputIterator,
             typename BinaryFunction>
-  bool transform(const DerivedPolicy &,
-                 InputIterator1 first1,
-                 InputIterator1 last1,
-                 InputIterator2 first2,
-                 OutputIterator result,
-                 BinaryFunction op) {
-    return std::transform(first1, last1, first2, result, op);
+  OutputIterator transform(const DerivedPolicy &,
+                           InputIterator1 first1,
+                           InputIterator1 last1,
+                           InputIterator2 first2,
+                           OutputIterator result,
+                           BinaryFunction op) {
+    parallel_for(last1 - first1, [&](decltype(last1 - first1) i) {
+      result[i] = op(first1[i], first2[i]);
+    });
+    return result + (last1 - first1);
   }
 
 }
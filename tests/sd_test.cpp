@@ -0,0 +1,390 @@
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "sd_test.hpp"
+
+using namespace sd_test;
+
+namespace {
+
+using solver_type = sd::solver<policy::host, double>;
+using workspace_type = sd::workspace<policy::host, double>;
+
+std::size_t const n_part = 27;
+double const sqrt_kT_Dt = 0.3;
+
+/** The conjugate gradient method stops at a relative residual of 1e-10,
+ *  without thermal forces, whose square root differs from the Cholesky
+ *  factor of the dense solver
+ */
+bool iterative() {
+  configuration const conf(n_part);
+  bool ok = true;
+  for (int flg : {ft, ft | LUBRICATION}) {
+    solver_type solver{1.0, n_part};
+    workspace_type ws{n_part, flg | sd::flags::ITERATIVE};
+    sd_instrumentation stats;
+    ws.stats = &stats;
+    auto const u = solver.calc_vel(ws, conf.x, conf.f, conf.a, 0.0, 3, 42,
+                                   flg | sd::flags::ITERATIVE);
+    ok &= check("iterative vs dense", flg,
+                max_difference(u, dense(conf, flg, 0.0)), 1e-6);
+    ok &= check("iterative fallbacks", flg,
+                static_cast<double>(stats.fallbacks), 0);
+  }
+  return ok;
+}
+
+/** The refinement in double precision reaches the dense result */
+bool mixed_precision() {
+  configuration const conf(n_part);
+  bool ok = true;
+  for (int flg : dense_flgs) {
+    solver_type solver{1.0, n_part};
+    workspace_type ws{n_part, flg | sd::flags::MIXED_PRECISION};
+    auto const u = solver.calc_vel(ws, conf.x, conf.f, conf.a, 0.0, 3, 42,
+                                   flg | sd::flags::MIXED_PRECISION);
+    ok &= check("mixed precision vs dense", flg,
+                max_difference(u, dense(conf, flg, 0.0)), 1e-10);
+  }
+  return ok;
+}
+
+/** A step after a small displacement reuses the factors of the first one
+ *  and converges to the velocities of the dense solver
+ */
+bool reuse_factorization() {
+  configuration const conf(n_part);
+  configuration moved = conf;
+  for (std::size_t i = 0; i < n_part; ++i) {
+    moved.x[6 * i] += 0.01 * std::cos(static_cast<double>(i));
+  }
+  bool ok = true;
+  for (int flg : {ft, ft | LUBRICATION}) {
+    int const reuse = flg | sd::flags::REUSE_FACTORIZATION;
+    solver_type solver{1.0, n_part};
+    workspace_type ws{n_part, reuse};
+    solver.calc_vel(ws, conf.x, conf.f, conf.a, 0.0, 3, 42, reuse);
+    sd_instrumentation stats;
+    ws.stats = &stats;
+    auto const u =
+        solver.calc_vel(ws, moved.x, moved.f, moved.a, 0.0, 3, 42, reuse);
+    ok &= check("reused factors vs dense", flg,
+                max_difference(u, dense(moved, flg, 0.0)), 1e-8);
+    ok &= check("reused factors fallbacks", flg,
+                static_cast<double>(stats.fallbacks), 0);
+    ok &= check("reused factors, no iterations", flg,
+                stats.iterations > 0 ? 0 : 1, 0);
+  }
+  return ok;
+}
+
+/** The shared buffers change the order of nothing but the allocations */
+bool low_memory() {
+  configuration const conf(n_part);
+  bool ok = true;
+  for (int flg : dense_flgs) {
+    auto const u = dense(conf, flg | sd::flags::LOW_MEMORY, sqrt_kT_Dt);
+    ok &= check("low memory vs dense", flg,
+                max_difference(u, dense(conf, flg, sqrt_kT_Dt)), 1e-12);
+  }
+  return ok;
+}
+
+/** The specialized kernels of equal radii compute the same terms */
+bool monodisperse() {
+  configuration const conf(n_part, false);
+  bool ok = true;
+  for (int flg : dense_flgs) {
+    auto const u = dense(conf, flg | sd::flags::MONODISPERSE, sqrt_kT_Dt);
+    ok &= check("monodisperse vs dense", flg,
+                max_difference(u, dense(conf, flg, sqrt_kT_Dt)), 1e-12);
+  }
+  return ok;
+}
+
+/** Shifting all particles, or single particles by a box length, does not
+ *  change the velocities in a periodic box
+ */
+bool periodic() {
+  configuration const conf(n_part);
+  double const box_l = 7.5;
+  configuration shifted = conf;
+  for (std::size_t i = 0; i < n_part; ++i) {
+    shifted.x[6 * i + 0] += 0.37 * box_l;
+    shifted.x[6 * i + 1] -= 1.2 * box_l;
+    shifted.x[6 * i + 2] += (i % 3 == 0 ? 2.0 : 0.0) * box_l + 0.1;
+  }
+  bool ok = true;
+  for (int flg : {ft, ft | LUBRICATION}) {
+    int const per = flg | sd::flags::PERIODIC;
+    auto const u = dense(shifted, per, sqrt_kT_Dt, box_l);
+    ok &= check("periodic, shifted vs unshifted", flg,
+                max_difference(u, dense(conf, per, sqrt_kT_Dt, box_l)),
+                1e-12);
+  }
+  return ok;
+}
+
+/** Remove all files of the factor cache in \p directory */
+void clear_cache(std::string const &directory) {
+  ::mkdir(directory.c_str(), 0755);
+  if (DIR *dir = ::opendir(directory.c_str())) {
+    while (dirent const *entry = ::readdir(dir)) {
+      if (std::strncmp(entry->d_name, "sd_", 3) == 0) {
+        ::unlink((directory + "/" + entry->d_name).c_str());
+      }
+    }
+    ::closedir(dir);
+  }
+}
+
+/** Names of the files of the factor cache in \p directory */
+std::vector<std::string> cache_files(std::string const &directory) {
+  std::vector<std::string> files;
+  if (DIR *dir = ::opendir(directory.c_str())) {
+    while (dirent const *entry = ::readdir(dir)) {
+      if (std::strncmp(entry->d_name, "sd_", 3) == 0) {
+        files.emplace_back(entry->d_name);
+      }
+    }
+    ::closedir(dir);
+  }
+  return files;
+}
+
+/** Copy the file \p from over \p to */
+bool copy_file(std::string const &from, std::string const &to) {
+  std::FILE *in = std::fopen(from.c_str(), "rb");
+  std::FILE *out = in ? std::fopen(to.c_str(), "wb") : nullptr;
+  bool ok = out != nullptr;
+  char buffer[4096];
+  std::size_t n;
+  while (ok && (n = std::fread(buffer, 1, sizeof(buffer), in)) > 0) {
+    ok = std::fwrite(buffer, 1, n, out) == n;
+  }
+  if (out) {
+    ok &= std::fclose(out) == 0;
+  }
+  if (in) {
+    std::fclose(in);
+  }
+  return ok;
+}
+
+/** A step with lubrication that found its factor in the cache skips the
+ *  pair search, so the lubrication pairs tell hits from misses
+ */
+bool factor_cache(std::string const &directory) {
+  configuration const conf(n_part);
+  configuration other = conf;
+  other.x[0] += 0.05;
+  std::string const first = directory + "/first";
+  std::string const second = directory + "/second";
+  bool ok = true;
+  for (int flg : {ft | LUBRICATION, ft | FTS | LUBRICATION}) {
+    clear_cache(directory);
+    clear_cache(first);
+    clear_cache(second);
+    solver_type solver{1.0, n_part};
+    auto const step = [&](configuration const &c, std::string const &dir,
+                          bool &hit) {
+      workspace_type ws{n_part, flg};
+      ws.factor_cache = dir;
+      sd_instrumentation stats;
+      ws.stats = &stats;
+      auto u = solver.calc_vel(ws, c.x, c.f, c.a, sqrt_kT_Dt, 3, 42, flg);
+      hit = stats.lubrication_pairs == 0;
+      return u;
+    };
+    auto const ref = dense(conf, flg, sqrt_kT_Dt);
+    auto const ref_other = dense(other, flg, sqrt_kT_Dt);
+    bool hit = true;
+
+    auto u = step(conf, first, hit);
+    ok &= check("cache, first step misses", flg, hit ? 1 : 0, 0);
+    ok &= check("cache, first step vs dense", flg, max_difference(u, ref),
+                1e-12);
+    u = step(conf, first, hit);
+    ok &= check("cache, second step hits", flg, hit ? 0 : 1, 0);
+    ok &= check("cache, hit vs dense", flg, max_difference(u, ref), 1e-12);
+    u = step(other, first, hit);
+    ok &= check("cache, other configuration misses", flg, hit ? 1 : 0, 0);
+    ok &= check("cache, miss vs dense", flg, max_difference(u, ref_other),
+                1e-12);
+
+    // The files of the first configuration under the names of the second
+    // one hold another key and must not be loaded
+    step(other, second, hit);
+    std::vector<std::string> const files = cache_files(second);
+    for (std::string const &file : files) {
+      std::string const matrix = file.substr(file.find('.'));
+      for (std::string const &source : cache_files(first)) {
+        if (source.substr(source.find('.')) == matrix &&
+            source != file) {
+          ok &= copy_file(first + "/" + source, second + "/" + file);
+        }
+      }
+    }
+    u = step(other, second, hit);
+    ok &= check("cache, mismatched key misses", flg,
+                hit || files.empty() ? 1 : 0, 0);
+    ok &= check("cache, mismatched key vs dense", flg,
+                max_difference(u, ref_other), 1e-12);
+  }
+  clear_cache(first);
+  clear_cache(second);
+  ::rmdir(first.c_str());
+  ::rmdir(second.c_str());
+  return ok;
+}
+
+/** System b of a batch gets the velocities of a single system whose random
+ *  numbers start at index 6 * n_part * b
+ */
+bool batch() {
+  std::size_t const n = 8, n_batch = 4;
+  configuration const conf(n * n_batch);
+  bool ok = true;
+  for (int flg : dense_flgs) {
+    sd::batch_solver<policy::host, double> batch_solver{1.0, n};
+    sd::batch_workspace<policy::host, double> batch_ws;
+    std::vector<double> u;
+    // twice, so that the second call runs in the kept buffers
+    for (int call = 0; call < 2; ++call) {
+      u = batch_solver.calc_vel(batch_ws, conf.x, conf.f, conf.a, n_batch,
+                                sqrt_kT_Dt, 3, 42, flg);
+    }
+    std::vector<double> ref;
+    for (std::size_t b = 0; b < n_batch; ++b) {
+      auto const part = [&](std::vector<double> const &v, std::size_t width) {
+        return std::vector<double>(v.begin() + width * n * b,
+                                   v.begin() + width * n * (b + 1));
+      };
+      solver_type solver{1.0, n};
+      workspace_type ws{n, flg};
+      auto const v =
+          solver.calc_vel(ws, part(conf.x, 6), part(conf.f, 6),
+                          part(conf.a, 1), sqrt_kT_Dt, 3, 42, flg, nullptr,
+                          6 * n * b);
+      ref.insert(ref.end(), v.begin(), v.end());
+    }
+    ok &= check("batch vs single systems", flg, max_difference(u, ref),
+                1e-12);
+  }
+  return ok;
+}
+
+/** Force vector c of a multi-RHS step gets the velocities of a single step
+ *  whose random numbers start at index 6 * n_part * c
+ */
+bool multi_rhs() {
+  std::size_t const n_rhs = 3;
+  configuration const conf(n_part);
+  std::vector<double> f;
+  for (std::size_t c = 0; c < n_rhs; ++c) {
+    for (double const value : conf.f) {
+      f.push_back(value * (1.0 + c));
+    }
+  }
+  bool ok = true;
+  for (int flg : dense_flgs) {
+    solver_type solver{1.0, n_part};
+    workspace_type ws{n_part, flg};
+    auto const u = solver.calc_vel(ws, conf.x, f, conf.a, sqrt_kT_Dt, 3, 42,
+                                   flg, nullptr, 0, n_rhs);
+    std::vector<double> ref;
+    for (std::size_t c = 0; c < n_rhs; ++c) {
+      std::vector<double> const fc(f.begin() + 6 * n_part * c,
+                                   f.begin() + 6 * n_part * (c + 1));
+      workspace_type ws_c{n_part, flg};
+      auto const v = solver.calc_vel(ws_c, conf.x, fc, conf.a, sqrt_kT_Dt, 3,
+                                     42, flg, nullptr, 6 * n_part * c);
+      ref.insert(ref.end(), v.begin(), v.end());
+    }
+    ok &= check("multi-RHS vs single steps", flg, max_difference(u, ref),
+                1e-12);
+  }
+  return ok;
+}
+
+/** Regression test: pairs of spheres with radii above 1 used to read the
+ *  table of the lubrication functions beyond its end, which filled all
+ *  velocities with NaN
+ */
+bool polydisperse_lubrication() {
+  std::size_t const n = 20;
+  configuration conf(n);
+  double position = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    conf.a[i] = i % 2 == 1 ? 1.5 : 1.0;
+    if (i > 0) {
+      position += conf.a[i - 1] + conf.a[i] + 0.05;
+    }
+    conf.x[6 * i + 0] = position;
+    conf.x[6 * i + 1] = 0.05 * std::sin(static_cast<double>(i));
+    conf.x[6 * i + 2] = 0.05 * std::cos(static_cast<double>(i));
+  }
+  bool ok = true;
+  for (int flg : {ft | LUBRICATION, ft | FTS | LUBRICATION}) {
+    auto const u = dense(conf, flg, 0.0);
+    std::size_t nan = 0;
+    for (double const value : u) {
+      nan += std::isfinite(value) ? 0 : 1;
+    }
+    ok &= check("polydisperse lubrication NaNs", flg,
+                static_cast<double>(nan), 0);
+  }
+  return ok;
+}
+
+} // namespace
+
+/** Compares the modes of the solver against the dense solver, one test per
+ *  call, e.g.
+ *
+ *      sd_test periodic
+ *      sd_test factor_cache <directory>
+ *
+ *  \return 0 if all comparisons are within their limits
+ */
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s <test> [<cache directory>]\n", argv[0]);
+    return 2;
+  }
+  std::string const test = argv[1];
+  bool ok = false;
+  if (test == "iterative") {
+    ok = iterative();
+  } else if (test == "mixed_precision") {
+    ok = mixed_precision();
+  } else if (test == "reuse_factorization") {
+    ok = reuse_factorization();
+  } else if (test == "low_memory") {
+    ok = low_memory();
+  } else if (test == "monodisperse") {
+    ok = monodisperse();
+  } else if (test == "periodic") {
+    ok = periodic();
+  } else if (test == "factor_cache" && argc > 2) {
+    ok = factor_cache(argv[2]);
+  } else if (test == "batch") {
+    ok = batch();
+  } else if (test == "multi_rhs") {
+    ok = multi_rhs();
+  } else if (test == "polydisperse_lubrication") {
+    ok = polydisperse_lubrication();
+  } else {
+    std::fprintf(stderr, "unknown test %s\n", test.c_str());
+    return 2;
+  }
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+#ifndef SD_TEST_HPP
+#define SD_TEST_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include "sd.hpp"
+
+namespace sd_test {
+
+using sd::flags::FTS;
+using sd::flags::LUBRICATION;
+using sd::flags::PAIR_MOBILITY;
+using sd::flags::SELF_MOBILITY;
+
+/** far field F-T mode, the flags of the other modes are added to it */
+int const ft = SELF_MOBILITY | PAIR_MOBILITY;
+
+/** The four dense modes: F-T and FTS, with and without lubrication */
+std::vector<int> const dense_flgs = {ft, ft | LUBRICATION, ft | FTS,
+                                     ft | FTS | LUBRICATION};
+
+/** A system of \p n_part spheres on a slightly perturbed simple cubic
+ *  lattice, like the one of the benchmarks. The lattice constant of 2.5
+ *  keeps every sphere free of overlaps and puts its neighbours within the
+ *  lubrication cutoff. A cube of side 2.5 n^(1/3) holds the lattice
+ *  without overlaps in a periodic box. With \p polydisperse, the radii
+ *  alternate between 1 and 1.1, otherwise all of them are 1.
+ */
+struct configuration {
+    std::size_t n_part;
+    std::vector<double> x, f, a;
+
+    explicit configuration(std::size_t n_part, bool polydisperse = true)
+        : n_part(n_part), x(6 * n_part), f(6 * n_part), a(n_part, 1.0) {
+        // smallest cube that holds all spheres, cbrt may round up
+        auto side = static_cast<std::size_t>(
+            std::round(std::cbrt(static_cast<double>(n_part))));
+        while (side * side * side < n_part) {
+            ++side;
+        }
+        for (std::size_t i = 0; i < n_part; ++i) {
+            std::size_t const ijk[3] = {i % side, (i / side) % side,
+                                        i / (side * side)};
+            for (std::size_t d = 0; d < 3; ++d) {
+                // deterministic jitter of at most 0.1
+                double const jitter = 0.1 * std::sin(1.7 * i + 2.9 * d);
+                x[6 * i + d] = 2.5 * ijk[d] + jitter;
+                f[6 * i + d] = std::cos(0.3 * i + d);
+                f[6 * i + 3 + d] = std::sin(0.7 * i + d);
+            }
+            if (polydisperse && i % 2 == 1) {
+                a[i] = 1.1;
+            }
+        }
+    }
+};
+
+/** Largest difference between \p u and \p ref relative to the largest
+ *  element of \p ref. Any NaN in \p u makes it infinite.
+ */
+inline double max_difference(std::vector<double> const &u,
+                             std::vector<double> const &ref) {
+    if (u.size() != ref.size()) {
+        return INFINITY;
+    }
+    double diff = 0, norm = 0;
+    for (std::size_t i = 0; i < u.size(); ++i) {
+        if (!std::isfinite(u[i])) {
+            return INFINITY;
+        }
+        diff = std::max(diff, std::abs(u[i] - ref[i]));
+        norm = std::max(norm, std::abs(ref[i]));
+    }
+    return norm > 0 ? diff / norm : diff;
+}
+
+/** Print the result of one comparison.
+ *
+ *  \return whether \p value is within \p limit
+ */
+inline bool check(char const *what, int flg, double value, double limit) {
+    bool const ok = value <= limit;
+    std::printf("%-32s flg=%-4d %.3e (limit %.0e) %s\n", what, flg, value,
+                limit, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+/** Velocities of the dense double precision solver in a fresh workspace */
+inline std::vector<double> dense(configuration const &conf, int flg,
+                                 double sqrt_kT_Dt, double box_l = 0) {
+    sd::solver<policy::host, double> solver{1.0, conf.n_part, box_l};
+    sd::workspace<policy::host, double> ws{conf.n_part, flg};
+    return solver.calc_vel(ws, conf.x, conf.f, conf.a, sqrt_kT_Dt, 3, 42,
+                           flg);
+}
+
+} // namespace sd_test
+
+#endif